@@ -208,6 +208,52 @@ int main(void)
 }"
 )
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll and timerfd"
+    CODE
+"#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+int epfd = epoll_create1(EPOLL_CLOEXEC);
+int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+struct itimerspec spec = {};
+timerfd_settime(tfd, TFD_TIMER_ABSTIME, &spec, 0);
+struct epoll_event ev;
+ev.events = EPOLLIN;
+ev.data.fd = tfd;
+epoll_ctl(epfd, EPOLL_CTL_ADD, tfd, &ev);
+epoll_wait(epfd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+int fd = syscall(__NR_io_uring_setup, 8, &params);
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_READ;
+syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, &fd, 1);
+syscall(__NR_io_uring_enter, fd, 1, 0, IORING_ENTER_GETEVENTS, 0, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # eventfd
 qt_config_compile_test(eventfd
     LABEL "eventfd"
@@ -290,6 +336,27 @@ return __GLIBC__;
 }
 ")
 
+# fanotify
+qt_config_compile_test(fanotify
+    LABEL "fanotify"
+    CODE
+"#include <fcntl.h>
+#include <sys/fanotify.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+int fd = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME, O_RDONLY);
+fanotify_mark(fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, FAN_CREATE | FAN_ONDIR, AT_FDCWD, \"foobar\");
+struct file_handle *handle = 0;
+int mountId;
+name_to_handle_at(AT_FDCWD, \"foobar\", handle, &mountId, 0);
+open_by_handle_at(fd, handle, O_PATH);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # inotify
 qt_config_compile_test(inotify
     LABEL "inotify"
@@ -590,6 +657,10 @@ qt_feature("dladdr" PRIVATE
     LABEL "dladdr"
     CONDITION QT_FEATURE_dlopen AND TEST_dladdr
 )
+qt_feature("epoll" PRIVATE
+    LABEL "epoll event dispatcher"
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("eventfd" PUBLIC
     LABEL "eventfd"
     CONDITION NOT WASM AND TEST_eventfd
@@ -623,6 +694,14 @@ qt_feature("icu" PRIVATE
     AUTODETECT NOT WIN32
     CONDITION ICU_FOUND
 )
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND QT_FEATURE_future AND QT_FEATURE_eventfd AND TEST_io_uring
+)
+qt_feature("fanotify" PRIVATE
+    LABEL "fanotify"
+    CONDITION LINUX AND TEST_fanotify
+)
 qt_feature("inotify" PUBLIC PRIVATE
     LABEL "inotify"
     CONDITION TEST_inotify
@@ -0,0 +1,11 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+qint64 totalSize = 0;
+QDirWalker walker(assetPath, {"*.png", "*.ktx"}, QDir::Files);
+walker.walk([&totalSize](const QFileInfoList &batch) {
+    for (const QFileInfo &info : batch)
+        totalSize += info.size();
+});
+//! [0]
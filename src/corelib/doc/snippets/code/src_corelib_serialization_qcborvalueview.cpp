@@ -0,0 +1,12 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    QFile file(u"assets.cbor"_s);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    const uchar *data = file.map(0, file.size());
+    const QCborValueView assets = QCborValueView::fromCbor(QByteArrayView(data, file.size()));
+    const QCborValueView icon = assets["themes"]["dark"]["icons"]["close"];
+    return icon["path"].toString();
+//! [0]
@@ -0,0 +1,31 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    // Finds the "version" member of the top-level object, without reading
+    // the rest of the document.
+    QJsonStreamReader reader(&file);
+    if (reader.readNext() != QJsonStreamReader::StartObject)
+        return {};
+    while (reader.readNext() == QJsonStreamReader::Name) {
+        if (reader.text() == "version"_L1) {
+            reader.readNext();
+            return reader.readValue().toString();
+        }
+        reader.skipValue();
+    }
+    return {};
+//! [0]
+
+//! [1]
+    QJsonStreamWriter writer(&file);
+    writer.startObject();
+    writer.writeName("name"_L1);
+    writer.writeString(name);
+    writer.writeName("samples"_L1);
+    writer.startArray();
+    for (double sample : samples)
+        writer.writeDouble(sample);
+    writer.endArray();
+    writer.endObject();
+//! [1]
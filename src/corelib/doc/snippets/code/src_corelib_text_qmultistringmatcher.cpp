@@ -0,0 +1,11 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    const QMultiStringMatcher matcher({ u"error"_s, u"warning"_s, u"fatal"_s },
+                                      Qt::CaseInsensitive);
+    for (const QString &line : lines) {
+        for (const QMultiStringMatcher::Match &match : matcher.matches(line))
+            route(line, matcher.patterns().at(match.patternIndex));
+    }
+//! [0]
@@ -788,16 +788,18 @@ size_t simdSwapLoop(const uchar *src, size_t bytes, uchar *dst) noexcept
 }
 #elif defined(__SSE2__)
 template <typename T> static
-size_t simdSwapLoop(const uchar *, size_t, uchar *) noexcept
-{
-    // no generic version: we can't do 32- and 64-bit swaps easily,
-    // so we won't try
-    return 0;
-}
-
-template <> size_t simdSwapLoop<quint16>(const uchar *src, size_t bytes, uchar *dst) noexcept
+size_t simdSwapLoop(const uchar *src, size_t bytes, uchar *dst) noexcept
 {
+    // Without SSSE3's PSHUFB, reverse the order of the 16-bit words inside
+    // each element first and then swap the two bytes of every word.
     auto swapEndian = [](__m128i &data) {
+        if constexpr (sizeof(T) == 4) {
+            data = _mm_shufflelo_epi16(data, _MM_SHUFFLE(2, 3, 0, 1));
+            data = _mm_shufflehi_epi16(data, _MM_SHUFFLE(2, 3, 0, 1));
+        } else if constexpr (sizeof(T) == 8) {
+            data = _mm_shufflelo_epi16(data, _MM_SHUFFLE(0, 1, 2, 3));
+            data = _mm_shufflehi_epi16(data, _MM_SHUFFLE(0, 1, 2, 3));
+        }
         __m128i lows = _mm_srli_epi16(data, 8);
         __m128i highs = _mm_slli_epi16(data, 8);
         data = _mm_xor_si128(lows, highs);
@@ -821,8 +823,8 @@ template <> size_t simdSwapLoop<quint16>(const uchar *src, size_t bytes, uchar *
     }
 
     // epilogue
-    for (size_t _i = 0 ; i < bytes && _i < sizeof(__m128i); i += sizeof(quint16), _i += sizeof(quint16))
-        qbswap(qFromUnaligned<quint16>(src + i), dst + i);
+    for (size_t _i = 0 ; i < bytes && _i < sizeof(__m128i); i += sizeof(T), _i += sizeof(T))
+        qbswap(qFromUnaligned<T>(src + i), dst + i);
 
     // return the total, so the bswapLoop below does nothing
     return bytes;
@@ -81,6 +81,14 @@ extern char *__progname;
 #  define QLOGGING_HAVE_BACKTRACE
 #endif
 
+#if QT_CONFIG(thread) && defined(Q_COMPILER_THREAD_LOCAL)
+#  include "qmath.h"
+#  include "private/qwaitcondition_p.h"
+#  include <atomic>
+#  include <thread>
+#  define QLOGGING_HAVE_ASYNC_OUTPUT
+#endif
+
 #if defined(Q_OS_LINUX) && (defined(__GLIBC__) || __has_include(<sys/syscall.h>))
 #  include <sys/syscall.h>
 
@@ -1165,6 +1173,34 @@ static const char emptyTokenC[] = "";
 
 static const char defaultPattern[] = "%{if-category}%{category}: %{endif}%{message}";
 
+#ifndef QT_BOOTSTRAPPED
+// The parts of a formatted message that depend on where and when the message
+// was logged. The asynchronous output records them on the calling thread,
+// qFormatLogMessage() uses them when it runs on the output thread.
+struct QMessageLogOrigin
+{
+    enum Field {
+        ThreadId = 0x1,
+        ThreadPointer = 0x2,
+        Time = 0x4,
+        Backtrace = 0x8,
+    };
+
+    int fields = 0;
+    bool formatted = false;     // the message already is the formatted one
+    qint64 threadId = 0;
+    quintptr threadPointer = 0;
+    qint64 processTime = 0;
+    qint64 bootTime = 0;
+    qint64 currentTime = 0;
+};
+#endif
+
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+// set while the asynchronous output writes a message
+Q_CONSTINIT static thread_local const QMessageLogOrigin *messageOrigin = nullptr;
+#endif
+
 struct QMessagePattern
 {
     QMessagePattern();
@@ -1189,6 +1225,9 @@ struct QMessagePattern
 #endif
 
     bool fromEnvironment;
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    QAtomicInt originFields; // QMessageLogOrigin::Fields used by the pattern
+#endif
     static QBasicMutex mutex;
 };
 #ifdef QLOGGING_HAVE_BACKTRACE
@@ -1356,6 +1395,21 @@ void QMessagePattern::setPattern(const QString &pattern)
     if (!error.isEmpty())
         qt_message_print(error);
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    int fields = 0;
+    for (int i = 0; tokens[i]; ++i) {
+        if (tokens[i] == threadidTokenC)
+            fields |= QMessageLogOrigin::ThreadId;
+        else if (tokens[i] == qthreadptrTokenC)
+            fields |= QMessageLogOrigin::ThreadPointer;
+        else if (tokens[i] == timeTokenC)
+            fields |= QMessageLogOrigin::Time;
+        else if (tokens[i] == backtraceTokenC)
+            fields |= QMessageLogOrigin::Backtrace;
+    }
+    originFields.storeRelaxed(fields);
+#endif
+
     literals.reset(new std::unique_ptr<const char[]>[literalsVar.size() + 1]);
     std::move(literalsVar.begin(), literalsVar.end(), &literals[0]);
 }
@@ -1554,6 +1608,19 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
         return message;
     }
 
+#ifndef QT_BOOTSTRAPPED
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    const QMessageLogOrigin *origin = messageOrigin;
+    if (origin && origin->formatted)
+        return str;
+#else
+    const QMessageLogOrigin *origin = nullptr;
+#endif
+    const auto hasOrigin = [origin](QMessageLogOrigin::Field field) {
+        return origin && (origin->fields & field);
+    };
+#endif
+
     bool skip = false;
 
 #ifndef QT_BOOTSTRAPPED
@@ -1613,10 +1680,16 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             message.append(QCoreApplication::applicationName());
         } else if (token == threadidTokenC) {
             // print the TID as decimal
-            message.append(QString::number(qt_gettid()));
+            if (hasOrigin(QMessageLogOrigin::ThreadId))
+                message.append(QString::number(origin->threadId));
+            else
+                message.append(QString::number(qt_gettid()));
         } else if (token == qthreadptrTokenC) {
             message.append("0x"_L1);
-            message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
+            if (hasOrigin(QMessageLogOrigin::ThreadPointer))
+                message.append(QString::number(qulonglong(origin->threadPointer), 16));
+            else
+                message.append(QString::number(qlonglong(QThread::currentThread()->currentThread()), 16));
 #ifdef QLOGGING_HAVE_BACKTRACE
         } else if (token == backtraceTokenC) {
             QMessagePattern::BacktraceParams backtraceParams = pattern->backtraceArgs.at(backtraceArgsIdx);
@@ -1626,19 +1699,23 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
         } else if (token == timeTokenC) {
             QString timeFormat = pattern->timeArgs.at(timeArgsIdx);
             timeArgsIdx++;
+            const bool hasTime = hasOrigin(QMessageLogOrigin::Time);
             if (timeFormat == "process"_L1) {
-                quint64 ms = pattern->timer.elapsed();
+                quint64 ms = hasTime ? origin->processTime : pattern->timer.elapsed();
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
             } else if (timeFormat == "boot"_L1) {
                 // just print the milliseconds since the elapsed timer reference
                 // like the Linux kernel does
-                qint64 ms = QDeadlineTimer::current().deadline();
+                qint64 ms = hasTime ? origin->bootTime : QDeadlineTimer::current().deadline();
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                const QDateTime now = hasTime ? QDateTime::fromMSecsSinceEpoch(origin->currentTime)
+                                              : QDateTime::currentDateTime();
+                if (timeFormat.isEmpty())
+                    message.append(now.toString(Qt::ISODate));
+                else
+                    message.append(now.toString(timeFormat));
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1925,12 +2002,22 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     fflush(stderr);
 }
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+static bool postAsyncMessage(QtMsgType type, const QMessageLogContext &context,
+                             const QString &message);
+#endif
+
 /*!
     \internal
 */
 static void qDefaultMessageHandler(QtMsgType type, const QMessageLogContext &context,
                                    const QString &message)
 {
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    if (postAsyncMessage(type, context, message))
+        return;
+#endif
+
     bool handledStderr = false;
 
     // A message sink logs the message to a structured or unstructured destination,
@@ -1984,6 +2071,455 @@ static bool grabMessageHandler() { return true; }
 static void ungrabMessageHandler() { }
 #endif // (Q_COMPILER_THREAD_LOCAL)
 
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+// ------------------------ Asynchronous output -----------------------------
+
+// Written messages are kept in one single-producer/single-consumer ring buffer
+// per logging thread, so posting a message never waits for another thread.
+// A dedicated thread drains the buffers and calls the message sinks. Whoever
+// holds QAsyncMessageOutput::drainMutex is the one consumer of all buffers.
+
+struct QQueuedMessage
+{
+    QString message;
+    QByteArray contextStrings;  // file, function and category, each '\0'-terminated
+    QMessageLogOrigin origin;
+    QtMsgType type = QtDebugMsg;
+    int line = 0;
+    int fileOffset = -1;
+    int functionOffset = -1;
+    int categoryOffset = -1;
+    qsizetype size = 0;
+
+    void setContext(const QMessageLogContext &context)
+    {
+        // keeps the capacity, so a slot allocates only while it's still growing
+        contextStrings.resize(0);
+        const auto append = [this](const char *str) {
+            if (!str)
+                return -1;
+            const int offset = int(contextStrings.size());
+            contextStrings.append(str, qsizetype(strlen(str)) + 1);
+            return offset;
+        };
+        line = context.line;
+        fileOffset = append(context.file);
+        functionOffset = append(context.function);
+        // the category object may be gone by the time the message is written
+        categoryOffset = append(context.category);
+    }
+
+    const char *contextString(int offset) const
+    {
+        return offset < 0 ? nullptr : contextStrings.constData() + offset;
+    }
+};
+
+class QMessageQueue
+{
+public:
+    explicit QMessageQueue(quintptr capacity)
+        : messages(new QQueuedMessage[capacity]), mask(capacity - 1)
+    {
+    }
+
+    // producer side
+    QQueuedMessage *freeSlot()
+    {
+        const quintptr h = head.loadRelaxed();
+        if (h - tail.loadAcquire() > mask)
+            return nullptr;
+        return &messages[h & mask];
+    }
+
+    void push(qsizetype size)
+    {
+        queuedBytes.fetchAndAddRelaxed(size);
+        head.storeRelease(head.loadRelaxed() + 1);
+    }
+
+    // consumer side
+    QQueuedMessage *front()
+    {
+        const quintptr t = tail.loadRelaxed();
+        if (t == head.loadAcquire())
+            return nullptr;
+        return &messages[t & mask];
+    }
+
+    void pop()
+    {
+        QQueuedMessage &slot = messages[tail.loadRelaxed() & mask];
+        slot.message = QString();
+        queuedBytes.fetchAndSubRelaxed(slot.size);
+        tail.storeRelease(tail.loadRelaxed() + 1);
+    }
+
+    bool isEmpty() const { return head.loadAcquire() == tail.loadAcquire(); }
+
+    const std::unique_ptr<QQueuedMessage[]> messages;
+    const quintptr mask;
+    alignas(64) QAtomicInteger<quintptr> head = 0;
+    alignas(64) QAtomicInteger<quintptr> tail = 0;
+    QAtomicInteger<qsizetype> queuedBytes = 0;
+    QAtomicInt dropped = 0;
+    QAtomicInt producerGone = false;
+};
+
+class QAsyncMessageOutput
+{
+public:
+    QAsyncMessageOutput();
+    ~QAsyncMessageOutput();
+
+    bool post(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    void flush();
+    void stop();
+
+private:
+    QMessageQueue *currentQueue();
+    void wakeUp();
+    void run();
+    bool hasPendingMessages();
+    void drain();
+    static void write(const QQueuedMessage &message);
+
+    const quintptr queueSize;
+    const qsizetype queueBytes;
+
+    QBasicMutex queuesMutex;
+    std::vector<std::unique_ptr<QMessageQueue>> queues;
+
+    QBasicMutex drainMutex;
+
+    QtPrivate::mutex sleepMutex;
+    QtPrivate::condition_variable wakeCondition;
+    QAtomicInt sleeping = false;
+    QAtomicInt stopping = false;
+    std::thread thread;
+};
+
+Q_GLOBAL_STATIC(QAsyncMessageOutput, asyncMessageOutput)
+
+// -1 until QT_LOGGING_ASYNC has been read
+Q_CONSTINIT static QBasicAtomicInt asyncOutputEnabled = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+static bool isAsyncOutputEnabled()
+{
+    int enabled = asyncOutputEnabled.loadRelaxed();
+    if (Q_UNLIKELY(enabled < 0)) {
+        enabled = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC") != 0;
+        asyncOutputEnabled.testAndSetRelaxed(-1, enabled, enabled);
+    }
+    return enabled;
+}
+
+struct QMessageQueueHandle
+{
+    QMessageQueue *queue = nullptr;
+    bool finished = false;
+
+    ~QMessageQueueHandle()
+    {
+        finished = true;
+        // the output thread deletes the queue once it is empty
+        if (queue && !asyncMessageOutput.isDestroyed())
+            queue->producerGone.storeRelease(true);
+    }
+};
+Q_CONSTINIT static thread_local QMessageQueueHandle currentMessageQueue;
+
+static quintptr asyncQueueSize()
+{
+    // messages per thread, rounded up to a power of two
+    const int size = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC_QUEUE_SIZE");
+    return qNextPowerOfTwo(quint32(qBound(2, size > 0 ? size : 256, 1 << 20) - 1));
+}
+
+static qsizetype asyncBufferSize()
+{
+    // KiB per thread
+    const int size = qEnvironmentVariableIntValue("QT_LOGGING_ASYNC_BUFFER_SIZE");
+    return qsizetype(size > 0 ? size : 256) * 1024;
+}
+
+QAsyncMessageOutput::QAsyncMessageOutput()
+    : queueSize(asyncQueueSize()), queueBytes(asyncBufferSize())
+{
+    // make sure the pattern outlives us, it is needed to write the last messages
+    qMessagePattern();
+
+    QT_TRY {
+        thread = std::thread([this] { run(); });
+    } QT_CATCH(...) {
+        // no thread, no asynchronous output
+        stopping.storeRelaxed(true);
+        return;
+    }
+
+    // writing from a global destructor may be too late, e.g. on Windows, where
+    // joining a thread while the DLL is being unloaded deadlocks
+    qAddPostRoutine([] {
+        if (asyncMessageOutput.exists())
+            asyncMessageOutput->stop();
+    });
+}
+
+QAsyncMessageOutput::~QAsyncMessageOutput()
+{
+    stop();
+}
+
+QMessageQueue *QAsyncMessageOutput::currentQueue()
+{
+    QMessageQueueHandle &handle = currentMessageQueue;
+    if (Q_UNLIKELY(!handle.queue)) {
+        auto queue = std::make_unique<QMessageQueue>(queueSize);
+        handle.queue = queue.get();
+        const auto locker = qt_scoped_lock(queuesMutex);
+        queues.push_back(std::move(queue));
+    }
+    return handle.queue;
+}
+
+/*!
+    \internal
+
+    Adds the message to the calling thread's queue. Returns \c false if the
+    message must be written synchronously.
+
+    The name contains "Message" so %{backtrace} skips this frame.
+*/
+bool QAsyncMessageOutput::post(QtMsgType type, const QMessageLogContext &context,
+                               const QString &message)
+{
+    if (Q_UNLIKELY(stopping.loadRelaxed() || currentMessageQueue.finished)) {
+        // the messages that were posted before must come out first
+        flush();
+        return false;
+    }
+
+    QMessageQueue *queue = currentQueue();
+    QQueuedMessage *slot = queue->freeSlot();
+    if (!slot) {
+        queue->dropped.fetchAndAddRelaxed(1);
+        return true;
+    }
+
+    slot->type = type;
+    slot->setContext(context);
+
+    QMessageLogOrigin &origin = slot->origin;
+    origin = QMessageLogOrigin();
+    if (QMessagePattern *pattern = qMessagePattern()) {
+        origin.fields = pattern->originFields.loadRelaxed();
+        if (origin.fields & QMessageLogOrigin::Backtrace) {
+            // the backtrace is only available on this thread, so format the
+            // whole message here
+            slot->message = qFormatLogMessage(type, context, message);
+            origin.formatted = true;
+        } else {
+            if (origin.fields & QMessageLogOrigin::ThreadId)
+                origin.threadId = qt_gettid();
+            if (origin.fields & QMessageLogOrigin::ThreadPointer)
+                origin.threadPointer = quintptr(QThread::currentThread());
+            if (origin.fields & QMessageLogOrigin::Time) {
+                origin.processTime = pattern->timer.elapsed();
+                origin.bootTime = QDeadlineTimer::current().deadline();
+                origin.currentTime = QDateTime::currentMSecsSinceEpoch();
+            }
+        }
+    }
+    if (!origin.formatted)
+        slot->message = message;
+
+    slot->size = slot->message.size() * qsizetype(sizeof(QChar)) + slot->contextStrings.size();
+    if (queue->queuedBytes.loadRelaxed() + slot->size > queueBytes) {
+        slot->message = QString();
+        queue->dropped.fetchAndAddRelaxed(1);
+        return true;
+    }
+
+    queue->push(slot->size);
+    wakeUp();
+    return true;
+}
+
+void QAsyncMessageOutput::wakeUp()
+{
+    // pairs with the fence in run(): either we see the thread going to sleep,
+    // or the thread sees our message
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.loadRelaxed()) {
+        const auto locker = qt_scoped_lock(sleepMutex);
+        sleeping.storeRelaxed(false);
+        wakeCondition.notify_one();
+    } else if (Q_UNLIKELY(stopping.loadRelaxed())) {
+        // the thread may have exited before seeing our message
+        flush();
+    }
+}
+
+void QAsyncMessageOutput::flush()
+{
+    // we are already writing messages, e.g. a message sink called qFatal()
+    if (messageOrigin)
+        return;
+    drain();
+}
+
+void QAsyncMessageOutput::stop()
+{
+    {
+        const auto locker = qt_scoped_lock(sleepMutex);
+        if (stopping.loadRelaxed() && !thread.joinable())
+            return;
+        stopping.storeRelaxed(true);
+        sleeping.storeRelaxed(false);
+        wakeCondition.notify_one();
+    }
+    if (thread.joinable() && thread.get_id() != std::this_thread::get_id())
+        thread.join();
+    flush();
+}
+
+bool QAsyncMessageOutput::hasPendingMessages()
+{
+    const auto locker = qt_scoped_lock(queuesMutex);
+    return std::any_of(queues.cbegin(), queues.cend(), [](const auto &queue) {
+        return !queue->isEmpty() || queue->dropped.loadRelaxed();
+    });
+}
+
+void QAsyncMessageOutput::run()
+{
+    // messages from the message sinks are written directly
+    grabMessageHandler();
+
+    while (true) {
+        drain();
+
+        std::unique_lock locker(sleepMutex);
+        if (stopping.loadRelaxed())
+            break;
+        sleeping.storeRelaxed(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (hasPendingMessages()) {
+            sleeping.storeRelaxed(false);
+            continue;
+        }
+        wakeCondition.wait(locker, [this] { return !sleeping.loadRelaxed(); });
+    }
+}
+
+void QAsyncMessageOutput::drain()
+{
+    const auto locker = qt_scoped_lock(drainMutex);
+    const bool grabbed = grabMessageHandler();
+
+    QVarLengthArray<QMessageQueue *, 16> pending;
+    {
+        const auto locker = qt_scoped_lock(queuesMutex);
+        for (const auto &queue : queues)
+            pending.append(queue.get());
+    }
+
+    for (QMessageQueue *queue : pending) {
+        // at most one queue's worth, so a busy thread cannot starve the others
+        for (quintptr i = 0; i <= queue->mask; ++i) {
+            const QQueuedMessage *message = queue->front();
+            if (!message)
+                break;
+            write(*message);
+            queue->pop();
+        }
+        if (const int dropped = queue->dropped.fetchAndStoreRelaxed(0)) {
+            QQueuedMessage warning;
+            warning.type = QtWarningMsg;
+            warning.message = QStringLiteral("QT_LOGGING_ASYNC: %1 message(s) dropped, the queue was full")
+                    .arg(dropped);
+            write(warning);
+        }
+    }
+
+    {
+        // nobody can push to a queue whose thread has finished
+        const auto locker = qt_scoped_lock(queuesMutex);
+        queues.erase(std::remove_if(queues.begin(), queues.end(), [](const auto &queue) {
+            return queue->producerGone.loadAcquire() && queue->isEmpty()
+                    && !queue->dropped.loadRelaxed();
+        }), queues.end());
+    }
+
+    if (grabbed)
+        ungrabMessageHandler();
+}
+
+void QAsyncMessageOutput::write(const QQueuedMessage &message)
+{
+    QMessageLogContext context(message.contextString(message.fileOffset), message.line,
+                               message.contextString(message.functionOffset),
+                               message.contextString(message.categoryOffset));
+    messageOrigin = &message.origin;
+    qDefaultMessageHandler(message.type, context, message.message);
+    messageOrigin = nullptr;
+}
+
+/*!
+    \internal
+
+    Hands the message to the asynchronous output if it is enabled. Returns
+    \c false if the message must be written synchronously.
+*/
+static bool postAsyncMessage(QtMsgType type, const QMessageLogContext &context,
+                             const QString &message)
+{
+    // called back by the asynchronous output itself
+    if (messageOrigin)
+        return false;
+    if (!isAsyncOutputEnabled())
+        return false;
+    QAsyncMessageOutput *output = asyncMessageOutput();
+    if (!output)
+        return false;
+    if (type == QtFatalMsg) {
+        // the process is about to end, write everything right away
+        output->flush();
+        return false;
+    }
+    return output->post(type, context, message);
+}
+
+static void flushAsyncMessages()
+{
+    if (asyncMessageOutput.exists())
+        asyncMessageOutput->flush();
+}
+#endif // QLOGGING_HAVE_ASYNC_OUTPUT
+
+#ifndef QT_BOOTSTRAPPED
+namespace QtPrivate {
+/*!
+    \internal
+
+    Enables or disables the asynchronous output of the default message
+    handler, overriding the QT_LOGGING_ASYNC environment variable. Disabling
+    it writes the pending messages. Does nothing if this Qt build has no
+    asynchronous output.
+*/
+void setMessageOutputAsync(bool enable)
+{
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    asyncOutputEnabled.storeRelaxed(enable);
+    if (!enable)
+        flushAsyncMessages();
+#else
+    Q_UNUSED(enable);
+#endif
+}
+} // QtPrivate
+#endif
+
 static void qt_message_print(QtMsgType msgType, const QMessageLogContext &context, const QString &message)
 {
 #ifndef QT_BOOTSTRAPPED
@@ -2023,6 +2559,10 @@ static void qt_message_print(const QString &message)
 
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message)
 {
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    flushAsyncMessages();
+#endif
+
 #if defined(Q_CC_MSVC_ONLY) && defined(QT_DEBUG) && defined(_DEBUG) && defined(_CRT_ERROR)
     wchar_t contextFileL[256];
     // we probably should let the compiler do this for us, by declaring QMessageLogContext::file to
@@ -2129,6 +2669,24 @@ void qErrnoWarning(int code, const char *msg, ...)
 
     To restore the message handler, call \c qInstallMessageHandler(0).
 
+    Since Qt 6.6, the default message handler can write the messages
+    asynchronously, so that a slow destination, such as journald or a
+    blocked \c stderr pipe, does not stall the threads that log. Set the
+    \c QT_LOGGING_ASYNC environment variable to \c 1 to enable this. Each
+    thread then adds its messages to a queue of its own, and a separate
+    thread writes them. The messages of one thread are written in the order
+    they were logged, but messages from different threads may interleave
+    differently than they were logged. Everything that is pending is written
+    before a fatal message, when qSetMessagePattern() is called, and when the
+    QCoreApplication object is destroyed, after which the messages are
+    written synchronously again.
+
+    The size of each queue is limited. \c QT_LOGGING_ASYNC_QUEUE_SIZE sets
+    the number of messages (default 256) and \c QT_LOGGING_ASYNC_BUFFER_SIZE
+    the size of the queued text, in KiB (default 256). Messages that do not
+    fit are dropped, and their number is reported in a warning. A custom
+    message handler is always called synchronously.
+
     Example:
 
     \snippet code/src_corelib_global_qglobal.cpp 23
@@ -2206,6 +2764,10 @@ void qErrnoWarning(int code, const char *msg, ...)
     \c stderr output. Structured logging such as systemd will record the message as is,
     along with as much structured information as can be captured.
 
+    \note When the default message handler writes asynchronously (see
+    qInstallMessageHandler()), \c threadid, \c qthreadptr, \c time and
+    \c backtrace are still determined by the thread that logs the message.
+
     Custom message handlers can use qFormatLogMessage() to take \a pattern into account.
 
     \sa qInstallMessageHandler(), {Debugging Techniques}, {QLoggingCategory}, QMessageLogContext
@@ -2222,6 +2784,11 @@ QtMessageHandler qInstallMessageHandler(QtMessageHandler h)
 
 void qSetMessagePattern(const QString &pattern)
 {
+#ifdef QLOGGING_HAVE_ASYNC_OUTPUT
+    // the pending messages are formatted with the pattern they were logged with
+    flushAsyncMessages();
+#endif
+
     const auto locker = qt_scoped_lock(QMessagePattern::mutex);
 
     if (!qMessagePattern()->fromEnvironment)
@@ -22,6 +22,7 @@ QT_BEGIN_NAMESPACE
 namespace QtPrivate {
 
 Q_CORE_EXPORT bool shouldLogToStderr();
+Q_CORE_EXPORT void setMessageOutputAsync(bool enable);
 
 }
 
@@ -0,0 +1,604 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+/*!
+    \since 6.6
+    \class QDirWalker
+    \inmodule QtCore
+    \brief The QDirWalker class lists the entries of a directory tree in parallel.
+
+    QDirWalker visits the same entries as a QDirIterator constructed with the
+    same path, name filters, filters and flags, except that it never reports
+    the \c{.} and \c{..} entries. Instead of handing out one entry at a time,
+    it passes the matching entries in batches to a handler function, and it
+    reads several directories at the same time on the threads of a
+    QThreadPool.
+
+    \snippet code/src_corelib_io_qdirwalker.cpp 0
+
+    The entries are reported in no particular order: entries of the same
+    directory can be split over several batches, and batches from different
+    directories can be interleaved. The handler is called from the thread
+    that calls walk() and from pool threads, but never from two threads at
+    the same time.
+
+    On Unix systems, QDirWalker opens each directory relative to its parent,
+    reads entries in large blocks, and evaluates the name filters and the
+    file type filters on the directory entries before it asks the file
+    system for the metadata of an entry. The QFileInfo objects it reports
+    carry the result of that query, so that calls such as
+    QFileInfo::size() or QFileInfo::lastModified() do not touch the file
+    system again. On other platforms, and for paths handled by a file
+    engine (such as the Qt Resource System), QDirWalker lists the tree with
+    QDirIterator on the calling thread.
+
+    \sa QDirIterator, QThreadPool
+*/
+
+/*!
+    \typedef QDirWalker::BatchHandler
+
+    Synonym for \c{std::function<void(const QFileInfoList &)>}, the type of
+    the function walk() passes the entries to.
+*/
+
+#include "qdirwalker.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#if QT_CONFIG(regularexpression)
+#include <QtCore/qregularexpression.h>
+#endif
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+#endif
+
+#include <QtCore/private/qabstractfileengine_p.h>
+#include <QtCore/private/qfileinfo_p.h>
+#include <QtCore/private/qfilesystemengine_p.h>
+#include <QtCore/private/qfilesystementry_p.h>
+#include <QtCore/private/qfilesystemmetadata_p.h>
+
+#ifdef Q_OS_UNIX
+#include <QtCore/private/qcore_unix_p.h>
+#include <QtCore/private/qstringconverter_p.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <utility>
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+class QDirWalkerPrivate
+{
+public:
+    QDirWalkerPrivate(const QString &path, const QStringList &nameFilters,
+                      QDir::Filters filters, QDirIterator::IteratorFlags flags);
+
+    bool matchesName(const QString &fileName) const;
+    bool matchesFilters(const QString &fileName, const QFileInfo &fileInfo) const;
+
+    void walkWithIterator(const QDirWalker::BatchHandler &handler) const;
+#ifdef Q_OS_UNIX
+    void walkNatively(const QDirWalker::BatchHandler &handler) const;
+
+    static QFileInfo fileInfo(const QFileSystemEntry &entry, const QFileSystemMetaData &metaData)
+    { return QFileInfo(new QFileInfoPrivate(entry, metaData)); }
+#endif
+
+    const QString path;
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirIterator::IteratorFlags iteratorFlags;
+
+#if QT_CONFIG(regularexpression)
+    QList<QRegularExpression> nameRegExps;
+#endif
+
+    qsizetype batchSize = 1024;
+#if QT_CONFIG(thread)
+    QThreadPool *threadPool = nullptr;
+#endif
+};
+
+QDirWalkerPrivate::QDirWalkerPrivate(const QString &path, const QStringList &nameFilters,
+                                     QDir::Filters filters, QDirIterator::IteratorFlags flags)
+    : path(path),
+      nameFilters(nameFilters.contains("*"_L1) ? QStringList() : nameFilters),
+      filters(QDir::NoFilter == filters ? QDir::AllEntries : filters),
+      iteratorFlags(flags)
+{
+#if QT_CONFIG(regularexpression)
+    nameRegExps.reserve(this->nameFilters.size());
+    for (const auto &filter : this->nameFilters) {
+        nameRegExps.append(QRegularExpression::fromWildcard(
+                filter, (this->filters & QDir::CaseSensitive ? Qt::CaseSensitive
+                                                             : Qt::CaseInsensitive)));
+    }
+#endif
+}
+
+bool QDirWalkerPrivate::matchesName(const QString &fileName) const
+{
+#if QT_CONFIG(regularexpression)
+    if (nameFilters.isEmpty())
+        return true;
+    for (const auto &re : nameRegExps) {
+        if (re.match(fileName).hasMatch())
+            return true;
+    }
+    return false;
+#else
+    Q_UNUSED(fileName);
+    return true;
+#endif
+}
+
+/*!
+    \internal
+
+    The same checks as QDirIteratorPrivate::matchesFilters(), for entries
+    other than \c{.} and \c{..}.
+*/
+bool QDirWalkerPrivate::matchesFilters(const QString &fileName, const QFileInfo &fi) const
+{
+    // Pass all entries through name filters, except dirs if the AllDirs
+    if (!((filters & QDir::AllDirs) && fi.isDir()) && !matchesName(fileName))
+        return false;
+
+    // skip symlinks
+    const bool skipSymlinks = filters.testAnyFlag(QDir::NoSymLinks);
+    const bool includeSystem = filters.testAnyFlag(QDir::System);
+    if (skipSymlinks && fi.isSymLink()) {
+        // The only reason to save this file is if it is a broken link and we are requesting system files.
+        if (!includeSystem || fi.exists())
+            return false;
+    }
+
+    // filter hidden
+    if (!filters.testAnyFlag(QDir::Hidden) && fi.isHidden())
+        return false;
+
+    // filter system files
+    if (!includeSystem && (!(fi.isFile() || fi.isDir() || fi.isSymLink())
+                    || (!fi.exists() && fi.isSymLink())))
+        return false;
+
+    // skip directories
+    if (!(filters & (QDir::Dirs | QDir::AllDirs)) && fi.isDir())
+        return false;
+
+    // skip files
+    if (!(filters & QDir::Files) && fi.isFile())
+        return false;
+
+    // filter permissions
+    const bool filterPermissions = ((filters & QDir::PermissionMask)
+                                    && (filters & QDir::PermissionMask) != QDir::PermissionMask);
+    const bool doWritable = !filterPermissions || (filters & QDir::Writable);
+    const bool doExecutable = !filterPermissions || (filters & QDir::Executable);
+    const bool doReadable = !filterPermissions || (filters & QDir::Readable);
+    if (filterPermissions
+        && ((doReadable && !fi.isReadable())
+            || (doWritable && !fi.isWritable())
+            || (doExecutable && !fi.isExecutable()))) {
+        return false;
+    }
+
+    return true;
+}
+
+void QDirWalkerPrivate::walkWithIterator(const QDirWalker::BatchHandler &handler) const
+{
+    QDirIterator it(path, nameFilters, filters | QDir::NoDotAndDotDot, iteratorFlags);
+    QFileInfoList batch;
+    while (it.hasNext()) {
+        batch.append(it.nextFileInfo());
+        if (batch.size() >= batchSize) {
+            handler(batch);
+            batch.clear();
+        }
+    }
+    if (!batch.isEmpty())
+        handler(batch);
+}
+
+#ifdef Q_OS_UNIX
+namespace {
+
+#ifdef Q_OS_LINUX
+// The record getdents64(2) fills the buffer with; struct dirent only has the
+// same layout when it is struct dirent64.
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+#endif
+
+// Calls \a function with the name and the type of each entry of the directory
+// open at \a fd.
+template <typename Function>
+void forEachDirectoryEntry(int fd, char *buffer, size_t bufferSize, Function function)
+{
+#ifdef Q_OS_LINUX
+    for (;;) {
+        const long bytes = ::syscall(SYS_getdents64, fd, buffer, bufferSize);
+        if (bytes <= 0)
+            break;
+        for (long offset = 0; offset < bytes;) {
+            const auto *entry = reinterpret_cast<const LinuxDirent64 *>(buffer + offset);
+            function(entry->d_name, entry->d_type);
+            offset += entry->d_reclen;
+        }
+    }
+#else
+    Q_UNUSED(buffer);
+    Q_UNUSED(bufferSize);
+    // fdopendir() takes over the descriptor, and closedir() closes it
+    const int dirFd = qt_safe_dup(fd);
+    if (dirFd == -1)
+        return;
+    DIR *dir = ::fdopendir(dirFd);
+    if (!dir) {
+        qt_safe_close(dirFd);
+        return;
+    }
+    while (const QT_DIRENT *entry = QT_READDIR(dir)) {
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
+        function(entry->d_name, entry->d_type);
+#else
+        function(entry->d_name, DT_UNKNOWN);
+#endif
+    }
+    ::closedir(dir);
+#endif
+}
+
+class NativeWalk
+{
+public:
+    NativeWalk(const QDirWalkerPrivate *d, const QDirWalker::BatchHandler &handler)
+        : d(d), handler(handler)
+    {
+#if QT_CONFIG(thread)
+        pool = d->threadPool ? d->threadPool : QThreadPool::globalInstance();
+#endif
+    }
+
+    void walk(const QByteArray &nativePath, const QString &path)
+    {
+        // the starting directory is entered even if it is a symlink
+        walkTask(nativePath, path, 0, {});
+#if QT_CONFIG(thread)
+        QMutexLocker locker(&mutex);
+        while (pendingTasks)
+            finished.wait(&mutex);
+#endif
+    }
+
+private:
+    // State of one thread walking part of the tree. The buffer is reused for
+    // all directories the task reads, because each directory is read to the
+    // end before its subdirectories are.
+    struct Task
+    {
+        static constexpr size_t BufferSize = 32 * 1024;
+        std::unique_ptr<char[]> buffer{new char[BufferSize]};
+        QFileInfoList batch;
+    };
+
+    // The device and inode numbers of the directories on the way from the
+    // starting directory, only tracked when following symlinks.
+    using Ancestors = QList<std::pair<quint64, quint64>>;
+
+    void walkTask(const QByteArray &nativePath, const QString &path, int openFlags,
+                  Ancestors ancestors)
+    {
+        Task task;
+        const int fd = qt_safe_open(nativePath.constData(),
+                                    QT_OPEN_RDONLY | O_DIRECTORY | openFlags);
+        if (fd != -1) {
+            if (enterDirectory(fd, ancestors))
+                walkDirectory(fd, nativePath, path, ancestors, task);
+            qt_safe_close(fd);
+        }
+        flush(task);
+    }
+
+    // Returns false for directories reached through a symlink loop, that
+    // is, for one of their own ancestors.
+    bool enterDirectory(int fd, Ancestors &ancestors)
+    {
+        if (!(d->iteratorFlags & QDirIterator::FollowSymlinks))
+            return true;
+        QT_STATBUF statBuffer;
+        if (QT_FSTAT(fd, &statBuffer) != 0)
+            return false;
+        const std::pair id(quint64(statBuffer.st_dev), quint64(statBuffer.st_ino));
+        if (ancestors.contains(id))
+            return false;
+        ancestors.append(id);
+        return true;
+    }
+
+    void walkDirectory(int fd, const QByteArray &nativePath, const QString &path,
+                       Ancestors &ancestors, Task &task);
+
+    void report(Task &task, QFileInfo &&fileInfo)
+    {
+        task.batch.append(std::move(fileInfo));
+        if (task.batch.size() >= d->batchSize)
+            flush(task);
+    }
+
+    void flush(Task &task)
+    {
+        if (task.batch.isEmpty())
+            return;
+        QMutexLocker locker(&handlerMutex);
+        handler(task.batch);
+        task.batch.clear();
+    }
+
+#if QT_CONFIG(thread)
+    // Hands the directory to an idle pool thread, if there is one.
+    bool tryFanOut(const QByteArray &nativePath, const QString &path, int openFlags,
+                   const Ancestors &ancestors)
+    {
+        {
+            QMutexLocker locker(&mutex);
+            ++pendingTasks;
+        }
+        const bool started = pool->tryStart([this, nativePath, path, openFlags, ancestors] {
+            walkTask(nativePath, path, openFlags, ancestors);
+            finishTask();
+        });
+        if (!started)
+            finishTask();
+        return started;
+    }
+
+    void finishTask()
+    {
+        QMutexLocker locker(&mutex);
+        if (--pendingTasks == 0)
+            finished.wakeAll();
+    }
+#endif
+
+    const QDirWalkerPrivate *d;
+    const QDirWalker::BatchHandler &handler;
+
+    QMutex handlerMutex;
+#if QT_CONFIG(thread)
+    QThreadPool *pool;
+    QMutex mutex;
+    QWaitCondition finished;
+    qsizetype pendingTasks = 0;
+#endif
+};
+
+void NativeWalk::walkDirectory(int fd, const QByteArray &nativePath, const QString &path,
+                               Ancestors &ancestors, Task &task)
+{
+    const QDir::Filters filters = d->filters;
+    const bool recurse = d->iteratorFlags.testAnyFlag(QDirIterator::Subdirectories);
+    const bool followSymlinks = d->iteratorFlags.testAnyFlag(QDirIterator::FollowSymlinks);
+    QList<QByteArray> subdirectories;
+
+    auto handleEntry = [&](const char *name, unsigned char type) {
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            return;
+        const qsizetype nameLength = qstrlen(name);
+        // like QFileSystemIterator, skip names that cannot be represented in a QString
+        if (!QUtf8::isValidUtf8(QByteArrayView(name, nameLength)).isValidUtf8)
+            return;
+
+        QFileSystemMetaData metaData;
+        bool haveMetaData = false;
+        auto fillMetaData = [&] {
+            if (!haveMetaData)
+                QFileSystemEngine::fillMetaDataAt(fd, name, metaData);
+            haveMetaData = true;
+        };
+
+        if (type == DT_UNKNOWN || (type == DT_LNK && recurse && followSymlinks))
+            fillMetaData();
+        const bool isLink = haveMetaData ? metaData.isLink() : type == DT_LNK;
+        const bool isDir = haveMetaData ? metaData.isDirectory() : type == DT_DIR;
+        const bool hidden = name[0] == '.';
+        const QByteArray nativeName(name, nameLength);
+
+        // the same rules as QDirIteratorPrivate::checkAndPushDirectory()
+        if (recurse && isDir && (!isLink || followSymlinks)
+            && (!hidden || (filters & (QDir::AllDirs | QDir::Hidden)))) {
+            subdirectories.append(nativeName);
+        }
+
+        // Reject what the directory entry alone rules out before asking the
+        // file system for more.
+        if (hidden && !(filters & QDir::Hidden))
+            return;
+        const bool plainFile = !isLink && type == DT_REG;
+        const bool plainDir = !isLink && type == DT_DIR;
+        if (plainFile && !(filters & QDir::Files))
+            return;
+        if (plainDir && !(filters & (QDir::Dirs | QDir::AllDirs)))
+            return;
+        const QString fileName = QFile::decodeName(nativeName);
+        if ((plainFile || (plainDir && !(filters & QDir::AllDirs))) && !d->matchesName(fileName))
+            return;
+
+        fillMetaData();
+        QFileInfo fileInfo = QDirWalkerPrivate::fileInfo(
+                QFileSystemEntry(path + fileName, nativePath + nativeName), metaData);
+        if (d->matchesFilters(fileName, fileInfo))
+            report(task, std::move(fileInfo));
+    };
+    forEachDirectoryEntry(fd, task.buffer.get(), Task::BufferSize, handleEntry);
+
+    const int openFlags = followSymlinks ? 0 : O_NOFOLLOW;
+    for (const QByteArray &name : std::as_const(subdirectories)) {
+        const QByteArray childNativePath = nativePath + name + '/';
+        const QString childPath = path + QFile::decodeName(name) + u'/';
+#if QT_CONFIG(thread)
+        if (tryFanOut(childNativePath, childPath, openFlags, ancestors))
+            continue;
+#endif
+        int childFd;
+        EINTR_LOOP(childFd, ::openat(fd, name.constData(),
+                                     QT_OPEN_RDONLY | O_DIRECTORY | O_CLOEXEC | openFlags));
+        if (childFd == -1)
+            continue;
+        if (enterDirectory(childFd, ancestors)) {
+            walkDirectory(childFd, childNativePath, childPath, ancestors, task);
+            if (followSymlinks)
+                ancestors.removeLast();
+        }
+        qt_safe_close(childFd);
+    }
+}
+
+} // unnamed namespace
+
+void QDirWalkerPrivate::walkNatively(const QDirWalker::BatchHandler &handler) const
+{
+    QString rootPath = path;
+    if (!rootPath.endsWith(u'/'))
+        rootPath.append(u'/');
+    NativeWalk(this, handler).walk(QFile::encodeName(rootPath), rootPath);
+}
+#endif // Q_OS_UNIX
+
+/*!
+    Constructs a QDirWalker that lists the entries below \a path that match
+    \a filters. By default, it descends into all subdirectories; pass
+    different \a flags to change that, as for QDirIterator.
+*/
+QDirWalker::QDirWalker(const QString &path, QDir::Filters filters,
+                       QDirIterator::IteratorFlags flags)
+    : d(new QDirWalkerPrivate(path, QStringList(), filters, flags))
+{
+}
+
+/*!
+    Constructs a QDirWalker that lists the entries below \a path whose names
+    match one of the wildcard patterns in \a nameFilters and that match
+    \a filters. By default, it descends into all subdirectories; pass
+    different \a flags to change that, as for QDirIterator.
+
+    As with QDirIterator, directories are only checked against the name
+    filters if \a filters does not contain QDir::AllDirs, and the walker
+    descends into subdirectories whether their names match or not.
+*/
+QDirWalker::QDirWalker(const QString &path, const QStringList &nameFilters,
+                       QDir::Filters filters, QDirIterator::IteratorFlags flags)
+    : d(new QDirWalkerPrivate(path, nameFilters, filters, flags))
+{
+}
+
+/*!
+    Destroys the QDirWalker.
+*/
+QDirWalker::~QDirWalker() = default;
+
+/*!
+    Returns the path of the directory this walker lists.
+*/
+QString QDirWalker::path() const
+{
+    return d->path;
+}
+
+/*!
+    Sets the largest number of entries that walk() passes to its handler in
+    one call to \a size. The default is 1024.
+*/
+void QDirWalker::setBatchSize(qsizetype size)
+{
+    d->batchSize = qMax(size, qsizetype(1));
+}
+
+/*!
+    Returns the largest number of entries that walk() passes to its handler
+    in one call.
+*/
+qsizetype QDirWalker::batchSize() const
+{
+    return d->batchSize;
+}
+
+#if QT_CONFIG(thread)
+/*!
+    Makes walk() read directories on the threads of \a pool. If \a pool is
+    \nullptr, which is the default, QThreadPool::globalInstance() is used.
+
+    The walker only hands a directory to the pool if one of its threads is
+    idle, and reads it on the current thread otherwise, so walk() neither
+    waits for other work in the pool nor floods it with tasks.
+*/
+void QDirWalker::setThreadPool(QThreadPool *pool)
+{
+    d->threadPool = pool;
+}
+
+/*!
+    Returns the thread pool set with setThreadPool(), or \nullptr if walk()
+    uses the global thread pool.
+*/
+QThreadPool *QDirWalker::threadPool() const
+{
+    return d->threadPool;
+}
+#endif
+
+/*!
+    Lists the directory tree and calls \a handler with batches of the
+    matching entries. Returns when all directories have been read and the
+    last batch has been handled.
+
+    Directories that cannot be read are skipped.
+*/
+void QDirWalker::walk(const BatchHandler &handler) const
+{
+#ifdef Q_OS_UNIX
+    QFileSystemEntry entry(d->path);
+    QFileSystemMetaData metaData;
+    const std::unique_ptr<QAbstractFileEngine> engine(
+            QFileSystemEngine::resolveEntryAndCreateLegacyEngine(entry, metaData));
+    if (!engine) {
+        d->walkNatively(handler);
+        return;
+    }
+#endif
+    d->walkWithIterator(handler);
+}
+
+/*!
+    Returns all matching entries of the directory tree. The list is not
+    sorted.
+
+    \sa walk()
+*/
+QFileInfoList QDirWalker::entryInfoList() const
+{
+    QFileInfoList result;
+    walk([&result](const QFileInfoList &batch) { result.append(batch); });
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,51 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDIRWALKER_H
+#define QDIRWALKER_H
+
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfileinfo.h>
+
+#include <functional>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QThreadPool;
+class QDirWalkerPrivate;
+
+class Q_CORE_EXPORT QDirWalker
+{
+public:
+    using BatchHandler = std::function<void(const QFileInfoList &)>;
+
+    explicit QDirWalker(const QString &path, QDir::Filters filters = QDir::NoFilter,
+                        QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories);
+    QDirWalker(const QString &path, const QStringList &nameFilters,
+               QDir::Filters filters = QDir::NoFilter,
+               QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories);
+    ~QDirWalker();
+
+    QString path() const;
+
+    void setBatchSize(qsizetype size);
+    qsizetype batchSize() const;
+
+#if QT_CONFIG(thread)
+    void setThreadPool(QThreadPool *pool);
+    QThreadPool *threadPool() const;
+#endif
+
+    void walk(const BatchHandler &handler) const;
+    QFileInfoList entryInfoList() const;
+
+private:
+    Q_DISABLE_COPY(QDirWalker)
+
+    std::unique_ptr<QDirWalkerPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDIRWALKER_H
@@ -18,6 +18,11 @@
 #if defined(QT_BUILD_CORE_LIB)
 # include "qcoreapplication.h"
 #endif
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+# include "qfuture.h"
+# include "private/qbytearray_p.h"
+# include "private/qfileasyncio_p.h"
+#endif
 
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
@@ -1074,6 +1079,108 @@ bool QFile::open(int fd, OpenMode mode, FileHandleFlags handleFlags)
     return false;
 }
 
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+/*!
+    \since 6.6
+
+    Starts reading at most \a maxSize bytes from the file, beginning at
+    \a offset, and returns a QFuture that provides the data once it has
+    been read. The file must be open for reading.
+
+    The read does not use or change the current position of the file
+    (see pos()), and it does not block the calling thread. If fewer than
+    \a maxSize bytes are available after \a offset, the result contains
+    only those bytes. If an error occurs, the result is a null QByteArray.
+
+    On Linux, if the calling thread is running an event loop, the request
+    is handed to the kernel through io_uring together with any other
+    requests made before control returns to the event loop, and the future
+    is finished by that event loop. Do not block that thread waiting for
+    the future, but attach a continuation with QFuture::then() or use a
+    QFutureWatcher instead; in debug builds, waiting asserts. In all other
+    cases, the read is performed on QThreadPool::globalInstance(). Setting
+    the \c QT_NO_IO_URING environment variable disables the use of
+    io_uring.
+
+    The operation uses a duplicate of the file's descriptor, so the file
+    may be closed before the returned future has finished.
+
+    \note This function is only available on Unix systems, and only for
+    files that have a native file descriptor (see handle()).
+
+    \sa writeAsync(), QIODevice::read()
+*/
+QFuture<QByteArray> QFile::readAsync(qint64 offset, qint64 maxSize)
+{
+    if ((openMode() & ReadOnly) == 0) {
+        qWarning("QFile::readAsync: File (%ls) not open for reading",
+                 qUtf16Printable(fileName()));
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFile::readAsync: Called with negative offset or maxSize");
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    const int fd = handle();
+    if (fd == -1) {
+        qWarning("QFile::readAsync: File (%ls) has no file descriptor",
+                 qUtf16Printable(fileName()));
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    }
+    if (maxSize >= MaxByteArraySize) {
+        qWarning("QFile::readAsync: maxSize argument exceeds QByteArray size limit");
+        maxSize = MaxByteArraySize - 1;
+    }
+
+    // make sure buffered writes are visible to the read
+    if (openMode() & WriteOnly)
+        flush();
+    return QFileAsyncIO::read(fd, offset, maxSize);
+}
+
+/*!
+    \since 6.6
+
+    Starts writing \a data to the file at \a offset, and returns a QFuture
+    that provides the number of bytes that were written, or -1 if an error
+    occurred. The file must be open for writing.
+
+    The write does not use or change the current position of the file
+    (see pos()), and it does not block the calling thread. Data that is
+    still buffered by earlier calls to write() is flushed to the file
+    first.
+
+    Completion follows the same rules as for readAsync(), and the file may
+    be closed before the returned future has finished.
+
+    \note This function is only available on Unix systems, and only for
+    files that have a native file descriptor (see handle()).
+
+    \sa readAsync(), QIODevice::write()
+*/
+QFuture<qint64> QFile::writeAsync(qint64 offset, const QByteArray &data)
+{
+    if ((openMode() & WriteOnly) == 0) {
+        qWarning("QFile::writeAsync: File (%ls) not open for writing",
+                 qUtf16Printable(fileName()));
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    }
+    if (offset < 0) {
+        qWarning("QFile::writeAsync: Called with negative offset");
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    }
+    const int fd = handle();
+    if (fd == -1) {
+        qWarning("QFile::writeAsync: File (%ls) has no file descriptor",
+                 qUtf16Printable(fileName()));
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    }
+
+    flush();
+    return QFileAsyncIO::write(fd, offset, data);
+}
+#endif // QT_CONFIG(future) && Q_OS_UNIX
+
 /*!
     \reimp
 */
@@ -80,6 +80,9 @@ using ForceFilesystemPath = typename std::enable_if_t<std::is_same_v<std::filesy
 
 class QTemporaryFile;
 class QFilePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 // ### Qt 7: remove this, and make constructors always explicit.
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)) || defined(QT_EXPLICIT_QFILE_CONSTRUCTION_FROM_PATH)
@@ -286,6 +289,11 @@ public:
     bool open(FILE *f, OpenMode ioFlags, FileHandleFlags handleFlags=DontCloseHandle);
     bool open(int fd, OpenMode ioFlags, FileHandleFlags handleFlags=DontCloseHandle);
 
+#if QT_CONFIG(future) && (defined(Q_OS_UNIX) || defined(Q_QDOC))
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+#endif
+
     qint64 size() const override;
 
     bool resize(qint64 sz) override;
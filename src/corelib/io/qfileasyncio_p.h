@@ -0,0 +1,47 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFILEASYNCIO_P_H
+#define QFILEASYNCIO_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfuture.h>
+
+QT_REQUIRE_CONFIG(future);
+
+QT_BEGIN_NAMESPACE
+
+// Positional reads and writes on a native file descriptor that complete
+// asynchronously. With io_uring, the operations are submitted in batches
+// and completed by the calling thread's event loop; everywhere else (and
+// for threads that aren't running an event loop) they are run on the
+// global thread pool.
+class QFileAsyncIO
+{
+public:
+    static QFuture<QByteArray> read(int fd, qint64 offset, qint64 maxSize);
+    static QFuture<qint64> write(int fd, qint64 offset, const QByteArray &data);
+
+    // Marks future as one that only the current thread's event loop can
+    // finish, so that waiting for it in this thread asserts.
+    static void setCompletingThread(const QFutureInterfaceBase &future);
+
+    // how many operations the current thread submitted to io_uring
+    Q_CORE_EXPORT static qint64 ioUringOperationCount();
+};
+
+QT_END_NAMESPACE
+
+#endif // QFILEASYNCIO_P_H
@@ -0,0 +1,512 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplatformdefs.h"
+#include "qfileasyncio_p.h"
+
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qthreadstorage.h>
+
+#include <private/qcore_unix_p.h>
+#include <private/qfutureinterface_p.h>
+#include <private/qthread_p.h>
+
+#if QT_CONFIG(io_uring)
+#  include <QtCore/qsocketnotifier.h>
+#  include <linux/io_uring.h>
+#  include <sys/eventfd.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#endif
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+class QFileAsyncOperation
+{
+public:
+    enum Kind { Read, Write };
+
+    // takes ownership of fd
+    QFileAsyncOperation(Kind kind, int fd, qint64 offset)
+        : kind(kind), fd(fd), offset(offset)
+    { }
+    virtual ~QFileAsyncOperation() { qt_safe_close(fd); }
+
+    // result is the number of bytes transferred, or -errno
+    virtual void finish(qint64 result) = 0;
+
+    // Accounts for the result of one read or write call, the number of
+    // bytes transferred or -errno, and returns whether the operation is
+    // complete.
+    bool advance(qint64 result)
+    {
+        if (result < 0) {
+            error = result;
+            return true;
+        }
+        transferred += result;
+        return result == 0 || transferred == size;
+    }
+
+    // A write that failed after some data was written reports that data.
+    qint64 result() const
+    {
+        return error && (kind == Read || !transferred) ? error : transferred;
+    }
+
+    // Blocking implementation, used by the thread pool fallback. Unlike
+    // read(2) and write(2) on a QFile, this doesn't touch the file position.
+    void run()
+    {
+        bool done = transferred == size;
+        while (!done) {
+            ssize_t r;
+            if (kind == Read) {
+                EINTR_LOOP(r, ::pread(fd, data + transferred, size_t(size - transferred),
+                                      QT_OFF_T(offset + transferred)));
+            } else {
+                EINTR_LOOP(r, ::pwrite(fd, data + transferred, size_t(size - transferred),
+                                       QT_OFF_T(offset + transferred)));
+            }
+            done = advance(r < 0 ? -errno : r);
+        }
+        finish(result());
+    }
+
+    const Kind kind;
+    // a duplicate of the file's descriptor, so that closing the file
+    // doesn't affect the operation
+    const int fd;
+    const qint64 offset;
+    char *data = nullptr;
+    qint64 size = 0;
+    qint64 transferred = 0;
+    qint64 error = 0;
+};
+
+class QFileAsyncRead final : public QFileAsyncOperation
+{
+public:
+    QFileAsyncRead(int fd, qint64 offset, qint64 size)
+        : QFileAsyncOperation(Read, fd, offset),
+          buffer(qsizetype(size), Qt::Uninitialized)
+    {
+        data = buffer.data();
+        this->size = buffer.size();
+        promise.start();
+    }
+
+    void finish(qint64 result) override
+    {
+        if (result < 0)
+            buffer = QByteArray();
+        else
+            buffer.truncate(qsizetype(result));
+        promise.addResult(std::move(buffer));
+        promise.finish();
+    }
+
+    QPromise<QByteArray> promise;
+    QByteArray buffer;
+};
+
+class QFileAsyncWrite final : public QFileAsyncOperation
+{
+public:
+    QFileAsyncWrite(int fd, qint64 offset, const QByteArray &bytes)
+        : QFileAsyncOperation(Write, fd, offset),
+          bytes(bytes)
+    {
+        // only read from, and bytes keeps it alive
+        data = const_cast<char *>(bytes.constData());
+        size = bytes.size();
+        promise.start();
+    }
+
+    void finish(qint64 result) override
+    {
+        promise.addResult(result < 0 ? qint64(-1) : result);
+        promise.finish();
+    }
+
+    QPromise<qint64> promise;
+    const QByteArray bytes;
+};
+
+#if QT_CONFIG(io_uring)
+
+static int qt_io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int qt_io_uring_enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int qt_io_uring_register(int ringFd, unsigned opcode, const void *arg, unsigned nrArgs)
+{
+    return int(syscall(__NR_io_uring_register, ringFd, opcode, arg, nrArgs));
+}
+
+// One ring per thread. Submissions made while the thread is busy are
+// collected and handed to the kernel in one io_uring_enter() call on the
+// next pass through the event loop; completions are signalled through an
+// eventfd that is watched by a QSocketNotifier.
+class QIoUring
+{
+    Q_DISABLE_COPY_MOVE(QIoUring)
+public:
+    QIoUring() = default;
+    ~QIoUring();
+
+    static QIoUring *forCurrentThread();
+
+    bool submit(QFileAsyncOperation *operation);
+    qint64 operationCount() const { return submitted; }
+
+private:
+    bool init();
+    io_uring_sqe *nextSqe();
+    bool queue(QFileAsyncOperation *operation);
+    void scheduleSubmit();
+    void submitPending();
+    void reapCompletions();
+
+    // transfers are limited to what io_uring_cqe::res can report
+    static constexpr qint64 MaxTransferSize = 0x7ffff000;
+    static constexpr unsigned RingEntries = 256;
+
+    int ringFd = -1;
+    int eventFd = -1;
+
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqLocalTail = 0;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned cqMask = 0;
+    unsigned cqEntries = 0;
+
+    unsigned inFlight = 0;
+    qint64 submitted = 0;
+    bool submitScheduled = false;
+    std::unique_ptr<QSocketNotifier> notifier;
+};
+
+Q_CONSTINIT static QBasicAtomicInt ioUringUnavailable = Q_BASIC_ATOMIC_INITIALIZER(-1);
+Q_GLOBAL_STATIC(QThreadStorage<QIoUring *>, ioUrings)
+// set up a ring in this thread failed
+Q_CONSTINIT static thread_local bool ioUringSetupFailed = false;
+
+QIoUring *QIoUring::forCurrentThread()
+{
+    int unavailable = ioUringUnavailable.loadRelaxed();
+    if (unavailable == -1) {
+        unavailable = qEnvironmentVariableIsSet("QT_NO_IO_URING");
+        ioUringUnavailable.storeRelaxed(unavailable);
+    }
+    if (unavailable)
+        return nullptr;
+
+    // Completions are delivered by the event loop, so a thread that doesn't
+    // run one would never see them.
+    QThreadData *data = QThreadData::current();
+    if (data->eventLoops.isEmpty() || !data->hasEventDispatcher())
+        return nullptr;
+
+    QThreadStorage<QIoUring *> *storage = ioUrings();
+    if (!storage || ioUringSetupFailed)
+        return nullptr;
+    if (storage->hasLocalData())
+        return storage->localData();
+
+    auto ring = std::make_unique<QIoUring>();
+    if (!ring->init()) {
+        // Don't try again in this thread. Other threads may still succeed,
+        // for instance if this one ran into a resource limit.
+        ioUringSetupFailed = true;
+        return nullptr;
+    }
+    storage->setLocalData(ring.get());
+    return ring.release();
+}
+
+bool QIoUring::init()
+{
+    io_uring_params params = {};
+    ringFd = qt_io_uring_setup(RingEntries, &params);
+    if (ringFd < 0)
+        return false; // not supported by the kernel, or forbidden by a seccomp filter
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return false;
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+        return false;
+
+    auto sqField = [this](quint32 offset) {
+        return reinterpret_cast<unsigned *>(static_cast<char *>(sqRing) + offset);
+    };
+    auto cqField = [this](quint32 offset) {
+        return reinterpret_cast<unsigned *>(static_cast<char *>(cqRing) + offset);
+    };
+    sqHead = sqField(params.sq_off.head);
+    sqTail = sqField(params.sq_off.tail);
+    sqArray = sqField(params.sq_off.array);
+    sqMask = *sqField(params.sq_off.ring_mask);
+    sqEntries = *sqField(params.sq_off.ring_entries);
+    sqLocalTail = *sqTail;
+    cqHead = cqField(params.cq_off.head);
+    cqTail = cqField(params.cq_off.tail);
+    cqes = reinterpret_cast<io_uring_cqe *>(static_cast<char *>(cqRing) + params.cq_off.cqes);
+    cqMask = *cqField(params.cq_off.ring_mask);
+    cqEntries = *cqField(params.cq_off.ring_entries);
+
+    eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventFd < 0)
+        return false;
+    if (qt_io_uring_register(ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0)
+        return false;
+
+    notifier = std::make_unique<QSocketNotifier>(eventFd, QSocketNotifier::Read);
+    QObject::connect(notifier.get(), &QSocketNotifier::activated, notifier.get(),
+                     [this] { reapCompletions(); });
+    return true;
+}
+
+QIoUring::~QIoUring()
+{
+    notifier.reset();
+
+    // The kernel may still be writing into buffers we own, so wait for
+    // everything that was submitted before tearing the ring down.
+    if (ringFd >= 0 && sqes != MAP_FAILED) {
+        submitPending();
+        while (inFlight) {
+            if (qt_io_uring_enter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                // can't know when the kernel is done with the buffers; leak them
+                return;
+            }
+            reapCompletions();
+        }
+    }
+
+    if (eventFd >= 0)
+        qt_safe_close(eventFd);
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+io_uring_sqe *QIoUring::nextSqe()
+{
+    const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (sqLocalTail - head >= sqEntries)
+        return nullptr;
+
+    const unsigned index = sqLocalTail & sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    ++sqLocalTail;
+    return sqe;
+}
+
+bool QIoUring::submit(QFileAsyncOperation *operation)
+{
+    // Never have more operations in flight than the completion queue can
+    // hold, so that completions can't be dropped.
+    if (inFlight >= cqEntries || !queue(operation))
+        return false;
+
+    ++submitted;
+    scheduleSubmit();
+    return true;
+}
+
+// Queues the part of operation that is left to do, up to MaxTransferSize.
+bool QIoUring::queue(QFileAsyncOperation *operation)
+{
+    io_uring_sqe *sqe = nextSqe();
+    if (!sqe) {
+        submitPending();
+        sqe = nextSqe();
+        if (!sqe)
+            return false;
+    }
+
+    const bool read = operation->kind == QFileAsyncOperation::Read;
+    sqe->opcode = read ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe->fd = operation->fd;
+    sqe->off = quint64(operation->offset + operation->transferred);
+    sqe->addr = quintptr(operation->data + operation->transferred);
+    sqe->len = quint32(qMin(operation->size - operation->transferred, MaxTransferSize));
+    sqe->user_data = quintptr(operation);
+    ++inFlight;
+    return true;
+}
+
+void QIoUring::scheduleSubmit()
+{
+    if (submitScheduled)
+        return;
+    submitScheduled = true;
+    QMetaObject::invokeMethod(notifier.get(), [this] { submitPending(); }, Qt::QueuedConnection);
+}
+
+void QIoUring::submitPending()
+{
+    submitScheduled = false;
+
+    const unsigned toSubmit = sqLocalTail - *sqTail;
+    if (!toSubmit)
+        return;
+
+    __atomic_store_n(sqTail, sqLocalTail, __ATOMIC_RELEASE);
+    int ret;
+    EINTR_LOOP(ret, qt_io_uring_enter(ringFd, toSubmit, 0, 0));
+    if (ret < 0) {
+        // The entries stay in the submission queue and are picked up by
+        // the next io_uring_enter().
+        qErrnoWarning("QFile: io_uring_enter failed");
+    }
+}
+
+void QIoUring::reapCompletions()
+{
+    eventfd_t value;
+    eventfd_read(eventFd, &value);
+
+    for (;;) {
+        const unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+            break;
+
+        const io_uring_cqe &cqe = cqes[head & cqMask];
+        auto *operation = reinterpret_cast<QFileAsyncOperation *>(quintptr(cqe.user_data));
+        const qint64 result = cqe.res;
+
+        // release the slot before finishing, which can run continuations
+        // that submit more work
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        --inFlight;
+
+        // Short reads and writes continue where they stopped, until
+        // everything is transferred, the end of the file is reached, or an
+        // error occurs.
+        const bool retry = result == -EINTR || result == -EAGAIN;
+        if (retry || !operation->advance(result)) {
+            if (queue(operation)) {
+                scheduleSubmit();
+                continue;
+            }
+            // the submission queue is full; do the rest here
+            operation->run();
+        } else {
+            operation->finish(operation->result());
+        }
+        delete operation;
+    }
+}
+
+#endif // QT_CONFIG(io_uring)
+
+} // unnamed namespace
+
+template <typename Operation>
+static auto startOperation(std::unique_ptr<Operation> operation)
+{
+    auto future = operation->promise.future();
+
+#if QT_CONFIG(io_uring)
+    if (QIoUring *ring = QIoUring::forCurrentThread()) {
+        if (ring->submit(operation.get())) {
+            // owned by the ring until it completes
+            QFileAsyncIO::setCompletingThread(QFutureInterfaceBase::get(future));
+            operation.release();
+            return future;
+        }
+    }
+#endif
+
+    QThreadPool::globalInstance()->start([operation = std::move(operation)] {
+        operation->run();
+    });
+    return future;
+}
+
+void QFileAsyncIO::setCompletingThread(const QFutureInterfaceBase &future)
+{
+    future.d->completingThread = QThread::currentThread();
+}
+
+// The operations work on a duplicate of fd, so that closing the file while
+// they run doesn't make them use another file that got the same descriptor.
+QFuture<QByteArray> QFileAsyncIO::read(int fd, qint64 offset, qint64 maxSize)
+{
+    const int ownFd = qt_safe_dup(fd);
+    if (ownFd < 0)
+        return QtFuture::makeReadyValueFuture(QByteArray());
+    return startOperation(std::make_unique<QFileAsyncRead>(ownFd, offset, maxSize));
+}
+
+QFuture<qint64> QFileAsyncIO::write(int fd, qint64 offset, const QByteArray &data)
+{
+    const int ownFd = qt_safe_dup(fd);
+    if (ownFd < 0)
+        return QtFuture::makeReadyValueFuture(qint64(-1));
+    return startOperation(std::make_unique<QFileAsyncWrite>(ownFd, offset, data));
+}
+
+qint64 QFileAsyncIO::ioUringOperationCount()
+{
+#if QT_CONFIG(io_uring)
+    if (QThreadStorage<QIoUring *> *storage = ioUrings(); storage && storage->hasLocalData())
+        return storage->localData()->operationCount();
+#endif
+    return 0;
+}
+
+QT_END_NAMESPACE
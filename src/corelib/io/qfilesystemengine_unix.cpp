@@ -287,6 +287,11 @@ static int qt_fstatx(int fd, struct statx *statxBuffer)
     return qt_real_statx(fd, "", AT_EMPTY_PATH, statxBuffer);
 }
 
+static int qt_statxat(int dirFd, const char *name, int flags, struct statx *statxBuffer)
+{
+    return qt_real_statx(dirFd, name, flags, statxBuffer);
+}
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &statxBuffer)
 {
     // Permissions
@@ -348,6 +353,9 @@ static int qt_lstatx(const char *, struct statx *)
 static int qt_fstatx(int, struct statx *)
 { return -ENOSYS; }
 
+static int qt_statxat(int, const char *, int, struct statx *)
+{ return -ENOSYS; }
+
 inline void QFileSystemMetaData::fillFromStatxBuf(const struct statx &)
 { }
 #endif
@@ -379,6 +387,57 @@ bool QFileSystemEngine::fillMetaData(int fd, QFileSystemMetaData &data)
     return false;
 }
 
+static int qt_fstatat(int dirFd, const char *name, QT_STATBUF *statBuffer, int flags)
+{
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    return ::fstatat64(dirFd, name, statBuffer, flags);
+#else
+    return ::fstatat(dirFd, name, statBuffer, flags);
+#endif
+}
+
+//static
+bool QFileSystemEngine::fillMetaDataAt(int dirFd, const char *name, QFileSystemMetaData &data)
+{
+    // what = PosixStatFlags | LinkType, for an entry of the directory open at dirFd
+    data.entryFlags &= ~(QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+                         | QFileSystemMetaData::ExistsAttribute);
+    data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType
+            | QFileSystemMetaData::ExistsAttribute;
+
+    QT_STATBUF statBuffer;
+    struct statx statxBuffer;
+    bool usedStatx = false;
+    mode_t mode = 0;
+    auto statAt = [&](int flags) {
+        const int ret = qt_statxat(dirFd, name, flags, &statxBuffer);
+        usedStatx = ret != -ENOSYS;
+        if (usedStatx) {
+            mode = statxBuffer.stx_mode;
+            return ret == 0;
+        }
+        if (qt_fstatat(dirFd, name, &statBuffer, flags) != 0)
+            return false;
+        mode = statBuffer.st_mode;
+        return true;
+    };
+
+    // like fillMetaData() above: only stat(2) the target of symlinks
+    if (!statAt(AT_SYMLINK_NOFOLLOW))
+        return false;
+    if (S_ISLNK(mode)) {
+        data.entryFlags |= QFileSystemMetaData::LinkType;
+        if (!statAt(0))
+            return true;    // dangling symlink
+    }
+
+    if (usedStatx)
+        data.fillFromStatxBuf(statxBuffer);
+    else
+        data.fillFromStatBuf(statBuffer);
+    return true;
+}
+
 #if defined(_DEXTRA_FIRST)
 static void fillStat64fromStat32(struct stat64 *statBuf64, const struct stat &statBuf32)
 {
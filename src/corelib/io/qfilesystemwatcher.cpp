@@ -6,8 +6,10 @@
 
 #include <qdatetime.h>
 #include <qdir.h>
+#include <qdirwalker.h>
 #include <qfileinfo.h>
 #include <qloggingcategory.h>
+#include <qmetaobject.h>
 #include <qset.h>
 #include <qtimer.h>
 
@@ -15,6 +17,10 @@
 #define USE_INOTIFY
 #endif
 
+#if defined(Q_OS_LINUX) && QT_CONFIG(fanotify)
+#define USE_FANOTIFY
+#endif
+
 #include "qfilesystemwatcher_polling_p.h"
 #if defined(Q_OS_WIN)
 #  include "qfilesystemwatcher_win_p.h"
@@ -25,6 +31,9 @@
 #elif defined(Q_OS_MACOS)
 #  include "qfilesystemwatcher_fsevents_p.h"
 #endif
+#if defined(USE_FANOTIFY)
+#  include "qfilesystemwatcher_fanotify_p.h"
+#endif
 
 #include <algorithm>
 #include <iterator>
@@ -53,6 +62,36 @@ QFileSystemWatcherEngine *QFileSystemWatcherPrivate::createNativeEngine(QObject
 #endif
 }
 
+QFileSystemWatcherEngine *QFileSystemWatcherPrivate::createTreeEngine(QObject *parent)
+{
+#if defined(USE_FANOTIFY)
+    if (qEnvironmentVariableIsSet("QT_NO_FANOTIFY"))
+        return nullptr;
+    return QFanotifyFileSystemWatcherEngine::create(parent);
+#else
+    Q_UNUSED(parent);
+    return nullptr;
+#endif
+}
+
+// the directories that addPathRecursively() watches
+static constexpr QDir::Filters RecursiveFilters =
+        QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System | QDir::NoSymLinks;
+
+static bool isSameOrParentPath(QStringView parent, QStringView path)
+{
+    if (!path.startsWith(parent))
+        return false;
+    return path.size() == parent.size() || parent.endsWith(u'/') || path.at(parent.size()) == u'/';
+}
+
+static QString childPath(const QString &directory, const QString &name)
+{
+    if (directory.endsWith(u'/'))
+        return directory + name;
+    return directory + u'/' + name;
+}
+
 QFileSystemWatcherPrivate::QFileSystemWatcherPrivate()
     : native(nullptr), poller(nullptr)
 {
@@ -113,6 +152,7 @@ void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed
     if (removed)
         files.removeAll(path);
     emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+    queueChange(path, false);
 }
 
 void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool removed)
@@ -126,6 +166,181 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     if (removed)
         directories.removeAll(path);
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    queueChange(path, true);
+}
+
+void QFileSystemWatcherPrivate::initRecursiveEngines()
+{
+    if (recursiveEnginesInitialized)
+        return;
+    recursiveEnginesInitialized = true;
+
+    Q_Q(QFileSystemWatcher);
+    bool useTreeEngine = true;
+    bool useNativeEngine = true;
+#ifdef QT_BUILD_INTERNAL
+    const QString on = q->objectName();
+    if (Q_UNLIKELY(on.startsWith("_qt_autotest_force_engine_"_L1))) {
+        // Autotest override case - watch each directory with the selected engine
+        const auto forceName = QStringView{on}.mid(26);
+        useTreeEngine = false;
+        useNativeEngine = forceName != "poller"_L1;
+    }
+#endif
+    if (useTreeEngine)
+        treeEngine = createTreeEngine(q);
+    if (useNativeEngine)
+        perDirectoryEngine = createNativeEngine(q);
+    if (!perDirectoryEngine)
+        perDirectoryEngine = new QPollingFileSystemWatcherEngine(q);
+    qCDebug(lcWatcher) << "watching directory trees with"
+                       << (treeEngine ? treeEngine : perDirectoryEngine)->metaObject()->className();
+
+    if (treeEngine) {
+        QObject::connect(treeEngine, &QFileSystemWatcherEngine::directoryChanged, q,
+                         [this](const QString &path, bool removed) {
+                             recursiveDirectoryChanged(path, removed, false);
+                         });
+    }
+    QObject::connect(perDirectoryEngine, &QFileSystemWatcherEngine::directoryChanged, q,
+                     [this](const QString &path, bool removed) {
+                         recursiveDirectoryChanged(path, removed, true);
+                     });
+}
+
+bool QFileSystemWatcherPrivate::isInRecursiveTree(QStringView path) const
+{
+    for (const QString &root : recursiveRoots) {
+        if (isSameOrParentPath(root, path))
+            return true;
+    }
+    return false;
+}
+
+// Watches directory and all the directories below it with the per-directory
+// engine, registering them all at once. Returns false if any of them could not
+// be watched.
+bool QFileSystemWatcherPrivate::watchTree(const QString &directory)
+{
+    QStringList paths{ directory };
+    QDirWalker walker(directory, RecursiveFilters, QDirIterator::Subdirectories);
+    walker.walk([&paths](const QFileInfoList &batch) {
+        for (const QFileInfo &info : batch)
+            paths.append(info.filePath());
+    });
+    paths.removeIf([this](const QString &path) { return perDirectoryWatched.contains(path); });
+    if (paths.isEmpty())
+        return true;
+
+    QStringList watchedFiles, watchedDirectories;
+    const QStringList unhandled = perDirectoryEngine->addPaths(paths, &watchedFiles,
+                                                               &watchedDirectories);
+    for (const QString &path : std::as_const(watchedDirectories))
+        perDirectoryWatched.insert(path);
+    return unhandled.isEmpty();
+}
+
+// Stops watching directory and everything below it with the per-directory engine
+void QFileSystemWatcherPrivate::unwatchTree(const QString &directory)
+{
+    QStringList paths;
+    for (const QString &path : std::as_const(perDirectoryWatched)) {
+        if (isSameOrParentPath(directory, path))
+            paths.append(path);
+    }
+    if (paths.isEmpty())
+        return;
+
+    for (const QString &path : std::as_const(paths))
+        perDirectoryWatched.remove(path);
+    QStringList watchedFiles, watchedDirectories = paths;
+    perDirectoryEngine->removePaths(paths, &watchedFiles, &watchedDirectories);
+
+    // another tree may be nested in this one
+    for (const QString &root : std::as_const(recursiveRoots)) {
+        if (root != directory && isSameOrParentPath(directory, root))
+            watchTree(root);
+    }
+}
+
+void QFileSystemWatcherPrivate::recursiveDirectoryChanged(const QString &path, bool removed,
+                                                          bool perDirectory)
+{
+    Q_Q(QFileSystemWatcher);
+    qCDebug(lcWatcher) << "directory in tree changed" << path << "removed?" << removed;
+    if (perDirectory ? !perDirectoryWatched.contains(path) : !isInRecursiveTree(path)) {
+        // the tree was removed after a change was detected, but before we delivered the signal
+        return;
+    }
+
+    if (removed) {
+        if (perDirectory)
+            perDirectoryWatched.remove(path);
+        recursiveRoots.removeOne(path);
+    } else if (perDirectory) {
+        // look for new and moved away subdirectories once we get back to
+        // the event loop, when the engine is done with its bookkeeping
+        directoriesToRescan.insert(path);
+        if (!changesQueued) {
+            changesQueued = true;
+            QMetaObject::invokeMethod(q, [this] { processQueuedChanges(); },
+                                      Qt::QueuedConnection);
+        }
+    }
+    emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    queueChange(path, true);
+}
+
+void QFileSystemWatcherPrivate::queueChange(const QString &path, bool isDirectory)
+{
+    Q_Q(QFileSystemWatcher);
+    static const QMetaMethod filesChangedSignal =
+            QMetaMethod::fromSignal(&QFileSystemWatcher::filesChanged);
+    static const QMetaMethod directoriesChangedSignal =
+            QMetaMethod::fromSignal(&QFileSystemWatcher::directoriesChanged);
+    if (!q->isSignalConnected(isDirectory ? directoriesChangedSignal : filesChangedSignal))
+        return;
+
+    if (queuedChanges.contains(path))
+        return;
+    queuedChanges.insert(path);
+    (isDirectory ? changedDirectories : changedFiles).append(path);
+
+    if (!changesQueued) {
+        changesQueued = true;
+        QMetaObject::invokeMethod(q, [this] { processQueuedChanges(); }, Qt::QueuedConnection);
+    }
+}
+
+void QFileSystemWatcherPrivate::processQueuedChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    changesQueued = false;
+
+    const QSet<QString> rescan = std::exchange(directoriesToRescan, {});
+    for (const QString &directory : rescan) {
+        if (!perDirectoryWatched.contains(directory))
+            continue;
+        if (!QFileInfo(directory).isDir()) {
+            // moved away, or removed without us being told
+            unwatchTree(directory);
+            continue;
+        }
+        const QStringList subdirectories = QDir(directory).entryList(RecursiveFilters);
+        for (const QString &name : subdirectories) {
+            const QString path = childPath(directory, name);
+            if (!perDirectoryWatched.contains(path))
+                watchTree(path);
+        }
+    }
+
+    queuedChanges.clear();
+    const QStringList files = std::exchange(changedFiles, {});
+    const QStringList directories = std::exchange(changedDirectories, {});
+    if (!files.isEmpty())
+        emit q->filesChanged(files, QFileSystemWatcher::QPrivateSignal());
+    if (!directories.isEmpty())
+        emit q->directoriesChanged(directories, QFileSystemWatcher::QPrivateSignal());
 }
 
 #if defined(Q_OS_WIN)
@@ -217,6 +432,17 @@ void  QFileSystemWatcherPrivate::_q_winDriveRemoved(const QString &path)
     \endlist
     \endlist
 
+    To watch a whole directory tree, call addPathRecursively() with its
+    root. Changes to any directory inside the tree are reported with
+    directoryChanged(), and directories created in the tree later are
+    watched as well. On Linux, when the process has the required
+    privileges, this uses a single fanotify watch for the whole tree;
+    otherwise each directory in the tree is watched individually.
+
+    When many paths change at once, connecting to filesChanged() and
+    directoriesChanged() instead of fileChanged() and directoryChanged()
+    delivers the changes in batches, once per event loop iteration.
+
     \sa QFile, QDir
 */
 
@@ -411,6 +637,91 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     return p;
 }
 
+/*!
+    \since 6.6
+
+    Watches \a directory and all the directories below it. The
+    directoryChanged() signal is emitted when any directory in the tree
+    is modified or removed from disk. Directories that are created in
+    the tree, or moved into it, are watched as well.
+
+    Symbolic links to directories are not followed. Returns \c true if
+    the whole tree could be watched; returns \c false if \a directory
+    does not exist, is already being watched recursively, or if some of
+    the directories in the tree could not be watched.
+
+    Directories watched this way are not listed by directories(); use
+    recursiveDirectories() to get the roots of the watched trees.
+
+    \sa removePathRecursively(), addPath()
+*/
+bool QFileSystemWatcher::addPathRecursively(const QString &directory)
+{
+    Q_D(QFileSystemWatcher);
+
+    if (directory.isEmpty()) {
+        qWarning("QFileSystemWatcher::addPathRecursively: path is empty");
+        return false;
+    }
+    if (d->recursiveRoots.contains(directory) || !QFileInfo(directory).isDir())
+        return false;
+    qCDebug(lcWatcher) << "adding recursively" << directory;
+
+    d->initRecursiveEngines();
+    if (d->treeEngine) {
+        QStringList watchedFiles, watchedDirectories;
+        if (d->treeEngine->addPaths({ directory }, &watchedFiles, &watchedDirectories).isEmpty()) {
+            d->recursiveRoots.append(directory);
+            return true;
+        }
+    }
+
+    const bool ok = d->watchTree(directory);
+    if (d->perDirectoryWatched.contains(directory))
+        d->recursiveRoots.append(directory);
+    return ok;
+}
+
+/*!
+    \since 6.6
+
+    Stops watching the directory tree rooted at \a directory, which must
+    have been added with addPathRecursively(). Returns \c true if the
+    tree was being watched.
+
+    \sa addPathRecursively(), removePath()
+*/
+bool QFileSystemWatcher::removePathRecursively(const QString &directory)
+{
+    Q_D(QFileSystemWatcher);
+
+    if (!d->recursiveRoots.removeOne(directory))
+        return false;
+    qCDebug(lcWatcher) << "removing recursively" << directory;
+
+    if (d->perDirectoryWatched.contains(directory)) {
+        d->unwatchTree(directory);
+    } else if (d->treeEngine) {
+        QStringList watchedFiles, watchedDirectories = { directory };
+        d->treeEngine->removePaths({ directory }, &watchedFiles, &watchedDirectories);
+    }
+    return true;
+}
+
+/*!
+    \since 6.6
+
+    Returns the roots of the directory trees that are being watched with
+    addPathRecursively().
+
+    \sa directories()
+*/
+QStringList QFileSystemWatcher::recursiveDirectories() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->recursiveRoots;
+}
+
 /*!
     \fn void QFileSystemWatcher::fileChanged(const QString &path)
 
@@ -436,7 +747,36 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     However, the last change in the sequence of changes will always
     generate this signal.
 
-    \sa fileChanged()
+    \sa fileChanged(), directoriesChanged()
+*/
+
+/*!
+    \fn void QFileSystemWatcher::filesChanged(const QStringList &paths)
+    \since 6.6
+
+    This signal is emitted once control returns to the event loop after
+    one or more watched files were modified, renamed or removed from
+    disk, with the \a paths of all of them. Each path is listed once, in
+    the order in which the changes were first seen, regardless of how
+    many times it changed.
+
+    fileChanged() is still emitted for each change; connecting to this
+    signal instead avoids handling a burst of changes one at a time.
+
+    \sa directoriesChanged()
+*/
+
+/*!
+    \fn void QFileSystemWatcher::directoriesChanged(const QStringList &paths)
+    \since 6.6
+
+    This signal is emitted once control returns to the event loop after
+    one or more watched directories, including directories in trees
+    watched with addPathRecursively(), were modified or removed from
+    disk, with the \a paths of all of them. Each path is listed once, in
+    the order in which the changes were first seen.
+
+    \sa filesChanged(), directoryChanged()
 */
 
 /*!
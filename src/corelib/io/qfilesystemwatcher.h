@@ -31,9 +31,15 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    bool addPathRecursively(const QString &directory);
+    bool removePathRecursively(const QString &directory);
+    QStringList recursiveDirectories() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void filesChanged(const QStringList &paths, QPrivateSignal);
+    void directoriesChanged(const QStringList &paths, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
@@ -0,0 +1,395 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qfilesystemwatcher.h"
+#include "qfilesystemwatcher_fanotify_p.h"
+
+#include "private/qcore_unix_p.h"
+
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qscopeguard.h>
+#include <qvarlengtharray.h>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/fanotify.h>
+#include <sys/statfs.h>
+#include <unistd.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*
+    This engine marks whole filesystems with FAN_MARK_FILESYSTEM, so that a
+    single fanotify file descriptor reports the changes in any number of
+    directories, without a watch per directory. With FAN_REPORT_DFID_NAME,
+    events identify the directory that changed by its file handle, which we
+    turn into a path with open_by_handle_at() the first time we see it.
+
+    This needs CAP_SYS_ADMIN (for the filesystem marks) and
+    CAP_DAC_READ_SEARCH (for open_by_handle_at()); without them, adding a
+    path fails and QFileSystemWatcher watches each directory of the tree
+    with the regular engine instead.
+*/
+
+static constexpr quint64 FanotifyMask = FAN_CREATE | FAN_DELETE | FAN_MOVED_FROM | FAN_MOVED_TO
+        | FAN_ATTRIB | FAN_DELETE_SELF | FAN_ONDIR;
+
+// don't let the handles of directories outside of our trees pile up
+static constexpr qsizetype MaxForeignHandles = 0x10000;
+
+static QByteArray handleKey(quint64 fsid, const file_handle *handle)
+{
+    QByteArray key;
+    key.reserve(sizeof(fsid) + sizeof(handle->handle_type) + handle->handle_bytes);
+    key.append(reinterpret_cast<const char *>(&fsid), sizeof(fsid));
+    key.append(reinterpret_cast<const char *>(&handle->handle_type), sizeof(handle->handle_type));
+    key.append(reinterpret_cast<const char *>(handle->f_handle), handle->handle_bytes);
+    return key;
+}
+
+static bool isSameOrParentPath(QStringView parent, QStringView path)
+{
+    if (!path.startsWith(parent))
+        return false;
+    return path.size() == parent.size() || parent.endsWith(u'/') || path.at(parent.size()) == u'/';
+}
+
+QFanotifyFileSystemWatcherEngine *QFanotifyFileSystemWatcherEngine::create(QObject *parent)
+{
+    // FAN_REPORT_DFID_NAME requires Linux 5.9
+    const int fd = fanotify_init(FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_NONBLOCK
+                                 | FAN_REPORT_DFID_NAME,
+                                 O_RDONLY | O_CLOEXEC | O_LARGEFILE);
+    if (fd == -1)
+        return nullptr;
+    return new QFanotifyFileSystemWatcherEngine(fd, parent);
+}
+
+QFanotifyFileSystemWatcherEngine::QFanotifyFileSystemWatcherEngine(int fd, QObject *parent)
+    : QFileSystemWatcherEngine(parent),
+      fanotifyFd(fd),
+      notifier(fd, QSocketNotifier::Read, this)
+{
+    connect(&notifier, &QSocketNotifier::activated,
+            this, &QFanotifyFileSystemWatcherEngine::readFromFanotify);
+}
+
+QFanotifyFileSystemWatcherEngine::~QFanotifyFileSystemWatcherEngine()
+{
+    notifier.setEnabled(false);
+    for (const Filesystem &fs : std::as_const(filesystems))
+        qt_safe_close(fs.mountFd);
+    qt_safe_close(fanotifyFd);
+}
+
+QStringList QFanotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
+                                                       QStringList *files,
+                                                       QStringList *directories)
+{
+    Q_UNUSED(files);
+
+    QStringList unhandled;
+    for (const QString &path : paths) {
+        auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
+
+        // the paths we get from the kernel have all symlinks resolved
+        const QFileInfo fi(path);
+        const QString canonicalPath = fi.canonicalFilePath();
+        if (!fi.isDir() || canonicalPath.isEmpty() || roots.contains(canonicalPath))
+            continue;
+
+        const QByteArray encodedPath = QFile::encodeName(canonicalPath);
+        struct statfs sfs;
+        if (statfs(encodedPath.constData(), &sfs) != 0)
+            continue;
+        quint64 fsid;
+        static_assert(sizeof(fsid) == sizeof(sfs.f_fsid));
+        memcpy(&fsid, &sfs.f_fsid, sizeof(fsid));
+
+        auto fs = filesystems.find(fsid);
+        if (fs == filesystems.end()) {
+            const int mountFd = qt_safe_open(encodedPath.constData(), O_RDONLY | O_DIRECTORY);
+            if (mountFd == -1)
+                continue;
+            // fails with EPERM without CAP_SYS_ADMIN, and with ENODEV or
+            // EXDEV on filesystems that can't identify files by handle
+            if (fanotify_mark(fanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, FanotifyMask,
+                              AT_FDCWD, encodedPath.constData()) != 0) {
+                qt_safe_close(mountFd);
+                continue;
+            }
+            fs = filesystems.insert(fsid, Filesystem{ mountFd, 0 });
+        }
+        ++fs->rootCount;
+        roots.insert(canonicalPath, fsid);
+        rootPaths.insert(canonicalPath, path);
+
+        // this also checks that we are allowed to resolve handles at all
+        if (!rememberHandle(canonicalPath)) {
+            removeRoot(canonicalPath);
+            continue;
+        }
+        sg.dismiss();
+        directories->append(path);
+    }
+    return unhandled;
+}
+
+QStringList QFanotifyFileSystemWatcherEngine::removePaths(const QStringList &paths,
+                                                          QStringList *files,
+                                                          QStringList *directories)
+{
+    Q_UNUSED(files);
+
+    QStringList unhandled;
+    QSet<QString> removed;
+    for (const QString &path : paths) {
+        const QString canonicalPath = rootPaths.key(path);
+        if (canonicalPath.isEmpty()) {
+            unhandled.push_back(path);
+            continue;
+        }
+        removeRoot(canonicalPath);
+        removed.insert(path);
+    }
+    if (!removed.isEmpty())
+        directories->removeIf([&](const QString &path) { return removed.contains(path); });
+    return unhandled;
+}
+
+void QFanotifyFileSystemWatcherEngine::removeRoot(const QString &canonicalPath)
+{
+    const quint64 fsid = roots.take(canonicalPath);
+    rootPaths.remove(canonicalPath);
+    forgetPaths(canonicalPath);
+
+    const auto fs = filesystems.find(fsid);
+    Q_ASSERT(fs != filesystems.end());
+    if (--fs->rootCount == 0) {
+        fanotify_mark(fanotifyFd, FAN_MARK_REMOVE | FAN_MARK_FILESYSTEM, FanotifyMask,
+                      fs->mountFd, nullptr);
+        qt_safe_close(fs->mountFd);
+        filesystems.erase(fs);
+    }
+}
+
+// Returns the root of the tree that contains canonicalPath, if any
+QString QFanotifyFileSystemWatcherEngine::rootFor(QStringView canonicalPath) const
+{
+    for (auto it = roots.cbegin(), end = roots.cend(); it != end; ++it) {
+        if (isSameOrParentPath(it.key(), canonicalPath))
+            return it.key();
+    }
+    return QString();
+}
+
+// Maps a canonical path back to the spelling of the root it was added as
+QString QFanotifyFileSystemWatcherEngine::userPath(const QString &canonicalPath) const
+{
+    const QString root = rootFor(canonicalPath);
+    if (root.isEmpty())
+        return QString();
+    QString path = rootPaths.value(root);
+    if (canonicalPath.size() != root.size()) {
+        if (path.endsWith(u'/'))
+            path.chop(1);
+        path += QStringView(canonicalPath).sliced(root.endsWith(u'/') ? root.size() - 1
+                                                                      : root.size());
+    }
+    return path;
+}
+
+bool QFanotifyFileSystemWatcherEngine::rememberHandle(const QString &canonicalPath)
+{
+    const QString root = rootFor(canonicalPath);
+    if (root.isEmpty())
+        return false;
+
+    struct {
+        file_handle handle;
+        unsigned char bytes[MAX_HANDLE_SZ];
+    } buffer;
+    buffer.handle.handle_bytes = MAX_HANDLE_SZ;
+    int mountId;
+    if (name_to_handle_at(AT_FDCWD, QFile::encodeName(canonicalPath).constData(),
+                          &buffer.handle, &mountId, 0) != 0) {
+        return false;
+    }
+    const QByteArray key = handleKey(roots.value(root), &buffer.handle);
+    if (handleToPath.contains(key))
+        return true;
+
+    // make sure that we'll be able to turn the handles from the events
+    // into paths later: that needs CAP_DAC_READ_SEARCH
+    const int fd = open_by_handle_at(filesystems.value(roots.value(root)).mountFd,
+                                     &buffer.handle, O_PATH | O_CLOEXEC);
+    if (fd == -1)
+        return false;
+    qt_safe_close(fd);
+    handleToPath.insert(key, canonicalPath);
+    return true;
+}
+
+void QFanotifyFileSystemWatcherEngine::forgetPaths(QStringView canonicalPath)
+{
+    handleToPath.removeIf([&](const auto &it) {
+        return isSameOrParentPath(canonicalPath, it.value());
+    });
+}
+
+QString QFanotifyFileSystemWatcherEngine::pathForHandle(const QByteArray &key, quint64 fsid,
+                                                        file_handle *handle)
+{
+    if (const auto it = handleToPath.constFind(key); it != handleToPath.cend())
+        return it.value();
+    if (foreignHandles.contains(key))
+        return QString();
+
+    const auto fs = filesystems.constFind(fsid);
+    if (fs == filesystems.cend())
+        return QString();
+    const int fd = open_by_handle_at(fs->mountFd, handle, O_PATH | O_CLOEXEC);
+    if (fd == -1)
+        return QString();    // most likely already deleted
+
+    char link[32];
+    snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+    QVarLengthArray<char, PATH_MAX> target(PATH_MAX);
+    const ssize_t size = readlink(link, target.data(), target.size());
+    qt_safe_close(fd);
+    if (size <= 0 || size == target.size())
+        return QString();
+
+    const QString path = QFile::decodeName(QByteArray(target.constData(), size));
+    if (path.startsWith(u'/') && !rootFor(path).isEmpty()) {
+        handleToPath.insert(key, path);
+        return path;
+    }
+    if (foreignHandles.size() >= MaxForeignHandles)
+        foreignHandles.clear();
+    foreignHandles.insert(key);
+    return QString();
+}
+
+void QFanotifyFileSystemWatcherEngine::readFromFanotify()
+{
+    QStringList changed;
+    QSet<QString> seen;
+    QStringList removed;
+    const auto addChanged = [&](const QString &canonicalPath) {
+        if (!seen.contains(canonicalPath)) {
+            seen.insert(canonicalPath);
+            changed.append(canonicalPath);
+        }
+    };
+
+    alignas(fanotify_event_metadata) char buffer[16 * 1024];
+    for (;;) {
+        const qint64 bytesRead = qt_safe_read(fanotifyFd, buffer, sizeof(buffer));
+        if (bytesRead <= 0)
+            break;
+
+        qint64 len = bytesRead;
+        auto event = reinterpret_cast<fanotify_event_metadata *>(buffer);
+        for (; FAN_EVENT_OK(event, len); event = FAN_EVENT_NEXT(event, len)) {
+            if (event->vers != FANOTIFY_METADATA_VERSION)
+                continue;
+            if (event->fd >= 0)
+                qt_safe_close(event->fd);
+
+            if (event->mask & FAN_Q_OVERFLOW) {
+                // we lost events: report everything as changed
+                for (auto it = roots.cbegin(), end = roots.cend(); it != end; ++it)
+                    addChanged(it.key());
+                continue;
+            }
+
+            // find the record describing the directory
+            fanotify_event_info_fid *fid = nullptr;
+            char *info = reinterpret_cast<char *>(event) + event->metadata_len;
+            char * const infoEnd = reinterpret_cast<char *>(event) + event->event_len;
+            while (info + sizeof(fanotify_event_info_header) <= infoEnd) {
+                auto header = reinterpret_cast<fanotify_event_info_header *>(info);
+                if (header->len == 0)
+                    break;
+                if (header->info_type == FAN_EVENT_INFO_TYPE_DFID_NAME
+                        || header->info_type == FAN_EVENT_INFO_TYPE_DFID) {
+                    fid = reinterpret_cast<fanotify_event_info_fid *>(info);
+                    break;
+                }
+                info += header->len;
+            }
+            if (!fid)
+                continue;
+
+            auto handle = reinterpret_cast<file_handle *>(fid->handle);
+            const char *name = nullptr;
+            if (fid->hdr.info_type == FAN_EVENT_INFO_TYPE_DFID_NAME)
+                name = reinterpret_cast<const char *>(handle->f_handle + handle->handle_bytes);
+            const bool isSelf = !name || qstrcmp(name, ".") == 0;
+            const bool isDirectoryMove = (event->mask & FAN_ONDIR)
+                    && (event->mask & (FAN_MOVED_FROM | FAN_MOVED_TO));
+
+            // a directory from elsewhere may have been moved into our trees
+            if (isDirectoryMove)
+                foreignHandles.clear();
+
+            quint64 fsid;
+            static_assert(sizeof(fsid) == sizeof(fid->fsid));
+            memcpy(&fsid, &fid->fsid, sizeof(fsid));
+            const QByteArray key = handleKey(fsid, handle);
+            const QString directory = pathForHandle(key, fsid, handle);
+            if (directory.isEmpty())
+                continue;
+
+            if (isSelf) {
+                if (event->mask & FAN_DELETE_SELF) {
+                    handleToPath.remove(key);
+                    removed.append(directory);
+                } else {
+                    addChanged(directory);
+                }
+                continue;
+            }
+
+            addChanged(directory);
+            if (event->mask & FAN_ONDIR) {
+                QString child = directory;
+                if (!child.endsWith(u'/'))
+                    child += u'/';
+                child += QFile::decodeName(name);
+                // the paths of everything that was in a moved directory changed
+                if (event->mask & FAN_MOVED_FROM)
+                    forgetPaths(child);
+                if (event->mask & (FAN_DELETE | FAN_MOVED_FROM)) {
+                    if (roots.contains(child))
+                        removed.append(child);
+                } else if (event->mask & (FAN_CREATE | FAN_MOVED_TO)) {
+                    // so that we can tell where it was if it goes away quickly
+                    rememberHandle(child);
+                }
+            }
+        }
+    }
+
+    for (const QString &directory : std::as_const(changed)) {
+        const QString path = userPath(directory);
+        if (!path.isEmpty())
+            emit directoryChanged(path, false);
+    }
+    for (const QString &directory : std::as_const(removed)) {
+        const QString path = userPath(directory);
+        if (path.isEmpty())
+            continue;
+        if (roots.contains(directory))
+            removeRoot(directory);
+        emit directoryChanged(path, true);
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qfilesystemwatcher_fanotify_p.cpp"
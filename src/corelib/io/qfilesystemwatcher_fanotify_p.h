@@ -0,0 +1,79 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QFILESYSTEMWATCHER_FANOTIFY_P_H
+#define QFILESYSTEMWATCHER_FANOTIFY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qfilesystemwatcher_p.h"
+
+QT_REQUIRE_CONFIG(filesystemwatcher);
+QT_REQUIRE_CONFIG(fanotify);
+
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+#include <QtCore/qsocketnotifier.h>
+
+struct file_handle;
+
+QT_BEGIN_NAMESPACE
+
+// Watches whole directory trees: each path added to this engine is the root
+// of a tree, and directoryChanged() is emitted for any directory inside it.
+class QFanotifyFileSystemWatcherEngine : public QFileSystemWatcherEngine
+{
+    Q_OBJECT
+
+public:
+    ~QFanotifyFileSystemWatcherEngine();
+
+    static QFanotifyFileSystemWatcherEngine *create(QObject *parent);
+
+    QStringList addPaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+    QStringList removePaths(const QStringList &paths, QStringList *files, QStringList *directories) override;
+
+private Q_SLOTS:
+    void readFromFanotify();
+
+private:
+    struct Filesystem
+    {
+        int mountFd;
+        int rootCount;
+    };
+
+    QFanotifyFileSystemWatcherEngine(int fd, QObject *parent);
+
+    void removeRoot(const QString &canonicalPath);
+    QString rootFor(QStringView canonicalPath) const;
+    QString userPath(const QString &canonicalPath) const;
+    QString pathForHandle(const QByteArray &key, quint64 fsid, file_handle *handle);
+    bool rememberHandle(const QString &canonicalPath);
+    void forgetPaths(QStringView canonicalPath);
+
+    int fanotifyFd;
+    // canonical path of each root -> its filesystem, and the path it was added as
+    QHash<QString, quint64> roots;
+    QHash<QString, QString> rootPaths;
+    QHash<quint64, Filesystem> filesystems;
+    // file handle of a directory -> its path, for the directories in our
+    // trees; handles of directories elsewhere on the filesystem go to
+    // foreignHandles so that we don't resolve them again
+    QHash<QByteArray, QString> handleToPath;
+    QSet<QByteArray> foreignHandles;
+    QSocketNotifier notifier;
+};
+
+QT_END_NAMESPACE
+
+#endif // QFILESYSTEMWATCHER_FANOTIFY_P_H
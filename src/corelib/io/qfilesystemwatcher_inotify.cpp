@@ -11,6 +11,7 @@
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qscopeguard.h>
+#include <qset.h>
 #include <qsocketnotifier.h>
 #include <qvarlengtharray.h>
 
@@ -235,16 +236,13 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
 {
     QStringList unhandled;
     for (const QString &path : paths) {
+        auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
+        // pathToID has exactly the paths in files and directories, and
+        // doesn't get slow when watching hundreds of thousands of them
+        if (pathToID.contains(path))
+            continue;
         QFileInfo fi(path);
         bool isDir = fi.isDir();
-        auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
-        if (isDir) {
-            if (directories->contains(path))
-                continue;
-        } else {
-            if (files->contains(path))
-                continue;
-        }
 
         int wd = inotify_add_watch(inotifyFd,
                                    QFile::encodeName(path),
@@ -290,6 +288,7 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
                                                          QStringList *directories)
 {
     QStringList unhandled;
+    QSet<QString> removedFiles, removedDirectories;
     for (const QString &path : paths) {
         int id = pathToID.take(path);
 
@@ -315,12 +314,20 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
 
         sg.dismiss();
 
-        if (id < 0) {
-            directories->removeAll(path);
-        } else {
-            files->removeAll(path);
-        }
+        if (id < 0)
+            removedDirectories.insert(path);
+        else
+            removedFiles.insert(path);
+    }
+
+    // update the lists in a single pass each
+    if (!removedDirectories.isEmpty()) {
+        directories->removeIf([&](const QString &path) {
+            return removedDirectories.contains(path);
+        });
     }
+    if (!removedFiles.isEmpty())
+        files->removeIf([&](const QString &path) { return removedFiles.contains(path); });
 
     return unhandled;
 }
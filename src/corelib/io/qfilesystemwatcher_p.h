@@ -23,6 +23,7 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,11 +60,13 @@ class QFileSystemWatcherPrivate : public QObjectPrivate
     Q_DECLARE_PUBLIC(QFileSystemWatcher)
 
     static QFileSystemWatcherEngine *createNativeEngine(QObject *parent);
+    static QFileSystemWatcherEngine *createTreeEngine(QObject *parent);
 
 public:
     QFileSystemWatcherPrivate();
     void init();
     void initPollerEngine();
+    void initRecursiveEngines();
 
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
@@ -72,6 +75,29 @@ public:
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
 
+    // recursive watches
+    bool isInRecursiveTree(QStringView path) const;
+    bool watchTree(const QString &directory);
+    void unwatchTree(const QString &directory);
+    void recursiveDirectoryChanged(const QString &path, bool removed, bool perDirectory);
+
+    // watches whole trees at once, if the platform supports it
+    QFileSystemWatcherEngine *treeEngine = nullptr;
+    // otherwise, each directory in a tree is watched with this one
+    QFileSystemWatcherEngine *perDirectoryEngine = nullptr;
+    bool recursiveEnginesInitialized = false;
+    QStringList recursiveRoots;
+    QSet<QString> perDirectoryWatched;
+    QSet<QString> directoriesToRescan;
+
+    // coalescing of changes into filesChanged() and directoriesChanged()
+    void queueChange(const QString &path, bool isDirectory);
+    void processQueuedChanges();
+
+    QStringList changedFiles, changedDirectories;
+    QSet<QString> queuedChanges;
+    bool changesQueued = false;
+
 #if defined(Q_OS_WIN)
     void _q_winDriveLockForRemoval(const QString &);
     void _q_winDriveLockForRemovalFailed(const QString &);
@@ -3,6 +3,7 @@
 
 #include "qfilesystemwatcher_polling_p.h"
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qset.h>
 #include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
@@ -25,14 +26,14 @@ QStringList QPollingFileSystemWatcherEngine::addPaths(const QStringList &paths,
         if (!fi.exists())
             continue;
         if (fi.isDir()) {
-            if (directories->contains(path))
+            if (this->directories.contains(path))
                 continue;
             directories->append(path);
             if (!path.endsWith(u'/'))
                 fi = QFileInfo(path + u'/');
             this->directories.insert(path, fi);
         } else {
-            if (files->contains(path))
+            if (this->files.contains(path))
                 continue;
             files->append(path);
             this->files.insert(path, fi);
@@ -54,15 +55,23 @@ QStringList QPollingFileSystemWatcherEngine::removePaths(const QStringList &path
                                                          QStringList *directories)
 {
     QStringList unhandled;
+    QSet<QString> removedFiles, removedDirectories;
     for (const QString &path : paths) {
         if (this->directories.remove(path)) {
-            directories->removeAll(path);
+            removedDirectories.insert(path);
         } else if (this->files.remove(path)) {
-            files->removeAll(path);
+            removedFiles.insert(path);
         } else {
             unhandled.push_back(path);
         }
     }
+    if (!removedDirectories.isEmpty()) {
+        directories->removeIf([&](const QString &path) {
+            return removedDirectories.contains(path);
+        });
+    }
+    if (!removedFiles.isEmpty())
+        files->removeIf([&](const QString &path) { return removedFiles.contains(path); });
 
     if (this->files.isEmpty() &&
         this->directories.isEmpty()) {
@@ -665,4 +665,56 @@ void QLoggingCategory::setFilterRules(const QString &rules)
     This macro must be used outside of a class or method.
 */
 
+/*!
+    \macro Q_DECLARE_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(name, minimumLevel)
+    \sa Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL()
+    \relates QLoggingCategory
+    \since 6.6
+
+    Declares a logging category \a name whose messages with a lower severity
+    than \a minimumLevel are removed at compile time. The declaration must
+    match the one of Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL().
+
+    This macro must be used outside of a class or method.
+*/
+
+/*!
+    \macro Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(name, minimumLevel, string, msgType)
+    \sa Q_DECLARE_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(), Q_LOGGING_CATEGORY()
+    \relates QLoggingCategory
+    \since 6.6
+
+    Defines a logging category \a name, configurable under the \a string
+    identifier, like Q_LOGGING_CATEGORY() does. In addition, \a minimumLevel
+    is a QtMsgType that is known at compile time: qCDebug(), qCInfo(),
+    qCWarning() and qCCritical() statements for \a name with a lower
+    severity than \a minimumLevel are removed by the compiler, without
+    looking at the category at run time. The \c isDebugEnabled() family of
+    functions of the returned object are \c false for these types as well,
+    whatever the logging rules say.
+
+    The \a msgType argument is optional. By default, messages of type
+    \a minimumLevel and more severe are enabled at run time. Pass \a msgType
+    to enable only messages of that type and more severe by default.
+
+    The minimum level can come from the build system, for instance to remove
+    the debug messages of a category from release builds only:
+
+    \code
+    #ifdef QT_NO_DEBUG
+    #  define MY_LOGGING_MINIMUM_LEVEL QtInfoMsg
+    #else
+    #  define MY_LOGGING_MINIMUM_LEVEL QtDebugMsg
+    #endif
+
+    Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(lcNetwork, MY_LOGGING_MINIMUM_LEVEL, "my.network")
+    \endcode
+
+    Pass the category itself, not the result of calling it, to the logging
+    macros, as in \c{qCDebug(lcNetwork)}, so that no code remains for a removed
+    statement.
+
+    This macro must be used outside of a class or method.
+*/
+
 QT_END_NAMESPACE
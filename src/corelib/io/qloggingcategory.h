@@ -56,6 +56,51 @@ private:
     Q_DECL_UNUSED_MEMBER bool placeholder[4]; // reserved for future use
 };
 
+namespace QtPrivate {
+// the numeric values of the Qt*Msg constants are not in severity order
+constexpr int messageTypeSeverity(QtMsgType type) noexcept
+{
+    switch (type) {
+    case QtDebugMsg: return 0;
+    case QtInfoMsg: return 1;
+    case QtWarningMsg: return 2;
+    case QtCriticalMsg: return 3;
+    case QtFatalMsg: break;
+    }
+    return 4;
+}
+
+template <QtMsgType MinimumLevel>
+class QLoggingCategoryWithMinimumLevel : public QLoggingCategory
+{
+public:
+    static constexpr bool isCompiledIn(QtMsgType type) noexcept
+    {
+        return messageTypeSeverity(type) >= messageTypeSeverity(MinimumLevel);
+    }
+
+    explicit QLoggingCategoryWithMinimumLevel(const char *category,
+                                              QtMsgType severityLevel = MinimumLevel)
+        : QLoggingCategory(category, severityLevel)
+    {}
+
+    bool isEnabled(QtMsgType type) const
+    { return isCompiledIn(type) && QLoggingCategory::isEnabled(type); }
+
+    bool isDebugEnabled() const
+    { return isCompiledIn(QtDebugMsg) && QLoggingCategory::isDebugEnabled(); }
+    bool isInfoEnabled() const
+    { return isCompiledIn(QtInfoMsg) && QLoggingCategory::isInfoEnabled(); }
+    bool isWarningEnabled() const
+    { return isCompiledIn(QtWarningMsg) && QLoggingCategory::isWarningEnabled(); }
+    bool isCriticalEnabled() const
+    { return isCompiledIn(QtCriticalMsg) && QLoggingCategory::isCriticalEnabled(); }
+
+    QLoggingCategoryWithMinimumLevel &operator()() { return *this; }
+    const QLoggingCategoryWithMinimumLevel &operator()() const { return *this; }
+};
+} // namespace QtPrivate
+
 namespace { // allow different TUs to have different QT_NO_xxx_OUTPUT
 template <QtMsgType Which> struct QLoggingCategoryMacroHolder
 {
@@ -72,6 +117,24 @@ template <QtMsgType Which> struct QLoggingCategoryMacroHolder
         if (IsOutputEnabled)
             init(catfunc());
     }
+    // levels below the minimum are not even checked, so the compiler
+    // removes the whole statement
+    template <QtMsgType MinimumLevel>
+    explicit QLoggingCategoryMacroHolder(const QtPrivate::QLoggingCategoryWithMinimumLevel<MinimumLevel> &cat)
+    {
+        if constexpr (QtPrivate::QLoggingCategoryWithMinimumLevel<MinimumLevel>::isCompiledIn(Which)) {
+            if (IsOutputEnabled)
+                init(cat);
+        }
+    }
+    template <QtMsgType MinimumLevel>
+    explicit QLoggingCategoryMacroHolder(const QtPrivate::QLoggingCategoryWithMinimumLevel<MinimumLevel> &(*catfunc)())
+    {
+        if constexpr (QtPrivate::QLoggingCategoryWithMinimumLevel<MinimumLevel>::isCompiledIn(Which)) {
+            if (IsOutputEnabled)
+                init(catfunc());
+        }
+    }
     void init(const QLoggingCategory &cat) noexcept
     {
         category = &cat;
@@ -121,6 +184,17 @@ template <> const bool QLoggingCategoryMacroHolder<QtWarningMsg>::IsOutputEnable
         return category; \
     }
 
+#define Q_DECLARE_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(name, minimumLevel) \
+    const QT_PREPEND_NAMESPACE(QtPrivate)::QLoggingCategoryWithMinimumLevel<minimumLevel> &name();
+
+#define Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(name, minimumLevel, ...) \
+    const QT_PREPEND_NAMESPACE(QtPrivate)::QLoggingCategoryWithMinimumLevel<minimumLevel> &name() \
+    { \
+        static const QT_PREPEND_NAMESPACE(QtPrivate)::QLoggingCategoryWithMinimumLevel<minimumLevel> \
+                category(__VA_ARGS__); \
+        return category; \
+    }
+
 #define QT_MESSAGE_LOGGER_COMMON(category, level) \
     for (QLoggingCategoryMacroHolder<level> qt_category(category); qt_category; qt_category.control = false) \
         QMessageLogger(QT_MESSAGELOG_FILE, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC, qt_category.name())
@@ -12,6 +12,8 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qcoreapplication.h>
 
+#include <algorithm>
+
 #if QT_CONFIG(settings)
 #include <QtCore/qsettings.h>
 #include <QtCore/private/qsettings_p.h>
@@ -59,30 +61,37 @@ int QLoggingRule::pass(QLatin1StringView cat, QtMsgType msgType) const
     if (messageType > -1 && messageType != msgType)
         return 0;
 
+    if (matches(cat))
+        return (enabled ? 1 : -1);
+    return 0;
+}
+
+/*!
+    \internal
+    Returns whether the pattern of this rule matches category \a cat,
+    regardless of the message type.
+ */
+bool QLoggingRule::matches(QLatin1StringView cat) const
+{
     if (flags == FullText) {
         // full match
-        if (category == cat)
-            return (enabled ? 1 : -1);
-        else
-            return 0;
+        return category == cat;
     }
 
     const qsizetype idx = cat.indexOf(category);
     if (idx >= 0) {
         if (flags == MidFilter) {
             // matches somewhere
-            return (enabled ? 1 : -1);
+            return true;
         } else if (flags == LeftFilter) {
             // matches left
-            if (idx == 0)
-                return (enabled ? 1 : -1);
+            return idx == 0;
         } else if (flags == RightFilter) {
             // matches right
-            if (idx == (cat.size() - category.size()))
-                return (enabled ? 1 : -1);
+            return idx == (cat.size() - category.size());
         }
     }
-    return 0;
+    return false;
 }
 
 /*!
@@ -302,12 +311,18 @@ void QLoggingRegistry::initializeRules()
 
     const QMutexLocker locker(&registryMutex);
 
-    ruleSets[EnvironmentRules] = std::move(er);
-    ruleSets[QtConfigRules] = std::move(qr);
-    ruleSets[ConfigRules] = std::move(cr);
+    QSet<QLoggingCategory *> changedCategories;
+    setRules(EnvironmentRules, std::move(er), &changedCategories);
+    setRules(QtConfigRules, std::move(qr), &changedCategories);
+    setRules(ConfigRules, std::move(cr), &changedCategories);
+    updateCategories(changedCategories);
+}
 
-    if (!ruleSets[EnvironmentRules].isEmpty() || !ruleSets[QtConfigRules].isEmpty() || !ruleSets[ConfigRules].isEmpty())
-        updateRules();
+static QByteArray reversed(QByteArrayView name)
+{
+    QByteArray result(name.size(), Qt::Uninitialized);
+    std::reverse_copy(name.begin(), name.end(), result.begin());
+    return result;
 }
 
 /*!
@@ -325,6 +340,9 @@ void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableF
     if (categories.size() != oldSize) {
         // new entry
         e = enableForLevel;
+        const QByteArrayView name(cat->categoryName());
+        categoriesByName.insert(name, cat);
+        categoriesByReversedName.insert(reversed(name), cat);
         (*categoryFilter)(cat);
     }
 }
@@ -336,7 +354,11 @@ void QLoggingRegistry::registerCategory(QLoggingCategory *cat, QtMsgType enableF
 void QLoggingRegistry::unregisterCategory(QLoggingCategory *cat)
 {
     const auto locker = qt_scoped_lock(registryMutex);
-    categories.remove(cat);
+    if (categories.remove(cat)) {
+        const QByteArrayView name(cat->categoryName());
+        categoriesByName.remove(name, cat);
+        categoriesByReversedName.remove(reversed(name), cat);
+    }
 }
 
 /*!
@@ -368,9 +390,9 @@ void QLoggingRegistry::setApiRules(const QString &content)
 
     const QMutexLocker locker(&registryMutex);
 
-    ruleSets[ApiRules] = parser.rules();
-
-    updateRules();
+    QSet<QLoggingCategory *> changedCategories;
+    setRules(ApiRules, parser.rules(), &changedCategories);
+    updateCategories(changedCategories);
 }
 
 /*!
@@ -385,6 +407,97 @@ void QLoggingRegistry::updateRules()
         (*categoryFilter)(*it);
 }
 
+/*!
+    \internal
+    Replaces the rules of \a ruleSet with \a rules, and adds the categories
+    for which the result of the default filter may change to
+    \a changedCategories.
+
+    Rules are applied in order, and a later rule overrides an earlier one. So
+    the rules before the first and after the last difference between the old
+    and the new list don't matter: only a category that one of the rules in
+    between applies to can change.
+
+    (The caller must lock registryMutex to make sure the API is thread safe.)
+*/
+void QLoggingRegistry::setRules(RuleSet ruleSet, QList<QLoggingRule> &&rules,
+                                QSet<QLoggingCategory *> *changedCategories)
+{
+    const QList<QLoggingRule> &oldRules = ruleSets[ruleSet];
+    auto [oldBegin, newBegin] = std::mismatch(oldRules.cbegin(), oldRules.cend(),
+                                              rules.cbegin(), rules.cend());
+    auto oldEnd = oldRules.cend();
+    auto newEnd = rules.cend();
+    while (oldEnd != oldBegin && newEnd != newBegin && oldEnd[-1] == newEnd[-1]) {
+        --oldEnd;
+        --newEnd;
+    }
+    for (auto it = oldBegin; it != oldEnd; ++it)
+        addMatchingCategories(*it, changedCategories);
+    for (auto it = newBegin; it != newEnd; ++it)
+        addMatchingCategories(*it, changedCategories);
+
+    ruleSets[ruleSet] = std::move(rules);
+}
+
+/*!
+    \internal
+    Re-applies the filter to \a changedCategories.
+
+    A custom filter may depend on anything, so it still sees all categories.
+
+    (The caller must lock registryMutex to make sure the API is thread safe.)
+*/
+void QLoggingRegistry::updateCategories(const QSet<QLoggingCategory *> &changedCategories)
+{
+    if (categoryFilter != defaultCategoryFilter) {
+        updateRules();
+        return;
+    }
+    for (QLoggingCategory *category : changedCategories)
+        defaultCategoryFilter(category);
+}
+
+/*!
+    \internal
+    Adds the registered categories that \a rule applies to to \a result.
+
+    The sorted indexes give the candidates for full, left and right filters
+    as a range of names with the pattern as a prefix; only mid filters need
+    to look at all names.
+
+    (The caller must lock registryMutex to make sure the API is thread safe.)
+*/
+void QLoggingRegistry::addMatchingCategories(const QLoggingRule &rule,
+                                             QSet<QLoggingCategory *> *result) const
+{
+    // a pattern that is not Latin-1 matches nothing, so whatever the lossy
+    // conversion finds is discarded by QLoggingRule::matches()
+    const QByteArray pattern = rule.category.toLatin1();
+    const auto addMatching = [&](auto it, auto end, auto isCandidate) {
+        for (; it != end && isCandidate(it.key()); ++it) {
+            if (rule.matches(QLatin1StringView(it.value()->categoryName())))
+                result->insert(it.value());
+        }
+    };
+
+    if (rule.flags == QLoggingRule::FullText) {
+        const auto [begin, end] = categoriesByName.equal_range(pattern);
+        addMatching(begin, end, [](const auto &) { return true; });
+    } else if (rule.flags == QLoggingRule::LeftFilter) {
+        addMatching(categoriesByName.lowerBound(pattern), categoriesByName.cend(),
+                    [&](QByteArrayView name) { return name.startsWith(pattern); });
+    } else if (rule.flags == QLoggingRule::RightFilter) {
+        const QByteArray reversedPattern = reversed(pattern);
+        addMatching(categoriesByReversedName.lowerBound(reversedPattern),
+                    categoriesByReversedName.cend(),
+                    [&](QByteArrayView name) { return name.startsWith(reversedPattern); });
+    } else {
+        addMatching(categoriesByName.cbegin(), categoriesByName.cend(),
+                    [](const auto &) { return true; });
+    }
+}
+
 /*!
     \internal
     Installs a custom filter rule.
@@ -21,6 +21,7 @@
 #include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qtextstream.h>
 
@@ -44,6 +45,7 @@ public:
     QLoggingRule();
     QLoggingRule(QStringView pattern, bool enabled);
     int pass(QLatin1StringView categoryName, QtMsgType type) const;
+    bool matches(QLatin1StringView categoryName) const;
 
     enum PatternFlag {
         FullText = 0x1,
@@ -58,6 +60,16 @@ public:
     PatternFlags flags;
     bool enabled;
 
+    friend bool operator==(const QLoggingRule &lhs, const QLoggingRule &rhs) noexcept
+    {
+        return lhs.messageType == rhs.messageType && lhs.flags == rhs.flags
+                && lhs.enabled == rhs.enabled && lhs.category == rhs.category;
+    }
+    friend bool operator!=(const QLoggingRule &lhs, const QLoggingRule &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
 private:
     void parse(QStringView pattern);
 };
@@ -106,10 +118,6 @@ public:
     static QLoggingRegistry *instance();
 
 private:
-    void updateRules();
-
-    static void defaultCategoryFilter(QLoggingCategory *category);
-
     enum RuleSet {
         // sorted by order in which defaultCategoryFilter considers them:
         QtConfigRules,
@@ -120,11 +128,23 @@ private:
         NumRuleSets
     };
 
+    void updateRules();
+    void setRules(RuleSet ruleSet, QList<QLoggingRule> &&rules,
+                  QSet<QLoggingCategory *> *changedCategories);
+    void updateCategories(const QSet<QLoggingCategory *> &changedCategories);
+    void addMatchingCategories(const QLoggingRule &rule, QSet<QLoggingCategory *> *result) const;
+
+    static void defaultCategoryFilter(QLoggingCategory *category);
+
     QMutex registryMutex;
 
     // protected by mutex:
     QList<QLoggingRule> ruleSets[NumRuleSets];
     QHash<QLoggingCategory *, QtMsgType> categories;
+    // the same categories, sorted by name and by reversed name, to find the
+    // ones a rule applies to without looking at all of them
+    QMultiMap<QByteArrayView, QLoggingCategory *> categoriesByName;
+    QMultiMap<QByteArray, QLoggingCategory *> categoriesByReversedName;
     QLoggingCategory::CategoryFilter categoryFilter;
     QMap<QByteArrayView, QByteArrayView> qtCategoryEnvironmentOverrides;
 
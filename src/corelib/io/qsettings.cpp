@@ -37,6 +37,7 @@
 #endif
 
 #include <algorithm>
+#include <limits>
 #include <stdlib.h>
 
 #ifdef Q_OS_WIN // for homedirpath reading from registry
@@ -177,6 +178,247 @@ void QConfFile::clearCache()
     unusedCacheFunc()->clear();
 }
 
+#ifdef QSETTINGS_USE_BINARY_CACHE
+// ************************************************************************
+// QSettingsBinaryCache
+
+/*
+    The cache file starts with a Header, followed by one Entry per key in
+    key order, the UTF-16 key strings and finally the values serialized with
+    QDataStream. All offsets are relative to the start of the file. The file
+    is written in native byte order, as it never leaves the machine.
+*/
+struct QSettingsBinaryCache::Header
+{
+    enum : quint32 { Magic = 0x31435351, // "QSC1"
+                     Version = 1 };
+
+    quint32 magic;
+    quint32 version;
+    qint32 dataStreamVersion;
+    quint32 count;
+    qint64 iniSize;
+    qint64 iniTimeStamp;
+};
+
+struct QSettingsBinaryCache::Entry
+{
+    quint32 keyOffset;
+    quint32 keySize;
+    quint32 originalKeyOffset;
+    quint32 originalKeySize;
+    quint32 valueOffset;
+    quint32 valueSize;
+    qint64 position;
+};
+
+QString QSettingsBinaryCache::fileNameFor(const QString &iniFileName)
+{
+    return iniFileName + ".cache"_L1;
+}
+
+bool QSettingsBinaryCache::write(const QString &fileName, const ParsedSettingsMap &map,
+                                 qint64 iniSize, const QDateTime &iniTimeStamp)
+{
+    static_assert(sizeof(Header) % alignof(Entry) == 0);
+
+    const qint64 stringsOffset = sizeof(Header) + map.size() * sizeof(Entry);
+    QList<Entry> entries;
+    entries.reserve(map.size());
+    QByteArray strings;
+    QByteArray values;
+    QDataStream stream(&values, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_DefaultCompiledVersion);
+
+    const auto appendString = [&](QStringView str) {
+        const qint64 offset = stringsOffset + strings.size();
+        strings.append(reinterpret_cast<const char *>(str.utf16()), str.size() * sizeof(char16_t));
+        return offset;
+    };
+
+    for (auto it = map.cbegin(), end = map.cend(); it != end; ++it) {
+        const QSettingsKey &key = it.key();
+        const QString originalKey = key.originalCaseKey();
+        Entry entry;
+        entry.keyOffset = quint32(appendString(key));
+        entry.keySize = quint32(key.size());
+        if (originalKey == key)
+            entry.originalKeyOffset = entry.keyOffset;
+        else
+            entry.originalKeyOffset = quint32(appendString(originalKey));
+        entry.originalKeySize = quint32(originalKey.size());
+        entry.valueOffset = quint32(values.size());
+        stream << it.value();
+        if (stream.status() != QDataStream::Ok)
+            return false;
+        entry.valueSize = quint32(values.size() - entry.valueOffset);
+        entry.position = key.originalKeyPosition();
+        entries.append(entry);
+    }
+
+    // the offsets must fit the 32-bit fields
+    const qint64 valuesOffset = stringsOffset + strings.size();
+    if (valuesOffset + values.size() > std::numeric_limits<quint32>::max())
+        return false;
+    for (Entry &entry : entries)
+        entry.valueOffset += quint32(valuesOffset);
+
+    Header header;
+    header.magic = Header::Magic;
+    header.version = Header::Version;
+    header.dataStreamVersion = stream.version();
+    header.count = quint32(entries.size());
+    header.iniSize = iniSize;
+    header.iniTimeStamp = iniTimeStamp.toMSecsSinceEpoch();
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(entries.constData()),
+               entries.size() * sizeof(Entry));
+    file.write(strings);
+    file.write(values);
+    return file.commit();
+}
+
+bool QSettingsBinaryCache::open(const QString &fileName, qint64 iniSize,
+                                const QDateTime &iniTimeStamp)
+{
+    close();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 fileSize = file.size();
+    if (fileSize < qint64(sizeof(Header)) || fileSize > std::numeric_limits<quint32>::max()) {
+        file.close();
+        return false;
+    }
+    data = file.map(0, fileSize);
+    if (!data) {
+        file.close();
+        return false;
+    }
+
+    const auto header = reinterpret_cast<const Header *>(data);
+    bool ok = header->magic == Header::Magic
+            && header->version == Header::Version
+            && header->dataStreamVersion == QDataStream::Qt_DefaultCompiledVersion
+            && header->iniSize == iniSize
+            && header->iniTimeStamp == iniTimeStamp.toMSecsSinceEpoch()
+            && header->count <= (fileSize - sizeof(Header)) / sizeof(Entry);
+    if (ok)
+        count = header->count;
+
+    // Don't trust anything in the file: check that all entries point into
+    // it and that they are sorted, or lookups would go wrong.
+    const auto inFile = [fileSize](quint64 offset, quint64 size) {
+        return offset <= quint64(fileSize) && size <= quint64(fileSize) - offset;
+    };
+    for (qsizetype i = 0; ok && i < count; ++i) {
+        const Entry *e = entry(i);
+        ok = e->keyOffset % alignof(char16_t) == 0
+                && e->originalKeyOffset % alignof(char16_t) == 0
+                && inFile(e->keyOffset, quint64(e->keySize) * sizeof(char16_t))
+                && inFile(e->originalKeyOffset, quint64(e->originalKeySize) * sizeof(char16_t))
+                && inFile(e->valueOffset, e->valueSize)
+                && (i == 0 || key(entry(i - 1)).compare(key(e)) < 0);
+    }
+
+    if (!ok) {
+        close();
+        return false;
+    }
+    loaded = QBitArray(count);
+    return true;
+}
+
+void QSettingsBinaryCache::close()
+{
+    if (data)
+        file.unmap(const_cast<uchar *>(data));
+    file.close();
+    data = nullptr;
+    count = 0;
+    loaded.clear();
+}
+
+const QSettingsBinaryCache::Entry *QSettingsBinaryCache::entry(qsizetype i) const
+{
+    return reinterpret_cast<const Entry *>(data + sizeof(Header)) + i;
+}
+
+QStringView QSettingsBinaryCache::key(const Entry *e) const
+{
+    return QStringView(reinterpret_cast<const char16_t *>(data + e->keyOffset), e->keySize);
+}
+
+QStringView QSettingsBinaryCache::originalKey(const Entry *e) const
+{
+    return QStringView(reinterpret_cast<const char16_t *>(data + e->originalKeyOffset),
+                       e->originalKeySize);
+}
+
+qsizetype QSettingsBinaryCache::lowerBound(QStringView key) const
+{
+    qsizetype first = 0;
+    qsizetype n = count;
+    while (n > 0) {
+        const qsizetype half = n / 2;
+        if (this->key(entry(first + half)).compare(key) < 0) {
+            first += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return first;
+}
+
+bool QSettingsBinaryCache::load(qsizetype i, ParsedSettingsMap *map)
+{
+    if (loaded.testBit(i))
+        return true;
+    loaded.setBit(i);
+
+    const Entry *e = entry(i);
+    QVariant value;
+    QDataStream stream(QByteArray::fromRawData(reinterpret_cast<const char *>(data + e->valueOffset),
+                                               e->valueSize));
+    stream.setVersion(QDataStream::Qt_DefaultCompiledVersion);
+    stream >> value;
+    map->insert(QSettingsKey(originalKey(e).toString(), IniCaseSensitivity, e->position),
+                std::move(value));
+    return stream.status() == QDataStream::Ok;
+}
+
+bool QSettingsBinaryCache::loadAll(ParsedSettingsMap *map)
+{
+    bool ok = true;
+    for (qsizetype i = 0; i < count; ++i)
+        ok &= load(i, map);
+    return ok;
+}
+
+bool QSettingsBinaryCache::loadKey(QStringView key, ParsedSettingsMap *map)
+{
+    const qsizetype i = lowerBound(key);
+    if (i == count || this->key(entry(i)) != key)
+        return true;
+    return load(i, map);
+}
+
+bool QSettingsBinaryCache::loadPrefix(QStringView prefix, ParsedSettingsMap *map)
+{
+    bool ok = true;
+    for (qsizetype i = lowerBound(prefix); i < count && key(entry(i)).startsWith(prefix); ++i)
+        ok &= load(i, map);
+    return ok;
+}
+#endif // QSETTINGS_USE_BINARY_CACHE
+
 // ************************************************************************
 // QSettingsPrivate
 
@@ -1126,8 +1368,11 @@ QConfFileSettingsPrivate::~QConfFileSettingsPrivate()
                 if (unusedCache) {
                     QT_TRY {
                         // compute a better size?
-                        unusedCache->insert(conf_file->name, conf_file,
-                                            10 + (conf_file->originalKeys.size() / 4));
+                        qsizetype keyCount = conf_file->originalKeys.size();
+#ifdef QSETTINGS_USE_BINARY_CACHE
+                        keyCount += conf_file->binaryCache.size();
+#endif
+                        unusedCache->insert(conf_file->name, conf_file, 10 + (keyCount / 4));
                     } QT_CATCH(...) {
                         // out of memory. Do not cache the file.
                         delete conf_file;
@@ -1301,6 +1546,23 @@ bool QConfFileSettingsPrivate::isWritable() const
     return confFiles.at(0)->isWritable();
 }
 
+#ifdef QSETTINGS_USE_BINARY_CACHE
+bool QConfFileSettingsPrivate::usesBinaryCache(const QConfFile *confFile) const
+{
+#ifdef Q_OS_DARWIN
+    if (format == QSettings::NativeFormat)
+        return false;
+#endif
+#ifdef Q_OS_ANDROID
+    if (confFile->name.startsWith("content:"_L1))
+        return false;
+#else
+    Q_UNUSED(confFile);
+#endif
+    return format <= QSettings::IniFormat;
+}
+#endif
+
 void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 {
     bool readOnly = confFile->addedKeys.isEmpty() && confFile->removedKeys.isEmpty();
@@ -1359,6 +1621,9 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
         confFile->originalKeys.clear();
+#ifdef QSETTINGS_USE_BINARY_CACHE
+        confFile->binaryCache.close();
+#endif
 
         QFile file(confFile->name);
         if (!createFile && !file.open(QFile::ReadOnly)) {
@@ -1379,8 +1644,22 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             } else
 #endif
             if (format <= QSettings::IniFormat) {
-                QByteArray data = file.readAll();
-                ok = readIniFile(data, &confFile->unparsedIniSections);
+#ifdef QSETTINGS_USE_BINARY_CACHE
+                /*
+                    If the INI file was last written by QSettings, there is
+                    an up-to-date binary copy of it that we can map instead
+                    of parsing the file.
+                */
+                ok = usesBinaryCache(confFile)
+                        && confFile->binaryCache.open(
+                                QSettingsBinaryCache::fileNameFor(confFile->name),
+                                fileInfo.size(), fileInfo.lastModified(QTimeZone::UTC));
+                if (!ok)
+#endif
+                {
+                    QByteArray data = file.readAll();
+                    ok = readIniFile(data, &confFile->unparsedIniSections);
+                }
             } else if (readFunc) {
                 QSettings::SettingsMap tempNewKeys;
                 ok = readFunc(file, tempNewKeys);
@@ -1468,6 +1747,24 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
                     perms |= QFile::ReadGroup | QFile::ReadOther;
                 QFile(confFile->name).setPermissions(perms);
             }
+
+#ifdef QSETTINGS_USE_BINARY_CACHE
+            /*
+                Refresh the binary cache while we still hold the lock. It's
+                only an optimization for the readers, so failing to write it
+                is not an error; a stale cache is ignored by them.
+            */
+            if (usesBinaryCache(confFile)) {
+                const QString cacheFileName = QSettingsBinaryCache::fileNameFor(confFile->name);
+                if (!mergedKeys.isEmpty()
+                        && QSettingsBinaryCache::write(cacheFileName, mergedKeys,
+                                                       confFile->size, confFile->timeStamp)) {
+                    QFile::setPermissions(cacheFileName, QFile::permissions(confFile->name));
+                } else {
+                    QFile::remove(cacheFileName);
+                }
+            }
+#endif
         } else {
             setStatus(QSettings::AccessError);
         }
@@ -1817,6 +2114,14 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
 
 void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) const
 {
+#ifdef QSETTINGS_USE_BINARY_CACHE
+    if (confFile->binaryCache.isOpen()) {
+        if (!confFile->binaryCache.loadAll(&confFile->originalKeys))
+            setStatus(QSettings::FormatError);
+        confFile->binaryCache.close();
+    }
+#endif
+
     auto i = confFile->unparsedIniSections.constBegin();
     const auto end = confFile->unparsedIniSections.constEnd();
 
@@ -1830,6 +2135,18 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
 void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
                                                    const QSettingsKey &key) const
 {
+#ifdef QSETTINGS_USE_BINARY_CACHE
+    if (confFile->binaryCache.isOpen()) {
+        // a key ending in a slash is a group prefix: load everything below it
+        const bool ok = key.endsWith(u'/')
+                ? confFile->binaryCache.loadPrefix(key, &confFile->originalKeys)
+                : confFile->binaryCache.loadKey(key, &confFile->originalKeys);
+        if (!ok)
+            setStatus(QSettings::FormatError);
+        return;
+    }
+#endif
+
     if (confFile->unparsedIniSections.isEmpty())
         return;
 
@@ -2134,6 +2451,13 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
     Note that sync() imports changes made by other processes (in addition to
     writing the changes from this QSettings).
 
+    Since Qt 6.6, whenever QSettings writes an INI file, it also writes a
+    binary copy of its contents to a file with the same name and a \c .cache
+    suffix. Other QSettings objects, in the same or in other processes, map
+    that copy into memory instead of parsing the INI file, and only decode
+    the values they actually read. The copy is ignored if the INI file has
+    been modified since it was written, for instance by hand.
+
     \section1 Platform-Specific Notes
 
     \section2 Locations Where Application Settings Are Stored
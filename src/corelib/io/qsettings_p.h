@@ -15,7 +15,9 @@
 // We mean it.
 //
 
+#include "QtCore/qbitarray.h"
 #include "QtCore/qdatetime.h"
+#include "QtCore/qfile.h"
 #include "QtCore/qmap.h"
 #include "QtCore/qmutex.h"
 #include "QtCore/qiodevice.h"
@@ -35,6 +37,10 @@ QT_BEGIN_NAMESPACE
 #define QT_QSETTINGS_ALWAYS_CASE_SENSITIVE_AND_FORGET_ORIGINAL_KEY_ORDER
 #endif
 
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(temporaryfile)
+#define QSETTINGS_USE_BINARY_CACHE
+#endif
+
 // used in testing framework
 #define QSETTINGS_P_H_VERSION 3
 
@@ -111,6 +117,48 @@ inline QString QSettingsGroup::toString() const
     return result;
 }
 
+#ifdef QSETTINGS_USE_BINARY_CACHE
+/*
+    A binary, memory-mapped copy of the keys of an INI file, written next to
+    it whenever QSettings saves the file. The entries are sorted the same way
+    as a ParsedSettingsMap, so a key can be looked up with a binary search in
+    the mapped memory and only the values that are actually used need to be
+    deserialized. The cache records the size and modification time of the INI
+    file it was generated from and is ignored if they don't match.
+*/
+class QSettingsBinaryCache
+{
+public:
+    static QString fileNameFor(const QString &iniFileName);
+    static bool write(const QString &fileName, const ParsedSettingsMap &map,
+                      qint64 iniSize, const QDateTime &iniTimeStamp);
+
+    bool open(const QString &fileName, qint64 iniSize, const QDateTime &iniTimeStamp);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+    qsizetype size() const { return count; }
+
+    bool loadAll(ParsedSettingsMap *map);
+    bool loadKey(QStringView key, ParsedSettingsMap *map);
+    bool loadPrefix(QStringView prefix, ParsedSettingsMap *map);
+
+private:
+    struct Header;
+    struct Entry;
+
+    const Entry *entry(qsizetype i) const;
+    QStringView key(const Entry *e) const;
+    QStringView originalKey(const Entry *e) const;
+    qsizetype lowerBound(QStringView key) const;
+    bool load(qsizetype i, ParsedSettingsMap *map);
+
+    QFile file;
+    const uchar *data = nullptr;
+    qsizetype count = 0;
+    QBitArray loaded;
+};
+#endif
+
 class QConfFile
 {
 public:
@@ -130,6 +178,9 @@ public:
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
+#ifdef QSETTINGS_USE_BINARY_CACHE
+    QSettingsBinaryCache binaryCache;
+#endif
     QAtomicInt ref;
     QMutex mutex;
     bool userPerms;
@@ -254,6 +305,9 @@ private:
 #endif
     void ensureAllSectionsParsed(QConfFile *confFile) const;
     void ensureSectionParsed(QConfFile *confFile, const QSettingsKey &key) const;
+#ifdef QSETTINGS_USE_BINARY_CACHE
+    bool usesBinaryCache(const QConfFile *confFile) const;
+#endif
 
     QList<QConfFile *> confFiles;
     QSettings::ReadFunc readFunc;
@@ -337,7 +337,9 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 
 qsizetype qGlobalPostedEventsCount()
 {
-    const QPostEventList &l = QThreadData::current()->postEventList;
+    QPostEventList &l = QThreadData::current()->postEventList;
+    const auto locker = qt_scoped_lock(l.mutex);
+    l.takeIncomingEvents();
     return l.size() - l.startOffset;
 }
 
@@ -487,6 +489,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.takeIncomingEvents();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1585,6 +1588,61 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     return locker;
 }
 
+/*!
+    \internal
+
+    Adds \a event for \a receiver to the incoming events of the receiver's
+    thread, without locking its posted event list. This is only done for
+    events with the default priority of types that no compressEvent()
+    implementation looks at: queued calls and application-defined events.
+    Those are the ones that many threads post to a single one at high rates.
+*/
+bool QCoreApplicationPrivate::postEventWithoutLocking(QObject *receiver, QEvent *event)
+{
+    const QEvent::Type type = event->type();
+    if (type != QEvent::MetaCall && (type < QEvent::User || type > QEvent::MaxUser))
+        return false;
+
+    // delete the event on exceptions to protect against memory leaks
+    std::unique_ptr<QEvent> eventDeleter(event);
+    // allocated up front, so that nothing below can throw
+    auto node = std::make_unique<QPostEventList::IncomingEvent>(
+            QPostEventList::IncomingEvent{ QPostEvent(receiver, event, Qt::NormalEventPriority),
+                                           nullptr });
+
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    for (;;) {
+        QThreadData *data = threadData.loadAcquire();
+        if (!data) {
+            Q_UNUSED(eventDeleter.release());
+            return false;
+        }
+
+        // QObject::moveToThread() waits for us before it takes the incoming
+        // events, so the event can't be left behind in the old thread
+        QPostEventList &list = data->postEventList;
+        list.incomingPosters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (threadData.loadRelaxed() != data) {
+            list.incomingPosters.fetch_sub(1);
+            continue;
+        }
+
+        Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+        event->m_posted = true;
+        ++receiver->d_func()->postedEvents;
+        const bool first = list.addIncomingEvent(node.release());
+        Q_UNUSED(eventDeleter.release());
+        list.incomingPosters.fetch_sub(1);
+
+        if (first) {
+            if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire())
+                dispatcher->wakeUp();
+        }
+        return true;
+    }
+}
+
 /*!
     \since 4.3
 
@@ -1623,6 +1681,11 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    if (priority == Qt::NormalEventPriority
+        && QCoreApplicationPrivate::postEventWithoutLocking(receiver, event)) {
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1631,6 +1694,7 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     }
 
     QThreadData *data = locker.threadData;
+    data->postEventList.takeIncomingEvents();
 
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
@@ -1778,6 +1842,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.takeIncomingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1942,6 +2007,8 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     if (receiver && !receiver->d_func()->postedEvents)
         return;
 
+    data->postEventList.takeIncomingEvents();
+
     //we will collect all the posted events for the QObject
     //and we'll delete after the mutex was unlocked
     QVarLengthArray<QEvent*> events;
@@ -1997,6 +2064,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.takeIncomingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -119,6 +119,7 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static bool postEventWithoutLocking(QObject *receiver, QEvent *event);
 #endif // QT_NO_QOBJECT
 
     int &argc;
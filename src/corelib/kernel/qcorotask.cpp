@@ -0,0 +1,175 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcorotask.h"
+
+#include "qabstracteventdispatcher.h"
+#include "qcoreapplication.h"
+#include "private/qobject_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QCoroTask
+    \inmodule QtCore
+    \since 6.6
+    \brief The QCoroTask class is the return type of C++20 coroutines that
+    run in Qt event loops.
+
+    A function that returns QCoroTask<T> can use \c co_await on a QFuture,
+    on another QCoroTask, and on the awaitables returned by QtCoro::signal(),
+    QtCoro::readyRead() and QtCoro::bytesWritten(). It is then written as a
+    sequence of steps instead of a chain of QFuture::then() calls or
+    signal-slot connections:
+
+    \code
+    QCoroTask<QByteArray> Downloader::fetch(QIODevice *device)
+    {
+        co_await QtCoro::signal(this, &Downloader::started);
+        QByteArray data;
+        while (co_await QtCoro::readyRead(device) > 0)
+            data += device->readAll();
+        co_return data;
+    }
+    \endcode
+
+    The coroutine starts running as soon as it is called, and runs until it
+    has to wait for the first time. It is always resumed in the thread it
+    belongs to: the thread of the QObject whose member function it is (or,
+    more generally, of the QObject that its first parameter refers to), or
+    otherwise the thread that called it. When the awaited event happens in
+    another thread, the coroutine is resumed through the event loop of its
+    own thread. If the QObject it belongs to is destroyed while it waits, the
+    coroutine is not resumed any more.
+
+    If an awaited QFuture is canceled, the coroutine is canceled instead of
+    being resumed: it does not run any further, and isCanceled() returns
+    \c true. A coroutine that awaits a canceled QCoroTask is canceled as
+    well, just like the continuations attached with QFuture::then() are. A
+    coroutine whose QObject was destroyed while it waited for a QFuture is
+    canceled, and its frame freed, once that future is finished. A QFuture
+    that has an exception is not canceled; \c co_await rethrows the
+    exception.
+
+    Awaiting a QFuture that has a continuation already, for example one
+    attached with QFuture::then(), runs the coroutine after it. Attaching
+    a continuation to a QFuture that a coroutine awaits is not supported.
+
+    The state of each step lives in the coroutine frame. Waiting does not
+    allocate memory, except for the event that resumes the coroutine in its
+    own thread and for the connections made to wait for a signal or for
+    the destruction of the QObject the coroutine belongs to.
+
+    Destroying a QCoroTask does not stop its coroutine: the coroutine keeps
+    running and frees its frame when it finishes. A QCoroTask must not be
+    destroyed while another coroutine awaits it.
+
+    Coroutine support requires a compiler in C++20 mode; the class is not
+    available otherwise.
+
+    \sa QFuture, QPromise
+*/
+
+/*!
+    \fn template <typename T> bool QCoroTask<T>::isFinished() const
+
+    Returns \c true if the coroutine has returned or was canceled.
+
+    \sa isCanceled()
+*/
+
+/*!
+    \fn template <typename T> bool QCoroTask<T>::isCanceled() const
+
+    Returns \c true if the coroutine was canceled because a QFuture or
+    QCoroTask that it awaited was canceled. A canceled coroutine has no
+    result.
+
+    \sa isFinished()
+*/
+
+/*!
+    \fn template <typename T> decltype(auto) QCoroTask<T>::result() const
+
+    Returns a reference to the value that the finished coroutine returned
+    with \c co_return. If the coroutine exited with an exception, this
+    function rethrows it. The coroutine must not have been canceled.
+
+    \sa isFinished(), isCanceled()
+*/
+
+/*!
+    \namespace QtCoro
+    \inmodule QtCore
+    \since 6.6
+    \brief Contains awaitables for QCoroTask coroutines.
+*/
+
+/*!
+    \fn template <typename Signal> auto QtCoro::signal(const typename QtPrivate::FunctionPointer<Signal>::Object *sender, Signal signal)
+
+    Returns an awaitable that resumes the coroutine the next time \a sender
+    emits \a signal. The result of \c co_await is nothing if the signal has
+    no arguments, its argument if it has one, and a \c std::tuple of them
+    otherwise.
+
+    If \a sender is destroyed before it emits the signal, the coroutine is
+    not resumed.
+*/
+
+/*!
+    \fn auto QtCoro::readyRead(QIODevice *device)
+
+    Returns an awaitable that resumes the coroutine once \a device has data
+    to read, and gives the number of bytes available. If data is available
+    already, or \a device is not readable, the coroutine continues
+    immediately. It also resumes, possibly with 0 bytes, when the read
+    channel of \a device is finished or \a device is closed.
+
+    \sa QIODevice::readyRead()
+*/
+
+/*!
+    \fn auto QtCoro::bytesWritten(QIODevice *device)
+
+    Returns an awaitable that resumes the coroutine once \a device has
+    written a payload of data, and gives the number of bytes written. If
+    \a device has nothing left to write or is not writable, the coroutine
+    continues immediately with 0. It also resumes with 0 when \a device is
+    closed.
+
+    \sa QIODevice::bytesWritten()
+*/
+
+namespace QtPrivate {
+
+namespace {
+class QCoroutineResumeEvent : public QAbstractMetaCallEvent
+{
+public:
+    QCoroutineResumeEvent(void (*resume)(void *), void *frame)
+        : QAbstractMetaCallEvent(nullptr, -1), resume(resume), frame(frame)
+    { }
+
+    void placeMetaCall(QObject *) override { resume(frame); }
+
+private:
+    void (*resume)(void *);
+    void *frame;
+};
+} // unnamed namespace
+
+QObject *currentCoroutineContext()
+{
+    return QAbstractEventDispatcher::instance();
+}
+
+void postCoroutineResume(QObject *context, void (*resume)(void *), void *frame)
+{
+    Q_ASSERT(context);
+    QCoreApplication::postEvent(context, new QCoroutineResumeEvent(resume, frame));
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
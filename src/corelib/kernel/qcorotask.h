@@ -0,0 +1,592 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOROTASK_H
+#define QCOROTASK_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
+
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <tuple>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// Returns the event dispatcher of the current thread, if it has one.
+Q_CORE_EXPORT QObject *currentCoroutineContext();
+// Makes the event loop of the thread that \a context lives in call
+// resume(frame).
+Q_CORE_EXPORT void postCoroutineResume(QObject *context, void (*resume)(void *), void *frame);
+
+} // namespace QtPrivate
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+template <typename T = void>
+class QCoroTask;
+
+namespace QtPrivate {
+
+inline void resumeCoroutineFrame(void *frame)
+{
+    std::coroutine_handle<>::from_address(frame).resume();
+}
+
+// Calls step(frame) in the thread of \a context: directly if that's the
+// current thread, otherwise through that thread's event loop.
+inline void runInCoroutineContext(QObject *context, void (*step)(void *), void *frame)
+{
+    if (!context || context->thread() == QThread::currentThread())
+        step(frame);
+    else
+        postCoroutineResume(context, step, frame);
+}
+
+inline void resumeCoroutine(QObject *context, std::coroutine_handle<> handle)
+{
+    runInCoroutineContext(context, resumeCoroutineFrame, handle.address());
+}
+
+// The object whose thread the coroutine of \a handle resumes in: the owner
+// of a QCoroTask if it has one, otherwise the current thread's dispatcher.
+template <typename Promise>
+QObject *coroutineContext(std::coroutine_handle<Promise> handle)
+{
+    if constexpr (requires { handle.promise().context(); }) {
+        if (QObject *context = handle.promise().context())
+            return context;
+    }
+    return currentCoroutineContext();
+}
+
+class QCoroPromiseBase
+{
+public:
+    enum State { Running, Awaited, Finished, Detached };
+    using CancelFunction = void (*)(void *frame);
+
+    QCoroPromiseBase() = default;
+
+    // A coroutine whose first parameter is a reference to a QObject, as the
+    // implicit object parameter of a member function is, belongs to it.
+    template <typename Object, typename... Args>
+        requires std::is_base_of_v<QObject, Object>
+    explicit QCoroPromiseBase(Object &object, Args &...)
+        : m_context(const_cast<std::remove_const_t<Object> *>(&object))
+    { }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+
+    class FinalAwaiter
+    {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            QCoroPromiseBase &promise = handle.promise();
+            int state = promise.m_state.exchange(Finished, std::memory_order_acq_rel);
+            if (state == Detached) {
+                handle.destroy();
+            } else if (state == Awaited) {
+                QObject *context = promise.m_continuationContext;
+                if (!context || context->thread() == QThread::currentThread())
+                    return promise.m_continuation;
+                resumeCoroutine(context, promise.m_continuation);
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept { }
+    };
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        m_exception = std::current_exception();
+#else
+        std::terminate();
+#endif
+    }
+
+    QObject *context() const noexcept { return m_context.data(); }
+
+    bool isFinished() const noexcept
+    {
+        return m_state.load(std::memory_order_acquire) == Finished;
+    }
+
+    // Only meaningful once isFinished() returned true.
+    bool isCanceled() const noexcept { return m_canceled; }
+
+    // Returns false if the coroutine already finished. If \a cancel is set,
+    // the continuation is canceled with it instead of being resumed if this
+    // coroutine is canceled.
+    bool setContinuation(std::coroutine_handle<> continuation, QObject *context,
+                         CancelFunction cancel) noexcept
+    {
+        m_continuation = continuation;
+        m_continuationContext = context;
+        m_continuationCancel = cancel;
+        int expected = Running;
+        return m_state.compare_exchange_strong(expected, Awaited, std::memory_order_acq_rel);
+    }
+
+    // Finishes the suspended coroutine of \a frame without resuming it, and
+    // cancels the coroutine that awaits it, if any.
+    template <typename Promise>
+    static void cancel(void *frame)
+    {
+        const auto handle = std::coroutine_handle<Promise>::from_address(frame);
+        QCoroPromiseBase &promise = handle.promise();
+        promise.m_canceled = true;
+        int state = promise.m_state.exchange(Finished, std::memory_order_acq_rel);
+        if (state == Detached) {
+            handle.destroy();
+        } else if (state == Awaited) {
+            if (promise.m_continuationCancel) {
+                runInCoroutineContext(promise.m_continuationContext, promise.m_continuationCancel,
+                                      promise.m_continuation.address());
+            } else {
+                resumeCoroutine(promise.m_continuationContext, promise.m_continuation);
+            }
+        }
+    }
+
+    // Returns false if the coroutine already finished and has to be destroyed.
+    bool detach() noexcept
+    {
+        int expected = Running;
+        if (m_state.compare_exchange_strong(expected, Detached, std::memory_order_acq_rel))
+            return true;
+        Q_ASSERT_X(expected == Finished, "QCoroTask", "Destroying a task that is being awaited");
+        return false;
+    }
+
+    void rethrowPossibleException() const
+    {
+#ifndef QT_NO_EXCEPTIONS
+        if (m_exception)
+            std::rethrow_exception(m_exception);
+#endif
+    }
+
+private:
+    QPointer<QObject> m_context;
+    QObject *m_continuationContext = nullptr;
+    CancelFunction m_continuationCancel = nullptr;
+    std::coroutine_handle<> m_continuation;
+    std::exception_ptr m_exception;
+    std::atomic<int> m_state = Running;
+    bool m_canceled = false;
+};
+
+// Coroutines of other types than QCoroTask cannot be canceled, and are
+// resumed instead.
+template <typename Promise>
+constexpr QCoroPromiseBase::CancelFunction coroutineCancelFunction() noexcept
+{
+    if constexpr (std::is_base_of_v<QCoroPromiseBase, Promise>)
+        return &QCoroPromiseBase::cancel<Promise>;
+    else
+        return nullptr;
+}
+
+template <typename T>
+class QCoroPromise : public QCoroPromiseBase
+{
+public:
+    using QCoroPromiseBase::QCoroPromiseBase;
+
+    template <typename U = T>
+    void return_value(U &&value) { m_result.emplace(std::forward<U>(value)); }
+
+    T &result()
+    {
+        rethrowPossibleException();
+        Q_ASSERT(m_result);
+        return *m_result;
+    }
+
+private:
+    std::optional<T> m_result;
+};
+
+template <>
+class QCoroPromise<void> : public QCoroPromiseBase
+{
+public:
+    using QCoroPromiseBase::QCoroPromiseBase;
+
+    void return_void() noexcept { }
+    void result() { rethrowPossibleException(); }
+};
+
+#if QT_CONFIG(future)
+template <typename T>
+class QFutureAwaiter
+{
+public:
+    explicit QFutureAwaiter(const QFuture<T> &future) : m_future(future) { }
+    ~QFutureAwaiter()
+    {
+        if (m_contextGuard)
+            QObject::disconnect(m_contextGuard);
+    }
+
+    bool await_ready() const { return m_future.isFinished() && !isCanceled(m_future.d); }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        m_frame = handle.address();
+        m_cancel = coroutineCancelFunction<Promise>();
+        if (!m_future.isFinished()) {
+            m_context = coroutineContext(handle);
+            m_hasContext = m_context != nullptr;
+            if (m_context) {
+                m_contextGuard = QObject::connect(m_context, &QObject::destroyed,
+                                                  [this] { contextDestroyed(); });
+            }
+            // Once the continuation is installed, the coroutine can be resumed,
+            // and its frame destroyed, in another thread; so the future interface
+            // it's installed on must not be the one in this frame. The
+            // continuation only captures the awaiter, so that std::function
+            // stores it inline.
+            QFutureInterfaceBase future = m_future.d;
+            if (future.addContinuation([this](const QFutureInterfaceBase &f) { finished(f); }))
+                return true;
+            if (m_contextGuard)
+                QObject::disconnect(std::exchange(m_contextGuard, {}));
+        }
+        // A future that was canceled cancels the coroutine instead of resuming it.
+        if (!m_cancel || !isCanceled(m_future.d))
+            return false;
+        m_cancel(m_frame);
+        return true;
+    }
+
+    T await_resume()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        m_future.d.rethrowPossibleException();
+#endif
+        Q_ASSERT_X(!isCanceled(m_future.d), "QCoroTask", "Resumed by a canceled QFuture");
+        if constexpr (!std::is_void_v<T>) {
+            if constexpr (std::is_copy_constructible_v<T>)
+                return m_future.result();
+            else
+                return m_future.takeResult();
+        }
+    }
+
+private:
+    static bool isCanceled(const QFutureInterfaceBase &future)
+    {
+        return future.isCanceled() && !future.hasException();
+    }
+
+    // Called in the thread that finished the future.
+    void finished(const QFutureInterfaceBase &future)
+    {
+        void (*step)(void *) = m_cancel && isCanceled(future) ? m_cancel : resumeCoroutineFrame;
+        QMutexLocker locker(&m_mutex);
+        if (m_context) {
+            postCoroutineResume(m_context, step, m_frame);
+            m_posted = true;
+        } else if (!m_hasContext) {
+            locker.unlock();
+            step(m_frame);
+        } else if (m_cancel) {
+            // The owner of the coroutine is gone, so it is not resumed any more.
+            locker.unlock();
+            m_cancel(m_frame);
+        }
+    }
+
+    // Called in the thread of the context, while the coroutine is suspended.
+    void contextDestroyed()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_context = nullptr;
+        // The event posted to the context is discarded with it, so the
+        // coroutine ends here; otherwise it ends once the future is finished.
+        if (m_posted && m_cancel) {
+            locker.unlock();
+            m_cancel(m_frame);
+        }
+    }
+
+    QFuture<T> m_future;
+    QMutex m_mutex;
+    QObject *m_context = nullptr;
+    QMetaObject::Connection m_contextGuard;
+    void *m_frame = nullptr;
+    QCoroPromiseBase::CancelFunction m_cancel = nullptr;
+    bool m_hasContext = false;
+    bool m_posted = false;
+};
+#endif // QT_CONFIG(future)
+
+template <typename... Args>
+struct QSignalAwaiterResult
+{
+    using Type = std::tuple<std::decay_t<Args>...>;
+    static Type take(std::tuple<std::decay_t<Args>...> &&args) { return std::move(args); }
+};
+
+template <>
+struct QSignalAwaiterResult<>
+{
+    using Type = void;
+    static void take(std::tuple<> &&) { }
+};
+
+template <typename Arg>
+struct QSignalAwaiterResult<Arg>
+{
+    using Type = std::decay_t<Arg>;
+    static Type take(std::tuple<std::decay_t<Arg>> &&args) { return std::get<0>(std::move(args)); }
+};
+
+template <typename Signal, typename Arguments = typename FunctionPointer<Signal>::Arguments>
+class QSignalAwaiter;
+
+template <typename Signal, typename... Args>
+class QSignalAwaiter<Signal, List<Args...>>
+{
+    using Sender = typename FunctionPointer<Signal>::Object;
+    using Result = QSignalAwaiterResult<Args...>;
+
+public:
+    QSignalAwaiter(const Sender *sender, Signal signal) : m_sender(sender), m_signal(signal) { }
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        QObject *context = coroutineContext(handle);
+        // A direct connection stores the arguments right away; the coroutine
+        // is then resumed in its own thread.
+        QObject::connect(m_sender, m_signal, context ? context : m_sender,
+                         [this, handle, context](const std::decay_t<Args> &... args) {
+                             m_arguments.emplace(args...);
+                             resumeCoroutine(context, handle);
+                         },
+                         Qt::ConnectionType(Qt::DirectConnection | Qt::SingleShotConnection));
+    }
+
+    typename Result::Type await_resume()
+    {
+        Q_ASSERT(m_arguments);
+        return Result::take(std::move(*m_arguments));
+    }
+
+private:
+    const Sender *m_sender;
+    Signal m_signal;
+    std::optional<std::tuple<std::decay_t<Args>...>> m_arguments;
+};
+
+class QIODeviceAwaiter
+{
+public:
+    enum Mode { ReadyRead, BytesWritten };
+
+    QIODeviceAwaiter(QIODevice *device, Mode mode) : m_device(device), m_mode(mode) { }
+
+    bool await_ready()
+    {
+        if (m_mode == ReadyRead) {
+            m_result = m_device->bytesAvailable();
+            return m_result > 0 || !m_device->isReadable();
+        }
+        m_result = 0;
+        return m_device->bytesToWrite() == 0 || !m_device->isWritable();
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        m_handle = handle;
+        m_context = coroutineContext(handle);
+        QObject *receiver = m_context ? m_context : m_device;
+        const auto type = Qt::DirectConnection;
+        if (m_mode == ReadyRead) {
+            m_connections[0] = QObject::connect(m_device, &QIODevice::readyRead, receiver,
+                                                [this] { finish(m_device->bytesAvailable()); }, type);
+            m_connections[1] = QObject::connect(m_device, &QIODevice::readChannelFinished, receiver,
+                                                [this] { finish(m_device->bytesAvailable()); }, type);
+        } else {
+            m_connections[0] = QObject::connect(m_device, &QIODevice::bytesWritten, receiver,
+                                                [this](qint64 bytes) { finish(bytes); }, type);
+        }
+        m_connections[2] = QObject::connect(m_device, &QIODevice::aboutToClose, receiver,
+                                            [this] { finish(0); }, type);
+    }
+
+    qint64 await_resume() const noexcept { return m_result; }
+
+private:
+    void finish(qint64 result)
+    {
+        for (const QMetaObject::Connection &connection : m_connections)
+            QObject::disconnect(connection);
+        m_result = result;
+        resumeCoroutine(m_context, m_handle);
+    }
+
+    QIODevice *m_device;
+    QObject *m_context = nullptr;
+    std::coroutine_handle<> m_handle;
+    QMetaObject::Connection m_connections[3];
+    qint64 m_result = 0;
+    Mode m_mode;
+};
+
+} // namespace QtPrivate
+
+template <typename T>
+class QCoroTask
+{
+    Q_DISABLE_COPY(QCoroTask)
+public:
+    class promise_type : public QtPrivate::QCoroPromise<T>
+    {
+    public:
+        using QtPrivate::QCoroPromise<T>::QCoroPromise;
+
+        QCoroTask get_return_object() noexcept
+        {
+            return QCoroTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    QCoroTask(QCoroTask &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) { }
+    QCoroTask &operator=(QCoroTask &&other) noexcept
+    {
+        QCoroTask moved(std::move(other));
+        std::swap(m_handle, moved.m_handle);
+        return *this;
+    }
+    ~QCoroTask()
+    {
+        if (m_handle && !m_handle.promise().detach())
+            m_handle.destroy();
+    }
+
+    bool isFinished() const noexcept { return !m_handle || m_handle.promise().isFinished(); }
+    bool isCanceled() const noexcept { return isFinished() && m_handle && m_handle.promise().isCanceled(); }
+
+    decltype(auto) result() const
+    {
+        Q_ASSERT(isFinished());
+        Q_ASSERT(!isCanceled());
+        return m_handle.promise().result();
+    }
+
+    class Awaiter
+    {
+    public:
+        explicit Awaiter(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) { }
+
+        bool await_ready() const noexcept
+        {
+            return m_handle.promise().isFinished() && !m_handle.promise().isCanceled();
+        }
+
+        template <typename Promise>
+        bool await_suspend(std::coroutine_handle<Promise> awaiting) noexcept
+        {
+            const auto cancel = QtPrivate::coroutineCancelFunction<Promise>();
+            if (m_handle.promise().setContinuation(awaiting, QtPrivate::coroutineContext(awaiting),
+                                                   cancel)) {
+                return true;
+            }
+            // A canceled coroutine cancels the one that awaits it as well.
+            if (!cancel || !m_handle.promise().isCanceled())
+                return false;
+            cancel(awaiting.address());
+            return true;
+        }
+
+        decltype(auto) await_resume() const
+        {
+            if constexpr (std::is_void_v<T>)
+                m_handle.promise().result();
+            else
+                return std::move(m_handle.promise().result());
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    Awaiter operator co_await() const noexcept
+    {
+        Q_ASSERT(m_handle);
+        return Awaiter(m_handle);
+    }
+
+private:
+    explicit QCoroTask(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) { }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+#if QT_CONFIG(future)
+template <typename T>
+auto operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::QFutureAwaiter<T>(future);
+}
+#endif
+
+namespace QtCoro {
+
+template <typename Signal>
+auto signal(const typename QtPrivate::FunctionPointer<Signal>::Object *sender, Signal signal)
+{
+    Q_ASSERT(sender);
+    return QtPrivate::QSignalAwaiter<Signal>(sender, signal);
+}
+
+inline auto readyRead(QIODevice *device)
+{
+    Q_ASSERT(device);
+    return QtPrivate::QIODeviceAwaiter(device, QtPrivate::QIODeviceAwaiter::ReadyRead);
+}
+
+inline auto bytesWritten(QIODevice *device)
+{
+    Q_ASSERT(device);
+    return QtPrivate::QIODeviceAwaiter(device, QtPrivate::QIODeviceAwaiter::BytesWritten);
+}
+
+} // namespace QtCoro
+
+#endif // __cpp_impl_coroutine && __cpp_lib_coroutine
+
+QT_END_NAMESPACE
+
+#endif // QCOROTASK_H
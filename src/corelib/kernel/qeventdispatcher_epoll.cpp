@@ -0,0 +1,530 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+using namespace std::chrono;
+
+QT_BEGIN_NAMESPACE
+
+// The number of ready fds collected per call to epoll_wait(). Anything
+// beyond that stays ready (we are level-triggered) and is picked up by
+// the next iteration of the event loop.
+static constexpr int MaxEpollEvents = 256;
+
+static const char *socketType(QSocketNotifier::Type type)
+{
+    switch (type) {
+    case QSocketNotifier::Read:
+        return "Read";
+    case QSocketNotifier::Write:
+        return "Write";
+    case QSocketNotifier::Exception:
+        return "Exception";
+    }
+
+    Q_UNREACHABLE();
+}
+
+static quint32 epollEvents(const QSocketNotifierSetUNIX &sn_set) noexcept
+{
+    quint32 result = 0;
+
+    if (sn_set.notifiers[QSocketNotifier::Read])
+        result |= EPOLLIN;
+
+    if (sn_set.notifiers[QSocketNotifier::Write])
+        result |= EPOLLOUT;
+
+    if (sn_set.notifiers[QSocketNotifier::Exception])
+        result |= EPOLLPRI;
+
+    return result;
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+{
+    if (Q_UNLIKELY(threadPipe.init() == false))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot continue without a thread pipe");
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (Q_UNLIKELY(epollFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot create epoll instance: %s", qt_error_string().toLocal8Bit().constData());
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (Q_UNLIKELY(timerFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot create timerfd: %s", qt_error_string().toLocal8Bit().constData());
+
+    // both stay in the interest set for the lifetime of the dispatcher
+    for (int fd : { threadPipe.fds[0], timerFd }) {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (Q_UNLIKELY(epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == -1))
+            qFatal("QEventDispatcherEpollPrivate(): Cannot add fd %d to the epoll set: %s",
+                   fd, qt_error_string().toLocal8Bit().constData());
+    }
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    if (timerFd >= 0)
+        qt_safe_close(timerFd);
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+}
+
+void QEventDispatcherEpollPrivate::updateSocketInterest(int fd, const QSocketNotifierSetUNIX &sn_set,
+                                                        bool wasRegistered)
+{
+    epoll_event ev = {};
+    ev.events = epollEvents(sn_set);
+    ev.data.fd = fd;
+
+    const int op = sn_set.isEmpty() ? EPOLL_CTL_DEL
+                                    : wasRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+
+    auto control = [&](int op) {
+        if (epoll_ctl(epollFd, op, fd, &ev) == -1)
+            return false;
+        if (!nonPollableFds.isEmpty())
+            nonPollableFds.removeOne(fd);
+        return true;
+    };
+
+    if (control(op))
+        return;
+
+    switch (errno) {
+    case ENOENT:
+        // The fd was closed (and possibly reused) without unregistering its
+        // notifiers first, so the kernel already dropped the registration.
+        if (op == EPOLL_CTL_DEL || control(EPOLL_CTL_ADD))
+            return;
+        break;
+    case EEXIST:
+        // A dup() of a closed fd kept its old registration alive.
+        if (control(EPOLL_CTL_MOD))
+            return;
+        break;
+    case EPERM:
+        // epoll refuses regular files and directories, which poll() reports
+        // as always readable and writable. Emulate that.
+        if (op == EPOLL_CTL_DEL)
+            nonPollableFds.removeOne(fd);
+        else if (!nonPollableFds.contains(fd))
+            nonPollableFds.append(fd);
+        return;
+    case EBADF:
+        if (op == EPOLL_CTL_DEL)
+            return; // already closed, nothing to clean up
+        qWarning("QSocketNotifier: Invalid socket %d", fd);
+        return;
+    default:
+        break;
+    }
+
+    qErrnoWarning("QEventDispatcherEpoll: epoll_ctl failed for socket %d", fd);
+}
+
+void QEventDispatcherEpollPrivate::armTimerFd(steady_clock::time_point deadline)
+{
+    // Rearming is a syscall, so skip it if the timerfd is already set to
+    // fire at the right time.
+    if (deadline == timerFdDeadline)
+        return;
+
+    // steady_clock is CLOCK_MONOTONIC on Linux, the clock timerFd uses
+    itimerspec spec = {};
+    spec.it_value = durationToTimespec(deadline.time_since_epoch());
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+        qErrnoWarning("QEventDispatcherEpoll: timerfd_settime failed");
+        return;
+    }
+    timerFdDeadline = deadline;
+}
+
+void QEventDispatcherEpollPrivate::consumeTimerFd()
+{
+    quint64 expirations;
+    [[maybe_unused]] ssize_t ret = ::read(timerFd, &expirations, sizeof(expirations));
+    timerFdDeadline = steady_clock::time_point::max();
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+
+    if (pendingNotifiers.contains(notifier))
+        return;
+
+    pendingNotifiers << notifier;
+}
+
+void QEventDispatcherEpollPrivate::markPendingSocketNotifier(int fd, quint32 revents)
+{
+    auto it = socketNotifiers.constFind(fd);
+    if (it == socketNotifiers.cend())
+        return; // stale registration of an fd that was closed behind our back
+
+    const QSocketNotifierSetUNIX &sn_set = it.value();
+
+    static const struct {
+        QSocketNotifier::Type type;
+        quint32 flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      EPOLLIN  | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+        if (notifier && (revents & n.flags))
+            setSocketNotifierPending(notifier);
+    }
+}
+
+void QEventDispatcherEpollPrivate::markNonPollableSocketNotifiers()
+{
+    for (int fd : std::as_const(nonPollableFds))
+        markPendingSocketNotifier(fd, EPOLLIN | EPOLLOUT);
+}
+
+int QEventDispatcherEpollPrivate::waitForEvents(bool includeNotifiers, bool block)
+{
+    if (!includeNotifiers) {
+        // The socket notifiers stay in the epoll set, so bypass it and only
+        // wait for wake-ups and timers.
+        pollfd pfds[] = { threadPipe.prepare(), qt_make_pollfd(timerFd, POLLIN) };
+        const timespec zero = { 0, 0 };
+        switch (qt_safe_poll(pfds, 2, block ? nullptr : &zero)) {
+        case -1:
+            qErrnoWarning("qt_safe_poll");
+            if (QT_CONFIG(poll_exit_on_error))
+                abort();
+            return 0;
+        case 0:
+            return 0;
+        default:
+            if (pfds[1].revents & POLLIN)
+                consumeTimerFd();
+            return threadPipe.check(pfds[0]);
+        }
+    }
+
+    epoll_event events[MaxEpollEvents];
+    const int count = epoll_wait(epollFd, events, MaxEpollEvents, block ? -1 : 0);
+    if (count == -1) {
+        if (errno != EINTR) {
+            qErrnoWarning("epoll_wait");
+            if (QT_CONFIG(poll_exit_on_error))
+                abort();
+        }
+        return 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < count; ++i) {
+        const int fd = events[i].data.fd;
+        if (fd == threadPipe.fds[0]) {
+            pollfd pfd = threadPipe.prepare();
+            pfd.revents = POLLIN;
+            nevents += threadPipe.check(pfd);
+        } else if (fd == timerFd) {
+            consumeTimerFd();
+        } else {
+            markPendingSocketNotifier(fd, events[i].events);
+        }
+    }
+    return nevents;
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    int n_activated = 0;
+    QEvent event(QEvent::SockAct);
+
+    while (!pendingNotifiers.isEmpty()) {
+        QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        QCoreApplication::sendEvent(notifier, &event);
+        ++n_activated;
+    }
+
+    return n_activated;
+}
+
+int QEventDispatcherEpollPrivate::activateTimers()
+{
+    return timerList.activateTimers();
+}
+
+/*!
+    \internal
+    \class QEventDispatcherEpoll
+
+    An event dispatcher for Linux that keeps the set of watched file
+    descriptors in an epoll instance instead of rebuilding a pollfd array on
+    every iteration. Registering and unregistering a socket notifier is a
+    single epoll_ctl() call, and waking up only touches the descriptors that
+    are ready. The thread pipe and a timerfd armed for the next timer are
+    part of the same epoll set.
+
+    It is used instead of QEventDispatcherUNIX (and QEventDispatcherGlib)
+    when the QT_EVENT_DISPATCHER_EPOLL environment variable is set to a
+    positive value.
+*/
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+/*!
+    \internal
+*/
+void QEventDispatcherEpoll::registerTimer(int timerId, qint64 interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::registerTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, milliseconds{ interval }, timerType, obj);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    auto it = d->socketNotifiers.find(sockfd);
+    const bool wasRegistered = it != d->socketNotifiers.end();
+    if (!wasRegistered)
+        it = d->socketNotifiers.insert(sockfd, QSocketNotifierSetUNIX());
+
+    QSocketNotifierSetUNIX &sn_set = it.value();
+
+    if (sn_set.notifiers[type] == notifier)
+        return;
+
+    if (sn_set.notifiers[type])
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+
+    sn_set.notifiers[type] = notifier;
+    d->updateSocketInterest(sockfd, sn_set, wasRegistered);
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifier (fd %d) cannot be disabled from another thread.\n"
+                "(Notifier's thread is %s(%p), event dispatcher's thread is %s(%p), current thread is %s(%p))",
+                sockfd,
+                notifier->thread() ? notifier->thread()->metaObject()->className() : "QThread", notifier->thread(),
+                thread() ? thread()->metaObject()->className() : "QThread", thread(),
+                QThread::currentThread() ? QThread::currentThread()->metaObject()->className() : "QThread", QThread::currentThread());
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+
+    d->pendingNotifiers.removeOne(notifier);
+
+    auto i = d->socketNotifiers.find(sockfd);
+    if (i == d->socketNotifiers.end())
+        return;
+
+    QSocketNotifierSetUNIX &sn_set = i.value();
+
+    if (sn_set.notifiers[type] == nullptr)
+        return;
+
+    if (sn_set.notifiers[type] != notifier) {
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+        return;
+    }
+
+    sn_set.notifiers[type] = nullptr;
+    d->updateSocketInterest(sockfd, sn_set, true);
+
+    if (sn_set.isEmpty())
+        d->socketNotifiers.erase(i);
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(0);
+
+    // we are awake, broadcast it
+    emit awake();
+
+    auto threadData = d->threadData.loadRelaxed();
+    QCoreApplicationPrivate::sendPostedEvents(nullptr, 0, threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool include_notifiers = (flags & QEventLoop::ExcludeSocketNotifiers) == 0;
+    const bool wait_for_events = (flags & QEventLoop::WaitForMoreEvents) != 0;
+
+    const bool canWait = (threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    bool block = canWait;
+
+    if (include_timers) {
+        if (const auto timeout = d->timerList.nextTimerTimeout()) {
+            if (*timeout <= steady_clock::now())
+                block = false;
+            else if (block)
+                d->armTimerFd(*timeout);
+        }
+    }
+
+    if (include_notifiers && !d->nonPollableFds.isEmpty()) {
+        d->markNonPollableSocketNotifiers();
+        block = false;
+    }
+
+    int nevents = d->waitForEvents(include_notifiers, block);
+
+    if (include_notifiers)
+        nevents += d->activateSocketNotifiers();
+
+    if (include_timers)
+        nevents += d->activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->threadPipe.wakeUp();
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(1);
+    wakeUp();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
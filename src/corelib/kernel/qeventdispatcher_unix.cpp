@@ -192,11 +192,7 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
 }
 
-QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
-{
-    // cleanup timers
-    qDeleteAll(timerList);
-}
+QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate() = default;
 
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
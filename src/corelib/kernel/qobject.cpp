@@ -1673,6 +1673,30 @@ void QObject::moveToThread(QThread *targetThread)
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+    // Events posted without locking currentData (see
+    // QCoreApplicationPrivate::postEventWithoutLocking()) are newer than
+    // those moved above. Wait for the threads that may still be adding one
+    // for the objects we just moved, then sort them out.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (currentData->postEventList.incomingPosters.load() != 0)
+        QThread::yieldCurrentThread();
+    int eventsMoved = 0;
+    QPostEventList::IncomingEvent *node = currentData->postEventList.takeIncoming();
+    while (node) {
+        const QPostEvent &pe = node->event;
+        if (QObjectPrivate::get(pe.receiver)->threadData.loadRelaxed() == targetData) {
+            targetData->postEventList.addEvent(pe);
+            ++eventsMoved;
+        } else {
+            currentData->postEventList.addEvent(pe);
+        }
+        delete std::exchange(node, node->next);
+    }
+    if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
+        targetData->canWait = false;
+        targetData->eventDispatcher.loadRelaxed()->wakeUp();
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -10,6 +10,9 @@
 #include "private/qobject_p.h"
 #include "private/qabstracteventdispatcher_p.h"
 
+#include <qhash.h>
+#include <qvarlengtharray.h>
+
 #include <sys/times.h>
 
 using namespace std::chrono;
@@ -25,7 +28,90 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
  * timerBitVec array is used for keeping track of timer identifiers.
  */
 
-QTimerInfoList::QTimerInfoList() = default;
+namespace {
+struct QTimerWheelEntry : QTimerInfo
+{
+    QTimerWheelEntry *next = nullptr;
+    // the pointer that points to this entry, or nullptr if it isn't in a list
+    QTimerWheelEntry **pprev = nullptr;
+    // orders timers with the same timeout by when they were (re)scheduled
+    quint64 sequence = 0;
+    qint8 level = -1;
+    quint8 slot = 0;
+};
+} // unnamed namespace
+
+static qint64 toTick(steady_clock::time_point timePoint)
+{
+    return floor<milliseconds>(timePoint.time_since_epoch()).count();
+}
+
+static bool firesEarlier(const QTimerWheelEntry *t1, const QTimerWheelEntry *t2)
+{
+    if (t1->timeout != t2->timeout)
+        return t1->timeout < t2->timeout;
+    return t1->sequence < t2->sequence;
+}
+
+/*
+    A hierarchical timing wheel with a resolution of one millisecond.
+
+    Level L has SlotsPerLevel slots that cover 64^L milliseconds each. A
+    timer is kept in the lowest level that can hold it relative to
+    currentTick: the one that corresponds to the highest group of bits in
+    which its tick differs from currentTick. All the timers in a slot at
+    level 0 therefore expire in the same millisecond. When the wheel reaches
+    a slot at a higher level, its timers are moved ("cascaded") to the lower
+    levels, so each timer is touched at most Levels times no matter how many
+    other timers there are. Registering and unregistering a timer is a
+    constant-time operation.
+
+    Each slot remembers the earliest timeout that was put into it. That's
+    exact at level 0 and a lower bound after a timer was removed, which at
+    worst wakes the event loop up early once.
+*/
+class QTimerWheel
+{
+    Q_DISABLE_COPY_MOVE(QTimerWheel)
+public:
+    explicit QTimerWheel(steady_clock::time_point now) : currentTick(toTick(now)) { }
+    ~QTimerWheel() { qDeleteAll(timers); }
+
+    qsizetype count() const { return timers.size(); }
+    QTimerWheelEntry *find(int timerId) const { return timers.value(timerId); }
+
+    void add(QTimerWheelEntry *t);
+    void remove(QTimerWheelEntry *t);
+    void removeTimers(QObject *object);
+    QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
+
+    std::optional<steady_clock::time_point> nextTimeout() const;
+    int activateTimers(steady_clock::time_point now);
+
+private:
+    static constexpr int BitsPerLevel = 6;
+    static constexpr int SlotsPerLevel = 1 << BitsPerLevel;
+    // enough for any non-negative 64-bit tick
+    static constexpr int Levels = (63 + BitsPerLevel - 1) / BitsPerLevel;
+
+    static void link(QTimerWheelEntry **head, QTimerWheelEntry *t);
+    void unlink(QTimerWheelEntry *t);
+    void schedule(QTimerWheelEntry *t);
+    void place(QTimerWheelEntry *t);
+    void cascade(int level, int slot);
+    int firstSlot(int level) const;
+    qint64 slotStart(int level, int slot) const;
+
+    QHash<int, QTimerWheelEntry *> timers;
+    QMultiHash<QObject *, QTimerWheelEntry *> timersByObject;
+    // expired timers that activateTimers() hasn't gotten to yet, in order
+    QTimerWheelEntry *dueTimers = nullptr;
+    QTimerWheelEntry *buckets[Levels][SlotsPerLevel] = {};
+    steady_clock::time_point slotTimeout[Levels][SlotsPerLevel];
+    quint64 occupied[Levels] = {};
+    qint64 currentTick;
+    quint64 nextSequence = 0;
+};
 
 steady_clock::time_point QTimerInfoList::updateCurrentTime()
 {
@@ -43,7 +129,11 @@ bool QTimerInfoList::hasPendingTimers()
 {
     if (isEmpty())
         return false;
-    return updateCurrentTime() < constFirst()->timeout;
+    if (wheel) {
+        const std::optional<steady_clock::time_point> timeout = wheel->nextTimeout();
+        return timeout && updateCurrentTime() < *timeout;
+    }
+    return updateCurrentTime() < timers.constFirst()->timeout;
 }
 
 /*
@@ -51,13 +141,13 @@ bool QTimerInfoList::hasPendingTimers()
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
+    int index = timers.size();
     while (index--) {
-        const QTimerInfo * const t = at(index);
+        const QTimerInfo * const t = timers.at(index);
         if (!(ti->timeout < t->timeout))
             break;
     }
-    insert(index+1, ti);
+    timers.insert(index+1, ti);
 }
 
 static constexpr milliseconds roundToMillisecond(nanoseconds val)
@@ -232,18 +322,295 @@ static void calculateNextTimeout(QTimerInfo *t, steady_clock::time_point now)
     }
 }
 
-bool QTimerInfoList::timerWait(timespec &tm)
+void QTimerWheel::link(QTimerWheelEntry **head, QTimerWheelEntry *t)
 {
-    steady_clock::time_point now = updateCurrentTime();
+    Q_ASSERT(!t->pprev);
+    t->next = *head;
+    if (t->next)
+        t->next->pprev = &t->next;
+    *head = t;
+    t->pprev = head;
+}
+
+void QTimerWheel::unlink(QTimerWheelEntry *t)
+{
+    if (!t->pprev)
+        return;
+    *t->pprev = t->next;
+    if (t->next)
+        t->next->pprev = t->pprev;
+    t->next = nullptr;
+    t->pprev = nullptr;
+    if (t->level >= 0) {
+        if (!buckets[t->level][t->slot])
+            occupied[t->level] &= ~(quint64(1) << t->slot);
+        t->level = -1;
+    }
+}
+
+// (Re)schedules a timer whose timeout was just calculated.
+void QTimerWheel::schedule(QTimerWheelEntry *t)
+{
+    t->sequence = nextSequence++;
+    place(t);
+}
+
+void QTimerWheel::place(QTimerWheelEntry *t)
+{
+    // overdue timers go to the current slot
+    const qint64 tick = qMax(toTick(t->timeout), currentTick);
+    const quint64 difference = quint64(tick ^ currentTick);
+    const int level = difference ? (63 - qCountLeadingZeroBits(difference)) / BitsPerLevel : 0;
+    const int slot = int(quint64(tick) >> (level * BitsPerLevel)) & (SlotsPerLevel - 1);
+
+    QTimerWheelEntry *&head = buckets[level][slot];
+    if (!head) {
+        occupied[level] |= quint64(1) << slot;
+        slotTimeout[level][slot] = t->timeout;
+    } else if (t->timeout < slotTimeout[level][slot]) {
+        slotTimeout[level][slot] = t->timeout;
+    }
+    link(&head, t);
+    t->level = qint8(level);
+    t->slot = quint8(slot);
+}
+
+void QTimerWheel::cascade(int level, int slot)
+{
+    QTimerWheelEntry *t = std::exchange(buckets[level][slot], nullptr);
+    occupied[level] &= ~(quint64(1) << slot);
+    while (t) {
+        QTimerWheelEntry *next = t->next;
+        t->next = nullptr;
+        t->pprev = nullptr;
+        place(t);
+        Q_ASSERT(t->level < level);
+        t = next;
+    }
+}
+
+// Returns the first occupied slot at \a level that the wheel hasn't passed
+// yet, or -1 if there is none.
+int QTimerWheel::firstSlot(int level) const
+{
+    const int current = int(quint64(currentTick) >> (level * BitsPerLevel)) & (SlotsPerLevel - 1);
+    const quint64 pending = occupied[level] & (~quint64(0) << current);
+    return pending ? qCountTrailingZeroBits(pending) : -1;
+}
+
+// Returns the first tick covered by \a slot at \a level in the current
+// round of that level.
+qint64 QTimerWheel::slotStart(int level, int slot) const
+{
+    const int shift = level * BitsPerLevel;
+    const int roundShift = shift + BitsPerLevel;
+    const quint64 round = roundShift < 64 ? (quint64(currentTick) >> roundShift) << roundShift : 0;
+    return qint64(round | (quint64(slot) << shift));
+}
+
+void QTimerWheel::add(QTimerWheelEntry *t)
+{
+    timers.insert(t->id, t);
+    timersByObject.insert(t->obj, t);
+    schedule(t);
+}
+
+void QTimerWheel::remove(QTimerWheelEntry *t)
+{
+    unlink(t);
+    timers.remove(t->id);
+    timersByObject.remove(t->obj, t);
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+}
+
+void QTimerWheel::removeTimers(QObject *object)
+{
+    const QList<QTimerWheelEntry *> objectTimers = timersByObject.values(object);
+    for (QTimerWheelEntry *t : objectTimers)
+        remove(t);
+}
+
+QList<QAbstractEventDispatcher::TimerInfo> QTimerWheel::registeredTimers(QObject *object) const
+{
+    // in the order they fire, like the sorted list
+    QList<QTimerWheelEntry *> objectTimers = timersByObject.values(object);
+    std::sort(objectTimers.begin(), objectTimers.end(), firesEarlier);
+
+    QList<QAbstractEventDispatcher::TimerInfo> list;
+    list.reserve(objectTimers.size());
+    for (const QTimerWheelEntry *t : std::as_const(objectTimers))
+        list.emplaceBack(t->id, t->interval.count(), t->timerType);
+    return list;
+}
+
+/*
+    Returns the earliest timeout of the timers that are waiting, including
+    those that expired but weren't activated yet. Timers that are being
+    activated aren't in the wheel.
+*/
+std::optional<steady_clock::time_point> QTimerWheel::nextTimeout() const
+{
+    if (dueTimers)
+        return dueTimers->timeout;
+
+    std::optional<steady_clock::time_point> timeout;
+    for (int level = 0; level < Levels; ++level) {
+        const int slot = firstSlot(level);
+        if (slot >= 0 && (!timeout || slotTimeout[level][slot] < *timeout))
+            timeout = slotTimeout[level][slot];
+    }
+    return timeout;
+}
+
+int QTimerWheel::activateTimers(steady_clock::time_point now)
+{
+    const qint64 nowTick = toTick(now);
+    QVarLengthArray<QTimerWheelEntry *, 64> expired;
+
+    // Advance the wheel to now, one occupied slot at a time. A slot above
+    // level 0 is due once the wheel is in its range and its earliest timeout
+    // was reached; on ties, cascade first so that timers expiring in the
+    // same millisecond end up in the same slot at level 0.
+    for (;;) {
+        int dueLevel = -1;
+        int dueSlot = -1;
+        qint64 dueTick = 0;
+        for (int level = Levels - 1; level >= 0; --level) {
+            const int slot = firstSlot(level);
+            if (slot < 0)
+                continue;
+            qint64 tick = slotStart(level, slot);
+            if (level > 0)
+                tick = qMax(tick, toTick(slotTimeout[level][slot]));
+            if (dueLevel < 0 || tick < dueTick) {
+                dueLevel = level;
+                dueSlot = slot;
+                dueTick = tick;
+            }
+        }
+        if (dueLevel < 0 || dueTick > nowTick)
+            break;
+
+        currentTick = qMax(currentTick, dueTick);
+        if (dueLevel > 0) {
+            cascade(dueLevel, dueSlot);
+            continue;
+        }
+
+        // All the timers at level 0 expire in this millisecond (or are
+        // overdue), but only those up to now are due.
+        auto timeout = steady_clock::time_point::max();
+        QTimerWheelEntry *t = buckets[0][dueSlot];
+        while (t) {
+            QTimerWheelEntry *next = t->next;
+            if (t->timeout <= now) {
+                unlink(t);
+                expired.append(t);
+            } else {
+                timeout = qMin(timeout, t->timeout);
+            }
+            t = next;
+        }
+        if (buckets[0][dueSlot]) {
+            slotTimeout[0][dueSlot] = timeout;
+            break;
+        }
+    }
+    currentTick = qMax(currentTick, nowTick);
+
+    if (expired.isEmpty() && !dueTimers)
+        return 0;
+
+    // Fire in the same order as the sorted list does. The expired timers
+    // are kept in a list until they are activated, so that unregistering
+    // one removes it from there, and so that a nested event loop started
+    // by one of them activates the others. That nested loop may already
+    // have expired more timers.
+    while (QTimerWheelEntry *t = dueTimers) {
+        unlink(t);
+        expired.append(t);
+    }
+    std::sort(expired.begin(), expired.end(), firesEarlier);
+    for (auto it = expired.crbegin(); it != expired.crend(); ++it)
+        link(&dueTimers, *it);
+
+    int n_act = 0;
+    while (QTimerWheelEntry *t = dueTimers) {
+        unlink(t);
+        calculateNextTimeout(t, now);
+        if (t->interval > 0ms)
+            n_act++;
+
+        // The timer stays out of the wheel while its event is delivered, so
+        // that nested event loops neither fire it nor wait for it.
+        QTimerInfo *currentTimerInfo = t;
+        t->activateRef = &currentTimerInfo;
+        QTimerEvent e(t->id);
+        QCoreApplication::sendEvent(t->obj, &e);
+
+        // currentTimerInfo is cleared if the timer was unregistered
+        if (currentTimerInfo) {
+            t->activateRef = nullptr;
+            schedule(t);
+        }
+    }
+    return n_act;
+}
+
+QTimerInfoList::QTimerInfoList()
+    : QTimerInfoList(qEnvironmentVariableIntValue("QT_TIMER_WHEEL") > 0 ? TimerWheel : SortedList)
+{
+}
+
+QTimerInfoList::QTimerInfoList(Storage storage)
+{
+    if (storage == TimerWheel)
+        wheel = std::make_unique<QTimerWheel>(updateCurrentTime());
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
+}
+
+bool QTimerInfoList::isEmpty() const
+{
+    return wheel ? wheel->count() == 0 : timers.isEmpty();
+}
+
+qsizetype QTimerInfoList::size() const
+{
+    return wheel ? wheel->count() : timers.size();
+}
+
+/*! \internal
+    Returns the timeout of the first timer that is not currently being
+    activated, or std::nullopt if there is no such timer.
+*/
+std::optional<steady_clock::time_point> QTimerInfoList::nextTimerTimeout() const
+{
+    if (wheel)
+        return wheel->nextTimeout();
 
     auto isWaiting = [](QTimerInfo *tinfo) { return !tinfo->activateRef; };
     // Find first waiting timer not already active
-    auto it = std::find_if(cbegin(), cend(), isWaiting);
-    if (it == cend())
+    auto it = std::find_if(timers.cbegin(), timers.cend(), isWaiting);
+    if (it == timers.cend())
+        return std::nullopt;
+    return (*it)->timeout;
+}
+
+bool QTimerInfoList::timerWait(timespec &tm)
+{
+    steady_clock::time_point now = updateCurrentTime();
+
+    const std::optional<steady_clock::time_point> timeout = nextTimerTimeout();
+    if (!timeout)
         return false;
 
-    QTimerInfo *t = *it;
-    nanoseconds timeToWait = t->timeout - now;
+    nanoseconds timeToWait = *timeout - now;
     if (timeToWait > 0ns)
         tm = durationToTimespec(roundToMillisecond(timeToWait));
     else
@@ -266,15 +633,19 @@ milliseconds QTimerInfoList::remainingDuration(int timerId)
 {
     const steady_clock::time_point now = updateCurrentTime();
 
-    auto it = findTimerById(timerId);
-    if (it == cend()) {
+    const QTimerInfo *t = nullptr;
+    if (wheel) {
+        t = wheel->find(timerId);
+    } else if (auto it = findTimerById(timerId); it != timers.cend()) {
+        t = *it;
+    }
+    if (!t) {
 #ifndef QT_NO_DEBUG
         qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", timerId);
 #endif
         return -1ms;
     }
 
-    const QTimerInfo *t = *it;
     if (now < t->timeout) // time to wait
         return roundToMillisecond(t->timeout - now);
     return 0ms;
@@ -288,7 +659,7 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 void QTimerInfoList::registerTimer(int timerId, milliseconds interval,
                                    Qt::TimerType timerType, QObject *object)
 {
-    QTimerInfo *t = new QTimerInfo;
+    QTimerInfo *t = wheel ? new QTimerWheelEntry : new QTimerInfo;
     t->id = timerId;
     t->interval = interval;
     t->timerType = timerType;
@@ -331,13 +702,24 @@ void QTimerInfoList::registerTimer(int timerId, milliseconds interval,
             t->timeout += 1s;
     }
 
-    timerInsert(t);
+    if (wheel)
+        wheel->add(static_cast<QTimerWheelEntry *>(t));
+    else
+        timerInsert(t);
 }
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
+    if (wheel) {
+        QTimerWheelEntry *t = wheel->find(timerId);
+        if (!t)
+            return false; // id not found
+        wheel->remove(t);
+        return true;
+    }
+
     auto it = findTimerById(timerId);
-    if (it == cend())
+    if (it == timers.cend())
         return false; // id not found
 
     // set timer inactive
@@ -347,7 +729,7 @@ bool QTimerInfoList::unregisterTimer(int timerId)
     if (t->activateRef)
         *(t->activateRef) = nullptr;
     delete t;
-    erase(it);
+    timers.erase(it);
     return true;
 }
 
@@ -355,11 +737,15 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    if (wheel) {
+        wheel->removeTimers(object);
+        return true;
+    }
+    for (int i = 0; i < timers.size(); ++i) {
+        QTimerInfo *t = timers.at(i);
         if (t->obj == object) {
             // object found
-            removeAt(i);
+            timers.removeAt(i);
             if (t == firstTimerInfo)
                 firstTimerInfo = nullptr;
             if (t->activateRef)
@@ -374,8 +760,11 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
+    if (wheel)
+        return wheel->registeredTimers(object);
+
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (const QTimerInfo *const t : std::as_const(*this)) {
+    for (const QTimerInfo *const t : std::as_const(timers)) {
         if (t->obj == object)
             list.emplaceBack(t->id, t->interval.count(), t->timerType);
     }
@@ -390,6 +779,9 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
+    if (wheel)
+        return wheel->activateTimers(updateCurrentTime());
+
     firstTimerInfo = nullptr;
 
     const steady_clock::time_point now = updateCurrentTime();
@@ -397,16 +789,16 @@ int QTimerInfoList::activateTimers()
     // Find out how many timer have expired
     auto stillActive = [&now](const QTimerInfo *t) { return now < t->timeout; };
     // Find first one still active (list is sorted by timeout)
-    auto it = std::find_if(cbegin(), cend(), stillActive);
-    auto maxCount = it - cbegin();
+    auto it = std::find_if(timers.cbegin(), timers.cend(), stillActive);
+    auto maxCount = it - timers.cbegin();
 
     int n_act = 0;
     //fire the timers.
     while (maxCount--) {
-        if (isEmpty())
+        if (timers.isEmpty())
             break;
 
-        QTimerInfo *currentTimerInfo = constFirst();
+        QTimerInfo *currentTimerInfo = timers.constFirst();
         if (now < currentTimerInfo->timeout)
             break; // no timer has expired
 
@@ -421,7 +813,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        timers.removeFirst();
 
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, now);
@@ -21,6 +21,8 @@
 
 #include <sys/time.h> // struct timespec
 #include <chrono>
+#include <memory>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -34,17 +36,34 @@ struct QTimerInfo {
     QTimerInfo **activateRef; // - ref from activateTimers
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+class QTimerWheel;
+
+class Q_CORE_EXPORT QTimerInfoList
 {
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo = nullptr;
 
 public:
+    // How the timers are kept. The sorted list is the default; the timer
+    // wheel (selected with QT_TIMER_WHEEL=1) registers, unregisters and
+    // expires timers in constant time, for threads with very many timers.
+    enum Storage {
+        SortedList,
+        TimerWheel
+    };
+
     QTimerInfoList();
+    explicit QTimerInfoList(Storage storage);
+    ~QTimerInfoList();
+
+    Storage storage() const { return wheel ? TimerWheel : SortedList; }
+    bool isEmpty() const;
+    qsizetype size() const;
 
     std::chrono::steady_clock::time_point currentTime;
 
     bool timerWait(timespec &);
+    std::optional<std::chrono::steady_clock::time_point> nextTimerTimeout() const;
     void timerInsert(QTimerInfo *);
 
     qint64 timerRemainingTime(int timerId);
@@ -60,14 +79,18 @@ public:
     int activateTimers();
     bool hasPendingTimers();
 
-    QList::const_iterator findTimerById(int timerId) const
+private:
+    QList<QTimerInfo *>::const_iterator findTimerById(int timerId) const
     {
         auto matchesId = [timerId](const QTimerInfo *t) { return t->id == timerId; };
-        return std::find_if(cbegin(), cend(), matchesId);
+        return std::find_if(timers.cbegin(), timers.cend(), matchesId);
     }
 
-private:
     std::chrono::steady_clock::time_point updateCurrentTime();
+
+    // the timers sorted by timeout; always empty when the wheel is used
+    QList<QTimerInfo *> timers;
+    std::unique_ptr<QTimerWheel> wheel;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,803 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcborvalueview.h"
+
+#include <qendian.h>
+#include <qfloat16.h>
+#include <private/qstringconverter_p.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// the same limit as for QCborValue::fromCbor()
+constexpr int MaximumRecursionDepth = 1024;
+
+enum MajorType : quint8 {
+    UnsignedIntegerType = 0,
+    NegativeIntegerType,
+    ByteStringType,
+    TextStringType,
+    ArrayType,
+    MapType,
+    TagType,
+    SimpleTypesType
+};
+
+enum : quint8 {
+    Value8Bit = 24,
+    Value16Bit = 25,
+    Value32Bit = 26,
+    Value64Bit = 27,
+    IndefiniteLength = 31,
+    BreakByte = 0xff
+};
+
+struct Head
+{
+    MajorType majorType;
+    quint8 info;                // the additional information
+    quint64 value;              // the argument
+    const uchar *next;          // the byte after the head
+
+    bool isIndefinite() const { return info == IndefiniteLength; }
+};
+
+// Decodes the initial byte and the argument of an item that was validated.
+inline Head decodeHead(const uchar *p) noexcept
+{
+    Head h;
+    h.majorType = MajorType(*p >> 5);
+    h.info = *p & 0x1f;
+    ++p;
+    switch (h.info) {
+    case Value8Bit:
+        h.value = *p;
+        p += 1;
+        break;
+    case Value16Bit:
+        h.value = qFromBigEndian<quint16>(p);
+        p += 2;
+        break;
+    case Value32Bit:
+        h.value = qFromBigEndian<quint32>(p);
+        p += 4;
+        break;
+    case Value64Bit:
+        h.value = qFromBigEndian<quint64>(p);
+        p += 8;
+        break;
+    default:
+        h.value = h.info < Value8Bit ? h.info : 0;
+        break;
+    }
+    h.next = p;
+    return h;
+}
+
+// Returns the byte after the item at \a p, which was validated.
+const uchar *skipItem(const uchar *p) noexcept
+{
+    const Head h = decodeHead(p);
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+    case SimpleTypesType:
+        return h.next;
+    case TagType:
+        return skipItem(h.next);
+    case ByteStringType:
+    case TextStringType:
+        if (!h.isIndefinite())
+            return h.next + h.value;
+        break;
+    case ArrayType:
+    case MapType:
+        if (!h.isIndefinite()) {
+            p = h.next;
+            for (quint64 n = h.majorType == MapType ? 2 * h.value : h.value; n; --n)
+                p = skipItem(p);
+            return p;
+        }
+        break;
+    }
+
+    // the chunks of a string, or the items of a container, up to the break
+    p = h.next;
+    while (*p != BreakByte)
+        p = skipItem(p);
+    return p + 1;
+}
+
+bool isOutOfIntegerRange(const Head &h) noexcept
+{
+    return h.value > quint64(std::numeric_limits<qint64>::max());
+}
+
+template <typename Float>
+double decodeFloat(const uchar *p) noexcept
+{
+    using UInt = std::conditional_t<sizeof(Float) == 2, quint16,
+                 std::conditional_t<sizeof(Float) == 4, quint32, quint64>>;
+    const UInt bits = qFromBigEndian<UInt>(p);
+    Float f;
+    memcpy(static_cast<void *>(&f), &bits, sizeof(f));
+    return double(f);
+}
+
+// Checks that the item at the start of the data is well-formed, like
+// QCborValue::fromCbor() does.
+class Validator
+{
+public:
+    Validator(const uchar *begin, const uchar *end) : end(end), errorPos(begin) {}
+
+    bool validate(const uchar *&p, int remainingDepth);
+
+    const uchar *const end;
+    const uchar *errorPos;
+    QCborError error = { QCborError::NoError };
+
+private:
+    bool fail(const uchar *p, QCborError::Code code)
+    {
+        error = { code };
+        errorPos = p;
+        return false;
+    }
+    bool readHead(const uchar *p, Head *h);
+    bool validateString(const uchar *&p, const Head &h);
+};
+
+bool Validator::readHead(const uchar *p, Head *h)
+{
+    if (p == end)
+        return fail(p, QCborError::EndOfFile);
+    const quint8 info = *p & 0x1f;
+    if (info > Value64Bit && info != IndefiniteLength)
+        return fail(p, (*p >> 5) == SimpleTypesType ? QCborError::UnknownType : QCborError::IllegalNumber);
+    const qsizetype argumentSize = info >= Value8Bit && info <= Value64Bit ? 1 << (info - Value8Bit) : 0;
+    if (end - p - 1 < argumentSize)
+        return fail(p, QCborError::EndOfFile);
+    *h = decodeHead(p);
+    return true;
+}
+
+bool Validator::validateString(const uchar *&p, const Head &h)
+{
+    if (h.value > quint64(end - h.next))
+        return fail(p, QCborError::EndOfFile);
+    const QByteArrayView payload(h.next, qsizetype(h.value));
+    if (h.majorType == TextStringType && !QUtf8::isValidUtf8(payload).isValidUtf8)
+        return fail(p, QCborError::InvalidUtf8String);
+    p = h.next + h.value;
+    return true;
+}
+
+bool Validator::validate(const uchar *&p, int remainingDepth)
+{
+    Head h;
+    if (!readHead(p, &h))
+        return false;
+
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+        if (h.isIndefinite())
+            return fail(p, QCborError::IllegalNumber);
+        p = h.next;
+        return true;
+
+    case SimpleTypesType:
+        if (h.isIndefinite())
+            return fail(p, QCborError::UnexpectedBreak);
+        if (h.info == Value8Bit && h.value < 32)
+            return fail(p, QCborError::IllegalSimpleType);
+        p = h.next;
+        return true;
+
+    case TagType:
+        if (h.isIndefinite())
+            return fail(p, QCborError::IllegalNumber);
+        if (remainingDepth == 0)
+            return fail(p, QCborError::NestingTooDeep);
+        p = h.next;
+        return validate(p, remainingDepth - 1);
+
+    case ByteStringType:
+    case TextStringType:
+        if (!h.isIndefinite())
+            return validateString(p, h);
+        // each chunk is a definite-length string of the same type
+        p = h.next;
+        while (true) {
+            if (p == end)
+                return fail(p, QCborError::EndOfFile);
+            if (*p == BreakByte)
+                break;
+            Head chunk;
+            if (!readHead(p, &chunk))
+                return false;
+            if (chunk.majorType != h.majorType)
+                return fail(p, QCborError::IllegalType);
+            if (chunk.isIndefinite())
+                return fail(p, QCborError::IllegalNumber);
+            if (!validateString(p, chunk))
+                return false;
+        }
+        ++p;
+        return true;
+
+    case ArrayType:
+    case MapType:
+        if (remainingDepth == 0)
+            return fail(p, QCborError::NestingTooDeep);
+        p = h.next;
+        if (!h.isIndefinite()) {
+            // each item takes at least one byte, so this loop ends at the
+            // end of the data for bogus counts
+            for (quint64 n = h.value; n; --n) {
+                if (!validate(p, remainingDepth - 1))
+                    return false;
+                if (h.majorType == MapType && !validate(p, remainingDepth - 1))
+                    return false;
+            }
+            return true;
+        }
+        while (true) {
+            if (p == end)
+                return fail(p, QCborError::EndOfFile);
+            if (*p == BreakByte)
+                break;
+            if (!validate(p, remainingDepth - 1))
+                return false;
+            if (h.majorType == MapType && !validate(p, remainingDepth - 1))
+                return false;
+        }
+        ++p;
+        return true;
+    }
+    Q_UNREACHABLE_RETURN(false);
+}
+} // unnamed namespace
+
+/*!
+    \class QCborValueView
+    \inmodule QtCore
+    \ingroup cbor
+    \ingroup qtserialization
+    \reentrant
+    \since 6.6
+
+    \brief The QCborValueView class is a read-only view of a CBOR value that
+    is decoded on demand.
+
+    QCborValue::fromCbor() decodes a whole CBOR document and copies all of its
+    strings. For large documents of which only a few values are needed, like
+    configuration files or asset manifests that are memory-mapped with
+    QFile::map(), QCborValueView provides access without either: it refers to
+    the encoded data, and looks up array elements and map members when they
+    are requested. Looking up a value never allocates memory, and
+    stringView() and byteArrayView() refer to the payload in the encoded
+    data.
+
+    \snippet code/src_corelib_serialization_qcborvalueview.cpp 0
+
+    fromCbor() checks that the data is well-formed once, like
+    QCborValue::fromCbor() does, so that the views don't need to check it
+    again. A lookup walks over the preceding elements of the array or map,
+    and therefore takes linear time. The data must stay valid and unmodified
+    as long as the views that refer to it are used.
+
+    Unlike QCborValue, QCborValueView does not interpret tags: the type of
+    a tagged value is always QCborValue::Tag, and taggedValue() returns the
+    value that the tag applies to.
+
+    JSON documents can be stored in CBOR form with
+    QCborValue::fromJsonValue() and QCborValue::toCbor() to be read with
+    QCborValueView.
+
+    \sa QCborValue, QCborStreamReader
+*/
+
+/*!
+    \class QCborValueView::ConstIterator
+    \inmodule QtCore
+    \since 6.6
+
+    \brief The QCborValueView::ConstIterator class iterates over the
+    elements of an array or the members of a map in a QCborValueView.
+
+    For an array, operator*() and value() return the current element. For a
+    map, key() returns the key of the current member and operator*() and
+    value() return its value.
+*/
+
+/*!
+    \fn QCborValueView::ConstIterator::ConstIterator()
+
+    Constructs an iterator that is past the end of any container.
+*/
+
+/*!
+    \fn QCborValueView QCborValueView::ConstIterator::operator*() const
+
+    Returns the current element of an array or the value of the current
+    member of a map.
+
+    \sa value(), key()
+*/
+
+/*!
+    \fn QCborValueView::ConstIterator QCborValueView::ConstIterator::operator++(int)
+
+    Advances the iterator to the next element or member and returns an
+    iterator to the previous one.
+*/
+
+/*!
+    \fn bool QCborValueView::ConstIterator::operator==(const ConstIterator &lhs, const ConstIterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to the same element.
+*/
+
+/*!
+    \fn bool QCborValueView::ConstIterator::operator!=(const ConstIterator &lhs, const ConstIterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to different elements.
+*/
+
+QCborValueView::ConstIterator::ConstIterator(const uchar *first, quint64 count, bool isMap) noexcept
+    : ptr(count && *first != BreakByte ? first : nullptr), remaining(count), isMap(isMap)
+{
+}
+
+/*!
+    Returns the key of the current member of a map, or an invalid view when
+    iterating over an array.
+*/
+QCborValueView QCborValueView::ConstIterator::key() const noexcept
+{
+    return isMap ? QCborValueView(ptr) : QCborValueView();
+}
+
+/*!
+    Returns the current element of an array or the value of the current
+    member of a map.
+*/
+QCborValueView QCborValueView::ConstIterator::value() const noexcept
+{
+    return QCborValueView(isMap ? skipItem(ptr) : ptr);
+}
+
+/*!
+    Advances the iterator to the next element or member and returns it.
+*/
+QCborValueView::ConstIterator &QCborValueView::ConstIterator::operator++() noexcept
+{
+    ptr = skipItem(ptr);
+    if (isMap)
+        ptr = skipItem(ptr);
+    if (remaining != std::numeric_limits<quint64>::max()) {
+        if (--remaining == 0)
+            ptr = nullptr;
+    } else if (*ptr == BreakByte) {
+        ptr = nullptr;
+    }
+    return *this;
+}
+
+/*!
+    \fn QCborValueView::QCborValueView()
+
+    Constructs an invalid view.
+
+    \sa isInvalid()
+*/
+
+/*!
+    Checks that \a data starts with a well-formed CBOR value and returns a
+    view of it. Any data after the value is ignored. If the value isn't
+    well-formed, this function returns an invalid view and, if \a error is not
+    \nullptr, stores the error and its offset in it. Otherwise, the offset in
+    \a error is the size of the encoded value.
+
+    The data is not copied, and must stay valid as long as the view and the
+    views obtained from it are used.
+
+    \sa QCborValue::fromCbor()
+*/
+QCborValueView QCborValueView::fromCbor(QByteArrayView data, QCborParserError *error)
+{
+    const uchar *begin = reinterpret_cast<const uchar *>(data.data());
+    Validator validator(begin, begin + data.size());
+    const uchar *p = begin;
+    const bool ok = validator.validate(p, MaximumRecursionDepth);
+    if (error) {
+        error->error = validator.error;
+        error->offset = (ok ? p : validator.errorPos) - begin;
+    }
+    return ok ? QCborValueView(begin) : QCborValueView();
+}
+
+/*!
+    Returns the type of the value. Integers that don't fit a qint64 have the
+    type QCborValue::Double, like in QCborValue. The type of a tagged value is
+    QCborValue::Tag, whatever the tag is.
+*/
+QCborValue::Type QCborValueView::type() const noexcept
+{
+    if (!ptr)
+        return QCborValue::Invalid;
+    const Head h = decodeHead(ptr);
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+    case NegativeIntegerType:
+        return isOutOfIntegerRange(h) ? QCborValue::Double : QCborValue::Integer;
+    case ByteStringType:
+        return QCborValue::ByteArray;
+    case TextStringType:
+        return QCborValue::String;
+    case ArrayType:
+        return QCborValue::Array;
+    case MapType:
+        return QCborValue::Map;
+    case TagType:
+        return QCborValue::Tag;
+    case SimpleTypesType:
+        if (h.info >= Value16Bit)
+            return QCborValue::Double;
+        return QCborValue::Type(QCborValue::SimpleType + int(h.value));
+    }
+    Q_UNREACHABLE_RETURN(QCborValue::Invalid);
+}
+
+/*!
+    \fn bool QCborValueView::isInteger() const
+    Returns \c true if the value is an integer.
+*/
+/*!
+    \fn bool QCborValueView::isByteArray() const
+    Returns \c true if the value is a byte array.
+*/
+/*!
+    \fn bool QCborValueView::isString() const
+    Returns \c true if the value is a text string.
+*/
+/*!
+    \fn bool QCborValueView::isArray() const
+    Returns \c true if the value is an array.
+*/
+/*!
+    \fn bool QCborValueView::isMap() const
+    Returns \c true if the value is a map.
+*/
+/*!
+    \fn bool QCborValueView::isTag() const
+    Returns \c true if the value is a tagged value.
+*/
+/*!
+    \fn bool QCborValueView::isFalse() const
+    Returns \c true if the value is \c false.
+*/
+/*!
+    \fn bool QCborValueView::isTrue() const
+    Returns \c true if the value is \c true.
+*/
+/*!
+    \fn bool QCborValueView::isBool() const
+    Returns \c true if the value is \c true or \c false.
+*/
+/*!
+    \fn bool QCborValueView::isNull() const
+    Returns \c true if the value is null.
+*/
+/*!
+    \fn bool QCborValueView::isUndefined() const
+    Returns \c true if the value is undefined.
+*/
+/*!
+    \fn bool QCborValueView::isDouble() const
+    Returns \c true if the value is a floating-point number.
+*/
+/*!
+    \fn bool QCborValueView::isSimpleType() const
+    Returns \c true if the value is a simple type, including \c false,
+    \c true, null and undefined.
+*/
+/*!
+    \fn bool QCborValueView::isInvalid() const
+    Returns \c true if this view doesn't refer to a value: it was
+    default-constructed, the data passed to fromCbor() was not well-formed,
+    or a lookup didn't find the value.
+*/
+
+/*!
+    Returns the value as an integer if it is an integer, the value truncated
+    to an integer if it is a floating-point number, and \a defaultValue
+    otherwise.
+*/
+qint64 QCborValueView::toInteger(qint64 defaultValue) const noexcept
+{
+    switch (type()) {
+    case QCborValue::Integer: {
+        const Head h = decodeHead(ptr);
+        return h.majorType == UnsignedIntegerType ? qint64(h.value) : -1 - qint64(h.value);
+    }
+    case QCborValue::Double:
+        return qint64(toDouble());
+    default:
+        return defaultValue;
+    }
+}
+
+/*!
+    Returns the value as a double if it is a number, and \a defaultValue
+    otherwise.
+*/
+double QCborValueView::toDouble(double defaultValue) const noexcept
+{
+    if (!ptr)
+        return defaultValue;
+    const Head h = decodeHead(ptr);
+    switch (h.majorType) {
+    case UnsignedIntegerType:
+        return double(h.value);
+    case NegativeIntegerType:
+        return -1 - double(h.value);
+    case SimpleTypesType:
+        switch (h.info) {
+        case Value16Bit:
+            return decodeFloat<qfloat16>(ptr + 1);
+        case Value32Bit:
+            return decodeFloat<float>(ptr + 1);
+        case Value64Bit:
+            return decodeFloat<double>(ptr + 1);
+        }
+        break;
+    default:
+        break;
+    }
+    return defaultValue;
+}
+
+/*!
+    Returns the value if it is \c true or \c false, and \a defaultValue
+    otherwise.
+*/
+bool QCborValueView::toBool(bool defaultValue) const noexcept
+{
+    return isBool() ? isTrue() : defaultValue;
+}
+
+/*!
+    Returns the simple type of the value if it is one, and \a defaultValue
+    otherwise.
+*/
+QCborSimpleType QCborValueView::toSimpleType(QCborSimpleType defaultValue) const noexcept
+{
+    return isSimpleType() ? QCborSimpleType(type() - QCborValue::SimpleType) : defaultValue;
+}
+
+/*!
+    Returns the tag of a tagged value, and \a defaultValue otherwise.
+
+    \sa taggedValue()
+*/
+QCborTag QCborValueView::tag(QCborTag defaultValue) const noexcept
+{
+    return isTag() ? QCborTag(decodeHead(ptr).value) : defaultValue;
+}
+
+/*!
+    Returns the value that the tag of a tagged value applies to, and an
+    invalid view otherwise.
+
+    \sa tag()
+*/
+QCborValueView QCborValueView::taggedValue() const noexcept
+{
+    return isTag() ? QCborValueView(decodeHead(ptr).next) : QCborValueView();
+}
+
+/*!
+    Returns a view of the UTF-8 data of a text string. Returns a null view if
+    the value is not a text string, or if it was encoded in chunks, which
+    aren't contiguous. Use toString() for those.
+
+    \sa toString(), byteArrayView()
+*/
+QUtf8StringView QCborValueView::stringView() const noexcept
+{
+    if (!isString())
+        return {};
+    const Head h = decodeHead(ptr);
+    if (h.isIndefinite())
+        return {};
+    return QUtf8StringView(h.next, qsizetype(h.value));
+}
+
+/*!
+    Returns a view of the data of a byte array. Returns a null view if the
+    value is not a byte array, or if it was encoded in chunks, which aren't
+    contiguous. Use toByteArray() for those.
+
+    \sa toByteArray(), stringView()
+*/
+QByteArrayView QCborValueView::byteArrayView() const noexcept
+{
+    if (!isByteArray())
+        return {};
+    const Head h = decodeHead(ptr);
+    if (h.isIndefinite())
+        return {};
+    return QByteArrayView(h.next, qsizetype(h.value));
+}
+
+// Concatenates the chunks of a byte or text string
+static QByteArray stringPayload(const uchar *ptr)
+{
+    const Head h = decodeHead(ptr);
+    if (!h.isIndefinite())
+        return QByteArray(reinterpret_cast<const char *>(h.next), qsizetype(h.value));
+    QByteArray result;
+    for (const uchar *p = h.next; *p != BreakByte; p = skipItem(p)) {
+        const Head chunk = decodeHead(p);
+        result.append(reinterpret_cast<const char *>(chunk.next), qsizetype(chunk.value));
+    }
+    return result;
+}
+
+/*!
+    Returns the value if it is a text string, and \a defaultValue otherwise.
+    Unlike stringView(), this function also works for strings that were
+    encoded in chunks.
+
+    \sa stringView()
+*/
+QString QCborValueView::toString(const QString &defaultValue) const
+{
+    if (!isString())
+        return defaultValue;
+    if (QUtf8StringView view = stringView(); !view.isNull())
+        return view.toString();
+    return QString::fromUtf8(stringPayload(ptr));
+}
+
+/*!
+    Returns the value if it is a byte array, and \a defaultValue otherwise.
+    Unlike byteArrayView(), this function also works for byte arrays that
+    were encoded in chunks.
+
+    \sa byteArrayView()
+*/
+QByteArray QCborValueView::toByteArray(const QByteArray &defaultValue) const
+{
+    if (!isByteArray())
+        return defaultValue;
+    return stringPayload(ptr);
+}
+
+/*!
+    Returns the number of elements of an array or members of a map, and 0
+    for other values. For containers that were encoded without their size,
+    this function counts the elements.
+*/
+qsizetype QCborValueView::size() const noexcept
+{
+    if (!isArray() && !isMap())
+        return 0;
+    const Head h = decodeHead(ptr);
+    if (!h.isIndefinite())
+        return qsizetype(h.value);
+    qsizetype count = 0;
+    for (ConstIterator it = begin(); it != end(); ++it)
+        ++count;
+    return count;
+}
+
+/*!
+    If the value is an array, returns the element at index \a key. If it is
+    a map, returns the value of the member whose key is the integer \a key.
+    Returns an invalid view otherwise, or if there is no such element or
+    member.
+*/
+QCborValueView QCborValueView::operator[](qint64 key) const noexcept
+{
+    if (isArray()) {
+        if (key < 0)
+            return {};
+        for (ConstIterator it = begin(); it != end(); ++it) {
+            if (key-- == 0)
+                return *it;
+        }
+    } else if (isMap()) {
+        for (ConstIterator it = begin(); it != end(); ++it) {
+            const QCborValueView k = it.key();
+            if (k.isInteger() && k.toInteger() == key)
+                return it.value();
+        }
+    }
+    return {};
+}
+
+/*!
+    If the value is a map, returns the value of the member whose key is the
+    text string \a key. Returns an invalid view otherwise, or if there is no
+    such member.
+
+    This function does not allocate memory, unless a key in the map was
+    encoded in chunks.
+*/
+QCborValueView QCborValueView::operator[](QAnyStringView key) const noexcept
+{
+    if (!isMap())
+        return {};
+    for (ConstIterator it = begin(); it != end(); ++it) {
+        const QCborValueView k = it.key();
+        if (!k.isString())
+            continue;
+        const QUtf8StringView view = k.stringView();
+        if (view.isNull() ? QAnyStringView::equal(k.toString(), key)
+                          : QAnyStringView::equal(view, key))
+            return it.value();
+    }
+    return {};
+}
+
+/*!
+    Returns an iterator to the first element of an array or the first member
+    of a map. For other values, returns end().
+*/
+QCborValueView::ConstIterator QCborValueView::begin() const noexcept
+{
+    if (!isArray() && !isMap())
+        return {};
+    const Head h = decodeHead(ptr);
+    const quint64 count = h.isIndefinite() ? std::numeric_limits<quint64>::max() : h.value;
+    return ConstIterator(h.next, count, h.majorType == MapType);
+}
+
+/*!
+    \fn QCborValueView::ConstIterator QCborValueView::constBegin() const
+    \sa begin()
+*/
+
+/*!
+    \fn QCborValueView::ConstIterator QCborValueView::end() const
+
+    Returns an iterator that is past the last element of an array or the
+    last member of a map.
+*/
+
+/*!
+    \fn QCborValueView::ConstIterator QCborValueView::constEnd() const
+    \sa end()
+*/
+
+/*!
+    Returns the encoded data of the value, including the elements of an
+    array or the members of a map.
+*/
+QByteArrayView QCborValueView::encoded() const noexcept
+{
+    if (!ptr)
+        return {};
+    return QByteArrayView(ptr, skipItem(ptr) - ptr);
+}
+
+/*!
+    Decodes the value, including the elements of an array or the members of
+    a map, and returns it as a QCborValue, which copies all of its strings.
+*/
+QCborValue QCborValueView::toCborValue() const
+{
+    if (!ptr)
+        return QCborValue(QCborValue::Invalid);
+    const QByteArrayView data = encoded();
+    return QCborValue::fromCbor(QByteArray::fromRawData(data.data(), data.size()));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,109 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCBORVALUEVIEW_H
+#define QCBORVALUEVIEW_H
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qutf8stringview.h>
+
+#include <iterator>
+
+QT_REQUIRE_CONFIG(cborstreamreader);
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QCborValueView
+{
+public:
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qsizetype;
+        using value_type = QCborValueView;
+        using pointer = void;
+        using reference = QCborValueView;
+
+        constexpr ConstIterator() noexcept = default;
+
+        QCborValueView operator*() const noexcept { return value(); }
+        QCborValueView key() const noexcept;
+        QCborValueView value() const noexcept;
+
+        ConstIterator &operator++() noexcept;
+        ConstIterator operator++(int) noexcept { ConstIterator it = *this; ++*this; return it; }
+
+        friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return lhs.ptr == rhs.ptr; }
+        friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return lhs.ptr != rhs.ptr; }
+
+    private:
+        friend class QCborValueView;
+        ConstIterator(const uchar *first, quint64 count, bool isMap) noexcept;
+
+        const uchar *ptr = nullptr;     // the current element, or the key of the current member
+        quint64 remaining = 0;          // elements left, or ~0 for an indefinite-length container
+        bool isMap = false;
+    };
+    using const_iterator = ConstIterator;
+
+    constexpr QCborValueView() noexcept = default;
+
+    static QCborValueView fromCbor(QByteArrayView data, QCborParserError *error = nullptr);
+
+    QCborValue::Type type() const noexcept;
+    bool isInteger() const noexcept { return type() == QCborValue::Integer; }
+    bool isByteArray() const noexcept { return type() == QCborValue::ByteArray; }
+    bool isString() const noexcept { return type() == QCborValue::String; }
+    bool isArray() const noexcept { return type() == QCborValue::Array; }
+    bool isMap() const noexcept { return type() == QCborValue::Map; }
+    bool isTag() const noexcept { return type() == QCborValue::Tag; }
+    bool isFalse() const noexcept { return type() == QCborValue::False; }
+    bool isTrue() const noexcept { return type() == QCborValue::True; }
+    bool isBool() const noexcept { return isFalse() || isTrue(); }
+    bool isNull() const noexcept { return type() == QCborValue::Null; }
+    bool isUndefined() const noexcept { return type() == QCborValue::Undefined; }
+    bool isDouble() const noexcept { return type() == QCborValue::Double; }
+    bool isSimpleType() const noexcept { return type() >= QCborValue::SimpleType && type() < QCborValue::Double; }
+    bool isInvalid() const noexcept { return ptr == nullptr; }
+
+    qint64 toInteger(qint64 defaultValue = 0) const noexcept;
+    double toDouble(double defaultValue = 0) const noexcept;
+    bool toBool(bool defaultValue = false) const noexcept;
+    QCborSimpleType toSimpleType(QCborSimpleType defaultValue = QCborSimpleType::Undefined) const noexcept;
+    QCborTag tag(QCborTag defaultValue = QCborTag(-1)) const noexcept;
+    QCborValueView taggedValue() const noexcept;
+
+    QUtf8StringView stringView() const noexcept;
+    QByteArrayView byteArrayView() const noexcept;
+    QString toString(const QString &defaultValue = {}) const;
+    QByteArray toByteArray(const QByteArray &defaultValue = {}) const;
+
+    qsizetype size() const noexcept;
+    QCborValueView operator[](qint64 key) const noexcept;
+    QCborValueView operator[](QAnyStringView key) const noexcept;
+
+    ConstIterator begin() const noexcept;
+    ConstIterator constBegin() const noexcept { return begin(); }
+    ConstIterator end() const noexcept { return ConstIterator(); }
+    ConstIterator constEnd() const noexcept { return end(); }
+
+    QByteArrayView encoded() const noexcept;
+    QCborValue toCborValue() const;
+
+private:
+    explicit constexpr QCborValueView(const uchar *p) noexcept : ptr(p) {}
+
+    const uchar *ptr = nullptr;
+};
+
+Q_DECLARE_TYPEINFO(QCborValueView, Q_RELOCATABLE_TYPE);
+Q_DECLARE_TYPEINFO(QCborValueView::ConstIterator, Q_RELOCATABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QCBORVALUEVIEW_H
@@ -7,10 +7,12 @@
 #if !defined(QT_NO_DATASTREAM) || defined(QT_BOOTSTRAPPED)
 #include "qbuffer.h"
 #include "qfloat16.h"
+#include "qscopeguard.h"
 #include "qstring.h"
 #include <stdio.h>
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 #include "qendian.h"
 
 QT_BEGIN_NAMESPACE
@@ -1400,6 +1402,178 @@ int QDataStream::skipRawData(int len)
     return skipResult;
 }
 
+/*!
+    \fn template <typename T> QDataStream &QDataStream::readArray(T *data, qsizetype count)
+    \since 6.6
+
+    Reads \a count values of type \c T from the stream into the preallocated
+    array \a data and returns a reference to the stream. The result is the
+    same as reading each element with operator>>(), but the data is read
+    from the device as one block and byte-swapped in place only if the
+    stream's byteOrder() differs from the host's.
+
+    \c T must be one of the integral types QDataStream has operators for,
+    \c char16_t, \c char32_t, \c float or \c double. Floating-point values
+    follow floatingPointPrecision(). If the stream does not hold \a count
+    values, the status is set to ReadPastEnd and \a data is filled with
+    zeroes.
+
+    \sa writeArray(), readRawData()
+*/
+
+/*!
+    \fn template <typename T> QDataStream &QDataStream::writeArray(const T *data, qsizetype count)
+    \since 6.6
+
+    Writes the \a count values of type \c T in \a data to the stream and
+    returns a reference to the stream. The stream contents are the same as
+    writing each element with operator<<(), without a size prefix, but the
+    device is written to in large blocks.
+
+    QList streaming operators use this function for the element types
+    readArray() accepts.
+
+    \sa readArray(), writeRawData()
+*/
+
+static void byteSwapArray(const void *source, qsizetype count, void *dest, int elementSize)
+{
+    switch (elementSize) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+// readBlock() takes an int; stay well below that and keep every chunk a
+// whole number of elements.
+static constexpr qsizetype MaxArrayChunk = 1 << 30;
+// Elements converted at a time when the in-memory and the stream types of
+// floating-point data differ.
+static constexpr qsizetype ArrayConversionChunk = 1024;
+
+bool QDataStream::readArrayData(void *data, qsizetype count, int elementSize)
+{
+    char *p = static_cast<char *>(data);
+    char *const end = p + count * elementSize;
+    auto clearArray = qScopeGuard([&] { memset(data, 0, end - static_cast<char *>(data)); });
+    CHECK_STREAM_PRECOND(false)
+    while (p != end) {
+        const int chunk = int(qMin(qsizetype(end - p), MaxArrayChunk));
+        if (readBlock(p, chunk) != chunk)
+            return false;
+        if (!noswap && elementSize > 1)
+            byteSwapArray(p, chunk / elementSize, p, elementSize);
+        p += chunk;
+    }
+    clearArray.dismiss();
+    return true;
+}
+
+template <typename Wire, typename T>
+static void convertArray(const T *source, qsizetype count, Wire *dest)
+{
+    for (qsizetype i = 0; i < count; ++i)
+        dest[i] = Wire(source[i]);
+}
+
+void QDataStream::readArrayData(float *data, qsizetype count)
+{
+    if (version() < QDataStream::Qt_4_6 || floatingPointPrecision() == SinglePrecision) {
+        readArrayData(static_cast<void *>(data), count, int(sizeof(float)));
+        return;
+    }
+
+    double buffer[ArrayConversionChunk];
+    for (qsizetype i = 0; i < count; i += ArrayConversionChunk) {
+        const qsizetype n = qMin(count - i, ArrayConversionChunk);
+        if (!readArrayData(buffer, n, int(sizeof(double)))) {
+            memset(data, 0, count * sizeof(float));
+            break;
+        }
+        convertArray(buffer, n, data + i);
+    }
+}
+
+void QDataStream::readArrayData(double *data, qsizetype count)
+{
+    if (version() < QDataStream::Qt_4_6 || floatingPointPrecision() == DoublePrecision) {
+        readArrayData(static_cast<void *>(data), count, int(sizeof(double)));
+        return;
+    }
+
+    float buffer[ArrayConversionChunk];
+    for (qsizetype i = 0; i < count; i += ArrayConversionChunk) {
+        const qsizetype n = qMin(count - i, ArrayConversionChunk);
+        if (!readArrayData(buffer, n, int(sizeof(float)))) {
+            memset(data, 0, count * sizeof(double));
+            break;
+        }
+        convertArray(buffer, n, data + i);
+    }
+}
+
+void QDataStream::writeArrayData(const void *data, qsizetype count, int elementSize)
+{
+    CHECK_STREAM_WRITE_PRECOND()
+    const char *p = static_cast<const char *>(data);
+    const qint64 size = qint64(count) * elementSize;
+    if (noswap || elementSize == 1) {
+        if (dev->write(p, size) != size)
+            q_status = WriteFailed;
+        return;
+    }
+
+    // byte-swap into a bounce buffer and write that one piece at a time
+    alignas(8) char buffer[16384];
+    for (qint64 offset = 0; offset < size; offset += qint64(sizeof(buffer))) {
+        const qint64 chunk = qMin(size - offset, qint64(sizeof(buffer)));
+        byteSwapArray(p + offset, chunk / elementSize, buffer, elementSize);
+        if (dev->write(buffer, chunk) != chunk) {
+            q_status = WriteFailed;
+            return;
+        }
+    }
+}
+
+void QDataStream::writeArrayData(const float *data, qsizetype count)
+{
+    if (version() < QDataStream::Qt_4_6 || floatingPointPrecision() == SinglePrecision) {
+        writeArrayData(static_cast<const void *>(data), count, int(sizeof(float)));
+        return;
+    }
+
+    double buffer[ArrayConversionChunk];
+    for (qsizetype i = 0; i < count && q_status == Ok; i += ArrayConversionChunk) {
+        const qsizetype n = qMin(count - i, ArrayConversionChunk);
+        convertArray(data + i, n, buffer);
+        writeArrayData(buffer, n, int(sizeof(double)));
+    }
+}
+
+void QDataStream::writeArrayData(const double *data, qsizetype count)
+{
+    if (version() < QDataStream::Qt_4_6 || floatingPointPrecision() == DoublePrecision) {
+        writeArrayData(static_cast<const void *>(data), count, int(sizeof(double)));
+        return;
+    }
+
+    float buffer[ArrayConversionChunk];
+    for (qsizetype i = 0; i < count && q_status == Ok; i += ArrayConversionChunk) {
+        const qsizetype n = qMin(count - i, ArrayConversionChunk);
+        convertArray(data + i, n, buffer);
+        writeArrayData(buffer, n, int(sizeof(float)));
+    }
+}
+
 /*!
     \fn template <class T1, class T2> QDataStream &operator<<(QDataStream &out, const std::pair<T1, T2> &pair)
     \since 6.0
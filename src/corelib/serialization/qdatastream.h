@@ -25,6 +25,18 @@ class QIODevice;
 class QDataStreamPrivate;
 namespace QtPrivate {
 class StreamStateSaver;
+
+template <typename T>
+inline constexpr bool IsDataStreamArrayElement =
+        std::is_same_v<T, char> || std::is_same_v<T, qint8> || std::is_same_v<T, quint8>
+        || std::is_same_v<T, qint16> || std::is_same_v<T, quint16>
+        || std::is_same_v<T, qint32> || std::is_same_v<T, quint32>
+        || std::is_same_v<T, qint64> || std::is_same_v<T, quint64>
+        || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+        || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename T>
+using IfDataStreamArrayElement = std::enable_if_t<IsDataStreamArrayElement<T>, bool>;
 }
 class Q_CORE_EXPORT QDataStream : public QIODeviceBase
 {
@@ -166,6 +178,25 @@ public:
 
     int skipRawData(int len);
 
+    template <typename T, QtPrivate::IfDataStreamArrayElement<T> = true>
+    QDataStream &readArray(T *data, qsizetype count)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            readArrayData(data, count);
+        else
+            readArrayData(data, count, int(sizeof(T)));
+        return *this;
+    }
+    template <typename T, QtPrivate::IfDataStreamArrayElement<T> = true>
+    QDataStream &writeArray(const T *data, qsizetype count)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+            writeArrayData(data, count);
+        else
+            writeArrayData(data, count, int(sizeof(T)));
+        return *this;
+    }
+
     void startTransaction();
     bool commitTransaction();
     void rollbackTransaction();
@@ -185,6 +216,12 @@ private:
     Status q_status;
 
     int readBlock(char *data, int len);
+    bool readArrayData(void *data, qsizetype count, int elementSize);
+    void readArrayData(float *data, qsizetype count);
+    void readArrayData(double *data, qsizetype count);
+    void writeArrayData(const void *data, qsizetype count, int elementSize);
+    void writeArrayData(const float *data, qsizetype count);
+    void writeArrayData(const double *data, qsizetype count);
     friend class QtPrivate::StreamStateSaver;
 };
 
@@ -286,6 +323,36 @@ QDataStream &writeSequentialContainer(QDataStream &s, const Container &c)
     return s;
 }
 
+template <typename Container>
+QDataStream &readContiguousContainer(QDataStream &s, Container &c)
+{
+    StreamStateSaver stateSaver(&s);
+
+    c.clear();
+    quint32 n;
+    s >> n;
+    c.reserve(n);
+    // Grow the container one chunk at a time, so that we do not write zeroes
+    // into all of it before the stream overwrites them.
+    constexpr qsizetype ChunkSize = 16384;
+    for (qsizetype i = 0; i < qsizetype(n) && s.status() == QDataStream::Ok; i += ChunkSize) {
+        const qsizetype count = qMin(qsizetype(n) - i, ChunkSize);
+        c.resize(i + count);
+        s.readArray(c.data() + i, count);
+    }
+    if (s.status() != QDataStream::Ok)
+        c.clear();
+
+    return s;
+}
+
+template <typename Container>
+QDataStream &writeContiguousContainer(QDataStream &s, const Container &c)
+{
+    s << quint32(c.size());
+    return s.writeArray(c.constData(), c.size());
+}
+
 template <typename Container>
 QDataStream &writeAssociativeContainer(QDataStream &s, const Container &c)
 {
@@ -410,13 +477,19 @@ operator>>(QDataStream &s, T &t)
 template<typename T>
 inline QDataStreamIfHasIStreamOperatorsContainer<QList<T>, T> operator>>(QDataStream &s, QList<T> &v)
 {
-    return QtPrivate::readArrayBasedContainer(s, v);
+    if constexpr (QtPrivate::IsDataStreamArrayElement<T>)
+        return QtPrivate::readContiguousContainer(s, v);
+    else
+        return QtPrivate::readArrayBasedContainer(s, v);
 }
 
 template<typename T>
 inline QDataStreamIfHasOStreamOperatorsContainer<QList<T>, T> operator<<(QDataStream &s, const QList<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    if constexpr (QtPrivate::IsDataStreamArrayElement<T>)
+        return QtPrivate::writeContiguousContainer(s, v);
+    else
+        return QtPrivate::writeSequentialContainer(s, v);
 }
 
 template <typename T>
@@ -11,6 +11,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include <private/qsimd_p.h>
 #include <private/qtools_p.h>
 
 //#define PARSER_DEBUG
@@ -240,6 +241,97 @@ enum {
     Quote = 0x22
 };
 
+static inline bool isJsonSpace(char c)
+{
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
+/*
+    The scanning functions below are the first stage of parsing strings and
+    whitespace: they skip over the bytes that need no further attention in
+    blocks of 16 or 32 bytes, so that the parser only looks at the bytes that
+    matter one by one.
+*/
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_BOOTSTRAPPED)
+static const char *QT_FUNCTION_TARGET(AVX2)
+findStringSpecial_avx2(const char *p, const char *end) noexcept
+{
+    const __m256i quote = _mm256_set1_epi8(Quote);
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    for ( ; end - p >= 32; p += 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote),
+                                          _mm256_cmpeq_epi8(data, backslash));
+        // PMOVMSKB also picks up the high bit of the non-ASCII bytes
+        uint mask = uint(_mm256_movemask_epi8(_mm256_or_si256(special, data)));
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+    }
+    return p;
+}
+#endif
+
+// Returns the first byte in [p, end) that ends a string, starts an escape
+// sequence or is part of a non-ASCII UTF-8 sequence, or end if there is none.
+static const char *findStringSpecial(const char *p, const char *end) noexcept
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2) && !defined(QT_BOOTSTRAPPED)
+    if (end - p >= 32 && qCpuHasFeature(AVX2))
+        p = findStringSpecial_avx2(p, end);
+#endif
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8(Quote);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - p >= 16; p += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                       _mm_cmpeq_epi8(data, backslash));
+        uint mask = uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint8x16_t quote = vdupq_n_u8(Quote);
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t maxAscii = vdupq_n_u8(0x7f);
+    for ( ; end - p >= 16; p += 16) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                      vcgtq_u8(data, maxAscii));
+        if (vmaxvq_u8(special))
+            break;      // the loop below finds it
+    }
+#endif
+    while (p < end && *p != Quote && *p != '\\' && uchar(*p) < 0x80)
+        ++p;
+    return p;
+}
+
+// Returns the first byte in [p, end) that isn't whitespace, or end.
+static const char *skipJsonSpace(const char *p, const char *end) noexcept
+{
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i carriageReturn = _mm_set1_epi8(Return);
+    for ( ; end - p >= 16; p += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i isSpace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                                    _mm_cmpeq_epi8(data, tab)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed),
+                                                    _mm_cmpeq_epi8(data, carriageReturn)));
+        uint mask = ~uint(_mm_movemask_epi8(isSpace)) & 0xffff;
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+    }
+#endif
+    while (p < end && isJsonSpace(*p))
+        ++p;
+    return p;
+}
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -253,15 +345,12 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
+    // Most tokens are preceded by no or a single space. Longer runs are
+    // indentation, which is skipped in blocks.
+    if (json < end && isJsonSpace(*json)) {
         ++json;
+        if (json < end && isJsonSpace(*json))
+            json = skipJsonSpace(json + 1, end);
     }
     return (json < end);
 }
@@ -777,76 +866,6 @@ bool Parser::parseNumber()
 
         unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
  */
-static inline bool addHexDigit(char digit, char32_t *result)
-{
-    *result <<= 4;
-    const int h = fromHex(digit);
-    if (h != -1) {
-        *result |= h;
-        return true;
-    }
-
-    return false;
-}
-
-static inline bool scanEscapeSequence(const char *&json, const char *end, char32_t *ch)
-{
-    ++json;
-    if (json >= end)
-        return false;
-
-    DEBUG << "scan escape" << (char)*json;
-    uchar escaped = *json++;
-    switch (escaped) {
-    case '"':
-        *ch = '"'; break;
-    case '\\':
-        *ch = '\\'; break;
-    case '/':
-        *ch = '/'; break;
-    case 'b':
-        *ch = 0x8; break;
-    case 'f':
-        *ch = 0xc; break;
-    case 'n':
-        *ch = 0xa; break;
-    case 'r':
-        *ch = 0xd; break;
-    case 't':
-        *ch = 0x9; break;
-    case 'u': {
-        *ch = 0;
-        if (json > end - 4)
-            return false;
-        for (int i = 0; i < 4; ++i) {
-            if (!addHexDigit(*json, ch))
-                return false;
-            ++json;
-        }
-        return true;
-    }
-    default:
-        // this is not as strict as one could be, but allows for more Json files
-        // to be parsed correctly.
-        *ch = escaped;
-        return true;
-    }
-    return true;
-}
-
-static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *result)
-{
-    const auto *usrc = reinterpret_cast<const uchar *>(json);
-    const auto *uend = reinterpret_cast<const uchar *>(end);
-    const uchar b = *usrc++;
-    qsizetype res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, result, usrc, uend);
-    if (res < 0)
-        return false;
-
-    json = reinterpret_cast<const char *>(usrc);
-    return true;
-}
-
 bool Parser::parseString()
 {
     const char *start = json;
@@ -858,7 +877,8 @@ bool Parser::parseString()
     bool isAscii = true;
     while (json < end) {
         char32_t ch = 0;
-        if (*json == '"')
+        json = findStringSpecial(json, end);
+        if (json == end || *json == '"')
             break;
         if (*json == '\\') {
             isAscii = false;
@@ -868,13 +888,13 @@ bool Parser::parseString()
             isUtf8 = false;
             break;
         }
+        // a non-ASCII character
         if (!scanUtf8Char(json, end, &ch)) {
             lastError = QJsonParseError::IllegalUTF8String;
             return false;
         }
-        if (ch > 0x7f)
-            isAscii = false;
-        DEBUG << "  " << ch << char(ch);
+        isAscii = false;
+        DEBUG << "  " << ch;
     }
     ++json;
     DEBUG << "end of string";
@@ -900,6 +920,12 @@ bool Parser::parseString()
     QString ucs4;
     while (json < end) {
         char32_t ch = 0;
+        const char *special = findStringSpecial(json, end);
+        if (special != json) {
+            ucs4.append(QLatin1StringView(json, special - json));
+            json = special;
+            continue;
+        }
         if (*json == '"')
             break;
         else if (*json == '\\') {
@@ -17,12 +17,84 @@
 
 #include <QtCore/private/qglobal_p.h>
 #include <QtCore/private/qcborvalue_p.h>
+#include <QtCore/private/qstringconverter_p.h>
+#include <QtCore/private/qtools_p.h>
 #include <QtCore/qjsondocument.h>
 
 QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
+// helpers for parsing strings, shared with QJsonStreamReader
+inline bool addHexDigit(char digit, char32_t *result)
+{
+    *result <<= 4;
+    const int h = QtMiscUtils::fromHex(digit);
+    if (h != -1) {
+        *result |= h;
+        return true;
+    }
+
+    return false;
+}
+
+inline bool scanEscapeSequence(const char *&json, const char *end, char32_t *ch)
+{
+    ++json;
+    if (json >= end)
+        return false;
+
+    uchar escaped = *json++;
+    switch (escaped) {
+    case '"':
+        *ch = '"'; break;
+    case '\\':
+        *ch = '\\'; break;
+    case '/':
+        *ch = '/'; break;
+    case 'b':
+        *ch = 0x8; break;
+    case 'f':
+        *ch = 0xc; break;
+    case 'n':
+        *ch = 0xa; break;
+    case 'r':
+        *ch = 0xd; break;
+    case 't':
+        *ch = 0x9; break;
+    case 'u': {
+        *ch = 0;
+        if (json > end - 4)
+            return false;
+        for (int i = 0; i < 4; ++i) {
+            if (!addHexDigit(*json, ch))
+                return false;
+            ++json;
+        }
+        return true;
+    }
+    default:
+        // this is not as strict as one could be, but allows for more Json files
+        // to be parsed correctly.
+        *ch = escaped;
+        return true;
+    }
+    return true;
+}
+
+inline bool scanUtf8Char(const char *&json, const char *end, char32_t *result)
+{
+    const auto *usrc = reinterpret_cast<const uchar *>(json);
+    const auto *uend = reinterpret_cast<const uchar *>(end);
+    const uchar b = *usrc++;
+    qsizetype res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, result, usrc, uend);
+    if (res < 0)
+        return false;
+
+    json = reinterpret_cast<const char *>(usrc);
+    return true;
+}
+
 class Parser
 {
 public:
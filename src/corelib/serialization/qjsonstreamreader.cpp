@@ -0,0 +1,873 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+
+#include "qjsonparser_p.h"
+
+#include <qiodevice.h>
+#include <qjsonarray.h>
+#include <qjsonobject.h>
+#include <qvarlengtharray.h>
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <private/qtools_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+// the same limit as QJsonDocument::fromJson()
+static constexpr int NestingLimit = 1024;
+
+// how much to read from the device at once, at least
+static constexpr qsizetype MinimumReadSize = 16384;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State : quint8 {
+        ExpectValue,        // at the start, after a name, or after a comma in an array
+        ExpectValueOrEnd,   // after the start of an array
+        ExpectName,         // after a comma in an object
+        ExpectNameOrEnd,    // after the start of an object
+        AfterValue,         // expecting a comma or the end of the container
+        Finished
+    };
+    enum Result { Ok, NeedMoreData, Failed };
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;          // the start of the next token in buffer
+    qint64 bufferOffset = 0;    // the offset of buffer in the input
+    bool dataComplete = false;  // buffer holds the whole rest of the input
+    bool needMoreData = false;
+    bool bomChecked = false;
+
+    QVarLengthArray<char, 32> containers; // '[' or '{' for each open container
+    State state = ExpectValue;
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    QJsonParseError::ParseError lastError = QJsonParseError::NoError;
+    qint64 errorOffset = 0;
+
+    QString text;
+    double number = 0;
+    qint64 integer = 0;
+    bool numberIsInteger = false;
+    bool boolean = false;
+
+    bool fillBuffer();
+    bool atEndOfInput() const;
+    void clearToken();
+
+    QJsonStreamReader::TokenType readNext();
+    Result parseToken(bool final);
+    Result parseValue(const char *&p, const char *end, bool final);
+    Result parseName(const char *&p, const char *end, bool final);
+    Result parseString(const char *&p, const char *end, bool final);
+    Result parseNumber(const char *&p, const char *end, bool final);
+    Result parseLiteral(const char *&p, const char *end, bool final, const char *literal,
+                        qsizetype length);
+    Result fail(const char *p, QJsonParseError::ParseError error);
+    QJsonParseError::ParseError unterminatedError() const;
+};
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \since 6.6
+    \brief The QJsonStreamReader class is a simple JSON parser that reads the
+    document one token at a time.
+    \ingroup json
+    \ingroup shared
+    \reentrant
+
+    QJsonStreamReader reads JSON from a QIODevice or from data added with
+    addData(), without creating a QJsonDocument for the whole document.
+    Each call to readNext() reads the next token, such as the start or the end
+    of an array or an object, the name of a member of an object, or a value.
+    This keeps the memory use low for large documents, and lets the
+    application stop reading as soon as it has found what it was looking for.
+
+    The data doesn't have to be available all at once: if readNext() reaches
+    the end of the data in the middle of a token, it returns \l NoToken. Call
+    readNext() again after adding more data with addData() or, when reading
+    from a device, once the device has emitted the \l{QIODevice::}{readyRead()}
+    signal. This makes it possible to parse a document while it is being
+    downloaded, for instance from a QNetworkReply.
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 0
+
+    The reader accepts the same documents as QJsonDocument::fromJson(), and
+    additionally a single value of any type at the top level. The errors are
+    reported with the same codes, see error().
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of the token that the reader just read.
+
+    \value NoToken The reader has not read anything yet, or it needs more data
+           to read the next token.
+    \value Invalid An error occurred, see error() and errorString().
+    \value StartArray The reader read the start of an array.
+    \value EndArray The reader read the end of an array.
+    \value StartObject The reader read the start of an object.
+    \value EndObject The reader read the end of an object.
+    \value Name The reader read the name of a member of an object, see text().
+           The next token is the value of the member.
+    \value String The reader read a string value, see text().
+    \value Number The reader read a number, see toDouble(), isInteger() and
+           toInteger().
+    \value Bool The reader read \c true or \c false, see toBool().
+    \value Null The reader read \c null.
+    \value EndDocument The reader read the end of the top-level value.
+*/
+
+/*!
+    Constructs a QJsonStreamReader without a device or data. Use setDevice()
+    or addData() to give it the JSON to read.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a QJsonStreamReader that reads from \a device.
+
+    \sa setDevice()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a QJsonStreamReader that reads the complete document \a data.
+    Unlike with addData(), the reader reports an error if the document is
+    truncated.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    d->buffer = data;
+    d->dataComplete = true;
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+    = default;
+
+/*!
+    Makes the reader read from \a device. The reader continues with the state
+    it has, so that a document can be read from consecutive devices.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->device = device;
+    d->dataComplete = false;
+}
+
+/*!
+    Returns the device that the reader reads from, or \nullptr if it has none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds \a data for the reader to read. If the reader returned \l NoToken
+    because it needed more data, call readNext() again afterwards.
+
+    Since more data may always be added, the reader doesn't report an error
+    for a truncated document, but keeps returning \l NoToken.
+
+    This function should not be called when the reader reads from a device.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with a device()");
+        return;
+    }
+    if (d->pos) {
+        d->buffer.remove(0, d->pos);
+        d->bufferOffset += d->pos;
+        d->pos = 0;
+    }
+    d->buffer += data;
+    d->dataComplete = false;
+    d->needMoreData = false;
+}
+
+/*!
+    Removes the device or the data from the reader, and resets it to its
+    initial state.
+*/
+void QJsonStreamReader::clear()
+{
+    d.reset(new QJsonStreamReaderPrivate);
+}
+
+/*!
+    Returns \c true if the reader can't read another token: it read the end of
+    the document, an error occurred, or it needs more data. In the latter
+    case, atEnd() returns \c false again once more data was added with
+    addData(), or after the next call to readNext().
+
+    \sa readNext()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    return d->needMoreData || d->type == Invalid || d->type == EndDocument;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    Returns \l NoToken if the data ends in the middle of the next token. The
+    reader then keeps its state, and continues when readNext() is called after
+    more data was made available. Once the reader returned \l EndDocument or
+    \l Invalid, it returns the same again.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    return d->readNext();
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->type;
+}
+
+/*!
+    \fn bool QJsonStreamReader::isStartArray() const
+
+    Returns \c true if tokenType() is \l StartArray.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndArray() const
+
+    Returns \c true if tokenType() is \l EndArray.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isStartObject() const
+
+    Returns \c true if tokenType() is \l StartObject.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndObject() const
+
+    Returns \c true if tokenType() is \l EndObject.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isName() const
+
+    Returns \c true if tokenType() is \l Name.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isString() const
+
+    Returns \c true if tokenType() is \l String.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNumber() const
+
+    Returns \c true if tokenType() is \l Number.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isBool() const
+
+    Returns \c true if tokenType() is \l Bool.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNull() const
+
+    Returns \c true if tokenType() is \l Null.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndDocument() const
+
+    Returns \c true if tokenType() is \l EndDocument.
+*/
+
+/*!
+    Returns the name of the member if the current token is a \l Name, or the
+    string if it is a \l String. Otherwise returns a null QString.
+*/
+QString QJsonStreamReader::text() const
+{
+    return d->text;
+}
+
+/*!
+    Returns \c true if the current token is a \l Number that can be
+    represented exactly as a qint64.
+
+    \sa toInteger(), toDouble()
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return d->type == Number && d->numberIsInteger;
+}
+
+/*!
+    Returns the current \l Number as an integer. If the number is not an
+    integer (see isInteger()), it is truncated. Returns 0 if the current
+    token is not a number.
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    if (d->type != Number)
+        return 0;
+    return d->numberIsInteger ? d->integer : qint64(d->number);
+}
+
+/*!
+    Returns the current \l Number as a double, or 0 if the current token is
+    not a number.
+*/
+double QJsonStreamReader::toDouble() const
+{
+    if (d->type != Number)
+        return 0;
+    return d->numberIsInteger ? double(d->integer) : d->number;
+}
+
+/*!
+    Returns the value of the current \l Bool, or \c false if the current
+    token is not a Bool.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return d->type == Bool && d->boolean;
+}
+
+/*!
+    Reads the value that starts with the current token and returns it. For a
+    \l StartArray or \l StartObject, this reads the tokens up to the matching
+    \l EndArray or \l EndObject, which becomes the current token. For a
+    \l Name, this reads the value of the member.
+
+    The whole value has to be available. If the reader runs out of data or
+    encounters an error, this function returns an undefined QJsonValue.
+
+    \sa skipValue()
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    switch (d->type) {
+    case Name:
+        readNext();
+        return readValue();
+    case String:
+        return d->text;
+    case Number:
+        if (d->numberIsInteger)
+            return d->integer;
+        return d->number;
+    case Bool:
+        return d->boolean;
+    case Null:
+        return QJsonValue::Null;
+    case StartArray: {
+        QJsonArray array;
+        while (readNext() != EndArray) {
+            if (atEnd())
+                return QJsonValue::Undefined;
+            array.append(readValue());
+        }
+        return array;
+    }
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString name = d->text;
+            readNext();
+            if (atEnd())
+                return QJsonValue::Undefined;
+            object.insert(name, readValue());
+        }
+        if (d->type != EndObject)
+            return QJsonValue::Undefined;
+        return object;
+    }
+    case NoToken:
+    case Invalid:
+    case EndArray:
+    case EndObject:
+    case EndDocument:
+        break;
+    }
+    return QJsonValue::Undefined;
+}
+
+/*!
+    Skips the value that starts with the current token, like readValue()
+    without creating the value. Returns \c false if the reader ran out of data
+    or encountered an error, and \c true otherwise.
+
+    \sa readValue()
+*/
+bool QJsonStreamReader::skipValue()
+{
+    if (d->type == Name && readNext() == NoToken)
+        return false;
+    if (d->type != StartArray && d->type != StartObject)
+        return d->type != Invalid;
+
+    const qsizetype depth = d->containers.size();
+    while (d->containers.size() >= depth) {
+        readNext();
+        if (d->type == NoToken || d->type == Invalid)
+            return false;
+    }
+    return true;
+}
+
+/*!
+    Returns the number of arrays and objects that contain the current token.
+    A \l StartArray or \l StartObject token counts as inside the container it
+    starts, an \l EndArray or \l EndObject token as outside.
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset in the input of the end of the current token, or of
+    the error if there was one.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    if (d->type == Invalid)
+        return d->errorOffset;
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Returns \c true if an error occurred while reading.
+
+    \sa error(), errorString()
+*/
+bool QJsonStreamReader::hasError() const
+{
+    return d->lastError != QJsonParseError::NoError;
+}
+
+/*!
+    Returns the error that occurred, or QJsonParseError::NoError.
+
+    \sa errorString(), currentOffset()
+*/
+QJsonParseError::ParseError QJsonStreamReader::error() const
+{
+    return d->lastError;
+}
+
+/*!
+    Returns a human-readable description of the error that occurred.
+
+    \sa error()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    QJsonParseError error;
+    error.error = d->lastError;
+    return error.errorString();
+}
+
+bool QJsonStreamReaderPrivate::fillBuffer()
+{
+    if (!device || dataComplete)
+        return false;
+
+    if (pos) {
+        buffer.remove(0, pos);
+        bufferOffset += pos;
+        pos = 0;
+    }
+
+    // Read at least as much as there is in the buffer already, so that a
+    // large token isn't rescanned once per small chunk.
+    const qint64 size = qMax(device->bytesAvailable(),
+                             qint64(qMax(buffer.size(), MinimumReadSize)));
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + size);
+    const qint64 read = device->read(buffer.data() + oldSize, size);
+    buffer.resize(oldSize + qMax(read, qint64(0)));
+    return read > 0;
+}
+
+bool QJsonStreamReaderPrivate::atEndOfInput() const
+{
+    if (dataComplete)
+        return true;
+    // a sequential device, like a socket, may always receive more data
+    return device && !device->isSequential() && device->atEnd();
+}
+
+void QJsonStreamReaderPrivate::clearToken()
+{
+    text.clear();
+    numberIsInteger = false;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    if (type == QJsonStreamReader::Invalid || type == QJsonStreamReader::EndDocument)
+        return type;
+
+    clearToken();
+    needMoreData = false;
+    while (true) {
+        Result result = parseToken(false);
+        if (result == NeedMoreData) {
+            if (fillBuffer())
+                continue;
+            if (!atEndOfInput()) {
+                needMoreData = true;
+                type = QJsonStreamReader::NoToken;
+                return type;
+            }
+            result = parseToken(true);
+        }
+        Q_ASSERT(result != NeedMoreData);
+        if (result == Failed)
+            type = QJsonStreamReader::Invalid;
+        return type;
+    }
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::fail(const char *p, QJsonParseError::ParseError error)
+{
+    lastError = error;
+    errorOffset = bufferOffset + (p - buffer.constData());
+    return Failed;
+}
+
+// the error for reaching the end of the input in the current state
+QJsonParseError::ParseError QJsonStreamReaderPrivate::unterminatedError() const
+{
+    if (containers.isEmpty())
+        return QJsonParseError::IllegalValue;
+    if (containers.last() == '[')
+        return QJsonParseError::UnterminatedArray;
+    return QJsonParseError::UnterminatedObject;
+}
+
+static inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseToken(bool final)
+{
+    const char *p = buffer.constData() + pos;
+    const char *const end = buffer.constData() + buffer.size();
+
+    if (!bomChecked) {
+        static const char bom[] = "\xEF\xBB\xBF";
+        const qsizetype available = qMin(end - p, qsizetype(3));
+        if (available < 3 && !final && memcmp(p, bom, available) == 0)
+            return NeedMoreData;
+        if (available == 3 && memcmp(p, bom, 3) == 0)
+            p += 3;
+        bomChecked = true;
+    }
+
+    while (true) {
+        while (p < end && isJsonSpace(*p))
+            ++p;
+        pos = p - buffer.constData();
+
+        if (state == AfterValue && containers.isEmpty()) {
+            // Only check the data that is already there for garbage, so that
+            // the end of the document is reported without waiting for more.
+            if (p < end)
+                return fail(p, QJsonParseError::GarbageAtEnd);
+            state = Finished;
+            type = QJsonStreamReader::EndDocument;
+            return Ok;
+        }
+        if (p == end)
+            return final ? fail(p, unterminatedError()) : NeedMoreData;
+
+        const char c = *p;
+        switch (state) {
+        case AfterValue:
+            if (c == ',') {
+                ++p;
+                state = containers.last() == '[' ? ExpectValue : ExpectName;
+                continue;
+            }
+            if ((c == ']' && containers.last() == '[') || (c == '}' && containers.last() == '{')) {
+                type = c == ']' ? QJsonStreamReader::EndArray : QJsonStreamReader::EndObject;
+                containers.removeLast();
+                pos = p + 1 - buffer.constData();
+                return Ok;
+            }
+            return fail(p, containers.last() == '[' ? QJsonParseError::MissingValueSeparator
+                                                    : QJsonParseError::UnterminatedObject);
+
+        case ExpectValueOrEnd:
+            if (c == ']') {
+                type = QJsonStreamReader::EndArray;
+                containers.removeLast();
+                state = AfterValue;
+                pos = p + 1 - buffer.constData();
+                return Ok;
+            }
+            return parseValue(p, end, final);
+
+        case ExpectValue:
+            return parseValue(p, end, final);
+
+        case ExpectNameOrEnd:
+            if (c == '}') {
+                type = QJsonStreamReader::EndObject;
+                containers.removeLast();
+                state = AfterValue;
+                pos = p + 1 - buffer.constData();
+                return Ok;
+            }
+            return parseName(p, end, final);
+
+        case ExpectName:
+            if (c == '}')
+                return fail(p, QJsonParseError::MissingObject);
+            return parseName(p, end, final);
+
+        case Finished:
+            break;
+        }
+        Q_UNREACHABLE_RETURN(Failed);
+    }
+}
+
+/*
+    member = string name-separator value
+*/
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseName(const char *&p, const char *end, bool final)
+{
+    if (*p != '"')
+        return fail(p, QJsonParseError::UnterminatedObject);
+
+    Result result = parseString(p, end, final);
+    if (result != Ok)
+        return result;
+    while (p < end && isJsonSpace(*p))
+        ++p;
+    if (p == end)
+        return final ? fail(p, QJsonParseError::MissingNameSeparator) : NeedMoreData;
+    if (*p != ':')
+        return fail(p, QJsonParseError::MissingNameSeparator);
+
+    type = QJsonStreamReader::Name;
+    state = ExpectValue;
+    pos = p + 1 - buffer.constData();
+    return Ok;
+}
+
+/*
+    value = false / null / true / object / array / number / string
+*/
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseValue(const char *&p, const char *end, bool final)
+{
+    Result result;
+    switch (*p) {
+    case '[':
+    case '{':
+        if (containers.size() >= NestingLimit)
+            return fail(p, QJsonParseError::DeepNesting);
+        containers.append(*p);
+        if (*p == '[') {
+            type = QJsonStreamReader::StartArray;
+            state = ExpectValueOrEnd;
+        } else {
+            type = QJsonStreamReader::StartObject;
+            state = ExpectNameOrEnd;
+        }
+        pos = p + 1 - buffer.constData();
+        return Ok;
+    case '"':
+        result = parseString(p, end, final);
+        type = QJsonStreamReader::String;
+        break;
+    case 't':
+        result = parseLiteral(p, end, final, "true", 4);
+        type = QJsonStreamReader::Bool;
+        boolean = true;
+        break;
+    case 'f':
+        result = parseLiteral(p, end, final, "false", 5);
+        type = QJsonStreamReader::Bool;
+        boolean = false;
+        break;
+    case 'n':
+        result = parseLiteral(p, end, final, "null", 4);
+        type = QJsonStreamReader::Null;
+        break;
+    case ',':
+        return fail(p, QJsonParseError::IllegalValue);
+    case ']':
+    case '}':
+        return fail(p, QJsonParseError::MissingObject);
+    default:
+        if (*p != '-' && !isAsciiDigit(*p))
+            return fail(p, QJsonParseError::IllegalValue);
+        result = parseNumber(p, end, final);
+        type = QJsonStreamReader::Number;
+        break;
+    }
+
+    if (result != Ok)
+        return result;
+    state = AfterValue;
+    pos = p - buffer.constData();
+    return Ok;
+}
+
+QJsonStreamReaderPrivate::Result
+QJsonStreamReaderPrivate::parseLiteral(const char *&p, const char *end, bool final,
+                                       const char *literal, qsizetype length)
+{
+    if (end - p < length) {
+        if (!final && memcmp(p, literal, end - p) == 0)
+            return NeedMoreData;
+        return fail(p, QJsonParseError::IllegalValue);
+    }
+    if (memcmp(p, literal, length) != 0)
+        return fail(p, QJsonParseError::IllegalValue);
+    p += length;
+    return Ok;
+}
+
+/*
+    number = [ minus ] int [ frac ] [ exp ]
+*/
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseNumber(const char *&p, const char *end, bool final)
+{
+    const char *json = p;
+    bool isInt = true;
+
+    if (json < end && *json == '-')
+        ++json;
+    if (json < end && *json == '0') {
+        ++json;
+    } else {
+        while (json < end && isAsciiDigit(*json))
+            ++json;
+    }
+    if (json < end && *json == '.') {
+        ++json;
+        while (json < end && isAsciiDigit(*json)) {
+            isInt = isInt && *json == '0';
+            ++json;
+        }
+    }
+    if (json < end && (*json == 'e' || *json == 'E')) {
+        isInt = false;
+        ++json;
+        if (json < end && (*json == '-' || *json == '+'))
+            ++json;
+        while (json < end && isAsciiDigit(*json))
+            ++json;
+    }
+
+    // the number may continue in the data that hasn't arrived yet
+    if (json == end && !final)
+        return NeedMoreData;
+
+    const QByteArray digits = QByteArray::fromRawData(p, json - p);
+    bool ok = false;
+    if (isInt) {
+        integer = digits.toLongLong(&ok);
+        numberIsInteger = ok;
+    }
+    if (!ok) {
+        number = digits.toDouble(&ok);
+        if (!ok)
+            return fail(p, QJsonParseError::IllegalNumber);
+        numberIsInteger = convertDoubleTo(number, &integer);
+    }
+    p = json;
+    return Ok;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseString(const char *&p, const char *end, bool final)
+{
+    using namespace QJsonPrivate;
+
+    // find the end of the string first, so that we don't decode it twice if
+    // it's incomplete
+    const char *start = p + 1;
+    const char *json = start;
+    bool hasEscapes = false;
+    while (json < end && *json != '"') {
+        if (*json == '\\') {
+            hasEscapes = true;
+            ++json;
+        }
+        ++json;
+    }
+    if (json >= end)
+        return final ? fail(p, QJsonParseError::UnterminatedString) : NeedMoreData;
+
+    const char *stringEnd = json;
+    if (!hasEscapes) {
+        const QByteArrayView utf8(start, stringEnd - start);
+        if (!QUtf8::isValidUtf8(utf8).isValidUtf8)
+            return fail(p, QJsonParseError::IllegalUTF8String);
+        text = QString::fromUtf8(utf8);
+    } else {
+        text.clear();
+        text.reserve(stringEnd - start);
+        json = start;
+        while (json < stringEnd) {
+            char32_t ch = 0;
+            if (*json == '\\') {
+                if (!scanEscapeSequence(json, stringEnd, &ch))
+                    return fail(json, QJsonParseError::IllegalEscapeSequence);
+            } else if (!scanUtf8Char(json, stringEnd, &ch)) {
+                return fail(json, QJsonParseError::IllegalUTF8String);
+            }
+            text.append(QChar::fromUcs4(ch));
+        }
+    }
+    p = stringEnd + 1;
+    return Ok;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
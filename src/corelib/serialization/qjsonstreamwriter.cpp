@@ -0,0 +1,380 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamwriter.h"
+
+#include "qjsonwriter_p.h"
+
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qlocale.h>
+#include <qvarlengtharray.h>
+#include <private/qnumeric_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+// the amount of output that is collected before it's written to the device
+static constexpr qsizetype FlushThreshold = 16384;
+
+static QByteArray escapedString(QAnyStringView string)
+{
+    return string.visit([](auto s) {
+        if constexpr (std::is_same_v<decltype(s), QStringView>)
+            return Writer::escapedString(s);
+        else
+            return Writer::escapedString(s.toString());
+    });
+}
+
+class QJsonStreamWriterPrivate
+{
+public:
+    struct Container
+    {
+        char type;  // '[' or '{'
+        bool empty;
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Container, 32> containers;
+    bool compact = false;
+    bool afterName = false;
+    bool hasError = false;
+
+    QByteArray &output() { return data ? *data : buffer; }
+    int indent() const { return compact ? 0 : int(containers.size()); }
+
+    void startElement();
+    void startValue();
+    void endValue();
+    void startContainer(char type);
+    void endContainer(char type);
+    void flush();
+};
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \since 6.6
+    \brief The QJsonStreamWriter class writes JSON one value at a time.
+    \ingroup json
+    \reentrant
+
+    QJsonStreamWriter writes JSON to a QIODevice or a QByteArray, without
+    creating a QJsonDocument first. Arrays and objects are started and ended
+    with startArray(), endArray(), startObject() and endObject(). In between,
+    values are written with writeString(), writeDouble(), and the other write
+    functions. In an object, each value must be preceded by writeName().
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 1
+
+    The output is the same as the output of QJsonDocument::toJson() for a
+    document with the same contents, in the format set with setFormat().
+    Unlike QJsonDocument, QJsonStreamWriter can also write a single value of
+    any type at the top level.
+
+    When writing to a device, the writer collects the output and writes it in
+    blocks of a few kilobytes, and when the top-level value is complete. Call
+    flush() to write the output collected so far.
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter, QXmlStreamWriter
+*/
+
+/*!
+    Constructs a QJsonStreamWriter without a device. Use setDevice() before
+    writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a QJsonStreamWriter that writes to \a device.
+
+    \sa setDevice()
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : QJsonStreamWriter()
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a QJsonStreamWriter that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : QJsonStreamWriter()
+{
+    d->data = data;
+}
+
+/*!
+    Destroys the writer, after writing any pending output to the device.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Makes the writer write to \a device, after writing any pending output to
+    the previous device.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the device that the writer writes to, or \nullptr if it has none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Sets the format of the output to \a format. The default is
+    QJsonDocument::Indented. The format should be set before the writing
+    starts.
+
+    \sa format()
+*/
+void QJsonStreamWriter::setFormat(QJsonDocument::JsonFormat format)
+{
+    d->compact = format == QJsonDocument::Compact;
+}
+
+/*!
+    Returns the format of the output.
+
+    \sa setFormat()
+*/
+QJsonDocument::JsonFormat QJsonStreamWriter::format() const
+{
+    return d->compact ? QJsonDocument::Compact : QJsonDocument::Indented;
+}
+
+/*!
+    Starts an array. The values written after this are the elements of the
+    array, up to the matching endArray().
+
+    \sa endArray(), startObject()
+*/
+void QJsonStreamWriter::startArray()
+{
+    d->startContainer('[');
+}
+
+/*!
+    Ends the array that was started last.
+
+    \sa startArray()
+*/
+void QJsonStreamWriter::endArray()
+{
+    d->endContainer('[');
+}
+
+/*!
+    Starts an object. Its members are written after this with writeName()
+    followed by the value, up to the matching endObject().
+
+    \sa endObject(), startArray()
+*/
+void QJsonStreamWriter::startObject()
+{
+    d->startContainer('{');
+}
+
+/*!
+    Ends the object that was started last.
+
+    \sa startObject()
+*/
+void QJsonStreamWriter::endObject()
+{
+    d->endContainer('{');
+}
+
+/*!
+    Writes \a name as the name of the next member of the current object. The
+    next value that is written is the value of the member.
+*/
+void QJsonStreamWriter::writeName(QAnyStringView name)
+{
+    Q_ASSERT_X(!d->containers.isEmpty() && d->containers.last().type == '{' && !d->afterName,
+               "QJsonStreamWriter::writeName", "A name can only be written in an object");
+    d->startElement();
+    QByteArray &out = d->output();
+    out += '"';
+    out += escapedString(name);
+    out += d->compact ? "\":" : "\": ";
+    d->afterName = true;
+}
+
+/*!
+    Writes \a string as a string value.
+*/
+void QJsonStreamWriter::writeString(QAnyStringView string)
+{
+    d->startValue();
+    QByteArray &out = d->output();
+    out += '"';
+    out += escapedString(string);
+    out += '"';
+    d->endValue();
+}
+
+/*!
+    Writes \a value as a number.
+*/
+void QJsonStreamWriter::writeInteger(qint64 value)
+{
+    d->startValue();
+    d->output() += QByteArray::number(value);
+    d->endValue();
+}
+
+/*!
+    Writes \a value as a number. Like QJsonDocument::toJson(), this writes
+    \c null if \a value is infinite or NaN, as JSON can't represent those.
+*/
+void QJsonStreamWriter::writeDouble(double value)
+{
+    d->startValue();
+    if (qIsFinite(value))
+        d->output() += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    else
+        d->output() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \a value as \c true or \c false.
+*/
+void QJsonStreamWriter::writeBool(bool value)
+{
+    d->startValue();
+    d->output() += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeNull()
+{
+    d->startValue();
+    d->output() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \a value, including all elements if it is an array or an object.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    d->startValue();
+    Writer::valueToJson(QCborValue::fromJsonValue(value), d->output(), d->indent(), d->compact);
+    if (d->containers.isEmpty() && !d->compact && (value.isArray() || value.isObject()))
+        d->output() += '\n';
+    d->endValue();
+}
+
+/*!
+    Writes the output collected so far to the device.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->hasError;
+}
+
+// writes what separates the element from the previous one in the container
+void QJsonStreamWriterPrivate::startElement()
+{
+    Container &container = containers.last();
+    QByteArray &out = output();
+    if (!container.empty)
+        out += compact ? "," : ",\n";
+    container.empty = false;
+    if (!compact)
+        out += QByteArray(4 * containers.size(), ' ');
+}
+
+void QJsonStreamWriterPrivate::startValue()
+{
+    if (afterName) {
+        afterName = false;
+        return;
+    }
+    if (containers.isEmpty())
+        return;
+    Q_ASSERT_X(containers.last().type == '[', "QJsonStreamWriter",
+               "A value in an object must be preceded by writeName()");
+    startElement();
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (containers.isEmpty() || buffer.size() >= FlushThreshold)
+        flush();
+}
+
+void QJsonStreamWriterPrivate::startContainer(char type)
+{
+    startValue();
+    QByteArray &out = output();
+    out += type;
+    if (!compact)
+        out += '\n';
+    containers.append({ type, true });
+}
+
+void QJsonStreamWriterPrivate::endContainer(char type)
+{
+    Q_ASSERT_X(!containers.isEmpty() && containers.last().type == type && !afterName,
+               "QJsonStreamWriter", "Mismatched end of an array or object");
+    const bool empty = containers.last().empty;
+    containers.removeLast();
+    QByteArray &out = output();
+    if (!compact) {
+        if (!empty)
+            out += '\n';
+        out += QByteArray(4 * containers.size(), ' ');
+    }
+    out += type == '[' ? ']' : '}';
+    if (containers.isEmpty() && !compact)
+        out += '\n';
+    endValue();
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (!device || buffer.isEmpty())
+        return;
+    if (device->write(buffer) != buffer.size())
+        hasError = true;
+    buffer.truncate(0);
+}
+
+QT_END_NAMESPACE
@@ -1842,6 +1842,11 @@ bool QTextStreamPrivate::getReal(double *f)
     char buf[BufferSize];
     int i = 0;
 
+    // Look the locale's symbols up once, when the first character that
+    // needs them comes along, rather than for every such character
+    QString decimalPoint, exponential, negativeSign, positiveSign, groupSeparator;
+    bool haveSymbols = false;
+
     QChar c;
     while (getChar(&c)) {
         switch (c.unicode()) {
@@ -1865,16 +1870,24 @@ bool QTextStreamPrivate::getReal(double *f)
             input = InputT;
             break;
         default: {
+            if (!haveSymbols) {
+                decimalPoint = locale.decimalPoint().toLower();
+                exponential = locale.exponential().toLower();
+                negativeSign = locale.negativeSign().toLower();
+                positiveSign = locale.positiveSign().toLower();
+                // backward-compatibility: the C locale doesn't skip group separators
+                if (locale != QLocale::c())
+                    groupSeparator = locale.groupSeparator().toLower();
+                haveSymbols = true;
+            }
             QChar lc = c.toLower();
-            if (lc == locale.decimalPoint().toLower())
+            if (lc == decimalPoint)
                 input = InputDot;
-            else if (lc == locale.exponential().toLower())
+            else if (lc == exponential)
                 input = InputExp;
-            else if (lc == locale.negativeSign().toLower()
-                     || lc == locale.positiveSign().toLower())
+            else if (lc == negativeSign || lc == positiveSign)
                 input = InputSign;
-            else if (locale != QLocale::c() // backward-compatibility
-                     && lc == locale.groupSeparator().toLower())
+            else if (!groupSeparator.isEmpty() && lc == groupSeparator)
                 input = InputDigit; // well, it isn't a digit, but no one cares.
             else
                 input = None;
@@ -1920,8 +1933,14 @@ bool QTextStreamPrivate::getReal(double *f)
         *f = -qInf();
         return true;
     }
+    // Convert without allocating: like QString::fromLatin1(buf), stopping at
+    // the first NUL (which a non-Latin-1 character turned into).
+    char16_t number[BufferSize];
+    qsizetype length = 0;
+    for ( ; buf[length]; ++length)
+        number[length] = uchar(buf[length]);
     bool ok;
-    *f = locale.toDouble(QString::fromLatin1(buf), &ok);
+    *f = locale.toDouble(QStringView(number, length), &ok);
     return ok;
 }
 
@@ -293,6 +293,22 @@ int qstricmp(const char *str1, const char *str2)
     return innerCompare(-1, true);
 }
 
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+// Returns a mask of the bytes in \a chunk that are letters from \a first to
+// \a first + 25. Non-ASCII bytes are negative as signed bytes, so signed
+// comparisons are enough.
+static Q_ALWAYS_INLINE __m128i asciiLetters_sse2(__m128i chunk, char first)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(char(first - 1))),
+                         _mm_cmplt_epi8(chunk, _mm_set1_epi8(char(first + 26))));
+}
+
+static Q_ALWAYS_INLINE __m128i asciiLower_sse2(__m128i chunk)
+{
+    return _mm_or_si128(chunk, _mm_and_si128(asciiLetters_sse2(chunk, 'A'), _mm_set1_epi8(0x20)));
+}
+#endif
+
 /*! \relates QByteArray
 
     A safe \c strnicmp() function.
@@ -368,7 +384,19 @@ int qstrnicmp(const char *str1, qsizetype len1, const char *str2, qsizetype len2
     } else {
         // not null-terminated
         const qsizetype len = qMin(len1, len2);
-        for (qsizetype i = 0; i < len; ++i) {
+        qsizetype i = 0;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+        for ( ; len - i >= 16; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s1 + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s2 + i));
+            const __m128i equal = _mm_cmpeq_epi8(asciiLower_sse2(a), asciiLower_sse2(b));
+            if (const uint mask = ~uint(_mm_movemask_epi8(equal)) & 0xffff) {
+                const qsizetype idx = i + qCountTrailingZeroBits(mask);
+                return QtMiscUtils::caseCompareAscii(s1[idx], s2[idx]);
+            }
+        }
+#endif
+        for ( ; i < len; ++i) {
             if (int res = QtMiscUtils::caseCompareAscii(s1[i], s2[i]))
                 return res;
         }
@@ -1924,12 +1952,12 @@ void QByteArray::reallocData(qsizetype alloc, QArrayData::AllocationOption optio
     const bool cannotUseReallocate = d.freeSpaceAtBegin() > 0;
 
     if (d->needsDetach() || cannotUseReallocate) {
-        DataPointer dd(Data::allocate(alloc, option), qMin(alloc, d.size));
+        DataPointer dd(Data::allocate(alloc, option, d.arena()), qMin(alloc, d.size));
         Q_CHECK_PTR(dd.data());
         if (dd.size > 0)
             ::memcpy(dd.data(), d.data(), dd.size);
         dd.data()[dd.size] = 0;
-        d = dd;
+        d.swap(dd);
     } else {
         d->reallocate(alloc, option);
     }
@@ -3183,12 +3211,21 @@ QByteArray QByteArray::mid(qsizetype pos, qsizetype len) const
 */
 
 template <typename T>
-static QByteArray toCase_template(T &input, uchar (*lookup)(uchar))
+static QByteArray toCase_template(T &input, uchar (*lookup)(uchar), char firstLetter)
 {
     // find the first bad character in input
     const char *orig_begin = input.constBegin();
     const char *firstBad = orig_begin;
     const char *e = input.constEnd();
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+    for ( ; e - firstBad >= 16; firstBad += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(firstBad));
+        if (const uint mask = _mm_movemask_epi8(asciiLetters_sse2(chunk, firstLetter))) {
+            firstBad += qCountTrailingZeroBits(mask);
+            break;
+        }
+    }
+#endif
     for ( ; firstBad != e ; ++firstBad) {
         uchar ch = uchar(*firstBad);
         uchar converted = lookup(ch);
@@ -3204,6 +3241,15 @@ static QByteArray toCase_template(T &input, uchar (*lookup)(uchar))
     char *b = s.begin();            // will detach if necessary
     char *p = b + (firstBad - orig_begin);
     e = b + s.size();
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+    // the letters to convert differ from their counterparts in the 0x20 bit
+    for ( ; e - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i letters = asciiLetters_sse2(chunk, firstLetter);
+        chunk = _mm_xor_si128(chunk, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), chunk);
+    }
+#endif
     for ( ; p != e; ++p)
         *p = char(lookup(uchar(*p)));
     return s;
@@ -3211,12 +3257,12 @@ static QByteArray toCase_template(T &input, uchar (*lookup)(uchar))
 
 QByteArray QByteArray::toLower_helper(const QByteArray &a)
 {
-    return toCase_template(a, asciiLower);
+    return toCase_template(a, asciiLower, 'A');
 }
 
 QByteArray QByteArray::toLower_helper(QByteArray &a)
 {
-    return toCase_template(a, asciiLower);
+    return toCase_template(a, asciiLower, 'A');
 }
 
 /*!
@@ -3233,12 +3279,12 @@ QByteArray QByteArray::toLower_helper(QByteArray &a)
 
 QByteArray QByteArray::toUpper_helper(const QByteArray &a)
 {
-    return toCase_template(a, asciiUpper);
+    return toCase_template(a, asciiUpper, 'a');
 }
 
 QByteArray QByteArray::toUpper_helper(QByteArray &a)
 {
-    return toCase_template(a, asciiUpper);
+    return toCase_template(a, asciiUpper, 'a');
 }
 
 /*! \fn void QByteArray::clear()
@@ -9,6 +9,13 @@
 #include "qdebug.h"
 #include "qlocale_p.h"
 #include "qthreadstorage.h"
+#if QT_CONFIG(thread)
+#include "qsemaphore.h"
+#include "qthreadpool.h"
+#endif
+
+#include <algorithm>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -34,6 +41,66 @@ public:
 }
 Q_GLOBAL_STATIC(QThreadStorage<GenerationalCollator>, defaultCollator)
 
+/*
+    Calls \a function(begin, end) for consecutive ranges covering [0, \a count).
+    Large counts are split into batches that run on the calling thread and on
+    the global thread pool. The calling thread keeps taking batches until none
+    are left, so this makes progress even when called from a busy pool thread.
+*/
+template <typename Function>
+static void forEachBatch(qsizetype count, Function function)
+{
+    constexpr qsizetype BatchSize = 256;
+#if QT_CONFIG(thread)
+    const qsizetype batchCount = (count + BatchSize - 1) / BatchSize;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const qsizetype helpers = qMin<qsizetype>(pool->maxThreadCount(), batchCount) - 1;
+    if (helpers > 0) {
+        struct State
+        {
+            QAtomicInteger<qsizetype> next = 0;
+            QSemaphore done;
+        };
+        // helpers that start late find no batch left, and touch only the state
+        const auto state = std::make_shared<State>();
+        const auto work = [=] {
+            qsizetype batch;
+            while ((batch = state->next.fetchAndAddRelaxed(1)) < batchCount) {
+                const qsizetype begin = batch * BatchSize;
+                function(begin, qMin(begin + BatchSize, count));
+                state->done.release();
+            }
+        };
+        for (qsizetype i = 0; i < helpers; ++i)
+            pool->start(work);
+        work();
+        state->done.acquire(int(batchCount));
+        return;
+    }
+#else
+    Q_UNUSED(BatchSize);
+#endif
+    function(0, count);
+}
+
+int QCollatorPrivate::cachedCompare(const QCollator &collator, QStringView s1, QStringView s2)
+{
+    Q_ASSERT(sortKeyCache);
+    const auto keyFor = [&](const QString &string) {
+        {
+            QMutexLocker locker(&sortKeyCache->mutex);
+            if (const QCollatorSortKey *key = sortKeyCache->keys.object(string))
+                return *key;
+        }
+        // generating the key is the expensive part, don't hold the lock
+        QCollatorSortKey key = collator.sortKey(string);
+        QMutexLocker locker(&sortKeyCache->mutex);
+        sortKeyCache->keys.insert(string, new QCollatorSortKey(key));
+        return key;
+    };
+    return keyFor(s1.toString()).compare(keyFor(s2.toString()));
+}
+
 /*!
     \class QCollator
     \inmodule QtCore
@@ -163,9 +230,17 @@ void QCollator::detach()
 {
     if (d->ref.loadRelaxed() != 1) {
         QCollatorPrivate *x = new QCollatorPrivate(d->locale);
+        x->caseSensitivity = d->caseSensitivity;
+        x->numericMode = d->numericMode;
+        x->ignorePunctuation = d->ignorePunctuation;
+        if (d->sortKeyCache)
+            x->sortKeyCache = std::make_unique<QCollatorPrivate::SortKeyCache>(sortKeyCacheCapacity());
         if (!d->ref.deref())
             delete d;
         d = x;
+    } else if (d->sortKeyCache) {
+        // the keys are about to become stale
+        d->sortKeyCache->keys.clear();
     }
     // All callers need this, because about to modify the object:
     d->dirty = true;
@@ -285,6 +360,51 @@ bool QCollator::ignorePunctuation() const
     return d->ignorePunctuation;
 }
 
+/*!
+    \since 6.6
+
+    Sets the number of sort keys the collator caches to \a capacity.
+
+    When the capacity is greater than zero, compare() generates sort keys for
+    the strings it compares and keeps the \a capacity most recently used ones.
+    This speeds up comparing the same strings over and over, for example when
+    a model sorts its rows repeatedly, at the cost of generating a key on the
+    first comparison of each string, which is slower than comparing directly.
+
+    The cache is off (a capacity of 0) by default. It is shared between
+    threads using the same collator, and cleared when the collator's settings
+    change.
+
+    \note The cache is only used when Qt is built with ICU, or with the POSIX
+    implementation in a locale other than C.
+
+    \sa sortKeyCacheCapacity(), sortKey()
+*/
+void QCollator::setSortKeyCacheCapacity(qsizetype capacity)
+{
+    capacity = qMax<qsizetype>(capacity, 0);
+    if (capacity == sortKeyCacheCapacity())
+        return;
+
+    detach();
+    if (capacity)
+        d->sortKeyCache = std::make_unique<QCollatorPrivate::SortKeyCache>(capacity);
+    else
+        d->sortKeyCache.reset();
+}
+
+/*!
+    \since 6.6
+
+    Returns the number of sort keys compare() caches.
+
+    \sa setSortKeyCacheCapacity()
+*/
+qsizetype QCollator::sortKeyCacheCapacity() const
+{
+    return d->sortKeyCache ? d->sortKeyCache->keys.maxCost() : 0;
+}
+
 /*!
     \since 5.13
     \fn bool QCollator::operator()(QStringView s1, QStringView s2) const
@@ -372,6 +492,69 @@ QCollatorSortKey QCollator::defaultSortKey(QStringView key)
     \note Not supported with the C (a.k.a. POSIX) locale on Darwin.
 */
 
+/*!
+    \since 6.6
+
+    Returns the sort keys of \a strings, in the same order.
+
+    This is equivalent to calling sortKey() for each of the strings, but large
+    lists are split into batches that are processed in parallel on the global
+    QThreadPool.
+
+    \sa sortKey(), sort()
+*/
+QList<QCollatorSortKey> QCollator::sortKeys(const QStringList &strings) const
+{
+    // initialize now, rather than concurrently from each sortKey() call
+    d->ensureInitialized();
+
+    QList<QCollatorSortKey> keys(strings.size(), QCollatorSortKey(nullptr));
+    QCollatorSortKey *out = keys.data();
+    forEachBatch(strings.size(), [this, &strings, out](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i)
+            out[i] = sortKey(strings.at(i));
+    });
+    return keys;
+}
+
+/*!
+    \since 6.6
+
+    Sorts \a strings in the order of this collator. Strings that compare
+    equal keep their relative order.
+
+    The result is the same as that of std::stable_sort() with the collator as
+    the comparison function, but each string is collated only once: the sort
+    keys are generated with sortKeys() and the strings sorted by their keys.
+
+    \sa sortKeys(), compare()
+*/
+void QCollator::sort(QStringList &strings) const
+{
+    if (strings.size() < 2)
+        return;
+
+    d->ensureInitialized();
+    if (d->isC()) {
+        // the C locale's sort keys don't follow the case sensitivity setting
+        std::stable_sort(strings.begin(), strings.end(), *this);
+        return;
+    }
+
+    const QList<QCollatorSortKey> keys = sortKeys(strings);
+    QList<qsizetype> order(strings.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](qsizetype lhs, qsizetype rhs) {
+        return keys.at(lhs).compare(keys.at(rhs)) < 0;
+    });
+
+    QStringList sorted;
+    sorted.reserve(strings.size());
+    for (qsizetype i : std::as_const(order))
+        sorted.append(std::move(strings[i]));
+    strings = std::move(sorted);
+}
+
 /*!
     \class QCollatorSortKey
     \inmodule QtCore
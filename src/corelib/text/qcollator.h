@@ -38,6 +38,8 @@ private:
     QCollatorSortKey();
 };
 
+Q_DECLARE_SHARED(QCollatorSortKey)
+
 class Q_CORE_EXPORT QCollator
 {
 public:
@@ -82,6 +84,11 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    QList<QCollatorSortKey> sortKeys(const QStringList &strings) const;
+    void sort(QStringList &strings) const;
+
+    void setSortKeyCacheCapacity(qsizetype capacity);
+    qsizetype sortKeyCacheCapacity() const;
 
     static int defaultCompare(QStringView s1, QStringView s2);
     static QCollatorSortKey defaultSortKey(QStringView key);
@@ -92,7 +99,6 @@ private:
     void detach();
 };
 
-Q_DECLARE_SHARED(QCollatorSortKey)
 Q_DECLARE_SHARED(QCollator)
 
 QT_END_NAMESPACE
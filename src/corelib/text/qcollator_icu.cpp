@@ -81,6 +81,8 @@ int QCollator::compare(QStringView s1, QStringView s2) const
     d->ensureInitialized();
 
     if (d->collator) {
+        if (d->sortKeyCache)
+            return d->cachedCompare(*this, s1, s2);
         // truncating sizes (QTBUG-105038)
         return ucol_strcoll(d->collator,
                             reinterpret_cast<const UChar *>(s1.data()), s1.size(),
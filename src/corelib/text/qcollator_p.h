@@ -19,6 +19,10 @@
 #include <QtCore/private/qglobal_p.h>
 #include "qcollator.h"
 #include <QList>
+#include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
+
+#include <memory>
 #if QT_CONFIG(icu)
 #include <unicode/ucol.h>
 #elif defined(Q_OS_MACOS)
@@ -65,6 +69,15 @@ public:
 
     CollatorType collator = NoCollator;
 
+    // Least recently used sort keys, see QCollator::setSortKeyCacheCapacity()
+    struct SortKeyCache
+    {
+        explicit SortKeyCache(qsizetype capacity) : keys(capacity) {}
+        QMutex mutex;
+        QCache<QString, QCollatorSortKey> keys;
+    };
+    std::unique_ptr<SortKeyCache> sortKeyCache;
+
     QCollatorPrivate(const QLocale &locale) : locale(locale) {}
     ~QCollatorPrivate() { cleanup(); }
     bool isC() { return locale.language() == QLocale::C; }
@@ -80,6 +93,8 @@ public:
             init();
     }
 
+    int cachedCompare(const QCollator &collator, QStringView s1, QStringView s2);
+
     // Implemented by each back-end, in its own way:
     void init();
     void cleanup();
@@ -53,6 +53,9 @@ int QCollator::compare(QStringView s1, QStringView s2) const
 
     d->ensureInitialized();
 
+    if (d->sortKeyCache)
+        return d->cachedCompare(*this, s1, s2);
+
     QVarLengthArray<wchar_t> array1, array2;
     stringToWCharArray(array1, s1);
     stringToWCharArray(array2, s2);
@@ -4099,6 +4099,14 @@ bool QLocaleData::numberToCLocale(QStringView s, QLocale::NumberOptions number_o
     s = s.trimmed();
     if (s.size() < 1)
         return false;
+
+    // Only the slow path below implements these options' checks:
+    constexpr QLocale::NumberOptions checkedOptions =
+            QLocale::RejectLeadingZeroInExponent | QLocale::RejectTrailingZeroesAfterDot;
+    if (!(number_options & checkedOptions) && asciiNumberToCLocale(s, mode, result))
+        return true;
+    result->clear();
+
     NumericTokenizer tokens(s, numericData(mode), mode);
 
     // Digit-grouping details (all modes):
@@ -4201,6 +4209,59 @@ bool QLocaleData::numberToCLocale(QStringView s, QLocale::NumberOptions number_o
     return true;
 }
 
+/*
+    Fast path of numberToCLocale() for the usual case of a number written with
+    ASCII digits and signs and, if the locale uses them, '.' for the decimal
+    point and 'e' for the exponent: these convert to the C locale one to one,
+    without the tokenizer. Returns false for anything else (grouping, other
+    digits, inf and nan, ...), leaving numberToCLocale() to handle it; true does
+    not mean the number is valid, only that the C locale parser can tell.
+
+    The trimmed \a s must not be empty.
+*/
+bool QLocaleData::asciiNumberToCLocale(QStringView s, NumberMode mode, CharBuff *result) const
+{
+    Q_ASSERT(!s.isEmpty());
+    bool acceptDecimal = false;
+    bool acceptExponent = false;
+    if (mode != IntegerMode) {
+        if (this == c()) {
+            acceptDecimal = true;
+            acceptExponent = mode == DoubleScientificMode;
+#ifndef QT_NO_SYSTEMLOCALE
+        } else if (this == &systemLocaleData) {
+            // the system may override the separators, see numericData()
+#endif
+        } else {
+            acceptDecimal = decimalSeparator().viewData(single_character_data) == u".";
+            acceptExponent = mode == DoubleScientificMode
+                    && exponential().viewData(single_character_data)
+                               .compare(u"e", Qt::CaseInsensitive) == 0;
+        }
+    }
+
+    result->resize(s.size() + 1);
+    char *out = result->data();
+    bool seenDecimal = false;
+    bool seenExponent = false;
+    for (QChar ch : s) {
+        const char16_t c = ch.unicode();
+        if (isAsciiDigit(c) || c == u'+' || c == u'-') {
+            *out++ = char(c);
+        } else if (c == u'.' && acceptDecimal && !seenDecimal && !seenExponent) {
+            seenDecimal = true;
+            *out++ = '.';
+        } else if ((c | 0x20) == u'e' && acceptExponent && !seenExponent) {
+            seenExponent = true;
+            *out++ = 'e';
+        } else {
+            return false;
+        }
+    }
+    *out = '\0';
+    return true;
+}
+
 bool QLocaleData::validateChars(QStringView str, NumberMode numMode, QByteArray *buff,
                                 int decDigits, QLocale::NumberOptions number_options) const
 {
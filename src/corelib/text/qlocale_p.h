@@ -313,6 +313,8 @@ public:
 
     [[nodiscard]] bool numberToCLocale(QStringView s, QLocale::NumberOptions number_options,
                                        NumberMode mode, CharBuff *result) const;
+    [[nodiscard]] bool asciiNumberToCLocale(QStringView s, NumberMode mode,
+                                            CharBuff *result) const;
 
     struct NumericData
     {
@@ -84,6 +84,35 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
     if (form == QLocaleData::DFSignificantDigits && precision == 0)
         precision = 1; // 0 significant digits is silently converted to 1
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L && !defined(QT_BOOTSTRAPPED)
+    // The standard library's shortest round-trip conversion is considerably
+    // faster than libdouble-conversion's. It gives us "-d.ddde-dd", which we
+    // take apart into the sign, digits and decimal point position.
+    if (precision == QLocale::FloatingPointShortest
+            && bufSize >= std::numeric_limits<double>::max_digits10) {
+        char scientific[32]; // at most 17 digits, '-', '.' and "e-308"
+        const auto r = std::to_chars(scientific, scientific + sizeof scientific, d,
+                                     std::chars_format::scientific);
+        Q_ASSERT(r.ec == std::errc{});
+        const char *p = scientific;
+        const char *end = r.ptr;
+        sign = *p == '-';
+        if (sign)
+            ++p;
+        const char *exponent = std::find(p, end, 'e');
+        Q_ASSERT(exponent + 2 < end);
+        length = 0;
+        for ( ; p != exponent; ++p) {
+            if (*p != '.')
+                buf[length++] = *p;
+        }
+        int exponentValue = 0;
+        std::from_chars(exponent + 2, end, exponentValue);
+        decpt = (exponent[1] == '-' ? -exponentValue : exponentValue) + 1;
+        return;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
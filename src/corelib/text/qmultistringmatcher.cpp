@@ -0,0 +1,417 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmultistringmatcher.h"
+
+#include <private/qstringiterator_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \brief The QMultiStringMatcher class finds all occurrences of a set of
+    strings in a single pass over a text.
+
+    \since 6.6
+    \ingroup tools
+    \ingroup string-processing
+    \reentrant
+
+    Searching a text for each of many strings with QStringMatcher or
+    QString::indexOf() means one pass over the text per string. A
+    QMultiStringMatcher compiles the whole set of patterns into an
+    automaton once, and then finds the occurrences of all of them in one
+    pass whose cost doesn't depend on the number of patterns.
+
+    Create a QMultiStringMatcher with the list of patterns and the case
+    sensitivity, then call matches() with the text to search. Each
+    QMultiStringMatcher::Match holds the position and the length of the
+    occurrence in the text, and the index of the pattern in patterns().
+    Overlapping occurrences, and occurrences of patterns inside other
+    patterns, are all reported.
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 0
+
+    The text can be a QStringView, or a QByteArrayView holding UTF-8. In
+    the latter case, the positions and lengths of the matches count bytes.
+    Empty patterns never match.
+
+    Case-insensitive matching uses the simple case folding of
+    QChar::toCaseFolded() on both the patterns and QStringView texts. For
+    QByteArrayView texts, only ASCII letters are folded: non-ASCII
+    characters only match if they are already case-folded in the text.
+
+    \sa QStringMatcher, QByteArrayMatcher, QLatin1StringMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.6
+
+    \brief The Match struct describes an occurrence of a pattern found by
+    QMultiStringMatcher::matches().
+
+    \variable QMultiStringMatcher::Match::position
+    \brief the position of the occurrence in the text
+
+    \variable QMultiStringMatcher::Match::length
+    \brief the length of the occurrence in the text
+
+    \variable QMultiStringMatcher::Match::patternIndex
+    \brief the index of the matched pattern in QMultiStringMatcher::patterns()
+*/
+
+/*
+    The automaton is an Aho-Corasick automaton turned into a dense DFA, on
+    the UTF-8 encoding of the patterns. To keep the table small, the bytes
+    are mapped to equivalence classes first: every byte that appears in no
+    pattern is in class 0. The transitions store the offset of the row of
+    the next state, with OutputFlag set if at least one pattern ends in that
+    state, so that the matching loops are one table lookup per byte.
+*/
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    static constexpr quint32 OutputFlag = 0x80000000U;
+
+    QMultiStringMatcherPrivate(const QStringList &patterns, Qt::CaseSensitivity cs);
+
+    void addMatches(QList<QMultiStringMatcher::Match> *matches, quint32 row, qsizetype end,
+                    const QList<qsizetype> &lengths) const;
+
+    QStringList patterns;
+    Qt::CaseSensitivity cs;
+
+    uchar classes[256] = {};
+    qsizetype classCount = 1;
+    QList<quint32> transitions;
+
+    QList<qint32> terminalPattern;      // per state: the first pattern ending in it, or -1
+    QList<qint32> dictionaryLink;       // per state: the longest suffix state ending a pattern
+    QList<qint32> nextDuplicate;        // per pattern: the next pattern with the same text
+    QList<qsizetype> utf16Lengths;
+    QList<qsizetype> utf8Lengths;
+};
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+static qsizetype encodeUtf8(char32_t c, uchar *out) noexcept
+{
+    if (c < 0x80) {
+        out[0] = uchar(c);
+        return 1;
+    }
+    if (c < 0x800) {
+        out[0] = uchar(0xc0 | (c >> 6));
+        out[1] = uchar(0x80 | (c & 0x3f));
+        return 2;
+    }
+    if (c < 0x10000) {
+        out[0] = uchar(0xe0 | (c >> 12));
+        out[1] = uchar(0x80 | ((c >> 6) & 0x3f));
+        out[2] = uchar(0x80 | (c & 0x3f));
+        return 3;
+    }
+    out[0] = uchar(0xf0 | (c >> 18));
+    out[1] = uchar(0x80 | ((c >> 12) & 0x3f));
+    out[2] = uchar(0x80 | ((c >> 6) & 0x3f));
+    out[3] = uchar(0x80 | (c & 0x3f));
+    return 4;
+}
+
+// Returns the bytes the automaton must recognize for \a pattern. Lone
+// surrogates become U+FFFD, as they do when matching QStringView texts.
+static QByteArray patternBytes(QStringView pattern, Qt::CaseSensitivity cs)
+{
+    QByteArray result;
+    result.reserve(pattern.size());
+    QStringIterator it(pattern);
+    while (it.hasNext()) {
+        char32_t c = it.next();
+        if (cs == Qt::CaseInsensitive)
+            c = QChar::toCaseFolded(c);
+        uchar bytes[4];
+        result.append(reinterpret_cast<const char *>(bytes), encodeUtf8(c, bytes));
+    }
+    return result;
+}
+
+QMultiStringMatcherPrivate::QMultiStringMatcherPrivate(const QStringList &patterns,
+                                                       Qt::CaseSensitivity cs)
+    : patterns(patterns), cs(cs)
+{
+    QByteArrayList encoded;
+    encoded.reserve(patterns.size());
+    utf16Lengths.reserve(patterns.size());
+    utf8Lengths.reserve(patterns.size());
+    for (const QString &pattern : patterns) {
+        encoded.append(patternBytes(pattern, cs));
+        utf16Lengths.append(pattern.size());
+        utf8Lengths.append(encoded.constLast().size());
+        for (char c : std::as_const(encoded.constLast())) {
+            if (!classes[uchar(c)])
+                classes[uchar(c)] = uchar(classCount++);
+        }
+    }
+    // UTF-8 never uses 0xc0, 0xc1 and 0xf5 to 0xff, so the classes fit
+    Q_ASSERT(classCount <= 256);
+    if (cs == Qt::CaseInsensitive) {
+        // the patterns are folded: fold the ASCII letters of the text too
+        for (uchar c = 'A'; c <= 'Z'; ++c)
+            classes[c] = classes[c + 'a' - 'A'];
+    }
+
+    // Build the trie, with -1 for the missing transitions
+    QList<qint32> go(classCount, -1);
+    terminalPattern.append(-1);
+    nextDuplicate.resize(patterns.size(), -1);
+    for (qsizetype i = 0; i < encoded.size(); ++i) {
+        qint32 state = 0;
+        for (char c : std::as_const(encoded.at(i))) {
+            const qsizetype slot = state * classCount + classes[uchar(c)];
+            if (go.at(slot) < 0) {
+                go[slot] = qint32(terminalPattern.size());
+                terminalPattern.append(-1);
+                go.resize(go.size() + classCount, -1);
+            }
+            state = go.at(slot);
+        }
+        if (state == 0)
+            continue;           // empty pattern
+        qint32 *link = &terminalPattern[state];
+        while (*link >= 0)
+            link = &nextDuplicate[*link];
+        *link = qint32(i);
+    }
+
+    // Compute the failure links breadth-first, and replace the missing
+    // transitions with those of the failure state
+    const qsizetype stateCount = terminalPattern.size();
+    Q_ASSERT(stateCount * classCount < qsizetype(OutputFlag));
+    QList<qint32> failure(stateCount, 0);
+    dictionaryLink.resize(stateCount, -1);
+    QList<qint32> queue;
+    queue.reserve(stateCount);
+    for (qsizetype c = 0; c < classCount; ++c) {
+        if (go.at(c) < 0)
+            go[c] = 0;
+        else
+            queue.append(go.at(c));
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const qint32 state = queue.at(head);
+        const qint32 fallback = failure.at(state);
+        for (qsizetype c = 0; c < classCount; ++c) {
+            const qsizetype slot = state * classCount + c;
+            const qint32 fallbackNext = go.at(fallback * classCount + c);
+            const qint32 next = go.at(slot);
+            if (next < 0) {
+                go[slot] = fallbackNext;
+                continue;
+            }
+            failure[next] = fallbackNext;
+            dictionaryLink[next] = terminalPattern.at(fallbackNext) >= 0
+                    ? fallbackNext : dictionaryLink.at(fallbackNext);
+            queue.append(next);
+        }
+    }
+
+    transitions.resize(go.size());
+    for (qsizetype i = 0; i < go.size(); ++i) {
+        const qint32 next = go.at(i);
+        const bool output = terminalPattern.at(next) >= 0 || dictionaryLink.at(next) >= 0;
+        transitions[i] = quint32(next * classCount) | (output ? OutputFlag : 0);
+    }
+}
+
+void QMultiStringMatcherPrivate::addMatches(QList<QMultiStringMatcher::Match> *matches,
+                                            quint32 row, qsizetype end,
+                                            const QList<qsizetype> &lengths) const
+{
+    qint32 state = qint32(row / classCount);
+    if (terminalPattern.at(state) < 0)
+        state = dictionaryLink.at(state);
+    for ( ; state >= 0; state = dictionaryLink.at(state)) {
+        for (qint32 i = terminalPattern.at(state); i >= 0; i = nextDuplicate.at(i))
+            matches->append({ end - lengths.at(i), lengths.at(i), i });
+    }
+}
+
+/*!
+    Constructs a matcher without patterns, which finds nothing.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate({}, Qt::CaseSensitive))
+{
+}
+
+/*!
+    Constructs a matcher that finds the occurrences of any of the
+    \a patterns, with case sensitivity \a cs.
+
+    The cost of the construction grows with the total length of the
+    patterns; reuse the matcher for as many texts as possible.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other. The automaton is shared, not copied.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Assigns \a other to this matcher, and returns a reference to it.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher, and returns a reference to it.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Sets the patterns to search for to \a patterns, and rebuilds the
+    automaton.
+
+    \sa patterns()
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d.reset(new QMultiStringMatcherPrivate(patterns, d->cs));
+}
+
+/*!
+    Returns the patterns the matcher searches for. The
+    QMultiStringMatcher::Match::patternIndex of a match is an index in this
+    list.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity of the matching to \a cs, and rebuilds the
+    automaton if it changes.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        d.reset(new QMultiStringMatcherPrivate(d->patterns, cs));
+}
+
+/*!
+    Returns the case sensitivity of the matching.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Returns the occurrences of the patterns in \a haystack, sorted by the
+    position where they end. Occurrences that end at the same position are
+    sorted from the longest to the shortest.
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QStringView haystack) const
+{
+    constexpr quint32 OutputFlag = QMultiStringMatcherPrivate::OutputFlag;
+    const quint32 *table = d->transitions.constData();
+    const uchar *classes = d->classes;
+    const bool caseInsensitive = d->cs == Qt::CaseInsensitive;
+    QList<Match> result;
+    quint32 row = 0;
+
+    const char16_t *begin = haystack.utf16();
+    const char16_t *end = begin + haystack.size();
+    const auto step = [&](uchar byte, const char16_t *p) {
+        const quint32 next = table[row + classes[byte]];
+        row = next & ~OutputFlag;
+        if (Q_UNLIKELY(next & OutputFlag))
+            d->addMatches(&result, row, p - begin, d->utf16Lengths);
+    };
+    for (const char16_t *p = begin; p != end; ) {
+        char32_t c = *p++;
+        if (c < 0x80) {
+            step(uchar(c), p);
+            continue;
+        }
+        if (QChar::isHighSurrogate(c) && p != end && QChar::isLowSurrogate(*p))
+            c = QChar::surrogateToUcs4(char16_t(c), *p++);
+        else if (QChar::isSurrogate(c))
+            c = QChar::ReplacementCharacter;
+        if (caseInsensitive)
+            c = QChar::toCaseFolded(c);
+        uchar bytes[4];
+        const qsizetype count = encodeUtf8(c, bytes);
+        for (qsizetype i = 0; i < count; ++i)
+            step(bytes[i], p);
+    }
+    return result;
+}
+
+/*!
+    \overload
+
+    Returns the occurrences of the patterns in the UTF-8 text \a haystack.
+    The positions and lengths of the matches are in bytes.
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QByteArrayView haystack) const
+{
+    constexpr quint32 OutputFlag = QMultiStringMatcherPrivate::OutputFlag;
+    const quint32 *table = d->transitions.constData();
+    const uchar *classes = d->classes;
+    QList<Match> result;
+    quint32 row = 0;
+
+    const uchar *data = reinterpret_cast<const uchar *>(haystack.data());
+    for (qsizetype i = 0; i < haystack.size(); ++i) {
+        const quint32 next = table[row + classes[data[i]]];
+        row = next & ~OutputFlag;
+        if (Q_UNLIKELY(next & OutputFlag))
+            d->addMatches(&result, row, i + 1, d->utf8Lengths);
+    }
+    return result;
+}
+
+/*!
+    \fn QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(const QString &haystack) const
+    \overload
+*/
+
+/*!
+    \fn QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(const QByteArray &haystack) const
+    \overload
+*/
+
+QT_END_NAMESPACE
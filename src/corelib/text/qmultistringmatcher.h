@@ -0,0 +1,69 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMULTISTRINGMATCHER_H
+#define QMULTISTRINGMATCHER_H
+
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMultiStringMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiStringMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position;
+        qsizetype length;
+        qsizetype patternIndex;
+
+        friend constexpr bool operator==(const Match &lhs, const Match &rhs) noexcept
+        {
+            return lhs.position == rhs.position && lhs.length == rhs.length
+                    && lhs.patternIndex == rhs.patternIndex;
+        }
+        friend constexpr bool operator!=(const Match &lhs, const Match &rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    QMultiStringMatcher();
+    explicit QMultiStringMatcher(const QStringList &patterns,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other);
+    QMultiStringMatcher(QMultiStringMatcher &&other) noexcept = default;
+    ~QMultiStringMatcher();
+
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QMultiStringMatcher)
+
+    void swap(QMultiStringMatcher &other) noexcept { d.swap(other.d); }
+
+    void setPatterns(const QStringList &patterns);
+    QStringList patterns() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const;
+
+    QList<Match> matches(QStringView haystack) const;
+    QList<Match> matches(QByteArrayView haystack) const;
+    QList<Match> matches(const QString &haystack) const
+    { return matches(QStringView(haystack)); }
+    QList<Match> matches(const QByteArray &haystack) const
+    { return matches(QByteArrayView(haystack)); }
+
+private:
+    QExplicitlySharedDataPointer<QMultiStringMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+Q_DECLARE_TYPEINFO(QMultiStringMatcher::Match, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QMULTISTRINGMATCHER_H
@@ -4,7 +4,9 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qregularexpression.h"
+#include "qregularexpression_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -700,6 +702,30 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    The compiled (and JIT-compiled) PCRE code of a pattern, together with the
+    information we extract from it. It never changes once created, so all the
+    QRegularExpression objects with the same pattern and pattern options, in
+    any thread, share it through the cache of compiled patterns.
+*/
+struct QRegularExpressionCode : QSharedData
+{
+    QRegularExpressionCode(const QString &pattern,
+                           QRegularExpression::PatternOptions patternOptions);
+    ~QRegularExpressionCode();
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCode)
+
+    void getPatternInfo(const QString &pattern);
+    void optimizePattern();
+    qsizetype size() const;
+
+    pcre2_code_16 *compiledPattern = nullptr;
+    int errorCode = 0;
+    qsizetype errorOffset = -1;
+    int capturingCount = 0;
+    bool usingCrLfNewlines = false;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -708,8 +734,6 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
-    void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -732,9 +756,10 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is owned by code, possibly shared with other privates;
+    // the members below are copied from it. When the private is copied (i.e.
+    // a detach happened) they are all reset
+    QExplicitlySharedDataPointer<QRegularExpressionCode> code;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -844,10 +869,10 @@ QRegularExpressionPrivate::~QRegularExpressionPrivate()
     \internal
 
     Copies the private, which means copying only the pattern and the pattern
-    options. The compiledPattern pointer is NOT copied (we
-    do not own it any more), and in general all the members set when
-    compiling a pattern are set to default values. isDirty is set back to true
-    so that the pattern has to be recompiled again.
+    options. The compiled code is NOT shared with \a other, and in general
+    all the members set when compiling a pattern are set to default values.
+    isDirty is set back to true so that the pattern has to be compiled again
+    (which normally finds it in the cache of compiled patterns).
 */
 QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPrivate &other)
     : QSharedData(other),
@@ -868,7 +893,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    code.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -878,17 +903,13 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
 
 /*!
     \internal
+
+    Compiles \a pattern with the \a patternOptions, and JIT-compiles it if
+    the JIT is enabled.
 */
-void QRegularExpressionPrivate::compilePattern()
+QRegularExpressionCode::QRegularExpressionCode(const QString &pattern,
+                                               QRegularExpression::PatternOptions patternOptions)
 {
-    const QMutexLocker lock(&mutex);
-
-    if (!isDirty)
-        return;
-
-    isDirty = false;
-    cleanCompiledPattern();
-
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
@@ -909,13 +930,167 @@ void QRegularExpressionPrivate::compilePattern()
     }
 
     optimizePattern();
-    getPatternInfo();
+    getPatternInfo(pattern);
+}
+
+/*!
+    \internal
+*/
+QRegularExpressionCode::~QRegularExpressionCode()
+{
+    pcre2_code_free_16(compiledPattern);
 }
 
 /*!
     \internal
+
+    Returns the memory used by the compiled pattern, in bytes.
 */
-void QRegularExpressionPrivate::getPatternInfo()
+qsizetype QRegularExpressionCode::size() const
+{
+    size_t codeSize = 0;
+    size_t jitSize = 0;
+    if (compiledPattern) {
+        pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_SIZE, &codeSize);
+        pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JITSIZE, &jitSize);
+    }
+    return qsizetype(sizeof(*this) + codeSize + jitSize);
+}
+
+namespace {
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+
+    friend bool operator==(const QRegularExpressionCacheKey &lhs,
+                           const QRegularExpressionCacheKey &rhs) noexcept
+    {
+        return lhs.patternOptions == rhs.patternOptions && lhs.pattern == rhs.pattern;
+    }
+    friend size_t qHash(const QRegularExpressionCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.pattern, key.patternOptions);
+    }
+};
+
+/*
+    The process-wide cache of compiled patterns, so that constructing the
+    same QRegularExpression again (in a loop, or in many threads) doesn't
+    compile and JIT-compile the pattern again. The cost of an entry is the
+    memory it uses; the limit can be set in KiB with the QT_REGEXP_CACHE_SIZE
+    environment variable, 0 disabling the cache.
+*/
+struct QRegularExpressionCache
+{
+    using CodePointer = QExplicitlySharedDataPointer<QRegularExpressionCode>;
+
+    QRegularExpressionCache()
+    {
+        bool ok;
+        const int kilobytes = qEnvironmentVariableIntValue("QT_REGEXP_CACHE_SIZE", &ok);
+        cache.setMaxCost(ok ? qsizetype(qMax(kilobytes, 0)) * 1024 : 2 * 1024 * 1024);
+    }
+
+    CodePointer code(const QString &pattern, QRegularExpression::PatternOptions patternOptions);
+
+    QMutex mutex;
+    QCache<QRegularExpressionCacheKey, CodePointer> cache;
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
+QRegularExpressionCache::CodePointer
+QRegularExpressionCache::code(const QString &pattern,
+                              QRegularExpression::PatternOptions patternOptions)
+{
+    const QRegularExpressionCacheKey key{ pattern, patternOptions };
+    {
+        const QMutexLocker locker(&mutex);
+        if (const CodePointer *cached = cache.object(key)) {
+            ++hits;
+            return *cached;
+        }
+        ++misses;
+    }
+
+    // compile without holding the lock, so that threads compiling different
+    // patterns don't wait for each other
+    CodePointer result(new QRegularExpressionCode(pattern, patternOptions));
+    const qsizetype cost = result->size() + pattern.size() * sizeof(QChar);
+
+    const QMutexLocker locker(&mutex);
+    if (const CodePointer *cached = cache.object(key))
+        return *cached;     // another thread compiled it first
+    cache.insert(key, new CodePointer(result), cost);
+    return result;
+}
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionCache, regularExpressionCache)
+
+/*!
+    \internal
+
+    Returns the statistics of the cache of compiled patterns.
+*/
+QRegularExpressionCacheStatistics QtPrivate::regularExpressionCacheStatistics()
+{
+    QRegularExpressionCacheStatistics statistics;
+    if (QRegularExpressionCache *cache = regularExpressionCache()) {
+        const QMutexLocker locker(&cache->mutex);
+        statistics.hits = cache->hits;
+        statistics.misses = cache->misses;
+        statistics.count = cache->cache.count();
+        statistics.totalCost = cache->cache.totalCost();
+        statistics.maxCost = cache->cache.maxCost();
+    }
+    return statistics;
+}
+
+/*!
+    \internal
+
+    Sets the maximum memory used by the cache of compiled patterns to
+    \a bytes, evicting the least recently used patterns if needed.
+*/
+void QtPrivate::setRegularExpressionCacheMaxCost(qsizetype bytes)
+{
+    if (QRegularExpressionCache *cache = regularExpressionCache()) {
+        const QMutexLocker locker(&cache->mutex);
+        cache->cache.setMaxCost(bytes);
+    }
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::compilePattern()
+{
+    const QMutexLocker lock(&mutex);
+
+    if (!isDirty)
+        return;
+
+    isDirty = false;
+    cleanCompiledPattern();
+
+    if (QRegularExpressionCache *cache = regularExpressionCache())
+        code = cache->code(pattern, patternOptions);
+    else // during the destruction of the statics
+        code = new QRegularExpressionCode(pattern, patternOptions);
+
+    compiledPattern = code->compiledPattern;
+    errorCode = code->errorCode;
+    errorOffset = code->errorOffset;
+    capturingCount = code->capturingCount;
+    usingCrLfNewlines = code->usingCrLfNewlines;
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionCode::getPatternInfo(const QString &pattern)
 {
     Q_ASSERT(compiledPattern);
 
@@ -935,15 +1110,17 @@ void QRegularExpressionPrivate::getPatternInfo()
     unsigned int hasJOptionChanged;
     pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
     if (Q_UNLIKELY(hasJOptionChanged)) {
-        qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
+        qWarning("QRegularExpressionCode::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
                  qUtf16Printable(pattern));
     }
 }
 
 
 /*
-    Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
-    QThreadStorage.
+    Simple "smartpointer" wrappers around the PCRE objects that each thread
+    keeps for matching: the JIT stack, and the match context and match data,
+    which are reused by all the matches in the thread so that matching
+    doesn't allocate.
 */
 namespace {
 struct PcreJitStackFree
@@ -955,6 +1132,26 @@ struct PcreJitStackFree
     }
 };
 Q_CONSTINIT static thread_local std::unique_ptr<pcre2_jit_stack_16, PcreJitStackFree> jitStacks;
+
+struct PcreMatchContextFree
+{
+    void operator()(pcre2_match_context_16 *context)
+    {
+        if (context)
+            pcre2_match_context_free_16(context);
+    }
+};
+Q_CONSTINIT static thread_local std::unique_ptr<pcre2_match_context_16, PcreMatchContextFree> matchContexts;
+
+struct PcreMatchDataFree
+{
+    void operator()(pcre2_match_data_16 *matchData)
+    {
+        if (matchData)
+            pcre2_match_data_free_16(matchData);
+    }
+};
+Q_CONSTINIT static thread_local std::unique_ptr<pcre2_match_data_16, PcreMatchDataFree> matchDatas;
 }
 
 /*!
@@ -992,10 +1189,10 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called when a pattern is compiled by us, before the code is
+    shared.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCode::optimizePattern()
 {
     Q_ASSERT(compiledPattern);
 
@@ -1141,9 +1338,15 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
+    if (!matchContexts) {
+        matchContexts.reset(pcre2_match_context_create_16(nullptr));
+        pcre2_jit_stack_assign_16(matchContexts.get(), &qtPcreCallback, nullptr);
+    }
+    pcre2_match_context_16 *matchContext = matchContexts.get();
+    // the match data only needs to be large enough for the capturing groups
+    if (!matchDatas || pcre2_get_ovector_count_16(matchDatas.get()) <= uint(capturingCount))
+        matchDatas.reset(pcre2_match_data_create_16(capturingCount + 1, nullptr));
+    pcre2_match_data_16 *matchData = matchDatas.get();
 
     // PCRE does not accept a null pointer as subject string, even if
     // its length is zero. We however allow it in input: a QStringView
@@ -1256,9 +1459,6 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
             capturedOffsets[0] -= maximumLookBehind;
         }
     }
-
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
 }
 
 /*!
@@ -0,0 +1,40 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QREGULAREXPRESSION_P_H
+#define QREGULAREXPRESSION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+QT_REQUIRE_CONFIG(regularexpression);
+
+QT_BEGIN_NAMESPACE
+
+struct QRegularExpressionCacheStatistics
+{
+    quint64 hits = 0;           // compilations avoided
+    quint64 misses = 0;         // patterns compiled
+    qsizetype count = 0;        // patterns in the cache
+    qsizetype totalCost = 0;    // bytes used by them
+    qsizetype maxCost = 0;
+};
+
+namespace QtPrivate {
+Q_CORE_EXPORT QRegularExpressionCacheStatistics regularExpressionCacheStatistics();
+Q_CORE_EXPORT void setRegularExpressionCacheMaxCost(qsizetype bytes);
+}
+
+QT_END_NAMESPACE
+
+#endif // QREGULAREXPRESSION_P_H
@@ -1195,6 +1195,41 @@ void qt_to_latin1_unchecked(uchar *dst, const char16_t *src, qsizetype length)
     qt_to_latin1_internal<false>(dst, src, length);
 }
 
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+// Returns true if the case folding of all eight code units in \a chunk stays
+// within Latin-1. That excludes U+00B5 MICRO SIGN, which folds to U+03BC.
+static Q_ALWAYS_INLINE bool foldsWithinLatin1_sse2(__m128i chunk)
+{
+    const __m128i latin1 = _mm_cmpeq_epi16(_mm_and_si128(chunk, _mm_set1_epi16(short(0xff00))),
+                                           _mm_setzero_si128());
+    const __m128i micro = _mm_cmpeq_epi16(chunk, _mm_set1_epi16(0xb5));
+    return _mm_movemask_epi8(_mm_andnot_si128(micro, latin1)) == 0xffff;
+}
+
+// Case-folds eight Latin-1 code units (see foldsWithinLatin1_sse2): the
+// uppercase letters A to Z and U+00C0 to U+00DE, except U+00D7 MULTIPLICATION
+// SIGN, become their lowercase counterparts 0x20 code points above.
+static Q_ALWAYS_INLINE __m128i foldLatin1Case_sse2(__m128i chunk)
+{
+    const auto inRange = [chunk](short lo, short hi) {
+        return _mm_and_si128(_mm_cmpgt_epi16(chunk, _mm_set1_epi16(lo - 1)),
+                             _mm_cmplt_epi16(chunk, _mm_set1_epi16(hi + 1)));
+    };
+    __m128i upper = _mm_or_si128(inRange('A', 'Z'), inRange(0xc0, 0xde));
+    upper = _mm_andnot_si128(_mm_cmpeq_epi16(chunk, _mm_set1_epi16(0xd7)), upper);
+    return _mm_or_si128(chunk, _mm_and_si128(upper, _mm_set1_epi16(0x20)));
+}
+
+// Returns the index of the first of the eight code units that differ after
+// case folding, or -1 if they are all equal.
+static Q_ALWAYS_INLINE int firstLatin1CaseDifference_sse2(__m128i a, __m128i b)
+{
+    const __m128i equal = _mm_cmpeq_epi16(foldLatin1Case_sse2(a), foldLatin1Case_sse2(b));
+    const uint mask = ~uint(_mm_movemask_epi8(equal)) & 0xffff;
+    return mask ? int(qCountTrailingZeroBits(mask) / sizeof(char16_t)) : -1;
+}
+#endif
+
 // Unicode case-insensitive comparison (argument order matches QStringView)
 Q_NEVER_INLINE static int ucstricmp(qsizetype alen, const char16_t *a, qsizetype blen, const char16_t *b)
 {
@@ -1204,8 +1239,27 @@ Q_NEVER_INLINE static int ucstricmp(qsizetype alen, const char16_t *a, qsizetype
     char32_t alast = 0;
     char32_t blast = 0;
     qsizetype l = qMin(alen, blen);
-    qsizetype i;
-    for (i = 0; i < l; ++i) {
+    qsizetype i = 0;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+    // Most text folds within Latin-1, so compare eight code units at a time
+    // without the Unicode tables for as long as that holds.
+    for ( ; l - i >= 8; i += 8) {
+        const __m128i a8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i b8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        if (foldsWithinLatin1_sse2(a8) && foldsWithinLatin1_sse2(b8)) {
+            if (int idx = firstLatin1CaseDifference_sse2(a8, b8); idx >= 0)
+                return foldCase(a[i + idx]) - foldCase(b[i + idx]);
+            alast = a[i + 7];
+            blast = b[i + 7];
+        } else {
+            for (qsizetype j = i; j < i + 8; ++j) {
+                if (int diff = foldCase(a[j], alast) - foldCase(b[j], blast))
+                    return diff;
+            }
+        }
+    }
+#endif
+    for ( ; i < l; ++i) {
 //         qDebug() << Qt::hex << alast << blast;
 //         qDebug() << Qt::hex << "*a=" << *a << "alast=" << alast << "folded=" << foldCase (*a, alast);
 //         qDebug() << Qt::hex << "*b=" << *b << "blast=" << blast << "folded=" << foldCase (*b, blast);
@@ -1226,8 +1280,18 @@ Q_NEVER_INLINE static int ucstricmp(qsizetype alen, const char16_t *a, qsizetype
 Q_NEVER_INLINE static int ucstricmp(qsizetype alen, const char16_t *a, qsizetype blen, const char *b)
 {
     qsizetype l = qMin(alen, blen);
-    qsizetype i;
-    for (i = 0; i < l; ++i) {
+    qsizetype i = 0;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+    for ( ; l - i >= 8; i += 8) {
+        const __m128i a8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i b8 = mm_load8_zero_extend(b + i);
+        if (!foldsWithinLatin1_sse2(a8) || !foldsWithinLatin1_sse2(b8))
+            break;
+        if (int idx = firstLatin1CaseDifference_sse2(a8, b8); idx >= 0)
+            return foldCase(a[i + idx]) - foldCase(char16_t{uchar(b[i + idx])});
+    }
+#endif
+    for ( ; i < l; ++i) {
         int diff = foldCase(a[i]) - foldCase(char16_t{uchar(b[i])});
         if ((diff))
             return diff;
@@ -1390,7 +1454,30 @@ static int latin1nicmp(const char *lhsChar, qsizetype lSize, const char *rhsChar
     const qsizetype size = std::min(lSize, rSize);
 
     Q_ASSERT(lhsChar && rhsChar); // since both lSize and rSize are positive
-    for (qsizetype i = 0; i < size; i++) {
+    qsizetype i = 0;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+    // Same mapping as CaseInsensitiveL1, sixteen characters at a time. As
+    // signed bytes, U+00C0 to U+00DE is a contiguous negative range.
+    const auto toLower = [](__m128i chunk) {
+        const auto inRange = [chunk](char lo, char hi) {
+            return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(char(lo - 1))),
+                                 _mm_cmplt_epi8(chunk, _mm_set1_epi8(char(hi + 1))));
+        };
+        __m128i upper = _mm_or_si128(inRange('A', 'Z'), inRange(char(0xc0), char(0xde)));
+        upper = _mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(char(0xd7))), upper);
+        return _mm_or_si128(chunk, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+    };
+    for ( ; size - i >= 16; i += 16) {
+        const __m128i l16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhsChar + i));
+        const __m128i r16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhsChar + i));
+        const __m128i equal = _mm_cmpeq_epi8(toLower(l16), toLower(r16));
+        if (const uint mask = ~uint(_mm_movemask_epi8(equal)) & 0xffff) {
+            const qsizetype idx = i + qCountTrailingZeroBits(mask);
+            return CaseInsensitiveL1::difference(lhsChar[idx], rhsChar[idx]);
+        }
+    }
+#endif
+    for ( ; i < size; i++) {
         if (int res = CaseInsensitiveL1::difference(lhsChar[i], rhsChar[i]))
             return res;
     }
@@ -2760,12 +2847,12 @@ void QString::reallocData(qsizetype alloc, QArrayData::AllocationOption option)
     const bool cannotUseReallocate = d.freeSpaceAtBegin() > 0;
 
     if (d->needsDetach() || cannotUseReallocate) {
-        DataPointer dd(Data::allocate(alloc, option), qMin(alloc, d.size));
+        DataPointer dd(Data::allocate(alloc, option, d.arena()), qMin(alloc, d.size));
         Q_CHECK_PTR(dd.data());
         if (dd.size > 0)
             ::memcpy(dd.data(), d.data(), dd.size * sizeof(QChar));
         dd.data()[dd.size] = 0;
-        d = dd;
+        d.swap(dd);
     } else {
         d->reallocate(alloc, option);
     }
@@ -6833,6 +6920,27 @@ QString QString::rightJustified(qsizetype width, QChar fill, bool truncate) cons
 */
 
 namespace QUnicodeTables {
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+/*
+    \internal
+    If all eight code units in \a chunk are ASCII, stores in \a changes a mask
+    of the letters that the \a which conversion changes and returns true.
+    Conversions do not change the other ASCII characters. Returns false if any
+    of the code units is not ASCII.
+*/
+static Q_ALWAYS_INLINE bool asciiCaseChanges_sse2(__m128i chunk, Case which, __m128i *changes)
+{
+    const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(chunk, _mm_set1_epi16(short(0xff80))),
+                                          _mm_setzero_si128());
+    if (_mm_movemask_epi8(ascii) != 0xffff)
+        return false;
+    const short first = (which == UpperCase || which == TitleCase) ? 'a' : 'A';
+    *changes = _mm_and_si128(_mm_cmpgt_epi16(chunk, _mm_set1_epi16(first - 1)),
+                              _mm_cmplt_epi16(chunk, _mm_set1_epi16(first + 26)));
+    return true;
+}
+#endif
+
 /*
     \internal
     Converts the \a str string starting from the position pointed to by the \a
@@ -6867,6 +6975,22 @@ static QString detachAndConvertCase(T &str, QStringIterator it, QUnicodeTables::
     QChar *pp = s.begin() + it.index(); // will detach if necessary
 
     do {
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+        // What is left of the output always has the size of what is left of
+        // the input, so the input has eight more code units if the output does.
+        if (s.constEnd() - pp >= 8) {
+            const QChar *in = it.position();
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+            if (__m128i changes; asciiCaseChanges_sse2(chunk, which, &changes)) {
+                const __m128i converted =
+                        _mm_xor_si128(chunk, _mm_and_si128(changes, _mm_set1_epi16(0x20)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(pp), converted);
+                it.setPosition(in + 8);
+                pp += 8;
+                continue;
+            }
+        }
+#endif
         const auto folded = fullConvertCase(it.next(), which);
         if (Q_UNLIKELY(folded.size() > 1)) {
             if (folded.chars[0] == *pp && folded.size() == 2) {
@@ -6906,11 +7030,30 @@ static QString convertCase(T &str, QUnicodeTables::Case which)
 
     QStringIterator it(p, e);
     while (it.hasNext()) {
-        const char32_t uc = it.next();
-        if (qGetProp(uc)->cases[which].diff) {
-            it.recede();
-            return detachAndConvertCase(str, it, which);
+        const QChar *blockEnd = e;
+#if defined(__SSE2__) && !defined(__OPTIMIZE_SIZE__)
+        // Skip the ASCII blocks that need no conversion without looking the
+        // characters up in the tables.
+        if (const QChar *pos = it.position(); e - pos >= 8) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+            if (__m128i changes; asciiCaseChanges_sse2(chunk, which, &changes)) {
+                if (const uint mask = _mm_movemask_epi8(changes)) {
+                    it.setPosition(pos + qCountTrailingZeroBits(mask) / sizeof(char16_t));
+                    return detachAndConvertCase(str, it, which);
+                }
+                it.setPosition(pos + 8);
+                continue;
+            }
+            blockEnd = pos + 8;
         }
+#endif
+        do {
+            const char32_t uc = it.next();
+            if (qGetProp(uc)->cases[which].diff) {
+                it.recede();
+                return detachAndConvertCase(str, it, which);
+            }
+        } while (it.hasNext() && it.position() < blockEnd);
     }
     return std::move(str);
 }
@@ -291,6 +291,9 @@ private:
 
     friend struct QtPrivate::UnwrapHandler;
 
+    template<typename ResultType>
+    friend class QtPrivate::QFutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
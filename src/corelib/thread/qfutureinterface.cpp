@@ -417,6 +417,8 @@ void QFutureInterfaceBase::waitForResult(int resultIndex)
     if (!isRunningOrPending())
         return;
     lock.unlock();
+    Q_ASSERT_X(d->completingThread != QThread::currentThread(), "QFuture::result",
+               "Waiting for a future that only this thread's event loop can finish");
 
     // To avoid deadlocks and reduce the number of threads used, try to
     // run the runnable in the current thread.
@@ -439,6 +441,8 @@ void QFutureInterfaceBase::waitForFinished()
     lock.unlock();
 
     if (!alreadyFinished) {
+        Q_ASSERT_X(d->completingThread != QThread::currentThread(), "QFuture::waitForFinished",
+                   "Waiting for a future that only this thread's event loop can finish");
         d->pool()->d_func()->stealAndRunRunnable(d->runnable);
 
         lock.relock();
@@ -850,6 +854,29 @@ void QFutureInterfaceBase::setContinuation(std::function<void(const QFutureInter
     }
 }
 
+/*
+    Adds \a func to be run after the continuation that the future may have
+    already, instead of replacing it. Unlike setContinuation(), this doesn't
+    run \a func if the future is finished, but returns \c false.
+*/
+bool QFutureInterfaceBase::addContinuation(std::function<void(const QFutureInterfaceBase &)> func)
+{
+    QMutexLocker lock(&d->continuationMutex);
+    if (isFinished())
+        return false;
+
+    if (d->continuation) {
+        d->continuation = [first = std::move(d->continuation),
+                           second = std::move(func)](const QFutureInterfaceBase &parent) {
+            first(parent);
+            second(parent);
+        };
+    } else {
+        d->continuation = std::move(func);
+    }
+    return true;
+}
+
 void QFutureInterfaceBase::cleanContinuation()
 {
     if (!d)
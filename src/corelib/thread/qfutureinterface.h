@@ -40,8 +40,13 @@ class FailureHandler;
 #endif
 
 class QBasicFutureWatcher;
+
+template<typename T>
+class QFutureAwaiter;
 }
 
+class QFileAsyncIO;
+
 class Q_CORE_EXPORT QFutureInterfaceBase
 {
 public:
@@ -180,6 +185,11 @@ private:
 
     friend class QtPrivate::QBasicFutureWatcher;
 
+    template<typename T>
+    friend class QtPrivate::QFutureAwaiter;
+
+    friend class QFileAsyncIO;
+
     template<class T>
     friend class QPromise;
 
@@ -187,6 +197,7 @@ protected:
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func,
                          QFutureInterfaceBasePrivate *continuationFutureData);
+    bool addContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void cleanContinuation();
     void runContinuation() const;
 
@@ -139,6 +139,8 @@ public:
 
     QRunnable *runnable = nullptr;
     QThreadPool *m_pool = nullptr;
+    // the thread whose event loop finishes the future, if only it can
+    QThread *completingThread = nullptr;
     // Wrapper for continuation
     std::function<void(const QFutureInterfaceBase &)> continuation;
     QFutureInterfaceBasePrivate *continuationData = nullptr;
@@ -10,7 +10,9 @@
 #include "qreadwritelock_p.h"
 #include "qelapsedtimer.h"
 #include "private/qfreelist_p.h"
+#include "private/qfutex_p.h"
 #include "private/qlocking_p.h"
+#include "private/qsimd_p.h"
 
 #include <algorithm>
 
@@ -29,6 +31,7 @@ QT_BEGIN_NAMESPACE
  */
 
 using namespace QReadWriteLockStates;
+using namespace QtFutex;
 namespace {
 
 using steady_clock = std::chrono::steady_clock;
@@ -37,12 +40,52 @@ const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintp
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+
+// With futexes, only recursive locks have a QReadWriteLockPrivate. The d_ptr
+// of the others is a word made of the State flags.
+inline bool isStateWord(const QReadWriteLockPrivate *d)
+{ return !d || (quintptr(d) & StateFlagsMask); }
+inline quintptr stateOf(const QReadWriteLockPrivate *d)
+{ return quintptr(d); }
+inline QReadWriteLockPrivate *fromState(quintptr state)
+{ return reinterpret_cast<QReadWriteLockPrivate *>(state); }
+
+// Before sleeping in the kernel, spin a few times with an exponential backoff,
+// in case the lock is released soon. Give up as soon as another thread already
+// sleeps, as the lock is then likely held for longer.
+constexpr int MaxSpinRounds = 8;
+bool spinOnce(int &rounds, quintptr state)
+{
+    static const bool multiCore = QThread::idealThreadCount() > 1;
+    if (rounds >= MaxSpinRounds || (state & StateWaiting) || !multiCore)
+        return false;
+    for (int i = 0; i < (1 << rounds); ++i)
+        qYieldCpu();
+    ++rounds;
+    return true;
+}
+
+// Sleeps until the state word changes from \a state (which includes
+// StateWaiting) or the \a timeout expires.
+void futexWaitForState(QAtomicPointer<QReadWriteLockPrivate> &d_ptr, quintptr state,
+                       QDeadlineTimer timeout)
+{
+    if (timeout.isForever())
+        futexWait(d_ptr, fromState(state));
+    else
+        futexWait(d_ptr, fromState(state), timeout.remainingTimeAsDuration());
+}
 }
 
 static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
                                     QDeadlineTimer timeout, QReadWriteLockPrivate *d);
 static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
                                      QDeadlineTimer timeout, QReadWriteLockPrivate *d);
+static bool futexLockForRead(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
+                             QDeadlineTimer timeout, quintptr state);
+static bool futexLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
+                              QDeadlineTimer timeout, quintptr state);
+static void futexUnlock(QAtomicPointer<QReadWriteLockPrivate> &d_ptr, quintptr state);
 
 /*! \class QReadWriteLock
     \inmodule QtCore
@@ -83,6 +126,15 @@ static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_pt
     to lock for reading in a thread that already has locked for
     writing (and vice versa).
 
+    By default, writers have priority, as described above. A lock constructed
+    with \l{QReadWriteLock::PreferReaders} instead lets new readers in for as
+    long as other readers hold the lock. This maximizes the throughput of
+    readers, but a writer may have to wait until there is no reader at all.
+
+    On platforms with futexes (Linux and Windows), a non-recursive
+    QReadWriteLock spins briefly before putting a contended thread to sleep
+    and doesn't allocate any memory.
+
     \sa QReadLocker, QWriteLocker, QMutex, QSemaphore
 */
 
@@ -100,6 +152,22 @@ static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_pt
     \sa QReadWriteLock()
 */
 
+/*!
+    \enum QReadWriteLock::Preference
+    \since 6.6
+
+    This enum describes which threads a QReadWriteLock lets in first when
+    both readers and writers wait for it.
+
+    \value PreferWriters New readers wait while a writer waits for the lock.
+    This is the default.
+
+    \value PreferReaders New readers get the lock while it is locked for
+    reading, even if a writer waits for it.
+
+    \sa QReadWriteLock()
+*/
+
 /*!
     \fn QReadWriteLock::QReadWriteLock(RecursionMode recursionMode)
     \since 4.4
@@ -113,10 +181,31 @@ static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_pt
 QReadWriteLockPrivate *QReadWriteLock::initRecursive()
 {
     auto d = new QReadWriteLockPrivate(true);
-    Q_ASSERT_X(!(quintptr(d) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
+    Q_ASSERT_X(!(quintptr(d) & StateFlagsMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
     return d;
 }
 
+/*!
+    \since 6.6
+
+    Constructs a QReadWriteLock object in the given \a recursionMode, that
+    gives priority to readers or to writers as specified by \a preference.
+
+    \sa Preference
+*/
+QReadWriteLock::QReadWriteLock(RecursionMode recursionMode, Preference preference)
+    : d_ptr(nullptr)
+{
+    const bool preferReaders = preference == PreferReaders;
+    if (recursionMode == Recursive || (preferReaders && !futexAvailable())) {
+        auto d = new QReadWriteLockPrivate(recursionMode == Recursive, preferReaders);
+        Q_ASSERT_X(!(quintptr(d) & StateFlagsMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
+        d_ptr.storeRelaxed(d);
+    } else if (preferReaders) {
+        d_ptr.storeRelaxed(fromState(StatePreferReaders));
+    }
+}
+
 /*!
     \fn QReadWriteLock::~QReadWriteLock()
     Destroys the QReadWriteLock object.
@@ -130,6 +219,8 @@ void QReadWriteLock::destroyRecursive(QReadWriteLockPrivate *d)
         qWarning("QReadWriteLock: destroying locked QReadWriteLock");
         return;
     }
+    if (quintptr(d) & StateFlagsMask) // not a pointer, e.g. StatePreferReaders
+        return;
     delete d;
 }
 
@@ -194,6 +285,9 @@ bool QReadWriteLock::tryLockForRead(QDeadlineTimer timeout)
 Q_NEVER_INLINE static bool contendedTryLockForRead(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
                                                    QDeadlineTimer timeout, QReadWriteLockPrivate *d)
 {
+    if (futexAvailable() && isStateWord(d))
+        return futexLockForRead(d_ptr, timeout, stateOf(d));
+
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
@@ -309,6 +403,9 @@ bool QReadWriteLock::tryLockForWrite(QDeadlineTimer timeout)
 Q_NEVER_INLINE static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
                                                     QDeadlineTimer timeout, QReadWriteLockPrivate *d)
 {
+    if (futexAvailable() && isStateWord(d))
+        return futexLockForWrite(d_ptr, timeout, stateOf(d));
+
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
@@ -372,6 +469,9 @@ void QReadWriteLock::unlock()
             return;
         }
 
+        if (futexAvailable() && isStateWord(d))
+            return futexUnlock(d_ptr, stateOf(d));
+
         if ((quintptr(d) & StateMask) == StateLockedForRead) {
             Q_ASSERT(quintptr(d) > (1U<<4)); //otherwise that would be the fast case
             // Just decrease the reader's count.
@@ -400,7 +500,7 @@ void QReadWriteLock::unlock()
                 return;
         }
 
-        if (d->waitingReaders || d->waitingWriters) {
+        if (d->waitingReaders || d->waitingWriters || d->preferReaders) {
             d->unlock();
         } else {
             Q_ASSERT(d_ptr.loadRelaxed() == d); // should not change when we still hold the mutex
@@ -415,7 +515,7 @@ bool QReadWriteLockPrivate::lockForRead(std::unique_lock<QtPrivate::mutex> &lock
 {
     Q_ASSERT(!mutex.try_lock()); // mutex must be locked when entering this function
 
-    while (waitingWriters || writerCount) {
+    while (writerCount || (waitingWriters && !preferReaders)) {
         if (timeout.hasExpired())
             return false;
         if (!timeout.isForever()) {
@@ -461,6 +561,113 @@ bool QReadWriteLockPrivate::lockForWrite(std::unique_lock<QtPrivate::mutex> &loc
     return true;
 }
 
+/*
+    The futex implementation, for non-recursive locks. The lock is entirely
+    described by its state word: the StateLockedForRead and
+    StateLockedForWrite bits, the number of readers, and the StateWaiting flag
+    which tells the thread that unlocks the lock to wake the sleeping threads.
+
+    A waiting writer sets StateWriterWaiting, which keeps new readers out
+    unless StatePreferReaders is set. A writer that gets the lock clears it;
+    the other waiting writers set it again once they are woken up. Unlocking
+    the lock completely also clears it, so that a writer that timed out can't
+    keep readers waiting for longer than the current holders of the lock.
+*/
+Q_NEVER_INLINE static bool futexLockForRead(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
+                                            QDeadlineTimer timeout, quintptr state)
+{
+    int spinRounds = 0;
+    while (true) {
+        const bool blocked = (state & StateLockedForWrite)
+                || ((state & StateWriterWaiting) && !(state & StatePreferReaders));
+        if (!blocked) {
+            quintptr newState = state | StateLockedForRead;
+            if (state & StateLockedForRead) {
+                newState = state + StateReaderIncrement;
+                Q_ASSERT_X(newState > state, "QReadWriteLock::tryLockForRead()",
+                           "Overflow in lock counter");
+            }
+            QReadWriteLockPrivate *d;
+            if (d_ptr.testAndSetAcquire(fromState(state), fromState(newState), d))
+                return true;
+            state = stateOf(d);
+            continue;
+        }
+
+        if (timeout.hasExpired())
+            return false;
+        if (spinOnce(spinRounds, state)) {
+            state = stateOf(d_ptr.loadRelaxed());
+            continue;
+        }
+
+        if (!(state & StateWaiting)) {
+            QReadWriteLockPrivate *d;
+            if (!d_ptr.testAndSetRelaxed(fromState(state), fromState(state | StateWaiting), d)) {
+                state = stateOf(d);
+                continue;
+            }
+            state |= StateWaiting;
+        }
+        futexWaitForState(d_ptr, state, timeout);
+        state = stateOf(d_ptr.loadRelaxed());
+    }
+}
+
+Q_NEVER_INLINE static bool futexLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_ptr,
+                                             QDeadlineTimer timeout, quintptr state)
+{
+    int spinRounds = 0;
+    while (true) {
+        if (!(state & StateMask)) {
+            // keep StateWaiting, as other threads may still sleep
+            const quintptr newState = (state & ~quintptr(StateWriterWaiting)) | StateLockedForWrite;
+            QReadWriteLockPrivate *d;
+            if (d_ptr.testAndSetAcquire(fromState(state), fromState(newState), d))
+                return true;
+            state = stateOf(d);
+            continue;
+        }
+
+        if (timeout.hasExpired())
+            return false;
+        if (spinOnce(spinRounds, state)) {
+            state = stateOf(d_ptr.loadRelaxed());
+            continue;
+        }
+
+        const quintptr waitingState = state | StateWaiting | StateWriterWaiting;
+        if (state != waitingState) {
+            QReadWriteLockPrivate *d;
+            if (!d_ptr.testAndSetRelaxed(fromState(state), fromState(waitingState), d)) {
+                state = stateOf(d);
+                continue;
+            }
+            state = waitingState;
+        }
+        futexWaitForState(d_ptr, state, timeout);
+        state = stateOf(d_ptr.loadRelaxed());
+    }
+}
+
+static void futexUnlock(QAtomicPointer<QReadWriteLockPrivate> &d_ptr, quintptr state)
+{
+    while (true) {
+        Q_ASSERT_X(state & StateMask, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
+        quintptr newState = state & StatePreferReaders;
+        if ((state & StateLockedForRead) && state >= StateReaderIncrement)
+            newState = state - StateReaderIncrement; // other readers remain
+        QReadWriteLockPrivate *d;
+        if (!d_ptr.testAndSetOrdered(fromState(state), fromState(newState), d)) {
+            state = stateOf(d);
+            continue;
+        }
+        if ((state & StateWaiting) && !(newState & StateMask))
+            futexWakeAll(d_ptr);
+        return;
+    }
+}
+
 void QReadWriteLockPrivate::unlock()
 {
     Q_ASSERT(!mutex.try_lock()); // mutex must be locked when entering this function
@@ -17,9 +17,11 @@ class Q_CORE_EXPORT QReadWriteLock
 {
 public:
     enum RecursionMode { NonRecursive, Recursive };
+    enum Preference { PreferWriters, PreferReaders };
 
     QT_CORE_INLINE_SINCE(6, 6)
     explicit QReadWriteLock(RecursionMode recursionMode = NonRecursive);
+    QReadWriteLock(RecursionMode recursionMode, Preference preference);
     QT_CORE_INLINE_SINCE(6, 6)
     ~QReadWriteLock();
 
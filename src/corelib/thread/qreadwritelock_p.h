@@ -30,6 +30,15 @@ enum {
     StateMask = 0x3,
     StateLockedForRead = 0x1,
     StateLockedForWrite = 0x2,
+
+    // only used by the futex implementation of non-recursive locks
+    StateWaiting = 0x4,         // some threads sleep on the lock
+    StateWriterWaiting = 0x8,   // a writer waits, so readers must not join
+    StatePreferReaders = 0x10,  // constant for the lifetime of the lock
+    StateFlagsMask = 0x1f,      // never set in a QReadWriteLockPrivate pointer
+
+    // the number of readers above one
+    StateReaderIncrement = 0x20,
 };
 enum StateForWaitCondition {
     LockedForRead,
@@ -39,11 +48,11 @@ enum StateForWaitCondition {
 };
 }
 
-class QReadWriteLockPrivate
+class alignas(QReadWriteLockStates::StateReaderIncrement) QReadWriteLockPrivate
 {
 public:
-    explicit QReadWriteLockPrivate(bool isRecursive = false)
-        : recursive(isRecursive) {}
+    explicit QReadWriteLockPrivate(bool isRecursive = false, bool preferReaders = false)
+        : recursive(isRecursive), preferReaders(preferReaders) {}
 
     alignas(QtPrivate::IdealMutexAlignment) QtPrivate::condition_variable writerCond;
     QtPrivate::condition_variable readerCond;
@@ -54,6 +63,8 @@ public:
     int waitingReaders = 0;
     int waitingWriters = 0;
     const bool recursive;
+    // Such a lock owns its private, which is not from the freelist
+    const bool preferReaders;
 
     //Called with the mutex locked
     bool lockForWrite(std::unique_lock<QtPrivate::mutex> &lock, QDeadlineTimer timeout);
@@ -96,7 +107,7 @@ QReadWriteLockPrivate::stateForWaitCondition(const QReadWriteLock *q)
     case StateLockedForWrite: return LockedForWrite;
     }
 
-    if (!d)
+    if (!d || (quintptr(d) & StateFlagsMask))
         return Unlocked;
     const auto lock = qt_scoped_lock(d->mutex);
     if (d->writerCount > 1)
@@ -40,6 +40,53 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+/*
+    Adds \a node to the incoming events without locking the mutex, and takes
+    ownership of it. Only used for events with the default priority that
+    can't be compressed. Returns \c true if there were no incoming events
+    before; otherwise, whoever added the first one wakes up the thread.
+*/
+bool QPostEventList::addIncomingEvent(IncomingEvent *node)
+{
+    Q_ASSERT(node->event.priority == Qt::NormalEventPriority);
+    node->next = incoming.load(std::memory_order_relaxed);
+    while (!incoming.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    return node->next == nullptr;
+}
+
+/*
+    Takes all the incoming events, in the order they were posted. The
+    caller owns the returned nodes.
+*/
+QPostEventList::IncomingEvent *QPostEventList::takeIncoming()
+{
+    IncomingEvent *node = incoming.exchange(nullptr, std::memory_order_acquire);
+    IncomingEvent *ordered = nullptr;
+    while (node) {
+        IncomingEvent *next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+    return ordered;
+}
+
+/*
+    Moves the incoming events to the list. The mutex must be locked.
+*/
+void QPostEventList::takeIncomingEvents()
+{
+    if (!hasIncomingEvents())
+        return;
+    IncomingEvent *node = takeIncoming();
+    while (node) {
+        addEvent(node->event);
+        delete std::exchange(node, node->next);
+    }
+}
+
 
 /*
   QThreadData
@@ -81,6 +128,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.takeIncomingEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
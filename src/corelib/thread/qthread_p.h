@@ -72,10 +72,30 @@ public:
 
     QMutex mutex;
 
+    // Events that QCoreApplication::postEvent() added without locking the
+    // mutex (see addIncomingEvent()). They are newer than all the events
+    // in the list, and are moved to it by takeIncomingEvents() before
+    // anyone looks at the list.
+    struct IncomingEvent
+    {
+        QPostEvent event;
+        IncomingEvent *next;
+    };
+    std::atomic<IncomingEvent *> incoming = nullptr;
+    // number of threads between checking the receiver's thread and adding
+    // an incoming event; QObject::moveToThread() waits for it to drop to 0
+    std::atomic<int> incomingPosters = 0;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
 
+    bool addIncomingEvent(IncomingEvent *node);
+    IncomingEvent *takeIncoming();
+    void takeIncomingEvents();
+    bool hasIncomingEvents() const
+    { return incoming.load(std::memory_order_relaxed) != nullptr; }
+
 private:
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
@@ -307,7 +327,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncomingEvents();
     }
 
 private:
@@ -325,6 +345,8 @@ public:
     QList<void *> tls;
 
     bool quitNow;
+    // protected by postEventList.mutex, and doesn't account for events
+    // posted without it; event dispatchers use canWaitLocked()
     bool canWait;
     bool isAdopted;
     bool requiresCoreApplication;
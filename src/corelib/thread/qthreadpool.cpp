@@ -21,14 +21,24 @@ class QThreadPoolThread : public QThread
     Q_OBJECT
 public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
+    ~QThreadPoolThread();
     void run() override;
+    void runTask(QRunnable *r);
     void registerThreadInactive();
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+    QThreadPoolWorkQueue *workQueue = nullptr; // work-stealing mode only
 };
 
+// the pool thread running on this thread, if any
+Q_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
+// how many default-priority tasks a worker moves from the shared queue to its
+// own when it takes one, so that other workers can steal them without the lock
+static constexpr int WorkStealingBatchSize = QThreadPoolWorkQueue::Capacity / 8;
+
 /*
     QThreadPool private class.
 */
@@ -43,11 +53,24 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
     setStackSize(manager->stackSize);
 }
 
+/*
+    \internal
+*/
+QThreadPoolThread::~QThreadPoolThread()
+{
+    // only reset() deletes threads, and it does so without holding the lock
+    if (workQueue) {
+        QMutexLocker locker(&manager->mutex);
+        workQueue->owner = nullptr;
+    }
+}
+
 /*
     \internal
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -55,27 +78,14 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
-#ifndef QT_NO_EXCEPTIONS
-                try {
-#endif
-                    r->run();
-#ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
+                runTask(r);
+                // In work-stealing mode, keep going without the lock for as long as
+                // this worker or any other one has tasks in its own queue.
+                if (workQueue) {
+                    while ((r = manager->takeWorkStealingTask(this)))
+                        runTask(r);
                 }
-#endif
-
-                if (del)
-                    delete r;
                 locker.relock();
             }
 
@@ -84,18 +94,19 @@ void QThreadPoolThread::run()
                 break;
 
             // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            if (manager->queue.isEmpty()) {
+                // (unless another worker has queued some of its own meanwhile)
+                if (workQueue && (r = manager->stealTask(workQueue)))
+                    continue;
                 break;
-
-            QueuePage *page = manager->queue.first();
-            r = page->pop();
-
-            if (page->isFinished()) {
-                manager->queue.removeFirst();
-                delete page;
             }
+
+            r = manager->takeQueuedTask(this);
         } while (true);
 
+        if (workQueue)
+            manager->requeueLocalTasks(this);
+
         // this thread is about to be deleted, do not wait or expire
         if (!manager->allThreads.contains(this)) {
             registerThreadInactive();
@@ -106,10 +117,22 @@ void QThreadPoolThread::run()
         if (manager->tooManyThreadsActive()) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateWorkStealingHints();
             return;
         }
         manager->waitingThreads.enqueue(this);
         registerThreadInactive();
+        manager->updateWorkStealingHints();
+        if (workQueue) {
+            // A worker that queued a task before it saw this thread waiting
+            // doesn't wake it up, so check once more now that it is visible.
+            if ((runnable = manager->stealTask(workQueue))) {
+                manager->waitingThreads.removeOne(this);
+                ++manager->activeThreads;
+                manager->updateWorkStealingHints();
+                continue;
+            }
+        }
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
         // this thread is about to be deleted, do not work or expire
@@ -122,9 +145,39 @@ void QThreadPoolThread::run()
             return;
         }
         ++manager->activeThreads;
+        manager->updateWorkStealingHints();
     }
 }
 
+/*
+    \internal
+
+    Runs \a r without holding the pool's lock, and deletes it afterwards if
+    it is auto-deleting.
+*/
+void QThreadPoolThread::runTask(QRunnable *r)
+{
+    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+    const bool del = r->autoDelete();
+
+#ifndef QT_NO_EXCEPTIONS
+    try {
+#endif
+        r->run();
+#ifndef QT_NO_EXCEPTIONS
+    } catch (...) {
+        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                 "This is not supported, exceptions thrown in worker threads must be\n"
+                 "caught before control returns to Qt Concurrent.");
+        registerThreadInactive();
+        throw;
+    }
+#endif
+
+    if (del)
+        delete r;
+}
+
 void QThreadPoolThread::registerThreadInactive()
 {
     if (--manager->activeThreads == 0)
@@ -136,8 +189,16 @@ void QThreadPoolThread::registerThreadInactive()
     \internal
 */
 QThreadPoolPrivate:: QThreadPoolPrivate()
+    : workStealing(qEnvironmentVariableIntValue("QT_THREADPOOL_WORK_STEALING") > 0)
 { }
 
+QThreadPoolPrivate::~QThreadPoolPrivate()
+{
+    QThreadPoolWorkQueue *workQueue = workQueues.load();
+    while (workQueue)
+        delete std::exchange(workQueue, workQueue->next);
+}
+
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
     Q_ASSERT(task != nullptr);
@@ -155,23 +216,13 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         // recycle an available thread
         enqueueTask(task);
         waitingThreads.takeFirst()->runnableReady.wakeOne();
+        updateWorkStealingHints();
         return true;
     }
 
     if (!expiredThreads.isEmpty()) {
         // restart an expired thread
-        QThreadPoolThread *thread = expiredThreads.dequeue();
-        Q_ASSERT(thread->runnable == nullptr);
-
-        ++activeThreads;
-
-        thread->runnable = task;
-
-        // Ensure that the thread has actually finished, otherwise the following
-        // start() has no effect.
-        thread->wait();
-        Q_ASSERT(thread->isFinished());
-        thread->start(threadPriority);
+        restartExpiredThread(task);
         return true;
     }
 
@@ -180,6 +231,23 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
     return true;
 }
 
+void QThreadPoolPrivate::restartExpiredThread(QRunnable *runnable)
+{
+    QThreadPoolThread *thread = expiredThreads.dequeue();
+    Q_ASSERT(thread->runnable == nullptr);
+
+    ++activeThreads;
+
+    thread->runnable = runnable;
+
+    // Ensure that the thread has actually finished, otherwise the following
+    // start() has no effect.
+    thread->wait();
+    Q_ASSERT(thread->isFinished());
+    thread->start(threadPriority);
+    updateWorkStealingHints();
+}
+
 inline bool comparePriority(int priority, const QueuePage *p)
 {
     return p->priority() < priority;
@@ -191,11 +259,13 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     for (QueuePage *page : std::as_const(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
+            updateWorkStealingHints();
             return;
         }
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateWorkStealingHints();
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -221,6 +291,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateWorkStealingHints();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -240,8 +311,11 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
+    // in work-stealing mode, a thread may be started to steal its first task
+    Q_ASSERT(runnable != nullptr || workStealing);
     auto thread = std::make_unique<QThreadPoolThread>(this);
+    if (workStealing)
+        acquireWorkQueue(thread.get());
     if (objectName.isEmpty())
         objectName = u"Thread (pooled)"_s;
     thread->setObjectName(objectName);
@@ -251,6 +325,204 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
 
     thread->runnable = runnable;
     thread.release()->start(threadPriority);
+    updateWorkStealingHints();
+}
+
+/*!
+    \internal
+
+    Takes the next task from the shared queue. In work-stealing mode, a batch
+    of the default-priority tasks behind it is moved to \a thread's own queue.
+    Tasks with other priorities always stay in the shared queue, so that
+    their order is preserved.
+*/
+QRunnable *QThreadPoolPrivate::takeQueuedTask(QThreadPoolThread *thread)
+{
+    if (queue.isEmpty())
+        return nullptr;
+
+    QueuePage *page = queue.constFirst();
+    QRunnable *runnable = page->pop();
+
+    if (thread->workQueue && page->priority() == 0) {
+        for (int i = 0; i < WorkStealingBatchSize && !page->isFinished(); ++i) {
+            if (!thread->workQueue->push(page->first()))
+                break;
+            page->pop();
+        }
+    }
+
+    if (page->isFinished()) {
+        queue.removeFirst();
+        delete page;
+    }
+    updateWorkStealingHints();
+    return runnable;
+}
+
+/*!
+    \internal
+
+    Steals a task from any worker's queue other than \a thief, starting at a
+    random one. Does not need the lock.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolWorkQueue *thief)
+{
+    QThreadPoolWorkQueue *head = workQueues.load();
+    const int count = workQueueCount.load();
+    if (count < 2)
+        return nullptr;
+
+    quint32 &seed = thief->stealSeed;   // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    QThreadPoolWorkQueue *start = head;
+    for (quint32 skip = seed % quint32(count); skip && start->next; --skip)
+        start = start->next;
+
+    QThreadPoolWorkQueue *victim = start;
+    do {
+        if (victim != thief) {
+            if (QRunnable *runnable = victim->take())
+                return runnable;
+        }
+        victim = victim->next ? victim->next : head;
+    } while (victim != start);
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Returns the next task for \a thread in work-stealing mode: tasks queued
+    with a priority above the default come first, then the thread's own
+    queue, the rest of the shared queue, and finally the other workers'
+    queues. Takes the lock only to access the shared queue.
+
+    Returns \nullptr when there is no work, or when \a thread should stop
+    working because the maximum thread count was lowered.
+*/
+QRunnable *QThreadPoolPrivate::takeWorkStealingTask(QThreadPoolThread *thread)
+{
+    if (tooManyThreads.load())
+        return nullptr;
+
+    if (queuedWork.load() == PriorityTasksQueued) {
+        QMutexLocker locker(&mutex);
+        if (QRunnable *runnable = takeQueuedTask(thread))
+            return runnable;
+    }
+
+    if (QRunnable *runnable = thread->workQueue->take())
+        return runnable;
+
+    if (queuedWork.load() != NothingQueued) {
+        QMutexLocker locker(&mutex);
+        if (QRunnable *runnable = takeQueuedTask(thread))
+            return runnable;
+    }
+
+    return stealTask(thread->workQueue);
+}
+
+/*!
+    \internal
+
+    In work-stealing mode, queues \a runnable on the current thread's own
+    queue if it is one of this pool's workers. Returns \c false if it isn't,
+    or if its queue is full.
+*/
+bool QThreadPoolPrivate::pushLocalTask(QRunnable *runnable)
+{
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this || !thread->workQueue->push(runnable))
+        return false;
+
+    // pairs with the last stealTask() in QThreadPoolThread::run() before it waits
+    if (!allThreadsBusy.load()) {
+        QMutexLocker locker(&mutex);
+        wakeStealingThread();
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Moves the tasks left in \a thread's own queue to the shared queue, so
+    that they are accounted for once it stops working.
+*/
+void QThreadPoolPrivate::requeueLocalTasks(QThreadPoolThread *thread)
+{
+    while (QRunnable *runnable = thread->workQueue->take())
+        enqueueTask(runnable);
+}
+
+/*!
+    \internal
+
+    Wakes up or starts a thread that will steal work from the other workers,
+    if the pool has room for one.
+*/
+void QThreadPoolPrivate::wakeStealingThread()
+{
+    if (!waitingThreads.isEmpty()) {
+        waitingThreads.takeFirst()->runnableReady.wakeOne();
+        updateWorkStealingHints();
+    } else if (!areAllThreadsActive()) {
+        if (!expiredThreads.isEmpty())
+            restartExpiredThread(nullptr);
+        else
+            startThread(nullptr);
+    }
+}
+
+/*!
+    \internal
+
+    Gives \a thread a queue of its own, reusing one of a deleted thread if
+    possible. The queues are only freed with the pool, so that thieves can
+    walk the list without the lock.
+*/
+void QThreadPoolPrivate::acquireWorkQueue(QThreadPoolThread *thread)
+{
+    QThreadPoolWorkQueue *workQueue = workQueues.load();
+    while (workQueue && workQueue->owner)
+        workQueue = workQueue->next;
+
+    if (!workQueue) {
+        workQueue = new QThreadPoolWorkQueue;
+        workQueue->stealSeed = quint32(workQueueCount.load() + 1) * 2654435761U;
+        workQueue->next = workQueues.load();
+        workQueues.store(workQueue);
+        workQueueCount.fetch_add(1);
+    }
+    workQueue->owner = thread;
+    thread->workQueue = workQueue;
+}
+
+/*!
+    \internal
+
+    Publishes the state of the shared queue and of the threads for the
+    lock-free paths of work-stealing mode.
+*/
+void QThreadPoolPrivate::updateWorkStealingHints()
+{
+    if (!workStealing)
+        return;
+
+    if (queue.isEmpty())
+        queuedWork.store(NothingQueued);
+    else if (queue.constFirst()->priority() > 0)
+        queuedWork.store(PriorityTasksQueued);
+    else
+        queuedWork.store(TasksQueued);
+
+    allThreadsBusy.store(waitingThreads.isEmpty() && areAllThreadsActive());
+    tooManyThreads.store(tooManyThreadsActive());
 }
 
 /*!
@@ -278,6 +550,7 @@ void QThreadPoolPrivate::reset()
     }
 
     mutex.lock();
+    updateWorkStealingHints();
 }
 
 /*!
@@ -321,6 +594,17 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+
+    for (QThreadPoolWorkQueue *workQueue = workQueues.load(); workQueue; workQueue = workQueue->next) {
+        while (QRunnable *r = workQueue->take()) {
+            if (r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
+    updateWorkStealingHints();
 }
 
 /*!
@@ -353,11 +637,17 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
+                d->updateWorkStealingHints();
             }
             return true;
         }
     }
 
+    for (QThreadPoolWorkQueue *workQueue = d->workQueues.load(); workQueue; workQueue = workQueue->next) {
+        if (workQueue->tryTake(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -510,6 +800,11 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    // In work-stealing mode, tasks started from a worker thread go to that
+    // worker's own queue (except for those that need to be prioritized).
+    if (d->workStealing && priority == 0 && d->pushLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -678,6 +973,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateWorkStealingHints();
 }
 
 /*! \property QThreadPool::stackSize
@@ -24,11 +24,14 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
 
 class QDeadlineTimer;
+class QThreadPoolThread;
 
 class QueuePage
 {
@@ -107,7 +110,77 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
-class QThreadPoolThread;
+/*
+    Per-worker run queue used in work-stealing mode. This is a Chase-Lev
+    deque of fixed capacity: the owning worker pushes at the bottom, and
+    takes from the top like any other thread does, so that tasks run in the
+    order they were queued. Every entry is claimed by swapping its slot with
+    nullptr, so tryTake() can remove a runnable from the middle of the queue;
+    take() skips the holes it leaves behind. A push never overwrites a slot
+    that has not been claimed yet; the queue reports itself full instead.
+*/
+class QThreadPoolWorkQueue
+{
+public:
+    enum {
+        Capacity = QueuePage::MaxPageSize
+    };
+
+    QThreadPoolWorkQueue()
+    {
+        for (std::atomic<QRunnable *> &slot : m_slots)
+            slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // owner only
+    bool push(QRunnable *runnable)
+    {
+        Q_ASSERT(runnable != nullptr);
+        const quintptr b = m_bottom.load(std::memory_order_relaxed);
+        if (qptrdiff(b - m_top.load()) >= Capacity)
+            return false;
+        std::atomic<QRunnable *> &slot = m_slots[b % Capacity];
+        if (slot.load() != nullptr)
+            return false;
+        slot.store(runnable);
+        m_bottom.store(b + 1);
+        return true;
+    }
+
+    QRunnable *take()
+    {
+        for (;;) {
+            quintptr t = m_top.load();
+            if (qptrdiff(m_bottom.load() - t) <= 0)
+                return nullptr;
+            if (!m_top.compare_exchange_strong(t, t + 1))
+                continue;
+            if (QRunnable *runnable = m_slots[t % Capacity].exchange(nullptr))
+                return runnable;
+        }
+    }
+
+    bool tryTake(QRunnable *runnable)
+    {
+        const quintptr b = m_bottom.load();
+        for (quintptr i = m_top.load(); qptrdiff(b - i) > 0; ++i) {
+            QRunnable *expected = runnable;
+            if (m_slots[i % Capacity].compare_exchange_strong(expected, nullptr))
+                return true;
+        }
+        return false;
+    }
+
+    QThreadPoolWorkQueue *next = nullptr;
+    QThreadPoolThread *owner = nullptr;     // protected by QThreadPoolPrivate::mutex
+    quint32 stealSeed = 1;                  // owner only
+
+private:
+    std::atomic<quintptr> m_top = 0;
+    std::atomic<quintptr> m_bottom = 0;
+    std::atomic<QRunnable *> m_slots[Capacity];
+};
+
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QThreadPool)
@@ -115,6 +188,7 @@ class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 
 public:
     QThreadPoolPrivate();
+    ~QThreadPoolPrivate();
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
@@ -134,6 +208,16 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    void restartExpiredThread(QRunnable *runnable);
+    QRunnable *takeQueuedTask(QThreadPoolThread *thread);
+    QRunnable *stealTask(QThreadPoolWorkQueue *thief);
+    QRunnable *takeWorkStealingTask(QThreadPoolThread *thread);
+    bool pushLocalTask(QRunnable *runnable);
+    void requeueLocalTasks(QThreadPoolThread *thread);
+    void wakeStealingThread();
+    void acquireWorkQueue(QThreadPoolThread *thread);
+    void updateWorkStealingHints();
+
     static QThreadPool *qtGuiInstance();
 
     mutable QMutex mutex;
@@ -150,6 +234,16 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // work-stealing mode (QT_THREADPOOL_WORK_STEALING)
+    enum QueuedWork { NothingQueued, TasksQueued, PriorityTasksQueued };
+    const bool workStealing;
+    std::atomic<QThreadPoolWorkQueue *> workQueues = nullptr; // never shrinks before destruction
+    std::atomic<int> workQueueCount = 0;
+    // lock-free snapshots of state protected by the mutex
+    std::atomic<int> queuedWork = NothingQueued;
+    std::atomic<bool> allThreadsBusy = false;
+    std::atomic<bool> tooManyThreads = false;
 };
 
 QT_END_NAMESPACE
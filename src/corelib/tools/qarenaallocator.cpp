@@ -0,0 +1,211 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qarenaallocator.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+
+#include <new>
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QArenaAllocator
+    \inmodule QtCore
+    \since 6.6
+    \brief The QArenaAllocator class provides memory for the Qt containers
+    of a short-lived piece of work.
+
+    An arena hands out memory by moving a pointer forward in large blocks,
+    and releases all of it at once in reset() or when it is destroyed.
+    Containers that list(), hash(), string() and byteArray() create keep
+    their elements in the arena: they allocate from it when they grow,
+    and freeing their memory costs nothing.
+
+    \code
+    QArenaAllocator arena;
+    for (const QByteArray &request : requests) {
+        {
+            QHash<QString, qsizetype> index = arena.hash<QString, qsizetype>(request.size());
+            buildIndex(request, &index);
+            respond(index);
+        }
+        arena.reset();
+    }
+    \endcode
+
+    All containers created by the arena must be destroyed before reset() is
+    called or the arena is destroyed. The memory of an arena is never shared:
+    copying such a container copies its elements into memory on the heap,
+    like copying a \c std::pmr container does with the default memory
+    resource. Moving it keeps the memory in the arena. QHash::clear() and
+    QList::squeeze() also move a container to the heap.
+
+    QMap keeps its nodes in a \c std::map and QMultiHash keeps the values of
+    a key in a linked list, so they don't have arena support.
+
+    The arena itself is not thread-safe. The containers it created may be
+    used in other threads as long as they are not copied or grown
+    concurrently with another container of the same arena.
+*/
+
+/*!
+    \fn template <typename T> QList<T> QArenaAllocator::list(qsizetype capacity)
+
+    Returns an empty list with room for \a capacity elements, that keeps its
+    elements in this arena.
+*/
+
+/*!
+    \fn template <typename Key, typename T> QHash<Key, T> QArenaAllocator::hash(qsizetype capacity)
+
+    Returns an empty hash with room for \a capacity items, that keeps its
+    items in this arena.
+*/
+
+/*!
+    \fn qsizetype QArenaAllocator::bytesAllocated() const
+
+    Returns the number of bytes handed out since the arena was created or
+    last reset, including padding for alignment.
+*/
+
+/*!
+    \fn qsizetype QArenaAllocator::blockSize() const
+
+    Returns the size of the blocks that the arena allocates from the heap.
+*/
+
+struct QArenaAllocator::Block
+{
+    Block *next;
+    qsizetype size;
+
+    char *begin() { return reinterpret_cast<char *>(this + 1); }
+    char *end() { return reinterpret_cast<char *>(this) + size; }
+
+    static Block *create(qsizetype size)
+    {
+        void *memory = ::malloc(size_t(size));
+        if (!memory)
+            return nullptr;
+        return new (memory) Block{ nullptr, size };
+    }
+
+    static void destroy(Block *block)
+    {
+        ::free(block);
+    }
+};
+
+/*!
+    Constructs an arena that allocates memory from the heap in blocks of
+    \a blockSize bytes. No memory is allocated until the first allocation.
+*/
+QArenaAllocator::QArenaAllocator(qsizetype blockSize)
+    : m_blockSize(qMax(blockSize, qsizetype(4096)))
+{
+}
+
+/*!
+    Destroys the arena and releases all of its memory.
+
+    \sa reset()
+*/
+QArenaAllocator::~QArenaAllocator()
+{
+    while (Block *block = m_blocks) {
+        m_blocks = block->next;
+        Block::destroy(block);
+    }
+}
+
+/*!
+    \fn void *QArenaAllocator::allocate(qsizetype size, qsizetype alignment)
+
+    Returns \a size bytes of memory aligned to \a alignment, which must be a
+    power of two. The memory stays valid until the arena is reset or
+    destroyed. Returns \nullptr if no memory could be allocated.
+*/
+
+void *QArenaAllocator::allocateInNewBlock(qsizetype size, qsizetype alignment)
+{
+    const qsizetype needed = qsizetype(sizeof(Block)) + size + alignment;
+    if (Q_UNLIKELY(size < 0 || needed < size))
+        return nullptr;
+
+    // Allocations that are large compared to the blocks get a block of
+    // their own, so that the rest of the current block isn't wasted.
+    const bool dedicated = needed > m_blockSize / 4;
+    Block *block = Block::create(dedicated ? needed : m_blockSize);
+    if (!block)
+        return nullptr;
+
+    char *start = reinterpret_cast<char *>((quintptr(block->begin()) + alignment - 1)
+                                           & ~quintptr(alignment - 1));
+    m_allocated += size;
+    if (dedicated && m_blocks) {
+        block->next = m_blocks->next;
+        m_blocks->next = block;
+    } else {
+        block->next = m_blocks;
+        m_blocks = block;
+        m_cursor = start + size;
+        m_end = block->end();
+    }
+    return start;
+}
+
+/*!
+    Releases the memory handed out by the arena, keeping one block for
+    reuse. All containers that allocated memory from the arena must have
+    been destroyed.
+*/
+void QArenaAllocator::reset()
+{
+    Block *keep = nullptr;
+    while (Block *block = m_blocks) {
+        m_blocks = block->next;
+        if (!keep && block->size == m_blockSize)
+            keep = block;
+        else
+            Block::destroy(block);
+    }
+    m_blocks = keep;
+    m_cursor = keep ? keep->begin() : nullptr;
+    m_end = keep ? keep->end() : nullptr;
+    if (keep)
+        keep->next = nullptr;
+    m_allocated = 0;
+}
+
+/*!
+    Returns an empty string with room for \a capacity characters, that keeps
+    its characters in this arena.
+*/
+QString QArenaAllocator::string(qsizetype capacity)
+{
+    QString::DataPointer d(QTypedArrayData<char16_t>::allocate(qMax(capacity, qsizetype(1)),
+                                                               QArrayData::KeepSize, this));
+    Q_CHECK_PTR(d.data());
+    d.data()[0] = u'\0';
+    return QString(std::move(d));
+}
+
+/*!
+    Returns an empty byte array with room for \a capacity bytes, that keeps
+    its bytes in this arena.
+*/
+QByteArray QArenaAllocator::byteArray(qsizetype capacity)
+{
+    QByteArray::DataPointer d(QTypedArrayData<char>::allocate(qMax(capacity, qsizetype(1)),
+                                                              QArrayData::KeepSize, this));
+    Q_CHECK_PTR(d.data());
+    d.data()[0] = '\0';
+    return QByteArray(std::move(d));
+}
+
+QT_END_NAMESPACE
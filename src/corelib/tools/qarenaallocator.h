@@ -0,0 +1,85 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QARENAALLOCATOR_H
+#define QARENAALLOCATOR_H
+
+#include <QtCore/qarraydata.h>
+#include <QtCore/qcontainerfwd.h>
+
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+class QByteArray;
+class QString;
+template <class T> struct QArrayDataPointer;
+
+class Q_CORE_EXPORT QArenaAllocator
+{
+    Q_DISABLE_COPY_MOVE(QArenaAllocator)
+public:
+    enum : qsizetype { DefaultBlockSize = 64 * 1024 };
+
+    explicit QArenaAllocator(qsizetype blockSize = DefaultBlockSize);
+    ~QArenaAllocator();
+
+    [[nodiscard]] void *allocate(qsizetype size, qsizetype alignment = alignof(std::max_align_t));
+    void reset();
+
+    qsizetype bytesAllocated() const noexcept { return m_allocated; }
+    qsizetype blockSize() const noexcept { return m_blockSize; }
+
+    template <typename T>
+    QList<T> list(qsizetype capacity = 0);
+    template <typename Key, typename T>
+    QHash<Key, T> hash(qsizetype capacity = 0);
+    QString string(qsizetype capacity = 0);
+    QByteArray byteArray(qsizetype capacity = 0);
+
+private:
+    struct Block;
+
+    void *allocateInNewBlock(qsizetype size, qsizetype alignment);
+
+    Block *m_blocks = nullptr;
+    char *m_cursor = nullptr;
+    char *m_end = nullptr;
+    qsizetype m_blockSize;
+    qsizetype m_allocated = 0;
+};
+
+inline void *QArenaAllocator::allocate(qsizetype size, qsizetype alignment)
+{
+    Q_ASSERT(size >= 0);
+    Q_ASSERT(alignment > 0 && !(alignment & (alignment - 1)));
+    char *start = reinterpret_cast<char *>((quintptr(m_cursor) + alignment - 1)
+                                           & ~quintptr(alignment - 1));
+    if (Q_LIKELY(m_cursor && start <= m_end && size <= m_end - start)) {
+        m_allocated += start + size - m_cursor;
+        m_cursor = start + size;
+        return start;
+    }
+    return allocateInNewBlock(size, alignment);
+}
+
+template <typename T>
+QList<T> QArenaAllocator::list(qsizetype capacity)
+{
+    QArrayDataPointer<T> d(QTypedArrayData<T>::allocate(qMax(capacity, qsizetype(1)),
+                                                        QArrayData::KeepSize, this));
+    Q_CHECK_PTR(d.data());
+    return QList<T>(std::move(d));
+}
+
+template <typename Key, typename T>
+QHash<Key, T> QArenaAllocator::hash(qsizetype capacity)
+{
+    QHash<Key, T> result;
+    result.d = QHash<Key, T>::Data::create(this, size_t(capacity));
+    return result;
+}
+
+QT_END_NAMESPACE
+
+#endif // QARENAALLOCATOR_H
@@ -2,6 +2,7 @@
 // Copyright (C) 2016 Intel Corporation.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
+#include <QtCore/qarenaallocator.h>
 #include <QtCore/qarraydata.h>
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
@@ -137,28 +138,50 @@ static inline qsizetype calculateBlockSize(qsizetype &capacity, qsizetype object
     }
 }
 
-static QArrayData *allocateData(qsizetype allocSize)
+namespace {
+// QArrayData with strictest alignment requirements supported by malloc()
+struct alignas(std::max_align_t) AlignedQArrayData : QArrayData
+{
+};
+
+// Memory from an arena starts with a pointer to the arena, padded so that the
+// header that follows it is aligned like memory from malloc().
+constexpr qsizetype ArenaPrefixSize = alignof(AlignedQArrayData);
+static_assert(ArenaPrefixSize >= qsizetype(sizeof(QArenaAllocator *)));
+}
+
+static QArrayData *allocateData(qsizetype allocSize, QArenaAllocator *arena)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    QArrayData *header;
+    if (arena) {
+        void *memory = nullptr;
+        if (Q_LIKELY(!add_overflow(allocSize, ArenaPrefixSize, &allocSize)))
+            memory = arena->allocate(allocSize, alignof(AlignedQArrayData));
+        header = memory
+                ? reinterpret_cast<QArrayData *>(static_cast<char *>(memory) + ArenaPrefixSize)
+                : nullptr;
+        if (header)
+            reinterpret_cast<QArenaAllocator **>(header)[-1] = arena;
+    } else {
+        header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    }
     if (header) {
         header->ref_.storeRelaxed(1);
-        header->flags = {};
+        header->flags = arena ? QArrayData::ArenaAllocated : QArrayData::ArrayOptionDefault;
         header->alloc = 0;
     }
     return header;
 }
 
 
-namespace {
-// QArrayData with strictest alignment requirements supported by malloc()
-struct alignas(std::max_align_t) AlignedQArrayData : QArrayData
+void *QArrayData::allocate(QArrayData **dptr, qsizetype objectSize, qsizetype alignment,
+        qsizetype capacity, QArrayData::AllocationOption option) noexcept
 {
-};
+    return allocate(dptr, objectSize, alignment, capacity, option, nullptr);
 }
 
-
 void *QArrayData::allocate(QArrayData **dptr, qsizetype objectSize, qsizetype alignment,
-        qsizetype capacity, QArrayData::AllocationOption option) noexcept
+        qsizetype capacity, QArrayData::AllocationOption option, QArenaAllocator *arena) noexcept
 {
     Q_ASSERT(dptr);
     // Alignment is a power of two
@@ -188,7 +211,7 @@ void *QArrayData::allocate(QArrayData **dptr, qsizetype objectSize, qsizetype al
         return nullptr;
     }
 
-    QArrayData *header = allocateData(allocSize);
+    QArrayData *header = allocateData(allocSize, arena);
     void *data = nullptr;
     if (header) {
         // find where offset should point to so that data() is aligned to alignment bytes
@@ -221,7 +244,18 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     if (Q_UNLIKELY(allocSize < 0))  // handle overflow. cannot reallocate reliably
         return qMakePair(data, dataPointer);
 
-    QArrayData *header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    QArrayData *header;
+    if (data && data->flags & ArenaAllocated) {
+        // memory of an arena can't be resized, so move it to a new block
+        header = allocateData(allocSize, data->arena());
+        if (header) {
+            const qsizetype used = headerSize + data->alloc * objectSize;
+            memcpy(static_cast<void *>(header), static_cast<const void *>(data),
+                   size_t(qMin(used, allocSize)));
+        }
+    } else {
+        header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    }
     if (header) {
         header->alloc = capacity;
         dataPointer = reinterpret_cast<char *>(header) + offset;
@@ -240,6 +274,9 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
+    // memory of an arena is only released by QArenaAllocator::reset()
+    if (data && data->flags & ArenaAllocated)
+        return;
     ::free(data);
 }
 
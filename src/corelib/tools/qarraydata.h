@@ -11,6 +11,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QArenaAllocator;
 template <class T> struct QTypedArrayData;
 
 struct QArrayData
@@ -27,7 +28,8 @@ struct QArrayData
 
    enum ArrayOption {
         ArrayOptionDefault = 0,
-        CapacityReserved     = 0x1  //!< the capacity was reserved by the user, try to keep it
+        CapacityReserved     = 0x1, //!< the capacity was reserved by the user, try to keep it
+        ArenaAllocated       = 0x2  //!< the memory belongs to a QArenaAllocator, never shared
     };
     Q_DECLARE_FLAGS(ArrayOptions, ArrayOption)
 
@@ -48,6 +50,8 @@ struct QArrayData
     /// Returns true if sharing took place
     bool ref() noexcept
     {
+        if (Q_UNLIKELY(flags & ArenaAllocated))
+            return false;
         ref_.ref();
         return true;
     }
@@ -78,12 +82,22 @@ struct QArrayData
         return newSize;
     }
 
+    // The arena that owns the memory is stored right before the header.
+    QArenaAllocator *arena() const noexcept
+    {
+        if (Q_LIKELY(!(flags & ArenaAllocated)))
+            return nullptr;
+        return reinterpret_cast<QArenaAllocator *const *>(this)[-1];
+    }
+
     [[nodiscard]]
 #if defined(Q_CC_GNU)
     __attribute__((__malloc__))
 #endif
     static Q_CORE_EXPORT void *allocate(QArrayData **pdata, qsizetype objectSize, qsizetype alignment,
             qsizetype capacity, AllocationOption option = QArrayData::KeepSize) noexcept;
+    [[nodiscard]] static Q_CORE_EXPORT void *allocate(QArrayData **pdata, qsizetype objectSize, qsizetype alignment,
+            qsizetype capacity, AllocationOption option, QArenaAllocator *arena) noexcept;
     [[nodiscard]] static Q_CORE_EXPORT QPair<QArrayData *, void *> reallocateUnaligned(QArrayData *data, void *dataPointer,
             qsizetype objectSize, qsizetype newCapacity, AllocationOption option) noexcept;
     static Q_CORE_EXPORT void deallocate(QArrayData *data, qsizetype objectSize,
@@ -109,6 +123,17 @@ struct QTypedArrayData
         return qMakePair(static_cast<QTypedArrayData *>(d), static_cast<T *>(result));
     }
 
+    [[nodiscard]] static QPair<QTypedArrayData *, T *> allocate(qsizetype capacity, AllocationOption option, QArenaAllocator *arena)
+    {
+        static_assert(sizeof(QTypedArrayData) == sizeof(QArrayData));
+        QArrayData *d;
+        void *result = QArrayData::allocate(&d, sizeof(T), alignof(AlignmentDummy), capacity, option, arena);
+#if __has_builtin(__builtin_assume_aligned)
+        result = __builtin_assume_aligned(result, Q_ALIGNOF(AlignmentDummy));
+#endif
+        return qMakePair(static_cast<QTypedArrayData *>(d), static_cast<T *>(result));
+    }
+
     static QPair<QTypedArrayData *, T *>
     reallocateUnaligned(QTypedArrayData *data, T *dataPointer, qsizetype capacity, AllocationOption option)
     {
@@ -35,7 +35,8 @@ public:
     QArrayDataPointer(const QArrayDataPointer &other) noexcept
         : d(other.d), ptr(other.ptr), size(other.size)
     {
-        ref();
+        if (Q_UNLIKELY(!ref()))
+            copyFromArena();
     }
 
     constexpr QArrayDataPointer(Data *header, T *adata, qsizetype n = 0) noexcept
@@ -95,7 +96,8 @@ public:
     {
         if (!deref()) {
             (*this)->destroyAll();
-            free(d);
+            if (Q_LIKELY(!(d->flags & QArrayData::ArenaAllocated)))
+                free(d);
         }
     }
 
@@ -237,6 +239,22 @@ public:
             old->swap(dp);
     }
 
+    /*! \internal
+
+        Memory that belongs to a QArenaAllocator is not shared: gives a copy
+        of such data its own memory on the heap.
+    */
+    Q_NEVER_INLINE void copyFromArena()
+    {
+        QArrayDataPointer copy(Data::allocate(qMax(size, qsizetype(1))));
+        Q_CHECK_PTR(copy.data());
+        copy->copyAppend(ptr, ptr + size);
+        if constexpr (std::is_same_v<T, char> || std::is_same_v<T, char16_t>)
+            copy.ptr[copy.size] = T(); // for QByteArray and QString
+        d = std::exchange(copy.d, nullptr);
+        ptr = copy.ptr;
+    }
+
     /*! \internal
 
         Attempts to relocate [begin(), end()) to accommodate the free space for
@@ -320,7 +338,7 @@ public:
         if constexpr (IsFwdIt) {
             const qsizetype n = std::distance(first, last);
             if (needsDetach() || n > constAllocatedCapacity()) {
-                QArrayDataPointer allocated(Data::allocate(detachCapacity(n)));
+                QArrayDataPointer allocated(Data::allocate(detachCapacity(n), QArrayData::KeepSize, arena()));
                 Q_CHECK_PTR(allocated.data());
                 swap(allocated);
             }
@@ -405,7 +423,7 @@ public:
     // forwards from QArrayData
     qsizetype allocatedCapacity() noexcept { return d ? d->allocatedCapacity() : 0; }
     qsizetype constAllocatedCapacity() const noexcept { return d ? d->constAllocatedCapacity() : 0; }
-    void ref() noexcept { if (d) d->ref(); }
+    bool ref() noexcept { return !d || d->ref(); }
     bool deref() noexcept { return !d || d->deref(); }
     bool isMutable() const noexcept { return d; }
     bool isShared() const noexcept { return !d || d->isShared(); }
@@ -415,6 +433,7 @@ public:
     const typename Data::ArrayOptions flags() const noexcept { return d ? d->flags : Data::ArrayOptionDefault; }
     void setFlag(typename Data::ArrayOptions f) noexcept { Q_ASSERT(d); d->flags |= f; }
     void clearFlag(typename Data::ArrayOptions f) noexcept { if (d) d->flags &= ~f; }
+    QArenaAllocator *arena() const noexcept { return d ? d->arena() : nullptr; }
 
     Data *d_ptr() noexcept { return d; }
     void setBegin(T *begin) noexcept { ptr = begin; }
@@ -446,7 +465,8 @@ public:
         minimalCapacity -= (position == QArrayData::GrowsAtEnd) ? from.freeSpaceAtEnd() : from.freeSpaceAtBegin();
         qsizetype capacity = from.detachCapacity(minimalCapacity);
         const bool grows = capacity > from.constAllocatedCapacity();
-        auto [header, dataPtr] = Data::allocate(capacity, grows ? QArrayData::Grow : QArrayData::KeepSize);
+        auto [header, dataPtr] = Data::allocate(capacity, grows ? QArrayData::Grow : QArrayData::KeepSize,
+                                                from.arena());
         const bool valid = header != nullptr && dataPtr != nullptr;
         if (!valid)
             return QArrayDataPointer(header, dataPtr);
@@ -0,0 +1,257 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qconcurrenthash.h"
+
+#include <QtCore/qlist.h>
+
+#include <algorithm>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QConcurrentHash
+    \inmodule QtCore
+    \since 6.6
+    \brief The QConcurrentHash class is a hash table that many threads can
+    read and write concurrently.
+    \ingroup tools
+    \threadsafe
+
+    QConcurrentHash<Key, T> is meant for caches that are shared by many
+    threads, where a QHash protected by a QReadWriteLock would make the
+    readers serialize on the lock. Looking up an item takes no lock and
+    writes to no memory shared with other threads. Writers lock one of
+    several shards, chosen by the hash of the key, so that writes to
+    different shards don't wait for each other.
+
+    The key type must provide \c qHash() and \c operator==(), like for
+    QHash, and the items are distributed with the same hashing and seed
+    (see QHashSeed). Since items may be replaced or removed by another
+    thread at any time, lookups return a copy of the value, and there are
+    no iterators.
+
+    \code
+    QConcurrentHash<QString, QHostAddress> dnsCache;
+
+    QHostAddress lookup(const QString &host)
+    {
+        QHostAddress address = dnsCache.value(host);
+        if (address.isNull()) {
+            address = resolve(host);
+            dnsCache.insert(host, address);
+        }
+        return address;
+    }
+    \endcode
+
+    Items that are replaced or removed while other threads may still be
+    reading them are freed later, when no thread can access them anymore,
+    using epoch-based reclamation.
+
+    \sa QHash, QReadWriteLock
+*/
+
+/*!
+    \fn template <typename Key, typename T> QConcurrentHash<Key, T>::QConcurrentHash(qsizetype capacity)
+
+    Constructs an empty hash with room for about \a capacity items.
+*/
+
+/*!
+    \fn template <typename Key, typename T> QConcurrentHash<Key, T>::~QConcurrentHash()
+
+    Destroys the hash. No other thread may access it anymore.
+*/
+
+/*!
+    \fn template <typename Key, typename T> qsizetype QConcurrentHash<Key, T>::size() const
+
+    Returns the number of items in the hash. Items that other threads insert
+    or remove at the same time may or may not be counted.
+*/
+
+/*!
+    \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::isEmpty() const
+
+    Returns \c true if the hash contains no items; otherwise returns \c false.
+
+    \sa size()
+*/
+
+/*!
+    \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::contains(const Key &key) const
+
+    Returns \c true if the hash contains an item with the \a key; otherwise
+    returns \c false.
+*/
+
+/*!
+    \fn template <typename Key, typename T> T QConcurrentHash<Key, T>::value(const Key &key, const T &defaultValue) const
+
+    Returns a copy of the value associated with the \a key, or
+    \a defaultValue if the hash contains no item with the key.
+*/
+
+/*!
+    \fn template <typename Key, typename T> void QConcurrentHash<Key, T>::insert(const Key &key, const T &value)
+
+    Inserts a new item with the \a key and the \a value. If there is already
+    an item with the key, its value is replaced with \a value.
+*/
+
+/*!
+    \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::remove(const Key &key)
+
+    Removes the item that has the \a key from the hash. Returns \c true if
+    there was such an item; otherwise returns \c false.
+*/
+
+/*!
+    \fn template <typename Key, typename T> void QConcurrentHash<Key, T>::clear()
+
+    Removes all items from the hash.
+*/
+
+namespace QtPrivate {
+
+// A thread has a record while it uses QEpochGuard. Records are never freed,
+// but a record whose thread exited gets reused by the next thread.
+struct alignas(64) QEpochRecord
+{
+    // the global epoch the thread saw when it entered, or 0 if it is outside
+    // of a QEpochGuard
+    QAtomicInteger<quint64> epoch;
+    QAtomicInt inUse;
+    QEpochRecord *next = nullptr;
+    int nesting = 0; // only used by the owning thread
+};
+
+namespace {
+struct RetiredPointer
+{
+    void *pointer;
+    void (*deleter)(void *);
+    quint64 epoch;
+};
+
+// Don't try to free memory on every call of qEpochRetire(), as it needs to
+// look at the records of all threads.
+constexpr qsizetype ReclaimThreshold = 64;
+
+struct RetiredList
+{
+    QBasicMutex mutex;
+    QList<RetiredPointer> pointers;
+
+    ~RetiredList()
+    {
+        // no other thread is running anymore
+        for (const RetiredPointer &r : std::as_const(pointers))
+            r.deleter(r.pointer);
+    }
+};
+
+struct RecordOwner
+{
+    QEpochRecord *record = nullptr;
+    ~RecordOwner()
+    {
+        if (record)
+            record->inUse.storeRelease(0);
+    }
+};
+} // unnamed namespace
+
+Q_CONSTINIT static QBasicAtomicInteger<quint64> globalEpoch = Q_BASIC_ATOMIC_INITIALIZER(1);
+Q_CONSTINIT static QBasicAtomicPointer<QEpochRecord> epochRecords = Q_BASIC_ATOMIC_INITIALIZER(nullptr);
+static thread_local RecordOwner currentRecord;
+
+static QEpochRecord *acquireRecord()
+{
+    for (QEpochRecord *r = epochRecords.loadAcquire(); r; r = r->next) {
+        if (r->inUse.loadRelaxed() == 0 && r->inUse.testAndSetAcquire(0, 1))
+            return r;
+    }
+
+    auto r = new QEpochRecord;
+    r->inUse.storeRelaxed(1);
+    QEpochRecord *head = epochRecords.loadRelaxed();
+    do {
+        r->next = head;
+    } while (!epochRecords.testAndSetOrdered(head, r, head));
+    return r;
+}
+
+QEpochRecord *QEpochGuard::enter() noexcept
+{
+    QEpochRecord *r = currentRecord.record;
+    if (Q_UNLIKELY(!r))
+        r = currentRecord.record = acquireRecord();
+    if (r->nesting++ == 0) {
+        r->epoch.storeRelaxed(globalEpoch.loadRelaxed());
+        // announce the epoch before loading any pointer that may be retired
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return r;
+}
+
+void QEpochGuard::leave(QEpochRecord *r) noexcept
+{
+    if (--r->nesting == 0)
+        r->epoch.storeRelease(0);
+}
+
+// Advances the global epoch if all threads inside a QEpochGuard have seen the
+// current one. Memory retired in epoch e can't be reached anymore once the
+// global epoch is e + 2.
+static quint64 tryAdvanceEpoch()
+{
+    const quint64 current = globalEpoch.loadRelaxed();
+    for (QEpochRecord *r = epochRecords.loadAcquire(); r; r = r->next) {
+        const quint64 epoch = r->epoch.loadAcquire();
+        if (epoch && epoch != current)
+            return current;
+    }
+    globalEpoch.storeRelease(current + 1);
+    return current + 1;
+}
+
+/*!
+    \internal
+
+    Calls \a deleter with \a pointer as soon as no thread that is in a
+    QEpochGuard can access the memory anymore. The caller must already have
+    made \a pointer unreachable for new readers.
+*/
+void qEpochRetire(void *pointer, void (*deleter)(void *))
+{
+    Q_CONSTINIT static RetiredList retired;
+
+    // make the caller's unlinking visible before the epochs are checked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    QList<RetiredPointer> reclaimable;
+    {
+        QMutexLocker locker(&retired.mutex);
+        retired.pointers.append({ pointer, deleter, globalEpoch.loadRelaxed() });
+        if (retired.pointers.size() < ReclaimThreshold)
+            return;
+
+        const quint64 epoch = tryAdvanceEpoch();
+        auto canReclaim = [epoch](const RetiredPointer &r) { return r.epoch + 2 <= epoch; };
+        const auto it = std::stable_partition(retired.pointers.begin(), retired.pointers.end(),
+                                              [&](const RetiredPointer &r) { return !canReclaim(r); });
+        reclaimable.assign(it, retired.pointers.end());
+        retired.pointers.erase(it, retired.pointers.end());
+    }
+
+    // the deleters may take locks themselves
+    for (const RetiredPointer &r : std::as_const(reclaimable))
+        r.deleter(r.pointer);
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
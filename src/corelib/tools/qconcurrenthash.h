@@ -0,0 +1,248 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCONCURRENTHASH_H
+#define QCONCURRENTHASH_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+struct QEpochRecord;
+
+// Epoch-based reclamation: memory passed to qEpochRetire() is only freed once
+// no thread is inside a QEpochGuard that could still see it.
+class QEpochGuard
+{
+    Q_DISABLE_COPY_MOVE(QEpochGuard)
+public:
+    QEpochGuard() noexcept : record(enter()) {}
+    ~QEpochGuard() { leave(record); }
+
+private:
+    Q_CORE_EXPORT static QEpochRecord *enter() noexcept;
+    Q_CORE_EXPORT static void leave(QEpochRecord *record) noexcept;
+
+    QEpochRecord *record;
+};
+
+Q_CORE_EXPORT void qEpochRetire(void *pointer, void (*deleter)(void *));
+
+} // namespace QtPrivate
+
+template <typename Key, typename T>
+class QConcurrentHash
+{
+    struct Node
+    {
+        size_t hash;
+        Key key;
+        T value;
+    };
+
+    // An open-addressing table with linear probing. Readers walk it without a
+    // lock, so buckets are only ever set, never moved: removing an item leaves
+    // a removed marker behind, and a table that gets too full is replaced.
+    struct Table
+    {
+        explicit Table(size_t capacity)
+            : numBuckets(QHashPrivate::GrowthPolicy::bucketsForCapacity(capacity)),
+              buckets(new QAtomicPointer<Node>[numBuckets])
+        {}
+
+        size_t numBuckets;
+        size_t used = 0; // buckets that are not empty, including removed items
+        std::unique_ptr<QAtomicPointer<Node>[]> buckets;
+    };
+
+    // Writers lock one of the shards, selected by the top bits of the hash.
+    static constexpr int ShardShift = 4;
+    static constexpr size_t ShardCount = size_t(1) << ShardShift;
+    struct alignas(64) Shard // keep writers of different shards off each other's cache lines
+    {
+        QAtomicPointer<Table> table;
+        QBasicMutex mutex;
+        QAtomicInteger<qsizetype> size;
+    };
+
+public:
+    explicit QConcurrentHash(qsizetype capacity = 0)
+        : seed(QHashSeed::globalSeed())
+    {
+        for (Shard &shard : shards)
+            shard.table.storeRelaxed(new Table(size_t(qMax(capacity, qsizetype(0))) / ShardCount));
+    }
+    ~QConcurrentHash()
+    {
+        for (Shard &shard : shards)
+            deleteTableAndNodes(shard.table.loadRelaxed());
+    }
+
+    qsizetype size() const noexcept
+    {
+        qsizetype result = 0;
+        for (const Shard &shard : shards)
+            result += shard.size.loadRelaxed();
+        return result;
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool contains(const Key &key) const
+    {
+        QtPrivate::QEpochGuard guard;
+        return findNode(key);
+    }
+
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        QtPrivate::QEpochGuard guard;
+        if (const Node *n = findNode(key))
+            return n->value;
+        return defaultValue;
+    }
+
+    void insert(const Key &key, const T &value)
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        Node *node = new Node{ hash, key, value };
+        Shard &shard = shardForHash(hash);
+
+        QMutexLocker locker(&shard.mutex);
+        Table *table = shard.table.loadRelaxed();
+        const size_t mask = table->numBuckets - 1;
+        QAtomicPointer<Node> *reusable = nullptr;
+        size_t bucket = hash & mask;
+        for (; Node *n = table->buckets[bucket].loadRelaxed(); bucket = (bucket + 1) & mask) {
+            if (n == removedNode()) {
+                if (!reusable)
+                    reusable = &table->buckets[bucket];
+            } else if (n->hash == hash && qHashEquals(n->key, key)) {
+                table->buckets[bucket].storeRelease(node);
+                locker.unlock();
+                QtPrivate::qEpochRetire(n, deleteNode);
+                return;
+            }
+        }
+
+        if (reusable) {
+            reusable->storeRelease(node);
+        } else {
+            table->buckets[bucket].storeRelease(node);
+            ++table->used;
+        }
+        const qsizetype newSize = shard.size.loadRelaxed() + 1;
+        shard.size.storeRelaxed(newSize);
+        if (table->used > table->numBuckets / 2) {
+            rehash(shard, size_t(newSize));
+            locker.unlock();
+            QtPrivate::qEpochRetire(table, deleteTable);
+        }
+    }
+
+    bool remove(const Key &key)
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        Shard &shard = shardForHash(hash);
+
+        QMutexLocker locker(&shard.mutex);
+        Table *table = shard.table.loadRelaxed();
+        const size_t mask = table->numBuckets - 1;
+        for (size_t bucket = hash & mask; Node *n = table->buckets[bucket].loadRelaxed();
+             bucket = (bucket + 1) & mask) {
+            if (n != removedNode() && n->hash == hash && qHashEquals(n->key, key)) {
+                table->buckets[bucket].storeRelease(removedNode());
+                shard.size.storeRelaxed(shard.size.loadRelaxed() - 1);
+                locker.unlock();
+                QtPrivate::qEpochRetire(n, deleteNode);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        for (Shard &shard : shards) {
+            QMutexLocker locker(&shard.mutex);
+            Table *table = shard.table.loadRelaxed();
+            shard.table.storeRelease(new Table(0));
+            shard.size.storeRelaxed(0);
+            locker.unlock();
+            QtPrivate::qEpochRetire(table, deleteTableAndNodes);
+        }
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentHash)
+
+    static Node *removedNode() noexcept { return reinterpret_cast<Node *>(quintptr(1)); }
+
+    Shard &shardForHash(size_t hash) noexcept
+    {
+        return shards[hash >> (std::numeric_limits<size_t>::digits - ShardShift)];
+    }
+    const Shard &shardForHash(size_t hash) const noexcept
+    {
+        return shards[hash >> (std::numeric_limits<size_t>::digits - ShardShift)];
+    }
+
+    // must be called within a QEpochGuard
+    const Node *findNode(const Key &key) const
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        const Table *table = shardForHash(hash).table.loadAcquire();
+        const size_t mask = table->numBuckets - 1;
+        for (size_t bucket = hash & mask; const Node *n = table->buckets[bucket].loadAcquire();
+             bucket = (bucket + 1) & mask) {
+            if (n != removedNode() && n->hash == hash && qHashEquals(n->key, key))
+                return n;
+        }
+        return nullptr;
+    }
+
+    // Publishes a new table for shard with the items of the current one. The
+    // caller retires the old table, but not its items.
+    static void rehash(Shard &shard, size_t size)
+    {
+        const Table *table = shard.table.loadRelaxed();
+        Table *newTable = new Table(size);
+        const size_t mask = newTable->numBuckets - 1;
+        for (size_t i = 0; i < table->numBuckets; ++i) {
+            Node *n = table->buckets[i].loadRelaxed();
+            if (!n || n == removedNode())
+                continue;
+            size_t bucket = n->hash & mask;
+            while (newTable->buckets[bucket].loadRelaxed())
+                bucket = (bucket + 1) & mask;
+            newTable->buckets[bucket].storeRelaxed(n);
+        }
+        newTable->used = size;
+        shard.table.storeRelease(newTable);
+    }
+
+    static void deleteNode(void *node) { delete static_cast<Node *>(node); }
+    static void deleteTable(void *table) { delete static_cast<Table *>(table); }
+    static void deleteTableAndNodes(void *pointer)
+    {
+        Table *table = static_cast<Table *>(pointer);
+        for (size_t i = 0; i < table->numBuckets; ++i) {
+            Node *n = table->buckets[i].loadRelaxed();
+            if (n != removedNode())
+                delete n;
+        }
+        delete table;
+    }
+
+    Shard shards[ShardCount];
+    size_t seed;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTHASH_H
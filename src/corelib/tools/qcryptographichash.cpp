@@ -10,6 +10,7 @@
 #include <qmutex.h>
 #include <qvarlengtharray.h>
 #include <private/qlocking_p.h>
+#include <private/qsimd_p.h>
 
 #include <array>
 #include <climits>
@@ -292,6 +293,627 @@ static constexpr bool useNonOpenSSLFallback(QCryptographicHash::Algorithm method
 }
 #endif // USING_OPENSSL30
 
+#ifndef USING_OPENSSL30
+/*
+    SHA-1 and SHA-256 compress whole 64-byte blocks with the SHA extensions
+    of the CPU where it has them. The block functions take the hash state as
+    an array of words and don't do any buffering. Only the non-OpenSSL
+    implementation needs them: OpenSSL does the same itself.
+*/
+using ShaBlockFunction = void (*)(quint32 *state, const uchar *data, qsizetype blocks);
+
+#if !defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1)
+alignas(16) static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86) \
+    && QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+#  define SHA_X86
+#  define QT_FUNCTION_TARGET_STRING_SHA_SSE4_1  QT_FUNCTION_TARGET_STRING_SHA "," \
+                                                QT_FUNCTION_TARGET_STRING_SSE4_1
+
+template <int Function>
+static inline void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1Rounds4_x86(__m128i &abcd, __m128i &e, __m128i msg)
+{
+    const __m128i e1 = _mm_sha1nexte_epu32(e, msg);
+    e = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e1, Function);
+}
+
+static inline __m128i QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1Schedule_x86(__m128i m0, __m128i m1, __m128i m2, __m128i m3)
+{
+    return _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(m0, m1), m2), m3);
+}
+
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1Blocks_x86(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    // the words are in reverse order in the registers
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1b);
+    __m128i e0 = _mm_set_epi32(int(state[4]), 0, 0, 0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const auto load = [&](int i) QT_FUNCTION_TARGET(SHA_SSE4_1) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i);
+            return _mm_shuffle_epi8(m, mask);
+        };
+        const __m128i abcdSaved = abcd;
+        const __m128i eSaved = e0;
+        __m128i m0 = load(0);
+        __m128i m1 = load(1);
+        __m128i m2 = load(2);
+        __m128i m3 = load(3);
+
+        // rounds 0-3 take E from the state, the others from the previous rounds
+        __m128i e = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, _mm_add_epi32(e0, m0), 0);
+        sha1Rounds4_x86<0>(abcd, e, m1);
+        sha1Rounds4_x86<0>(abcd, e, m2);
+        sha1Rounds4_x86<0>(abcd, e, m3);
+        m0 = sha1Schedule_x86(m0, m1, m2, m3);
+        sha1Rounds4_x86<0>(abcd, e, m0);
+        m1 = sha1Schedule_x86(m1, m2, m3, m0);
+        sha1Rounds4_x86<1>(abcd, e, m1);
+        m2 = sha1Schedule_x86(m2, m3, m0, m1);
+        sha1Rounds4_x86<1>(abcd, e, m2);
+        m3 = sha1Schedule_x86(m3, m0, m1, m2);
+        sha1Rounds4_x86<1>(abcd, e, m3);
+        m0 = sha1Schedule_x86(m0, m1, m2, m3);
+        sha1Rounds4_x86<1>(abcd, e, m0);
+        m1 = sha1Schedule_x86(m1, m2, m3, m0);
+        sha1Rounds4_x86<1>(abcd, e, m1);
+        m2 = sha1Schedule_x86(m2, m3, m0, m1);
+        sha1Rounds4_x86<2>(abcd, e, m2);
+        m3 = sha1Schedule_x86(m3, m0, m1, m2);
+        sha1Rounds4_x86<2>(abcd, e, m3);
+        m0 = sha1Schedule_x86(m0, m1, m2, m3);
+        sha1Rounds4_x86<2>(abcd, e, m0);
+        m1 = sha1Schedule_x86(m1, m2, m3, m0);
+        sha1Rounds4_x86<2>(abcd, e, m1);
+        m2 = sha1Schedule_x86(m2, m3, m0, m1);
+        sha1Rounds4_x86<2>(abcd, e, m2);
+        m3 = sha1Schedule_x86(m3, m0, m1, m2);
+        sha1Rounds4_x86<3>(abcd, e, m3);
+        m0 = sha1Schedule_x86(m0, m1, m2, m3);
+        sha1Rounds4_x86<3>(abcd, e, m0);
+        m1 = sha1Schedule_x86(m1, m2, m3, m0);
+        sha1Rounds4_x86<3>(abcd, e, m1);
+        m2 = sha1Schedule_x86(m2, m3, m0, m1);
+        sha1Rounds4_x86<3>(abcd, e, m2);
+        m3 = sha1Schedule_x86(m3, m0, m1, m2);
+        sha1Rounds4_x86<3>(abcd, e, m3);
+
+        e0 = _mm_sha1nexte_epu32(e, eSaved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = quint32(_mm_extract_epi32(e0, 3));
+}
+
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha256Blocks_x86(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    // the instructions want the state as ABEF and CDGH
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    const __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0xb1);
+    const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state) + 1), 0x1b);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+    for ( ; blocks; --blocks, data += 64) {
+        const auto load = [&](int i) QT_FUNCTION_TARGET(SHA_SSE4_1) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i);
+            return _mm_shuffle_epi8(m, mask);
+        };
+        const auto rounds4 = [&](__m128i msg, int i) QT_FUNCTION_TARGET(SHA_SSE4_1) {
+            const __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants) + i);
+            msg = _mm_add_epi32(msg, k);
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg, 0x0e));
+        };
+        const auto schedule = [](__m128i m0, __m128i m1, __m128i m2, __m128i m3)
+                QT_FUNCTION_TARGET(SHA_SSE4_1) {
+            const __m128i w = _mm_add_epi32(_mm_sha256msg1_epu32(m0, m1), _mm_alignr_epi8(m3, m2, 4));
+            return _mm_sha256msg2_epu32(w, m3);
+        };
+
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+        __m128i m0 = load(0);
+        __m128i m1 = load(1);
+        __m128i m2 = load(2);
+        __m128i m3 = load(3);
+        rounds4(m0, 0);
+        rounds4(m1, 1);
+        rounds4(m2, 2);
+        rounds4(m3, 3);
+        for (int i = 4; i < 16; i += 4) {
+            m0 = schedule(m0, m1, m2, m3);
+            rounds4(m0, i);
+            m1 = schedule(m1, m2, m3, m0);
+            rounds4(m1, i + 1);
+            m2 = schedule(m2, m3, m0, m1);
+            rounds4(m2, i + 2);
+            m3 = schedule(m3, m0, m1, m2);
+            rounds4(m3, i + 3);
+        }
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state) + 1, _mm_alignr_epi8(dchg, feba, 8));
+}
+#elif !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_ARM_64) && QT_COMPILER_SUPPORTS_HERE(AES)
+// The ARMv8 Cryptographic Extension has both the AES and the SHA instructions
+#  define SHA_ARM
+
+static void QT_FUNCTION_TARGET(AES)
+sha1Blocks_arm(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    static const uint32_t roundConstants[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t e = state[4];
+
+    for ( ; blocks; --blocks, data += 64) {
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; ++i)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        const uint32x4_t abcdSaved = abcd;
+        const uint32_t eSaved = e;
+        for (int i = 0; i < 20; ++i) {
+            if (i >= 4) {
+                const uint32x4_t w = vsha1su0q_u32(msg[i % 4], msg[(i + 1) % 4], msg[(i + 2) % 4]);
+                msg[i % 4] = vsha1su1q_u32(w, msg[(i + 3) % 4]);
+            }
+            const uint32x4_t wk = vaddq_u32(msg[i % 4], vdupq_n_u32(roundConstants[i / 5]));
+            const uint32_t nextE = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (i < 5)
+                abcd = vsha1cq_u32(abcd, e, wk);
+            else if (i >= 10 && i < 15)
+                abcd = vsha1mq_u32(abcd, e, wk);
+            else
+                abcd = vsha1pq_u32(abcd, e, wk);
+            e = nextE;
+        }
+        abcd = vaddq_u32(abcd, abcdSaved);
+        e += eSaved;
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e;
+}
+
+static void QT_FUNCTION_TARGET(AES)
+sha256Blocks_arm(quint32 *state, const uchar *data, qsizetype blocks)
+{
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+
+    for ( ; blocks; --blocks, data += 64) {
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; ++i)
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        const uint32x4_t abcdSaved = abcd;
+        const uint32x4_t efghSaved = efgh;
+        for (int i = 0; i < 16; ++i) {
+            if (i >= 4) {
+                const uint32x4_t w = vsha256su0q_u32(msg[i % 4], msg[(i + 1) % 4]);
+                msg[i % 4] = vsha256su1q_u32(w, msg[(i + 2) % 4], msg[(i + 3) % 4]);
+            }
+            const uint32x4_t wk = vaddq_u32(msg[i % 4], vld1q_u32(sha256RoundConstants + 4 * i));
+            const uint32x4_t previous = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, previous, wk);
+        }
+        abcd = vaddq_u32(abcd, abcdSaved);
+        efgh = vaddq_u32(efgh, efghSaved);
+    }
+
+    vst1q_u32(state, abcd);
+    vst1q_u32(state + 4, efgh);
+}
+#endif
+
+static ShaBlockFunction sha1BlockFunction() noexcept
+{
+#if defined(SHA_X86)
+    if (qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1))
+        return sha1Blocks_x86;
+#elif defined(SHA_ARM)
+    if (qCpuHasFeature(ARM_CRYPTO))
+        return sha1Blocks_arm;
+#endif
+    return nullptr;
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static ShaBlockFunction sha256BlockFunction() noexcept
+{
+#if defined(SHA_X86)
+    if (qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1))
+        return sha256Blocks_x86;
+#elif defined(SHA_ARM)
+    if (qCpuHasFeature(ARM_CRYPTO))
+        return sha256Blocks_arm;
+#endif
+    return nullptr;
+}
+#endif
+
+// Returns the number of bytes to pad a message of size \a size with, before
+// its size in bits: the 0x80 byte and as many zeroes as needed to end 8
+// bytes before a block boundary.
+static constexpr qsizetype shaPaddingLength(quint64 size) noexcept
+{
+    return qsizetype((55 - size) & 63) + 1;
+}
+
+static void sha1Input(Sha1State *state, const uchar *data, qsizetype length) noexcept
+{
+    const ShaBlockFunction blockFunction = sha1BlockFunction();
+    if (!blockFunction) {
+        sha1Update(state, data, length);
+        return;
+    }
+
+    qsizetype buffered = qsizetype(state->messageSize & 63);
+    state->messageSize += length;
+    if (buffered + length < 64) {
+        memcpy(state->buffer + buffered, data, length);
+        return;
+    }
+
+    quint32 h[5] = { state->h0, state->h1, state->h2, state->h3, state->h4 };
+    if (buffered) {
+        const qsizetype n = 64 - buffered;
+        memcpy(state->buffer + buffered, data, n);
+        blockFunction(h, state->buffer, 1);
+        data += n;
+        length -= n;
+    }
+    blockFunction(h, data, length / 64);
+    memcpy(state->buffer, data + (length & ~63), length & 63);
+    state->h0 = h[0];
+    state->h1 = h[1];
+    state->h2 = h[2];
+    state->h3 = h[3];
+    state->h4 = h[4];
+}
+
+static void sha1Finish(Sha1State *state, uchar *result) noexcept
+{
+    uchar padding[64 + 8] = { 0x80 };
+    const qsizetype paddingLength = shaPaddingLength(state->messageSize);
+    qToBigEndian(state->messageSize << 3, padding + paddingLength);
+    sha1Input(state, padding, paddingLength + 8);
+    sha1ToHash(state, result);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+// SHA-224 uses the same context and block function as SHA-256
+static void sha256Input(SHA256Context *context, const uchar *data, qsizetype length) noexcept
+{
+    const ShaBlockFunction blockFunction = sha256BlockFunction();
+    if (!blockFunction) {
+        SHA256Input(context, data, uint(length));
+        return;
+    }
+
+    // the length in bits fits an unsigned int: the callers pass at most UINT_MAX bytes
+    const auto addLength = [context](qsizetype bytes) {
+        for ( ; bytes > 0; bytes -= 1 << 28)
+            SHA224_256AddLength(context, uint(qMin(bytes, qsizetype(1) << 28)) * 8);
+    };
+    const qsizetype buffered = context->Message_Block_Index;
+    addLength(length);
+    if (buffered + length < SHA256_Message_Block_Size) {
+        memcpy(context->Message_Block + buffered, data, length);
+        context->Message_Block_Index = int_least16_t(buffered + length);
+        return;
+    }
+
+    if (buffered) {
+        const qsizetype n = SHA256_Message_Block_Size - buffered;
+        memcpy(context->Message_Block + buffered, data, n);
+        blockFunction(context->Intermediate_Hash, context->Message_Block, 1);
+        data += n;
+        length -= n;
+    }
+    blockFunction(context->Intermediate_Hash, data, length / 64);
+    memcpy(context->Message_Block, data + (length & ~63), length & 63);
+    context->Message_Block_Index = int_least16_t(length & 63);
+}
+
+static void sha256Finish(SHA256Context *context, uchar *result, int hashSize) noexcept
+{
+    const quint64 bits = quint64(context->Length_High) << 32 | context->Length_Low;
+    uchar padding[64 + 8] = { 0x80 };
+    const qsizetype paddingLength = shaPaddingLength(bits / 8);
+    qToBigEndian(bits, padding + paddingLength);
+    sha256Input(context, padding, paddingLength + 8);
+    for (int i = 0; i < hashSize / 4; ++i)
+        qToBigEndian(context->Intermediate_Hash[i], result + 4 * i);
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
+#if !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define SHA_MULTIBUFFER
+/*
+    Multi-buffer hashing: eight independent messages are hashed at the same
+    time, with one message in each 32-bit lane of the AVX2 registers. The
+    lanes that run out of messages get a dummy block and their result is
+    discarded.
+*/
+namespace {
+enum { MultiBufferLanes = 8 };
+using MultiBufferState = quint32[8][MultiBufferLanes];     // [word][lane]
+using MultiBufferBlocks = const uchar *[MultiBufferLanes];
+using MultiBufferFunction = void (*)(MultiBufferState &state, const MultiBufferBlocks &blocks);
+}
+
+// Loads the 16 big-endian words of one block of each lane, word by word
+static inline void QT_FUNCTION_TARGET(AVX2)
+loadTransposed(__m256i w[16], const MultiBufferBlocks &blocks)
+{
+    const __m256i byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (int half = 0; half < 2; ++half) {
+        __m256i r[MultiBufferLanes];
+        for (int lane = 0; lane < MultiBufferLanes; ++lane) {
+            const __m256i *p = reinterpret_cast<const __m256i *>(blocks[lane]) + half;
+            r[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256(p), byteSwap);
+        }
+        __m256i t[8], u[8];
+        for (int i = 0; i < 8; i += 2) {
+            t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+            t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+        }
+        for (int i = 0; i < 8; i += 4) {
+            u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+            u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+            u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+            u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (int i = 0; i < 4; ++i) {
+            w[8 * half + i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+            w[8 * half + i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+        }
+    }
+}
+
+template <int N> static inline __m256i QT_FUNCTION_TARGET(AVX2) rotl_avx2(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+}
+
+template <int N> static inline __m256i QT_FUNCTION_TARGET(AVX2) rotr_avx2(__m256i x)
+{
+    return rotl_avx2<32 - N>(x);
+}
+
+static void QT_FUNCTION_TARGET(AVX2)
+sha1MultiBuffer_avx2(MultiBufferState &state, const MultiBufferBlocks &blocks)
+{
+    __m256i w[16];
+    loadTransposed(w, blocks);
+
+    __m256i s[5];
+    for (int i = 0; i < 5; ++i)
+        s[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(state[i]));
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4];
+
+    const auto round = [&](int t, __m256i f, quint32 k) QT_FUNCTION_TARGET(AVX2) {
+        if (t >= 16) {
+            const __m256i x = _mm256_xor_si256(_mm256_xor_si256(w[(t + 13) & 15], w[(t + 8) & 15]),
+                                               _mm256_xor_si256(w[(t + 2) & 15], w[t & 15]));
+            w[t & 15] = rotl_avx2<1>(x);
+        }
+        __m256i temp = _mm256_add_epi32(rotl_avx2<5>(a), f);
+        temp = _mm256_add_epi32(temp, _mm256_add_epi32(e, _mm256_set1_epi32(int(k))));
+        temp = _mm256_add_epi32(temp, w[t & 15]);
+        e = d;
+        d = c;
+        c = rotl_avx2<30>(b);
+        b = a;
+        a = temp;
+    };
+    int t = 0;
+    for ( ; t < 20; ++t)    // Ch
+        round(t, _mm256_xor_si256(_mm256_and_si256(b, _mm256_xor_si256(c, d)), d), 0x5a827999);
+    for ( ; t < 40; ++t)    // Parity
+        round(t, _mm256_xor_si256(_mm256_xor_si256(b, c), d), 0x6ed9eba1);
+    for ( ; t < 60; ++t)    // Maj
+        round(t, _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c))),
+              0x8f1bbcdc);
+    for ( ; t < 80; ++t)    // Parity
+        round(t, _mm256_xor_si256(_mm256_xor_si256(b, c), d), 0xca62c1d6);
+
+    const __m256i result[5] = { a, b, c, d, e };
+    for (int i = 0; i < 5; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(state[i]),
+                           _mm256_add_epi32(s[i], result[i]));
+    }
+}
+
+static void QT_FUNCTION_TARGET(AVX2)
+sha256MultiBuffer_avx2(MultiBufferState &state, const MultiBufferBlocks &blocks)
+{
+    static const quint32 *const k = sha256RoundConstants;
+    __m256i w[16];
+    loadTransposed(w, blocks);
+
+    __m256i s[8];
+    for (int i = 0; i < 8; ++i)
+        s[i] = _mm256_load_si256(reinterpret_cast<const __m256i *>(state[i]));
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            const __m256i w15 = w[(t + 1) & 15];
+            const __m256i w2 = w[(t + 14) & 15];
+            const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<7>(w15), rotr_avx2<18>(w15)),
+                                                _mm256_srli_epi32(w15, 3));
+            const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<17>(w2), rotr_avx2<19>(w2)),
+                                                _mm256_srli_epi32(w2, 10));
+            w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                         _mm256_add_epi32(w[(t + 9) & 15], s1));
+        }
+        const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<6>(e), rotr_avx2<11>(e)),
+                                            rotr_avx2<25>(e));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(h, s1), ch);
+        temp1 = _mm256_add_epi32(temp1, _mm256_add_epi32(_mm256_set1_epi32(int(k[t])), w[t & 15]));
+        const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<2>(a), rotr_avx2<13>(a)),
+                                            rotr_avx2<22>(a));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                            _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        const __m256i temp2 = _mm256_add_epi32(s0, maj);
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(temp1, temp2);
+    }
+
+    const __m256i result[8] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(state[i]),
+                           _mm256_add_epi32(s[i], result[i]));
+    }
+}
+
+static bool hashManyMultiBuffer(const QList<QByteArrayView> &data,
+                                QCryptographicHash::Algorithm method, QList<QByteArray> &results)
+{
+    static const quint32 sha1Init[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+    static const quint32 sha224Init[8] = { 0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+                                           0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 };
+    static const quint32 sha256Init[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                           0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    // Only worth it with enough messages to fill the lanes, and when the
+    // CPU can't do better with the SHA instructions.
+    if (data.size() < MultiBufferLanes / 2 || !qCpuHasFeature(AVX2))
+        return false;
+
+    MultiBufferFunction function;
+    const quint32 *init;
+    int stateWords = 8;
+    switch (method) {
+    case QCryptographicHash::Sha1:
+        if (sha1BlockFunction())
+            return false;
+        function = sha1MultiBuffer_avx2;
+        init = sha1Init;
+        stateWords = 5;
+        break;
+    case QCryptographicHash::Sha224:
+    case QCryptographicHash::Sha256:
+        if (sha256BlockFunction())
+            return false;
+        function = sha256MultiBuffer_avx2;
+        init = method == QCryptographicHash::Sha224 ? sha224Init : sha256Init;
+        break;
+    default:
+        return false;
+    }
+    const int hashLength = hashLengthInternal(method);
+
+    struct Lane {
+        const uchar *data;
+        qsizetype blocks;           // full blocks left in data
+        int tailBlocks;             // blocks with the padding left in tail
+        qsizetype message = -1;     // -1 when the lane is idle
+        uchar tail[2 * 64];
+    };
+    Lane lanes[MultiBufferLanes];
+    alignas(32) MultiBufferState state;
+    static const uchar idleBlock[64] = {};
+    qsizetype nextMessage = 0;
+    int busyLanes = 0;
+
+    const auto startMessage = [&](int lane) {
+        Lane &l = lanes[lane];
+        if (nextMessage == data.size()) {
+            l.message = -1;
+            return;
+        }
+        const QByteArrayView message = data.at(nextMessage);
+        l.message = nextMessage++;
+        l.data = reinterpret_cast<const uchar *>(message.data());
+        l.blocks = message.size() / 64;
+        const qsizetype rest = message.size() % 64;
+        const qsizetype paddingLength = shaPaddingLength(quint64(message.size()));
+        l.tailBlocks = int(rest + paddingLength + 8) / 64;
+        // the tail blocks are at the end of the tail buffer
+        uchar *tail = l.tail + sizeof(l.tail) - 64 * l.tailBlocks;
+        memset(tail, 0, 64 * l.tailBlocks);
+        if (rest)
+            memcpy(tail, l.data + 64 * l.blocks, rest);
+        tail[rest] = 0x80;
+        qToBigEndian(quint64(message.size()) << 3, tail + rest + paddingLength);
+        for (int i = 0; i < stateWords; ++i)
+            state[i][lane] = init[i];
+        ++busyLanes;
+    };
+
+    results.resize(data.size());
+    for (int lane = 0; lane < MultiBufferLanes; ++lane)
+        startMessage(lane);
+    while (busyLanes) {
+        MultiBufferBlocks blocks;
+        for (int lane = 0; lane < MultiBufferLanes; ++lane) {
+            const Lane &l = lanes[lane];
+            if (l.message < 0)
+                blocks[lane] = idleBlock;
+            else if (l.blocks)
+                blocks[lane] = l.data;
+            else
+                blocks[lane] = l.tail + sizeof(l.tail) - 64 * l.tailBlocks;
+        }
+        function(state, blocks);
+        for (int lane = 0; lane < MultiBufferLanes; ++lane) {
+            Lane &l = lanes[lane];
+            if (l.message < 0)
+                continue;
+            if (l.blocks) {
+                --l.blocks;
+                l.data += 64;
+            } else if (--l.tailBlocks == 0) {
+                QByteArray &result = results[l.message];
+                result.resize(hashLength);
+                for (int i = 0; i < hashLength / 4; ++i)
+                    qToBigEndian(state[i][lane], result.data() + 4 * i);
+                --busyLanes;
+                startMessage(lane);
+            }
+        }
+    }
+    return true;
+}
+#endif // SHA_MULTIBUFFER
+#endif // !USING_OPENSSL30
+
 class QCryptographicHashPrivate
 {
 public:
@@ -846,7 +1468,7 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
-            sha1Update(&sha1Context, (const unsigned char *)data, length);
+            sha1Input(&sha1Context, reinterpret_cast<const uchar *>(data), length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
         default:
@@ -861,10 +1483,10 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
-            SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256Input(&sha224Context, reinterpret_cast<const uchar *>(data), length);
             break;
         case QCryptographicHash::Sha256:
-            SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256Input(&sha256Context, reinterpret_cast<const uchar *>(data), length);
             break;
         case QCryptographicHash::Sha384:
             SHA384Input(&sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -1025,8 +1647,7 @@ void QCryptographicHashPrivate::State::finalizeUnchecked(QCryptographicHash::Alg
     case QCryptographicHash::Sha1: {
         Sha1State copy = sha1Context;
         result.resizeForOverwrite(20);
-        sha1FinalizeState(&copy);
-        sha1ToHash(&copy, result.data());
+        sha1Finish(&copy, result.data());
         break;
     }
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -1050,13 +1671,13 @@ void QCryptographicHashPrivate::State::finalizeUnchecked(QCryptographicHash::Alg
     case QCryptographicHash::Sha224: {
         SHA224Context copy = sha224Context;
         result.resizeForOverwrite(SHA224HashSize);
-        SHA224Result(&copy, result.data());
+        sha256Finish(&copy, result.data(), SHA224HashSize);
         break;
     }
     case QCryptographicHash::Sha256: {
         SHA256Context copy = sha256Context;
         result.resizeForOverwrite(SHA256HashSize);
-        SHA256Result(&copy, result.data());
+        sha256Finish(&copy, result.data(), SHA256HashSize);
         break;
     }
     case QCryptographicHash::Sha384: {
@@ -1126,6 +1747,32 @@ QByteArray QCryptographicHash::hash(QByteArrayView data, Algorithm method)
     return hash.resultView().toByteArray();
 }
 
+/*!
+  \since 6.6
+
+  Returns the hashes of each of the messages in \a data, using \a method,
+  in the same order.
+
+  This is equivalent to calling hash() for each message, but may be
+  considerably faster for many short messages: when the CPU has no
+  dedicated instructions for \a method, SHA-1, SHA-224 and SHA-256 hash up
+  to eight messages at the same time using vector instructions.
+
+  \sa hash()
+*/
+QByteArrayList QCryptographicHash::hashMany(const QList<QByteArrayView> &data, Algorithm method)
+{
+    QByteArrayList results;
+#ifdef SHA_MULTIBUFFER
+    if (hashManyMultiBuffer(data, method, results))
+        return results;
+#endif
+    results.reserve(data.size());
+    for (QByteArrayView message : data)
+        results.append(hash(message, method));
+    return results;
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -3865,7 +3865,7 @@ static_assert(sizeof(Span<Node1>) == sizeof(Span<Node<char, void *>>));
 static_assert(sizeof(Span<Node1>) == sizeof(Span<Node<qsizetype, QHashDummyValue>>));
 static_assert(sizeof(Span<Node1>) == sizeof(Span<Node<QString, QVariant>>));
 static_assert(sizeof(Span<Node1>) > SpanConstants::NEntries);
-static_assert(qNextPowerOfTwo(sizeof(Span<Node1>)) == SpanConstants::NEntries * 2);
+static_assert(qNextPowerOfTwo(sizeof(Span<Node1>)) == SpanConstants::NEntries * 4);
 
 // ensure allocations are always a power of two, at a minimum NEntries,
 // obeying the fomula
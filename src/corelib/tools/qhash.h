@@ -6,6 +6,7 @@
 #define QHASH_H
 
 #include <QtCore/qalgorithms.h>
+#include <QtCore/qarenaallocator.h>
 #include <QtCore/qcontainertools_impl.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qiterator.h>
@@ -15,6 +16,14 @@
 #include <initializer_list>
 #include <functional> // for std::hash
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define QT_QHASH_GROUP_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define QT_QHASH_GROUP_NEON
+#endif
+
 class tst_QHash; // for befriending
 
 QT_BEGIN_NAMESPACE
@@ -223,8 +232,102 @@ struct SpanConstants {
     static constexpr size_t NEntries = (1 << SpanShift);
     static constexpr size_t LocalBucketMask = (NEntries - 1);
     static constexpr size_t UnusedEntry = 0xff;
+    static constexpr unsigned char EmptyControl = 0x80;
 
     static_assert ((NEntries & LocalBucketMask) == 0, "NEntries must be a power of two.");
+
+    // The control byte of a used bucket holds the top 7 bits of the hash of its key.
+    static constexpr unsigned char controlForHash(size_t hash) noexcept
+    {
+        return static_cast<unsigned char>(hash >> (std::numeric_limits<size_t>::digits - 7));
+    }
+};
+
+// A group of consecutive control bytes of a Span, to compare all of them against the
+// control byte of a key at once. In the masks returned by match() and matchEmpty(), each
+// matching bucket has one bit set, with the first bucket of the group in the lowest bits.
+struct ControlGroup
+{
+#if defined(QT_QHASH_GROUP_SSE2)
+    using Mask = quint32;
+    static constexpr size_t Size = 16;
+    static constexpr size_t BitsPerBucket = 1;
+
+    __m128i bytes;
+
+    static ControlGroup load(const unsigned char *controls) noexcept
+    {
+        return { _mm_loadu_si128(reinterpret_cast<const __m128i *>(controls)) };
+    }
+    Mask match(unsigned char control) const noexcept
+    {
+        const __m128i matches = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(char(control)));
+        return Mask(_mm_movemask_epi8(matches));
+    }
+    Mask matchEmpty() const noexcept
+    {
+        // EmptyControl is the only control byte with the top bit set
+        return Mask(_mm_movemask_epi8(bytes));
+    }
+#elif defined(QT_QHASH_GROUP_NEON)
+    using Mask = quint64;
+    static constexpr size_t Size = 16;
+    static constexpr size_t BitsPerBucket = 4;
+
+    uint8x16_t bytes;
+
+    static ControlGroup load(const unsigned char *controls) noexcept
+    {
+        return { vld1q_u8(controls) };
+    }
+    static Mask toMask(uint8x16_t matches) noexcept
+    {
+        // NEON has no movemask: narrow each byte to a nibble and keep one bit of it
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & Q_UINT64_C(0x8888888888888888);
+    }
+    Mask match(unsigned char control) const noexcept
+    {
+        return toMask(vceqq_u8(bytes, vdupq_n_u8(control)));
+    }
+    Mask matchEmpty() const noexcept
+    {
+        return toMask(vtstq_u8(bytes, vdupq_n_u8(SpanConstants::EmptyControl)));
+    }
+#else
+    using Mask = quint64;
+    static constexpr size_t Size = 8;
+    static constexpr size_t BitsPerBucket = 8;
+    static constexpr quint64 LowBits = Q_UINT64_C(0x0101010101010101);
+    static constexpr quint64 HighBits = Q_UINT64_C(0x8080808080808080);
+
+    quint64 bytes;
+
+    static ControlGroup load(const unsigned char *controls) noexcept
+    {
+        quint64 bytes = 0;
+        for (size_t i = 0; i < Size; ++i)
+            bytes |= quint64(controls[i]) << (8 * i);
+        return { bytes };
+    }
+    Mask match(unsigned char control) const noexcept
+    {
+        // sets the top bit of each zero byte of x; a byte above a zero byte can also be
+        // reported, which is harmless as the keys get compared anyway
+        const quint64 x = bytes ^ (LowBits * control);
+        return (x - LowBits) & ~x & HighBits;
+    }
+    Mask matchEmpty() const noexcept
+    {
+        return bytes & HighBits;
+    }
+#endif
+
+    static size_t firstBucket(Mask mask) noexcept
+    {
+        Q_ASSERT(mask);
+        return size_t(qCountTrailingZeroBits(mask)) / BitsPerBucket;
+    }
 };
 
 // Regular hash tables consist of a list of buckets that can store Nodes. But simply allocating one large array of buckets
@@ -235,6 +338,10 @@ struct SpanConstants {
 // actual storage space for the Nodes (the 'entries' member) or 0xff (UnusedEntry) to flag that the bucket is empty.
 // As we have only 128 entries per Span, the offset array can be represented using an unsigned char. This trick makes the hash
 // table have a very small memory overhead compared to many other implementations.
+//
+// The control array holds a byte per bucket as well: EmptyControl for an unused bucket, or 7 bits of the hash of the key
+// stored in it. Lookups compare a whole ControlGroup of them with the bits of the key they search for, and only compare
+// the keys of the buckets that match.
 template<typename Node>
 struct Span {
     // Entry is a slot available for storing a Node. The Span holds a pointer to
@@ -251,12 +358,15 @@ struct Span {
     };
 
     unsigned char offsets[SpanConstants::NEntries];
+    unsigned char control[SpanConstants::NEntries];
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
+    QArenaAllocator *arena = nullptr;
     Span() noexcept
     {
         memset(offsets, SpanConstants::UnusedEntry, sizeof(offsets));
+        memset(control, SpanConstants::EmptyControl, sizeof(control));
     }
     ~Span()
     {
@@ -271,11 +381,12 @@ struct Span {
                         entries[o].node().~Node();
                 }
             }
-            delete[] entries;
+            if (!arena)
+                delete[] entries;
             entries = nullptr;
         }
     }
-    Node *insert(size_t i)
+    Node *insert(size_t i, unsigned char c)
     {
         Q_ASSERT(i < SpanConstants::NEntries);
         Q_ASSERT(offsets[i] == SpanConstants::UnusedEntry);
@@ -285,6 +396,7 @@ struct Span {
         Q_ASSERT(entry < allocated);
         nextFree = entries[entry].nextFree();
         offsets[i] = entry;
+        control[i] = c;
         return &entries[entry].node();
     }
     void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
@@ -294,6 +406,7 @@ struct Span {
 
         unsigned char entry = offsets[bucket];
         offsets[bucket] = SpanConstants::UnusedEntry;
+        control[bucket] = SpanConstants::EmptyControl;
 
         entries[entry].node().~Node();
         entries[entry].nextFree() = nextFree;
@@ -339,6 +452,8 @@ struct Span {
         Q_ASSERT(offsets[to] == SpanConstants::UnusedEntry);
         offsets[to] = offsets[from];
         offsets[from] = SpanConstants::UnusedEntry;
+        control[to] = control[from];
+        control[from] = SpanConstants::EmptyControl;
     }
     void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to) noexcept(std::is_nothrow_move_constructible_v<Node>)
     {
@@ -355,6 +470,8 @@ struct Span {
 
         size_t fromOffset = fromSpan.offsets[fromIndex];
         fromSpan.offsets[fromIndex] = SpanConstants::UnusedEntry;
+        control[to] = fromSpan.control[fromIndex];
+        fromSpan.control[fromIndex] = SpanConstants::EmptyControl;
         Entry &fromEntry = fromSpan.entries[fromOffset];
 
         if constexpr (isRelocatable<Node>()) {
@@ -391,7 +508,14 @@ struct Span {
             alloc = SpanConstants::NEntries / 8 * 5;
         else
             alloc = allocated + SpanConstants::NEntries/8;
-        Entry *newEntries = new Entry[alloc];
+        Entry *newEntries;
+        if (arena) {
+            newEntries = static_cast<Entry *>(arena->allocate(qsizetype(alloc * sizeof(Entry)),
+                                                              alignof(Entry)));
+            Q_CHECK_PTR(newEntries);
+        } else {
+            newEntries = new Entry[alloc];
+        }
         // we only add storage if the previous storage was fully filled, so
         // simply copy the old data over
         if constexpr (isRelocatable<Node>()) {
@@ -406,7 +530,8 @@ struct Span {
         for (size_t i = allocated; i < alloc; ++i) {
             newEntries[i].nextFree() = uchar(i + 1);
         }
-        delete[] entries;
+        if (!arena)
+            delete[] entries;
         entries = newEntries;
         allocated = uchar(alloc);
     }
@@ -456,6 +581,9 @@ struct Data
     size_t numBuckets = 0;
     size_t seed = 0;
     Span *spans = nullptr;
+    // Data of a QHash created by QArenaAllocator::hash() lives in the arena
+    // together with its spans and is never shared.
+    QArenaAllocator *arena = nullptr;
 
     static constexpr size_t maxNumBuckets() noexcept
     {
@@ -506,9 +634,15 @@ struct Data
         {
             return &span->at(index);
         }
-        Node *insert() const
+        Node *insert(unsigned char control) const
         {
-            return span->insert(index);
+            return span->insert(index, control);
+        }
+        void advanceGroupWrapped(const Data *d) noexcept
+        {
+            // move to the first bucket of the next group
+            index |= ControlGroup::Size - 1;
+            advance_impl(d, d->spans);
         }
 
     private:
@@ -531,7 +665,7 @@ struct Data
         }
     };
 
-    static auto allocateSpans(size_t numBuckets)
+    static auto allocateSpans(size_t numBuckets, QArenaAllocator *arena = nullptr)
     {
         struct R {
             Span *spans;
@@ -547,16 +681,64 @@ struct Data
         }
 
         size_t nSpans = numBuckets >> SpanConstants::SpanShift;
-        return R{ new Span[nSpans], nSpans };
+        if (!arena)
+            return R{ new Span[nSpans], nSpans };
+
+        Span *spans = static_cast<Span *>(arena->allocate(qsizetype(nSpans * sizeof(Span)),
+                                                          alignof(Span)));
+        Q_CHECK_PTR(spans);
+        for (size_t s = 0; s < nSpans; ++s)
+            new (spans + s) Span;
+        for (size_t s = 0; s < nSpans; ++s)
+            spans[s].arena = arena;
+        return R{ spans, nSpans };
     }
 
-    Data(size_t reserve = 0)
+    static void freeSpans(Span *spans, size_t nSpans, QArenaAllocator *arena)
+        noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (!arena) {
+            delete[] spans;
+            return;
+        }
+        for (size_t s = 0; s < nSpans; ++s)
+            spans[s].~Span();
+    }
+
+    Data(size_t reserve = 0, QArenaAllocator *arena = nullptr)
+        : arena(arena)
     {
         numBuckets = GrowthPolicy::bucketsForCapacity(reserve);
-        spans = allocateSpans(numBuckets).spans;
+        spans = allocateSpans(numBuckets, arena).spans;
         seed = QHashSeed::globalSeed();
     }
 
+    static Data *create(QArenaAllocator *arena, size_t reserve)
+    {
+        void *memory = arena->allocate(qsizetype(sizeof(Data)), alignof(Data));
+        Q_CHECK_PTR(memory);
+        return new (memory) Data(reserve, arena);
+    }
+
+    static void destroy(Data *d) noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (d->arena)
+            d->~Data();
+        else
+            delete d;
+    }
+
+    // Returns the data for a copy of a hash using \a d.
+    static Data *shared(Data *d)
+    {
+        if (!d)
+            return nullptr;
+        if (Q_UNLIKELY(d->arena))
+            return new Data(*d);
+        d->ref.ref();
+        return d;
+    }
+
     void reallocationHelper(const Data &other, size_t nSpans, bool resized)
     {
         for (size_t s = 0; s < nSpans; ++s) {
@@ -565,9 +747,10 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 const Node &n = span.at(index);
-                auto it = resized ? findBucket(n.key) : Bucket { spans + s, index };
+                auto it = resized ? findUnusedBucket(QHashPrivate::calculateHash(n.key, seed))
+                                  : Bucket { spans + s, index };
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(span.control[index]);
                 new (newNode) Node(n);
             }
         }
@@ -593,7 +776,7 @@ struct Data
             return new Data;
         Data *dd = new Data(*d);
         if (!d->ref.deref())
-            delete d;
+            destroy(d);
         return dd;
     }
     static Data *detached(Data *d, size_t size)
@@ -602,13 +785,13 @@ struct Data
             return new Data(size);
         Data *dd = new Data(*d, size);
         if (!d->ref.deref())
-            delete d;
+            destroy(d);
         return dd;
     }
 
     void clear()
     {
-        delete[] spans;
+        freeSpans(spans, numBuckets >> SpanConstants::SpanShift, arena);
         spans = nullptr;
         size = 0;
         numBuckets = 0;
@@ -640,7 +823,7 @@ struct Data
 
         Span *oldSpans = spans;
         size_t oldBucketCount = numBuckets;
-        spans = allocateSpans(newBucketCount).spans;
+        spans = allocateSpans(newBucketCount, arena).spans;
         numBuckets = newBucketCount;
         size_t oldNSpans = oldBucketCount >> SpanConstants::SpanShift;
 
@@ -650,14 +833,14 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 Node &n = span.at(index);
-                auto it = findBucket(n.key);
+                auto it = findUnusedBucket(QHashPrivate::calculateHash(n.key, seed));
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(span.control[index]);
                 new (newNode) Node(std::move(n));
             }
             span.freeData();
         }
-        delete[] oldSpans;
+        freeSpans(oldSpans, oldNSpans, arena);
     }
 
     size_t nextBucket(size_t bucket) const noexcept
@@ -678,22 +861,50 @@ struct Data
     }
 
     Bucket findBucket(const Key &key) const noexcept
+    {
+        return findBucketWithHash(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    Bucket findBucketWithHash(const Key &key, size_t hash) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
+        const unsigned char control = SpanConstants::controlForHash(hash);
+        // loop over the groups of buckets until we find the entry we search for
         // or an empty slot, in which case we know the entry doesn't exist
         while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return bucket;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
-                    return bucket;
+            const size_t first = bucket.index & ~(ControlGroup::Size - 1);
+            const size_t shift = (bucket.index - first) * ControlGroup::BitsPerBucket;
+            const ControlGroup group = ControlGroup::load(bucket.span->control + first);
+            ControlGroup::Mask matches = group.match(control) >> shift;
+            const ControlGroup::Mask empty = group.matchEmpty() >> shift;
+            if (empty)
+                matches &= empty ^ (empty - 1); // up to the first empty bucket
+            while (matches) {
+                const size_t index = bucket.index + ControlGroup::firstBucket(matches);
+                if (qHashEquals(bucket.span->at(index).key, key))
+                    return Bucket(bucket.span, index);
+                matches &= matches - 1;
             }
-            bucket.advanceWrapped(this);
+            if (empty)
+                return Bucket(bucket.span, bucket.index + ControlGroup::firstBucket(empty));
+            bucket.advanceGroupWrapped(this);
+        }
+    }
+
+    // Returns the bucket where a key with \a hash that isn't in the table yet
+    // gets inserted.
+    Bucket findUnusedBucket(size_t hash) const noexcept
+    {
+        Q_ASSERT(numBuckets > 0);
+        Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
+        while (true) {
+            const size_t first = bucket.index & ~(ControlGroup::Size - 1);
+            const size_t shift = (bucket.index - first) * ControlGroup::BitsPerBucket;
+            const ControlGroup group = ControlGroup::load(bucket.span->control + first);
+            if (const ControlGroup::Mask empty = group.matchEmpty() >> shift)
+                return Bucket(bucket.span, bucket.index + ControlGroup::firstBucket(empty));
+            bucket.advanceGroupWrapped(this);
         }
     }
 
@@ -714,18 +925,19 @@ struct Data
     InsertionResult findOrInsert(const Key &key) noexcept
     {
         Bucket it(static_cast<Span *>(nullptr), 0);
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
         if (numBuckets > 0) {
-            it = findBucket(key);
+            it = findBucketWithHash(key, hash);
             if (!it.isUnused())
                 return { it.toIterator(this), true };
         }
         if (shouldGrow()) {
             rehash(size + 1);
-            it = findBucket(key); // need to get a new iterator after rehashing
+            it = findUnusedBucket(hash); // need to get a new iterator after rehashing
         }
         Q_ASSERT(it.span != nullptr);
         Q_ASSERT(it.isUnused());
-        it.insert();
+        it.insert(SpanConstants::controlForHash(hash));
         ++size;
         return { it.toIterator(this), false };
     }
@@ -767,7 +979,7 @@ struct Data
 
     ~Data()
     {
-        delete [] spans;
+        freeSpans(spans, numBuckets >> SpanConstants::SpanShift, arena);
     }
 };
 
@@ -820,6 +1032,7 @@ class QHash
     using Data = QHashPrivate::Data<Node>;
     friend class QSet<Key>;
     friend class QMultiHash<Key, T>;
+    friend class QArenaAllocator;
     friend tst_QHash;
 
     Data *d = nullptr;
@@ -841,10 +1054,8 @@ public:
             insert(it->first, it->second);
     }
     QHash(const QHash &other) noexcept
-        : d(other.d)
+        : d(Data::shared(other.d))
     {
-        if (d)
-            d->ref.ref();
     }
     ~QHash()
     {
@@ -852,17 +1063,15 @@ public:
         static_assert(std::is_nothrow_destructible_v<T>, "Types with throwing destructors are not supported in Qt containers.");
 
         if (d && !d->ref.deref())
-            delete d;
+            Data::destroy(d);
     }
 
     QHash &operator=(const QHash &other) noexcept(std::is_nothrow_destructible<Node>::value)
     {
         if (d != other.d) {
-            Data *o = other.d;
-            if (o)
-                o->ref.ref();
+            Data *o = Data::shared(other.d);
             if (d && !d->ref.deref())
-                delete d;
+                Data::destroy(d);
             d = o;
         }
         return *this;
@@ -949,7 +1158,7 @@ public:
     void clear() noexcept(std::is_nothrow_destructible<Node>::value)
     {
         if (d && !d->ref.deref())
-            delete d;
+            Data::destroy(d);
         d = nullptr;
     }
 
@@ -2233,4 +2442,7 @@ qsizetype erase_if(QMultiHash<Key, T> &hash, Predicate pred)
 
 QT_END_NAMESPACE
 
+#undef QT_QHASH_GROUP_SSE2
+#undef QT_QHASH_GROUP_NEON
+
 #endif // QHASH_H
@@ -261,7 +261,7 @@ private:
     }
 public:
     QList(DataPointer dd) noexcept
-        : d(dd)
+        : d(std::move(dd))
     {
     }
 
@@ -756,7 +756,7 @@ void QList<T>::reserve(qsizetype asize)
         }
     }
 
-    DataPointer detached(Data::allocate(qMax(asize, size())));
+    DataPointer detached(Data::allocate(qMax(asize, size()), QArrayData::KeepSize, d.arena()));
     detached->copyAppend(d->begin(), d->end());
     if (detached.d_ptr())
         detached->setFlag(Data::CapacityReserved);
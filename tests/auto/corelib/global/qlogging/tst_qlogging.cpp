@@ -36,6 +36,9 @@ private slots:
 
     void qMessagePattern_data();
     void qMessagePattern();
+    void asyncMessagePattern_data() { qMessagePattern_data(); }
+    void asyncMessagePattern();
+    void setMessagePattern_data();
     void setMessagePattern();
 
     void formatLogMessage_data();
@@ -43,6 +46,7 @@ private slots:
 
 private:
     QString backtraceHelperPath();
+    void testMessagePattern(bool async);
 #if QT_CONFIG(process)
     QProcessEnvironment m_baseEnvironment;
 #endif
@@ -822,8 +826,19 @@ void tst_qmessagehandler::qMessagePattern_data()
 
 
 void tst_qmessagehandler::qMessagePattern()
+{
+    testMessagePattern(false);
+}
+
+void tst_qmessagehandler::asyncMessagePattern()
+{
+    testMessagePattern(true);
+}
+
+void tst_qmessagehandler::testMessagePattern(bool async)
 {
 #if !QT_CONFIG(process)
+    Q_UNUSED(async);
     QSKIP("This test requires QProcess support");
 #else
 #ifdef Q_OS_ANDROID
@@ -841,6 +856,8 @@ void tst_qmessagehandler::qMessagePattern()
     //
     QProcessEnvironment environment = m_baseEnvironment;
     environment.insert("QT_MESSAGE_PATTERN", pattern);
+    if (async)
+        environment.insert("QT_LOGGING_ASYNC", "1");
     process.setProcessEnvironment(environment);
 
     process.start(appExe);
@@ -867,6 +884,14 @@ void tst_qmessagehandler::qMessagePattern()
 #endif
 }
 
+void tst_qmessagehandler::setMessagePattern_data()
+{
+    QTest::addColumn<bool>("async");
+
+    QTest::newRow("sync") << false;
+    QTest::newRow("async") << true;
+}
+
 void tst_qmessagehandler::setMessagePattern()
 {
 #if !QT_CONFIG(process)
@@ -875,6 +900,7 @@ void tst_qmessagehandler::setMessagePattern()
 #ifdef Q_OS_ANDROID
     QSKIP("This test crashes on Android");
 #endif
+    QFETCH(bool, async);
 
     //
     // test qSetMessagePattern
@@ -884,7 +910,11 @@ void tst_qmessagehandler::setMessagePattern()
     const QString appExe(backtraceHelperPath());
 
     // make sure there is no QT_MESSAGE_PATTERN in the environment
-    process.setProcessEnvironment(m_baseEnvironment);
+    QProcessEnvironment environment = m_baseEnvironment;
+    // the output must be the same, in the same order, when written asynchronously
+    if (async)
+        environment.insert("QT_LOGGING_ASYNC", "1");
+    process.setProcessEnvironment(environment);
 
     process.start(appExe);
     QVERIFY2(process.waitForStarted(), qPrintable(
@@ -0,0 +1,245 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QDirIterator>
+#include <QDirWalker>
+#include <QFile>
+#include <QMutex>
+#include <QSet>
+#include <QTemporaryDir>
+#if QT_CONFIG(thread)
+#include <QThread>
+#include <QThreadPool>
+#endif
+
+using namespace Qt::StringLiterals;
+
+class tst_QDirWalker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void sameEntriesAsIterator_data();
+    void sameEntriesAsIterator();
+    void batches();
+    void handlerIsSerialized();
+    void fileInfoHasMetaData();
+    void missingDirectory();
+    void resources();
+
+private:
+    static QStringList sorted(const QStringList &list);
+    static QStringList iteratorPaths(const QString &path, const QStringList &nameFilters,
+                                     QDir::Filters filters, QDirIterator::IteratorFlags flags);
+    static QStringList walkerPaths(const QDirWalker &walker);
+
+    QTemporaryDir tree;
+};
+
+void tst_QDirWalker::initTestCase()
+{
+    QVERIFY2(tree.isValid(), qPrintable(tree.errorString()));
+    QDir root(tree.path());
+
+    const auto createFile = [&](const QString &path, const QByteArray &contents = "data") {
+        QFile file(root.filePath(path));
+        QVERIFY2(file.open(QIODevice::WriteOnly), qPrintable(file.errorString()));
+        QCOMPARE(file.write(contents), contents.size());
+    };
+
+    // wide enough for the walker to hand directories to other threads
+    for (int i = 0; i < 20; ++i) {
+        const QString dir = u"dir%1/sub/subsub"_s.arg(i);
+        QVERIFY(root.mkpath(dir));
+        createFile(u"dir%1/file.txt"_s.arg(i));
+        createFile(u"dir%1/image.png"_s.arg(i));
+        createFile(dir + u"/deep.txt"_s);
+        createFile(u"dir%1/sub/.hidden.txt"_s.arg(i));
+    }
+    QVERIFY(root.mkpath(u".hiddendir/inner"_s));
+    createFile(u".hiddendir/inner/file.txt"_s);
+    createFile(u"top.txt"_s, "top level file");
+    createFile(u"Top.PNG"_s);
+
+#ifdef Q_OS_UNIX
+    QVERIFY(QFile::link(root.filePath(u"dir0"_s), root.filePath(u"linkToDir"_s)));
+    QVERIFY(QFile::link(root.filePath(u"top.txt"_s), root.filePath(u"linkToFile"_s)));
+    QVERIFY(QFile::link(root.filePath(u"missing"_s), root.filePath(u"danglingLink"_s)));
+    // a loop: following symlinks must not walk forever
+    QVERIFY(QFile::link(root.path(), root.filePath(u"dir1/sub/loop"_s)));
+#endif
+}
+
+QStringList tst_QDirWalker::sorted(const QStringList &list)
+{
+    QStringList result = list;
+    result.sort();
+    return result;
+}
+
+QStringList tst_QDirWalker::iteratorPaths(const QString &path, const QStringList &nameFilters,
+                                          QDir::Filters filters,
+                                          QDirIterator::IteratorFlags flags)
+{
+    QStringList result;
+    QDirIterator it(path, nameFilters, filters, flags);
+    while (it.hasNext()) {
+        const QString fileName = it.nextFileInfo().fileName();
+        if (fileName != "."_L1 && fileName != ".."_L1)
+            result.append(it.filePath());
+    }
+    return sorted(result);
+}
+
+QStringList tst_QDirWalker::walkerPaths(const QDirWalker &walker)
+{
+    QStringList result;
+    for (const QFileInfo &info : walker.entryInfoList())
+        result.append(info.filePath());
+    return sorted(result);
+}
+
+void tst_QDirWalker::sameEntriesAsIterator_data()
+{
+    QTest::addColumn<QStringList>("nameFilters");
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QDirIterator::IteratorFlags>("flags");
+
+    const QDirIterator::IteratorFlags recursive = QDirIterator::Subdirectories;
+    QTest::newRow("everything") << QStringList() << QDir::Filters(QDir::NoFilter) << recursive;
+    QTest::newRow("flat") << QStringList() << QDir::Filters(QDir::NoFilter)
+                          << QDirIterator::IteratorFlags();
+    QTest::newRow("files") << QStringList() << QDir::Filters(QDir::Files) << recursive;
+    QTest::newRow("dirs") << QStringList() << QDir::Filters(QDir::Dirs) << recursive;
+    QTest::newRow("hidden") << QStringList() << (QDir::AllEntries | QDir::Hidden) << recursive;
+    QTest::newRow("no symlinks") << QStringList() << (QDir::AllEntries | QDir::NoSymLinks)
+                                 << recursive;
+    QTest::newRow("system") << QStringList() << (QDir::AllEntries | QDir::System) << recursive;
+    QTest::newRow("*.txt") << QStringList{ u"*.txt"_s } << QDir::Filters(QDir::NoFilter)
+                           << recursive;
+    QTest::newRow("*.png, case-insensitive")
+            << QStringList{ u"*.png"_s } << QDir::Filters(QDir::Files) << recursive;
+    QTest::newRow("*.png, case-sensitive")
+            << QStringList{ u"*.png"_s } << (QDir::Files | QDir::CaseSensitive) << recursive;
+    QTest::newRow("*.txt, all dirs")
+            << QStringList{ u"*.txt"_s } << (QDir::Files | QDir::AllDirs) << recursive;
+    QTest::newRow("follow symlinks")
+            << QStringList() << QDir::Filters(QDir::NoFilter)
+            << (QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+}
+
+void tst_QDirWalker::sameEntriesAsIterator()
+{
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QDirIterator::IteratorFlags, flags);
+
+    const QStringList expected = iteratorPaths(tree.path(), nameFilters, filters, flags);
+    QVERIFY(!expected.isEmpty());
+
+    QDirWalker walker(tree.path(), nameFilters, filters, flags);
+    const QStringList actual = walkerPaths(walker);
+    if (flags & QDirIterator::FollowSymlinks) {
+        // QDirIterator and QDirWalker break symlink loops at different
+        // places, so only check that all the real entries were found
+        const QSet<QString> actualSet(actual.cbegin(), actual.cend());
+        for (const QString &path : expected) {
+            if (!path.contains("/loop/"_L1))
+                QVERIFY2(actualSet.contains(path), qPrintable(path));
+        }
+    } else {
+        QCOMPARE(actual, expected);
+    }
+}
+
+void tst_QDirWalker::batches()
+{
+    QDirWalker walker(tree.path(), QDir::Files);
+    QCOMPARE(walker.batchSize(), qsizetype(1024));
+    walker.setBatchSize(3);
+    QCOMPARE(walker.batchSize(), qsizetype(3));
+
+    qsizetype total = 0;
+    walker.walk([&](const QFileInfoList &batch) {
+        QVERIFY(!batch.isEmpty());
+        QVERIFY(batch.size() <= 3);
+        total += batch.size();
+    });
+    QCOMPARE(total, iteratorPaths(tree.path(), {}, QDir::Files,
+                                  QDirIterator::Subdirectories).size());
+
+    walker.setBatchSize(0);
+    QCOMPARE(walker.batchSize(), qsizetype(1));
+}
+
+void tst_QDirWalker::handlerIsSerialized()
+{
+#if QT_CONFIG(thread)
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QDirWalker walker(tree.path());
+    walker.setThreadPool(&pool);
+    QCOMPARE(walker.threadPool(), &pool);
+    walker.setBatchSize(1);
+
+    QAtomicInt inHandler;
+    bool overlapped = false;
+    QStringList paths;
+    walker.walk([&](const QFileInfoList &batch) {
+        if (inHandler.fetchAndAddOrdered(1) != 0)
+            overlapped = true;
+        // give other threads the chance to call in at the same time
+        QThread::yieldCurrentThread();
+        for (const QFileInfo &info : batch)
+            paths.append(info.filePath());
+        inHandler.fetchAndSubOrdered(1);
+    });
+    QVERIFY(!overlapped);
+    QCOMPARE(sorted(paths), iteratorPaths(tree.path(), {}, QDir::NoFilter,
+                                          QDirIterator::Subdirectories));
+#else
+    QSKIP("This test requires thread support");
+#endif
+}
+
+void tst_QDirWalker::fileInfoHasMetaData()
+{
+    QDirWalker walker(tree.path(), { u"top.txt"_s }, QDir::Files,
+                      QDirIterator::NoIteratorFlags);
+    const QFileInfoList infos = walker.entryInfoList();
+    QCOMPARE(infos.size(), 1);
+    const QFileInfo &info = infos.first();
+    QCOMPARE(info.fileName(), u"top.txt"_s);
+    QCOMPARE(info.absoluteFilePath(), QDir(tree.path()).filePath(u"top.txt"_s));
+    QVERIFY(info.exists());
+    QVERIFY(info.isFile());
+    QVERIFY(!info.isSymLink());
+    QCOMPARE(info.size(), qint64(sizeof("top level file") - 1));
+    QCOMPARE(info.lastModified(), QFileInfo(info.filePath()).lastModified());
+}
+
+void tst_QDirWalker::missingDirectory()
+{
+    QDirWalker walker(tree.filePath(u"does-not-exist"_s));
+    bool called = false;
+    walker.walk([&](const QFileInfoList &) { called = true; });
+    QVERIFY(!called);
+    QVERIFY(walker.entryInfoList().isEmpty());
+}
+
+void tst_QDirWalker::resources()
+{
+    // paths handled by a file engine go through QDirIterator
+    const QStringList expected = iteratorPaths(u":/testdata"_s, {}, QDir::NoFilter,
+                                               QDirIterator::Subdirectories);
+    QCOMPARE(expected.size(), 3);
+    QDirWalker walker(u":/testdata"_s);
+    QCOMPARE(walkerPaths(walker), expected);
+}
+
+QTEST_MAIN(tst_QDirWalker)
+
+#include "tst_qdirwalker.moc"
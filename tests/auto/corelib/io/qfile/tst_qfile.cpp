@@ -19,10 +19,22 @@
 #include <QOperatingSystemVersion>
 #include <QStorageInfo>
 #include <QScopeGuard>
+#if QT_CONFIG(future)
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QTimer>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
 #include <private/qfilesystemengine_p.h>
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+#include <private/qfileasyncio_p.h>
+#endif
+#if QT_CONFIG(io_uring)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
 
 #ifdef Q_OS_WIN
 #include <QtCore/private/qfunctions_win_p.h>
@@ -222,6 +234,13 @@ private slots:
     void writeLargeDataBlock();
     void readFromWriteOnlyFile();
     void writeToReadOnlyFile();
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+    void readWriteAsync_data();
+    void readWriteAsync();
+    void readAsyncMany_data() { readWriteAsync_data(); }
+    void readAsyncMany();
+    void readWriteAsyncInvalid();
+#endif
 #if defined(Q_OS_LINUX) || defined(Q_OS_AIX) || defined(Q_OS_FREEBSD) || defined(Q_OS_NETBSD)
     void virtualFile();
 #endif
@@ -2573,6 +2592,159 @@ void tst_QFile::writeToReadOnlyFile()
     QCOMPARE(file.write(&c, 1), qint64(-1));
 }
 
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+static bool ioUringAvailable()
+{
+#if QT_CONFIG(io_uring)
+    if (qEnvironmentVariableIsSet("QT_NO_IO_URING"))
+        return false;
+    io_uring_params params = {};
+    const int ringFd = int(syscall(__NR_io_uring_setup, 1, &params));
+    if (ringFd < 0)
+        return false;
+    QT_CLOSE(ringFd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Starts the operations from inside a running event loop, where QFile uses
+// io_uring if it can, or from outside, where they always go to the thread
+// pool.
+template <typename T, typename Start>
+static void runAsync(bool fromEventLoop, Start start)
+{
+    if (!fromEventLoop) {
+        const qint64 before = QFileAsyncIO::ioUringOperationCount();
+        QList<QFuture<T>> futures = start();
+        QCOMPARE(QFileAsyncIO::ioUringOperationCount(), before);
+        for (QFuture<T> &future : futures)
+            future.waitForFinished();
+        return;
+    }
+
+    QEventLoop loop;
+    QList<QFuture<T>> futures;
+    qint64 viaIoUring = 0;
+    QTimer::singleShot(0, &loop, [&] {
+        const qint64 before = QFileAsyncIO::ioUringOperationCount();
+        futures = start();
+        viaIoUring = QFileAsyncIO::ioUringOperationCount() - before;
+        loop.quit();
+    });
+    loop.exec();
+    for (QFuture<T> &future : futures)
+        QTRY_VERIFY(future.isFinished());
+    if (ioUringAvailable())
+        QVERIFY2(viaIoUring > 0, "io_uring was not used");
+    else
+        QCOMPARE(viaIoUring, 0);
+}
+
+void tst_QFile::readWriteAsync_data()
+{
+    QTest::addColumn<bool>("fromEventLoop");
+    QTest::newRow("thread-pool") << false;
+    QTest::newRow("event-loop") << true;
+}
+
+void tst_QFile::readWriteAsync()
+{
+    QFETCH(bool, fromEventLoop);
+
+    QTemporaryFile file;
+    QVERIFY2(file.open(), msgOpenFailed(file).constData());
+    // buffered, so writeAsync() must flush it first
+    QCOMPARE(file.write("0123456789"), qint64(10));
+    const qint64 pos = file.pos();
+
+    const QByteArray data = "Hello, asynchronous world!";
+    QFuture<qint64> written;
+    runAsync<qint64>(fromEventLoop, [&] {
+        written = file.writeAsync(10, data);
+        return QList<QFuture<qint64>>{ written };
+    });
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(written.result(), qint64(data.size()));
+    QCOMPARE(file.pos(), pos);
+    QCOMPARE(file.size(), qint64(10 + data.size()));
+
+    QFuture<QByteArray> whole, part, pastEnd;
+    runAsync<QByteArray>(fromEventLoop, [&] {
+        whole = file.readAsync(0, 1000);
+        part = file.readAsync(5, 10);
+        pastEnd = file.readAsync(1000, 10);
+        return QList<QFuture<QByteArray>>{ whole, part, pastEnd };
+    });
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(whole.result(), "0123456789" + data);
+    QCOMPARE(part.result(), "56789Hello");
+    QVERIFY(pastEnd.result().isEmpty());
+    QVERIFY(!pastEnd.result().isNull());
+    QCOMPARE(file.pos(), pos);
+
+    // the operations don't need the file to stay open
+    QFuture<QByteArray> afterClose;
+    runAsync<QByteArray>(fromEventLoop, [&] {
+        afterClose = file.readAsync(0, 10);
+        file.close();
+        return QList<QFuture<QByteArray>>{ afterClose };
+    });
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(afterClose.result(), "0123456789");
+}
+
+void tst_QFile::readAsyncMany()
+{
+    QFETCH(bool, fromEventLoop);
+
+    // more requests than fit into one io_uring submission or completion queue
+    constexpr int Count = 2000;
+    QByteArray data(Count, Qt::Uninitialized);
+    for (int i = 0; i < Count; ++i)
+        data[i] = char('a' + i % 26);
+
+    QTemporaryFile file;
+    QVERIFY2(file.open(), msgOpenFailed(file).constData());
+    QCOMPARE(file.write(data), qint64(Count));
+    QVERIFY(file.flush());
+
+    QList<QFuture<QByteArray>> futures;
+    runAsync<QByteArray>(fromEventLoop, [&] {
+        for (int i = 0; i < Count; ++i)
+            futures << file.readAsync(i, 1);
+        return futures;
+    });
+    if (QTest::currentTestFailed())
+        return;
+    for (int i = 0; i < Count; ++i)
+        QCOMPARE(futures.at(i).result(), data.mid(i, 1));
+}
+
+void tst_QFile::readWriteAsyncInvalid()
+{
+    QTemporaryFile temporaryFile;
+    QVERIFY2(temporaryFile.open(), msgOpenFailed(temporaryFile).constData());
+    const QString fileName = temporaryFile.fileName();
+    QFile file(fileName);
+
+    QTest::ignoreMessage(QtWarningMsg, qPrintable("QFile::readAsync: File (" + fileName
+                                                  + ") not open for reading"));
+    QVERIFY(file.readAsync(0, 1).result().isNull());
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg, qPrintable("QFile::writeAsync: File (" + fileName
+                                                  + ") not open for writing"));
+    QCOMPARE(file.writeAsync(0, "x").result(), qint64(-1));
+    QTest::ignoreMessage(QtWarningMsg, "QFile::readAsync: Called with negative offset or maxSize");
+    QVERIFY(file.readAsync(-1, 1).result().isNull());
+}
+#endif // QT_CONFIG(future) && Q_OS_UNIX
+
 #if defined(Q_OS_LINUX) || defined(Q_OS_AIX) || defined(Q_OS_FREEBSD) || defined(Q_OS_NETBSD)
 // This platform have 0-sized virtual files
 void tst_QFile::virtualFile()
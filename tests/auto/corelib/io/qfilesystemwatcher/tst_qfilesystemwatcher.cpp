@@ -11,6 +11,7 @@
 #include <QMap>
 #include <QString>
 #include <QDir>
+#include <QSet>
 #include <QSignalSpy>
 #include <QTimer>
 #include <QTemporaryFile>
@@ -66,6 +67,10 @@ private slots:
     void signalsEmittedAfterFileMoved();
 
     void watchUnicodeCharacters();
+
+    void watchRecursively_data();
+    void watchRecursively();
+    void batchedSignals();
 #if defined(Q_OS_WIN)
     void watchDirectoryAttributeChanges();
 #endif
@@ -817,6 +822,125 @@ void tst_QFileSystemWatcher::watchUnicodeCharacters()
     QTRY_COMPARE(changedSpy.count(), 1);
 }
 
+void tst_QFileSystemWatcher::watchRecursively_data()
+{
+    QTest::addColumn<QString>("backend");
+
+    QTest::newRow("default") << QString();
+#ifdef QT_BUILD_INTERNAL
+    QTest::newRow("native") << "native";
+    QTest::newRow("poller") << "poller";
+#endif
+}
+
+void tst_QFileSystemWatcher::watchRecursively()
+{
+    QFETCH(QString, backend);
+
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+    const QString root = temporaryDirectory.path();
+    QDir rootDir(root);
+    QVERIFY(rootDir.mkpath("a/b/c"));
+    QVERIFY(rootDir.mkpath("d"));
+
+    QFileSystemWatcher watcher;
+    if (!backend.isEmpty())
+        watcher.setObjectName(QLatin1String("_qt_autotest_force_engine_") + backend);
+    QVERIFY(!watcher.addPathRecursively(rootDir.filePath("nonexistent")));
+    QVERIFY(watcher.addPathRecursively(root));
+    QVERIFY(!watcher.addPathRecursively(root));
+    QCOMPARE(watcher.recursiveDirectories(), QStringList(root));
+    QVERIFY(watcher.directories().isEmpty());
+
+    QSignalSpy changedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    QVERIFY(changedSpy.isValid());
+
+    // the polling engine compares modification times, which may have a
+    // resolution of a second
+    if (backend == QLatin1String("poller"))
+        QTest::qWait(2000);
+
+    // a change deep inside the tree
+    const QString deepDir = rootDir.filePath("a/b/c");
+    QFile deepFile(deepDir + QLatin1String("/file.txt"));
+    QVERIFY(deepFile.open(QIODevice::WriteOnly));
+    deepFile.close();
+    QTRY_VERIFY(changedSpy.contains(QVariantList{ deepDir }));
+
+    // a directory created after the tree was added is watched as well
+    QVERIFY(rootDir.mkdir("e"));
+    const QString newDir = rootDir.filePath("e");
+    QTRY_VERIFY(changedSpy.contains(QVariantList{ root }));
+    if (backend == QLatin1String("poller"))
+        QTest::qWait(2000);
+    else
+        QTest::qWait(200);
+    changedSpy.clear();
+    QVERIFY(QDir(newDir).mkdir("f"));
+    QTRY_VERIFY(changedSpy.contains(QVariantList{ newDir }));
+
+    // nothing is reported once the tree is removed
+    QVERIFY(watcher.removePathRecursively(root));
+    QVERIFY(!watcher.removePathRecursively(root));
+    QVERIFY(watcher.recursiveDirectories().isEmpty());
+    changedSpy.clear();
+    QVERIFY(rootDir.mkdir("d/g"));
+    QTest::qWait(backend == QLatin1String("poller") ? 2000 : 500);
+    QCOMPARE(changedSpy.size(), 0);
+}
+
+void tst_QFileSystemWatcher::batchedSignals()
+{
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    QStringList testFiles;
+    for (int i = 0; i < 10; ++i) {
+        testFiles.append(temporaryDirectory.filePath(QString::number(i)));
+        QFile file(testFiles.last());
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QFileSystemWatcher watcher;
+    QVERIFY(watcher.addPaths(testFiles).isEmpty());
+
+    QSignalSpy filesSpy(&watcher, &QFileSystemWatcher::filesChanged);
+    QVERIFY(filesSpy.isValid());
+
+    // see watchDirectory() for why
+    QTest::qWait(2000);
+
+    // change every file twice without returning to the event loop
+    for (int round = 0; round < 2; ++round) {
+        for (const QString &path : std::as_const(testFiles)) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append));
+            file.write("change\n");
+        }
+    }
+
+    QTRY_VERIFY(!filesSpy.isEmpty());
+    QTest::qWait(500);
+
+    // each path is listed once, however many signals delivered it
+    QStringList changedFiles;
+    for (const QList<QVariant> &arguments : std::as_const(filesSpy)) {
+        const QStringList paths = arguments.at(0).toStringList();
+        QCOMPARE(QSet<QString>(paths.cbegin(), paths.cend()).size(), paths.size());
+        changedFiles += paths;
+    }
+#ifdef Q_OS_LINUX
+    // inotify delivers all the pending changes at once
+    QVERIFY2(filesSpy.size() < changedFiles.size(), "changes were not batched");
+#endif
+    changedFiles.removeDuplicates();
+    changedFiles.sort();
+    QStringList expected = testFiles;
+    expected.sort();
+    QCOMPARE(changedFiles, expected);
+}
+
 #if defined(Q_OS_WIN)
 void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 {
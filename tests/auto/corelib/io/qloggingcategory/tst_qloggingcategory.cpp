@@ -11,6 +11,9 @@ Q_LOGGING_CATEGORY(TST_LOG, "tst.log")
 Q_LOGGING_CATEGORY(Digia_Oslo_Office_com, "Digia.Oslo.Office.com")
 Q_LOGGING_CATEGORY(Digia_Oulu_Office_com, "Digia.Oulu.Office.com")
 Q_LOGGING_CATEGORY(Digia_Berlin_Office_com, "Digia.Berlin.Office.com")
+Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(TST_MINIMUM_INFO, QtInfoMsg, "tst.minimum.info")
+Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(TST_MINIMUM_WARNING, QtWarningMsg, "tst.minimum.warning",
+                                      QtCriticalMsg)
 
 QT_USE_NAMESPACE
 
@@ -381,6 +384,52 @@ private slots:
         QCOMPARE(cat4.isCriticalEnabled(), true);
     }
 
+    void minimumLevelCategory()
+    {
+        using InfoCategory = std::decay_t<decltype(TST_MINIMUM_INFO())>;
+        static_assert(!InfoCategory::isCompiledIn(QtDebugMsg));
+        static_assert(InfoCategory::isCompiledIn(QtInfoMsg));
+        static_assert(InfoCategory::isCompiledIn(QtFatalMsg));
+
+        const auto &info = TST_MINIMUM_INFO();
+        QCOMPARE(info.categoryName(), "tst.minimum.info");
+        QCOMPARE(info.isDebugEnabled(), false);
+        QCOMPARE(info.isInfoEnabled(), true);
+        QCOMPARE(info.isWarningEnabled(), true);
+        QCOMPARE(info.isCriticalEnabled(), true);
+
+        const auto &warning = TST_MINIMUM_WARNING();
+        QCOMPARE(warning.isInfoEnabled(), false);
+        QCOMPARE(warning.isWarningEnabled(), false);    // by default
+        QCOMPARE(warning.isCriticalEnabled(), true);
+
+        // rules cannot enable what was removed at compile time
+        QLoggingCategory::setFilterRules("tst.minimum.*=true");
+        QCOMPARE(info.isDebugEnabled(), false);
+        QCOMPARE(info.isEnabled(QtDebugMsg), false);
+        QCOMPARE(info.isInfoEnabled(), true);
+        QCOMPARE(warning.isInfoEnabled(), false);
+        QCOMPARE(warning.isWarningEnabled(), true);
+
+        int evaluated = 0;
+        logMessage = "no change";
+        qCDebug(TST_MINIMUM_INFO) << ++evaluated;
+        qCDebug(TST_MINIMUM_INFO, "%d", ++evaluated);
+        qCInfo(TST_MINIMUM_WARNING) << ++evaluated;
+        QCOMPARE(evaluated, 0);
+        QCOMPARE(logMessage, u"no change");
+
+        qCInfo(TST_MINIMUM_INFO) << "info";
+        QCOMPARE(logMessage, u"tst.minimum.info.info: info");
+        qCWarning(TST_MINIMUM_WARNING, "warning");
+        QCOMPARE(logMessage, u"tst.minimum.warning.warning: warning");
+        qCCritical(TST_MINIMUM_WARNING()) << "critical";
+        QCOMPARE(logMessage, u"tst.minimum.warning.critical: critical");
+
+        QLoggingCategory::setFilterRules(QString());
+        QCOMPARE(warning.isWarningEnabled(), false);
+    }
+
     void qCDebugMacros()
     {
         QString buf;
@@ -7,7 +7,11 @@
 
 #include <QtCore/private/qloggingregistry_p.h>
 
+#include <memory>
+#include <vector>
+
 QT_USE_NAMESPACE
+using namespace Qt::StringLiterals;
 enum LoggingRuleState {
     Invalid,
     Match,
@@ -285,6 +289,72 @@ private slots:
     }
 
 
+    void QLoggingRegistry_changedRules()
+    {
+        //
+        // Changing rules re-evaluates only the categories that a changed
+        // rule applies to; the result must be the same as re-evaluating all
+        //
+
+        QLoggingRegistry *registry = QLoggingRegistry::instance();
+        for (auto &ruleSet : registry->ruleSets)
+            ruleSet.clear();
+        registry->updateRules();
+
+        // names that prefix, suffix and mid filters hit in different ways
+        const char *names[] = { "a", "a.b", "a.b.c", "b.a", "c.a.b", "a.a", "ab", "x.b", "" };
+        std::vector<std::unique_ptr<QLoggingCategory>> categories;
+        for (const char *name : names)
+            categories.push_back(std::make_unique<QLoggingCategory>(name));
+        // a second object for the same name
+        categories.push_back(std::make_unique<QLoggingCategory>("a.b", QtWarningMsg));
+
+        const auto states = [&] {
+            QList<int> result;
+            for (const auto &category : categories) {
+                result.append(category->isDebugEnabled() | category->isInfoEnabled() << 1
+                              | category->isWarningEnabled() << 2
+                              | category->isCriticalEnabled() << 3);
+            }
+            return result;
+        };
+
+        const QString ruleLists[] = {
+            u""_s,
+            u"a.b=false"_s,
+            u"a.*=false"_s,
+            u"*.b=false\na.*=true"_s,
+            u"a.*=true\n*.b=false"_s,
+            u"*.a.*=false"_s,
+            u"a.b.debug=true\n*.a.warning=false"_s,
+            u"*=false"_s,
+            u"*.debug=true"_s,
+            u"a.b.c.critical=false\na.*=true\n*a=false"_s,
+            u"a.b.c.critical=false\n*a=false"_s,
+        };
+        for (const QString &from : ruleLists) {
+            for (const QString &to : ruleLists) {
+                QLoggingCategory::setFilterRules(from);
+                QLoggingCategory::setFilterRules(to);
+                const QList<int> changed = states();
+                registry->updateRules();
+                QVERIFY2(changed == states(),
+                         qPrintable(u"from \"%1\" to \"%2\""_s.arg(from, to)));
+            }
+        }
+
+        // a category that no changed rule applies to is left alone
+        QLoggingCategory::setFilterRules(u"a.b=false"_s);
+        categories.front()->setEnabled(QtDebugMsg, false);
+        QLoggingCategory::setFilterRules(u"a.b=false\nx.*=false"_s);
+        QVERIFY(!categories.front()->isDebugEnabled());
+
+        // destroyed categories are gone from the indexes
+        categories.clear();
+        QLoggingCategory::setFilterRules(u"*=true"_s);
+        QLoggingCategory::setFilterRules(QString());
+    }
+
     void QLoggingRegistry_checkErrors()
     {
         QLoggingSettingsParser parser;
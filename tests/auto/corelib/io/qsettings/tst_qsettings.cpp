@@ -131,6 +131,9 @@ private slots:
     void testRegistryShortRootNames();
     void testRegistry32And64Bit();
     void trailingWhitespace();
+#ifdef QT_BUILD_INTERNAL
+    void binaryCache();
+#endif
 #ifdef Q_OS_DARWIN
     void fileName();
 #endif
@@ -2307,6 +2310,100 @@ void tst_QSettings::trailingWhitespace()
     }
 }
 
+#ifdef QT_BUILD_INTERNAL
+void tst_QSettings::binaryCache()
+{
+    const QString path = settingsPath("binaryCache.ini");
+    const QString cachePath = path + QLatin1String(".cache");
+
+    const auto checkContents = [](QSettings &s) {
+        QCOMPARE(s.value("general").toString(), QLatin1String("value"));
+        QCOMPARE(s.value("Other/MixedCase").toInt(), 42);
+        QCOMPARE(s.value("group/list").toStringList(), QStringList({ "a", "b", "c" }));
+        QCOMPARE(s.value("group/bytes").toByteArray(), QByteArray("\0\1\2", 3));
+        QCOMPARE(s.childGroups(), QStringList({ "Other", "group", "many" }));
+        s.beginGroup("many");
+        QCOMPARE(s.childKeys().size(), 1000);
+        QCOMPARE(s.value("key500").toInt(), 500);
+        s.endGroup();
+        QVERIFY(!s.contains("group/missing"));
+        QCOMPARE(s.allKeys().size(), 1004);
+    };
+
+    {
+        QSettings s(path, QSettings::IniFormat);
+        s.setValue("general", "value");
+        s.setValue("Other/MixedCase", 42);
+        s.setValue("group/list", QStringList({ "a", "b", "c" }));
+        s.setValue("group/bytes", QByteArray("\0\1\2", 3));
+        for (int i = 0; i < 1000; ++i)
+            s.setValue(QString::fromLatin1("many/key%1").arg(i), i);
+        s.sync();
+        QCOMPARE(s.status(), QSettings::NoError);
+    }
+    QVERIFY(QFile::exists(cachePath));
+
+    // read it back through the cache
+    QConfFile::clearCache();
+    {
+        QSettings s(path, QSettings::IniFormat);
+        checkContents(s);
+        QCOMPARE(s.status(), QSettings::NoError);
+
+        // and modify it
+        s.remove("many");
+        s.setValue("group/list", "single");
+        s.sync();
+        QCOMPARE(s.status(), QSettings::NoError);
+    }
+    QConfFile::clearCache();
+    {
+        QSettings s(path, QSettings::IniFormat);
+        QCOMPARE(s.value("group/list").toString(), QLatin1String("single"));
+        QCOMPARE(s.value("Other/MixedCase").toInt(), 42);
+        QCOMPARE(s.childGroups(), QStringList({ "Other", "group" }));
+        QCOMPARE(s.allKeys().size(), 4);
+    }
+
+    // a cache that doesn't match the INI file is ignored
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("[General]\ngeneral=edited by hand\n");
+    }
+    QVERIFY(QFile::exists(cachePath));
+    QConfFile::clearCache();
+    {
+        QSettings s(path, QSettings::IniFormat);
+        QCOMPARE(s.value("general").toString(), QLatin1String("edited by hand"));
+        QCOMPARE(s.allKeys(), QStringList({ "general" }));
+    }
+
+    // and so is a broken one
+    {
+        QSettings s(path, QSettings::IniFormat);
+        s.setValue("general", "value");
+        s.setValue("group/key", 1);
+    }
+    QConfFile::clearCache();
+    QVERIFY(QFile::resize(cachePath, QFileInfo(cachePath).size() - 1));
+    {
+        QSettings s(path, QSettings::IniFormat);
+        QCOMPARE(s.value("general").toString(), QLatin1String("value"));
+        QCOMPARE(s.value("group/key").toInt(), 1);
+        QCOMPARE(s.status(), QSettings::NoError);
+    }
+
+    // clearing the settings removes the cache
+    {
+        QSettings s(path, QSettings::IniFormat);
+        s.clear();
+        s.sync();
+    }
+    QVERIFY(!QFile::exists(cachePath));
+}
+#endif
+
 void tst_QSettings::fromFile()
 {
     QFETCH(QSettings::Format, format);
@@ -511,6 +511,110 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+class SequencedEvent : public QEvent
+{
+public:
+    SequencedEvent(int producer, int sequence)
+        : QEvent(QEvent::Type(QEvent::User + 1)), producer(producer), sequence(sequence)
+    {}
+
+    int producer;
+    int sequence;
+};
+
+class SequencedEventReceiver : public QObject
+{
+public:
+    explicit SequencedEventReceiver(int producerCount)
+        : lastSequence(producerCount, -1)
+    {}
+
+    QList<int> lastSequence;
+    QAtomicInt received = 0;
+    bool inOrder = true;
+    bool inOwnThread = true;
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() != QEvent::User + 1)
+            return QObject::event(event);
+        const auto *e = static_cast<SequencedEvent *>(event);
+        inOrder = inOrder && e->sequence == lastSequence.at(e->producer) + 1;
+        inOwnThread = inOwnThread && QThread::currentThread() == thread();
+        lastSequence[e->producer] = e->sequence;
+        received.ref();
+        return true;
+    }
+};
+
+static std::vector<std::unique_ptr<QThread>> startEventProducers(QObject *receiver,
+                                                                  int producerCount,
+                                                                  int eventCount)
+{
+    std::vector<std::unique_ptr<QThread>> producers;
+    for (int producer = 0; producer < producerCount; ++producer) {
+        producers.emplace_back(QThread::create([=] {
+            for (int i = 0; i < eventCount; ++i)
+                QCoreApplication::postEvent(receiver, new SequencedEvent(producer, i));
+        }));
+        producers.back()->start();
+    }
+    return producers;
+}
+
+void tst_QCoreApplication::postEventFromManyThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int ProducerCount = 4;
+    constexpr int EventCount = 5000;
+    SequencedEventReceiver receiver(ProducerCount);
+
+    const auto producers = startEventProducers(&receiver, ProducerCount, EventCount);
+    // events with another priority are kept in order with those that aren't
+    QCoreApplication::postEvent(&receiver, new SequencedEvent(0, -1), Qt::HighEventPriority);
+    receiver.lastSequence[0] = -2;
+    for (const auto &producer : producers)
+        QVERIFY(producer->wait(30000));
+
+    QTRY_COMPARE(receiver.received.loadRelaxed(), ProducerCount * EventCount + 1);
+    QVERIFY(receiver.inOrder);
+}
+
+void tst_QCoreApplication::postEventWhileMovingToThread()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int ProducerCount = 4;
+    constexpr int EventCount = 5000;
+    SequencedEventReceiver receiver(ProducerCount);
+
+    QThread thread;
+    thread.start();
+    auto cleanup = qScopeGuard([&] {
+        thread.quit();
+        thread.wait();
+    });
+
+    const auto producers = startEventProducers(&receiver, ProducerCount, EventCount);
+    QCoreApplication::processEvents();
+    receiver.moveToThread(&thread);
+    for (const auto &producer : producers)
+        QVERIFY(producer->wait(30000));
+
+    // every event is delivered exactly once, in the thread the receiver lived in
+    QTRY_COMPARE(receiver.received.loadRelaxed(), ProducerCount * EventCount);
+    QVERIFY(receiver.inOrder);
+    QVERIFY(receiver.inOwnThread);
+
+    QMetaObject::invokeMethod(&receiver, [&] { receiver.moveToThread(app.thread()); },
+                              Qt::BlockingQueuedConnection);
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
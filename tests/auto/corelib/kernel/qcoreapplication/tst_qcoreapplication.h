@@ -20,6 +20,8 @@ private slots:
     void removePostedEvents();
 #if QT_CONFIG(thread)
     void deliverInDefinedOrder();
+    void postEventFromManyThreads();
+    void postEventWhileMovingToThread();
 #endif
     void applicationPid();
 #ifdef QT_BUILD_INTERNAL
@@ -0,0 +1,412 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QCoroTask>
+#include <QFuture>
+#include <QPromise>
+#include <QScopeGuard>
+#include <QThread>
+
+#include <memory>
+
+class SenderObject : public QObject
+{
+    Q_OBJECT
+
+Q_SIGNALS:
+    void noArgSignal();
+    void intArgSignal(int value);
+    void multipleArgs(int value1, const QString &value2);
+};
+
+// A sequential device that only has the data the test gives it.
+class PipeDevice : public QIODevice
+{
+public:
+    PipeDevice() { open(QIODevice::ReadWrite); }
+
+    void feed(const QByteArray &data)
+    {
+        buffer += data;
+        emit readyRead();
+    }
+
+    void flush(qint64 bytes)
+    {
+        pending -= bytes;
+        emit bytesWritten(bytes);
+    }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return buffer.size() + QIODevice::bytesAvailable(); }
+    qint64 bytesToWrite() const override { return pending; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 size = qMin(maxSize, qint64(buffer.size()));
+        memcpy(data, buffer.constData(), size);
+        buffer.remove(0, size);
+        return size;
+    }
+
+    qint64 writeData(const char *, qint64 size) override
+    {
+        pending += size;
+        return size;
+    }
+
+private:
+    QByteArray buffer;
+    qint64 pending = 0;
+};
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+class Owner : public QObject
+{
+public:
+    QCoroTask<QThread *> threadAfter(QFuture<void> future)
+    {
+        co_await future;
+        co_return QThread::currentThread();
+    }
+
+    QCoroTask<> touchAfter(QFuture<void> future, std::shared_ptr<int> counter)
+    {
+        co_await future;
+        ++*counter;
+    }
+
+};
+
+static QCoroTask<int> returnImmediately(int value)
+{
+    co_return value;
+}
+
+static QCoroTask<int> awaitFuture(QFuture<int> future)
+{
+    const int value = co_await future;
+    co_return value * 2;
+}
+
+static QCoroTask<int> awaitTask(QFuture<int> future)
+{
+    const int first = co_await awaitFuture(future);
+    const int second = co_await returnImmediately(1);
+    co_return first + second;
+}
+
+static QCoroTask<QThread *> threadAfter(QFuture<void> future)
+{
+    co_await future;
+    co_return QThread::currentThread();
+}
+
+#endif
+
+class tst_QCoroTask : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void returnValue();
+    void awaitReadyFuture();
+    void awaitFuture();
+    void awaitCanceledFuture();
+    void awaitFutureWithContinuation();
+    void awaitTask();
+    void awaitCanceledTask();
+    void resumeInOwnThread();
+    void resumeInOwnerThread();
+    void ownerDestroyed();
+    void awaitSignal();
+    void readyRead();
+    void bytesWritten();
+    void exception();
+    void detach();
+};
+
+void tst_QCoroTask::initTestCase()
+{
+#if !defined(__cpp_impl_coroutine) || !defined(__cpp_lib_coroutine)
+    QSKIP("This test requires C++20 coroutines.");
+#endif
+}
+
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+
+void tst_QCoroTask::returnValue()
+{
+    QCoroTask<int> task = returnImmediately(42);
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.result(), 42);
+}
+
+void tst_QCoroTask::awaitReadyFuture()
+{
+    QCoroTask<int> task = awaitFuture(QtFuture::makeReadyValueFuture(21));
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.result(), 42);
+}
+
+void tst_QCoroTask::awaitFuture()
+{
+    QPromise<int> promise;
+    promise.start();
+    QCoroTask<int> task = awaitFuture(promise.future());
+    QVERIFY(!task.isFinished());
+
+    promise.addResult(21);
+    promise.finish();
+    // resumed through the event loop
+    QVERIFY(!task.isFinished());
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.result(), 42);
+}
+
+void tst_QCoroTask::awaitCanceledFuture()
+{
+    QPromise<int> promise;
+    promise.start();
+    QCoroTask<int> task = awaitFuture(promise.future());
+
+    promise.future().cancel();
+    promise.finish();
+    QTRY_VERIFY(task.isFinished());
+    QVERIFY(task.isCanceled());
+
+    QFuture<int> canceled = QtFuture::makeReadyValueFuture(1);
+    canceled.cancel();
+    task = awaitFuture(canceled);
+    QVERIFY(task.isFinished());
+    QVERIFY(task.isCanceled());
+}
+
+void tst_QCoroTask::awaitFutureWithContinuation()
+{
+    QPromise<int> promise;
+    promise.start();
+    int thenResult = 0;
+    QFuture<void> then = promise.future().then([&thenResult](int value) { thenResult = value; });
+    QCoroTask<int> task = awaitFuture(promise.future());
+
+    promise.addResult(21);
+    promise.finish();
+    // both continuations run
+    QCOMPARE(thenResult, 21);
+    QVERIFY(then.isFinished());
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.result(), 42);
+}
+
+void tst_QCoroTask::awaitTask()
+{
+    QPromise<int> promise;
+    promise.start();
+    QCoroTask<int> task = ::awaitTask(promise.future());
+    QVERIFY(!task.isFinished());
+
+    promise.addResult(20);
+    promise.finish();
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.result(), 41);
+}
+
+void tst_QCoroTask::awaitCanceledTask()
+{
+    QPromise<int> promise;
+    promise.start();
+    QCoroTask<int> task = ::awaitTask(promise.future());
+
+    promise.future().cancel();
+    promise.finish();
+    // the coroutine awaiting the canceled one is canceled too
+    QTRY_VERIFY(task.isFinished());
+    QVERIFY(task.isCanceled());
+}
+
+void tst_QCoroTask::resumeInOwnThread()
+{
+    QPromise<void> promise;
+    promise.start();
+    QCoroTask<QThread *> task = threadAfter(promise.future());
+
+    std::unique_ptr<QThread> thread(QThread::create([&promise] { promise.finish(); }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.result(), QThread::currentThread());
+}
+
+void tst_QCoroTask::resumeInOwnerThread()
+{
+    QThread thread;
+    thread.start();
+    Owner owner;
+    owner.moveToThread(&thread);
+    auto cleanup = qScopeGuard([&thread] {
+        thread.quit();
+        thread.wait();
+    });
+
+    QPromise<void> promise;
+    promise.start();
+    QCoroTask<QThread *> task = owner.threadAfter(promise.future());
+    promise.finish();
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.result(), &thread);
+}
+
+void tst_QCoroTask::ownerDestroyed()
+{
+    auto counter = std::make_shared<int>(0);
+    auto owner = std::make_unique<Owner>();
+    QPromise<void> promise;
+    promise.start();
+    (void)owner->touchAfter(promise.future(), counter);
+    QCOMPARE(counter.use_count(), 2);
+
+    // not resumed once the owner is gone, but its frame is freed
+    owner.reset();
+    promise.finish();
+    QCOMPARE(counter.use_count(), 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(*counter, 0);
+
+    // also when the owner is destroyed after the future finished
+    owner = std::make_unique<Owner>();
+    QPromise<void> second;
+    second.start();
+    (void)owner->touchAfter(second.future(), counter);
+    second.finish();
+    QCOMPARE(counter.use_count(), 2);
+    owner.reset();
+    QCOMPARE(counter.use_count(), 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(*counter, 0);
+}
+
+void tst_QCoroTask::awaitSignal()
+{
+    SenderObject sender;
+    int step = 0;
+    auto coroutine = [](SenderObject *sender, int *step) -> QCoroTask<QString> {
+        co_await QtCoro::signal(sender, &SenderObject::noArgSignal);
+        *step = 1;
+        const int value = co_await QtCoro::signal(sender, &SenderObject::intArgSignal);
+        *step = 2;
+        const auto [number, text] = co_await QtCoro::signal(sender, &SenderObject::multipleArgs);
+        co_return QString::number(value + number) + text;
+    };
+    QCoroTask<QString> task = coroutine(&sender, &step);
+
+    QCOMPARE(step, 0);
+    emit sender.intArgSignal(0);
+    QCOMPARE(step, 0);
+    emit sender.noArgSignal();
+    QCOMPARE(step, 1);
+    emit sender.intArgSignal(40);
+    QCOMPARE(step, 2);
+    emit sender.intArgSignal(0);
+    QVERIFY(!task.isFinished());
+    emit sender.multipleArgs(2, QStringLiteral(" apples"));
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.result(), QStringLiteral("42 apples"));
+}
+
+void tst_QCoroTask::readyRead()
+{
+    PipeDevice device;
+    auto coroutine = [](QIODevice *device) -> QCoroTask<QByteArray> {
+        QByteArray data;
+        while (co_await QtCoro::readyRead(device) > 0)
+            data += device->readAll();
+        co_return data;
+    };
+    QCoroTask<QByteArray> task = coroutine(&device);
+
+    device.feed("abc");
+    device.feed("def");
+    QVERIFY(!task.isFinished());
+    device.close();
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.result(), "abcdef");
+}
+
+void tst_QCoroTask::bytesWritten()
+{
+    PipeDevice device;
+    auto coroutine = [](QIODevice *device) -> QCoroTask<qint64> {
+        qint64 written = 0;
+        device->write("0123456789");
+        while (device->bytesToWrite() > 0)
+            written += co_await QtCoro::bytesWritten(device);
+        co_return written;
+    };
+    QCoroTask<qint64> task = coroutine(&device);
+
+    device.flush(4);
+    QVERIFY(!task.isFinished());
+    device.flush(6);
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.result(), 10);
+}
+
+void tst_QCoroTask::exception()
+{
+#ifdef QT_NO_EXCEPTIONS
+    QSKIP("This test requires exception support.");
+#else
+    QPromise<int> promise;
+    promise.start();
+    QCoroTask<int> task = ::awaitTask(promise.future());
+
+    promise.setException(std::make_exception_ptr(std::runtime_error("failed")));
+    promise.finish();
+    QTRY_VERIFY(task.isFinished());
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, task.result());
+#endif
+}
+
+void tst_QCoroTask::detach()
+{
+    SenderObject sender;
+    bool done = false;
+    auto coroutine = [](SenderObject *sender, bool *done) -> QCoroTask<> {
+        co_await QtCoro::signal(sender, &SenderObject::noArgSignal);
+        *done = true;
+    };
+    // the coroutine outlives the task
+    (void)coroutine(&sender, &done);
+
+    QVERIFY(!done);
+    emit sender.noArgSignal();
+    QVERIFY(done);
+}
+
+#else
+
+void tst_QCoroTask::returnValue() { }
+void tst_QCoroTask::awaitReadyFuture() { }
+void tst_QCoroTask::awaitFuture() { }
+void tst_QCoroTask::awaitCanceledFuture() { }
+void tst_QCoroTask::awaitFutureWithContinuation() { }
+void tst_QCoroTask::awaitTask() { }
+void tst_QCoroTask::awaitCanceledTask() { }
+void tst_QCoroTask::resumeInOwnThread() { }
+void tst_QCoroTask::resumeInOwnerThread() { }
+void tst_QCoroTask::ownerDestroyed() { }
+void tst_QCoroTask::awaitSignal() { }
+void tst_QCoroTask::readyRead() { }
+void tst_QCoroTask::bytesWritten() { }
+void tst_QCoroTask::exception() { }
+void tst_QCoroTask::detach() { }
+
+#endif
+
+QTEST_MAIN(tst_QCoroTask)
+#include "tst_qcorotask.moc"
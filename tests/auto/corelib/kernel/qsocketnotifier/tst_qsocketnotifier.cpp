@@ -26,6 +26,14 @@
 
 using namespace std::chrono_literals;
 
+#ifdef USE_EPOLL_DISPATCHER
+#  define tst_QSocketNotifier tst_QSocketNotifier_Epoll
+static bool epollDispatcherEnabled = []() {
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    return true;
+}();
+#endif
+
 class tst_QSocketNotifier : public QObject
 {
     Q_OBJECT
@@ -35,6 +35,13 @@ static bool glibDisabled = []() {
 }();
 #endif
 
+#ifdef USE_TIMER_WHEEL
+static bool timerWheelEnabled = []() {
+    qputenv("QT_TIMER_WHEEL", "1");
+    return true;
+}();
+#endif
+
 class tst_QTimer : public QObject
 {
     Q_OBJECT
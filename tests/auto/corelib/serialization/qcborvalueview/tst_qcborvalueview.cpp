@@ -0,0 +1,366 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValueView>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCborValueView : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void invalid();
+    void basics_data();
+    void basics();
+    void chunkedStrings_data();
+    void chunkedStrings();
+    void arrays_data();
+    void arrays();
+    void maps_data();
+    void maps();
+    void mapLookup();
+    void nested();
+    void trailingData();
+    void validation_data();
+    void validation();
+    void recursionLimit_data();
+    void recursionLimit();
+};
+
+// Get the validation data from TinyCBOR (see src/3rdparty/tinycbor/tests/parser/data.cpp)
+#include "data.cpp"
+
+void tst_QCborValueView::invalid()
+{
+    QCborValueView view;
+    QVERIFY(view.isInvalid());
+    QCOMPARE(view.type(), QCborValue::Invalid);
+    QCOMPARE(view.toInteger(-1), -1);
+    QCOMPARE(view.toDouble(-1.5), -1.5);
+    QVERIFY(view.toString().isNull());
+    QVERIFY(view.stringView().isNull());
+    QCOMPARE(view.size(), 0);
+    QVERIFY(view[0].isInvalid());
+    QVERIFY(view["a"].isInvalid());
+    QVERIFY(view.begin() == view.end());
+    QVERIFY(view.encoded().isNull());
+    QCOMPARE(view.toCborValue(), QCborValue(QCborValue::Invalid));
+
+    QCborParserError error;
+    view = QCborValueView::fromCbor({}, &error);
+    QVERIFY(view.isInvalid());
+    QCOMPARE(error.error, QCborError::EndOfFile);
+    QCOMPARE(error.offset, 0);
+}
+
+void tst_QCborValueView::basics_data()
+{
+    QTest::addColumn<QCborValue>("value");
+
+    QTest::newRow("Integer:0") << QCborValue(0);
+    QTest::newRow("Integer:-1") << QCborValue(-1);
+    QTest::newRow("Integer:1000000") << QCborValue(1000000);
+    QTest::newRow("Integer:max") << QCborValue(std::numeric_limits<qint64>::max());
+    QTest::newRow("Integer:min") << QCborValue(std::numeric_limits<qint64>::min());
+    QTest::newRow("Double:0.5") << QCborValue(0.5);
+    QTest::newRow("Double:-inf") << QCborValue(-qInf());
+    QTest::newRow("Double:1e300") << QCborValue(1e300);
+    QTest::newRow("ByteArray:empty") << QCborValue(QByteArray(""));
+    QTest::newRow("ByteArray") << QCborValue(QByteArray("\0\1\2", 3));
+    QTest::newRow("String:empty") << QCborValue(u""_s);
+    QTest::newRow("String") << QCborValue(u"Hello"_s);
+    QTest::newRow("String:nonAscii") << QCborValue(u"é€\U0001F600"_s);
+    QTest::newRow("False") << QCborValue(false);
+    QTest::newRow("True") << QCborValue(true);
+    QTest::newRow("Null") << QCborValue(nullptr);
+    QTest::newRow("Undefined") << QCborValue();
+    QTest::newRow("SimpleType:32") << QCborValue(QCborSimpleType(32));
+    QTest::newRow("Tag") << QCborValue(QCborTag(1000), u"tagged"_s);
+    QTest::newRow("Array") << QCborValue(QCborArray{ 1, u"two"_s, 3.5 });
+    QTest::newRow("Map") << QCborValue(QCborMap{ { 1, 2 }, { u"a"_s, u"b"_s } });
+}
+
+void tst_QCborValueView::basics()
+{
+    QFETCH(QCborValue, value);
+    const QByteArray encoded = value.toCbor();
+
+    QCborParserError error;
+    const QCborValueView view = QCborValueView::fromCbor(encoded, &error);
+    QCOMPARE(error.error, QCborError::NoError);
+    QCOMPARE(error.offset, encoded.size());
+    QVERIFY(!view.isInvalid());
+
+    QCOMPARE(view.type(), value.type());
+    QCOMPARE(view.isInteger(), value.isInteger());
+    QCOMPARE(view.isDouble(), value.isDouble());
+    QCOMPARE(view.isByteArray(), value.isByteArray());
+    QCOMPARE(view.isString(), value.isString());
+    QCOMPARE(view.isBool(), value.isBool());
+    QCOMPARE(view.isNull(), value.isNull());
+    QCOMPARE(view.isUndefined(), value.isUndefined());
+    QCOMPARE(view.isSimpleType(), value.isSimpleType());
+    QCOMPARE(view.isTag(), value.isTag());
+    QCOMPARE(view.isArray(), value.isArray());
+    QCOMPARE(view.isMap(), value.isMap());
+
+    QCOMPARE(view.toInteger(-42), value.toInteger(-42));
+    QCOMPARE(view.toDouble(-42), value.toDouble(-42));
+    QCOMPARE(view.toBool(true), value.toBool(true));
+    QCOMPARE(view.toSimpleType(), value.toSimpleType());
+    QCOMPARE(view.toString(u"default"_s), value.toString(u"default"_s));
+    QCOMPARE(view.toByteArray("default"), value.toByteArray("default"));
+    QCOMPARE(view.tag(), value.tag());
+    QCOMPARE(view.taggedValue().toCborValue(), value.taggedValue(QCborValue(QCborValue::Invalid)));
+
+    if (value.isString())
+        QCOMPARE(view.stringView().toString(), value.toString());
+    else
+        QVERIFY(view.stringView().isNull());
+    if (value.isByteArray())
+        QCOMPARE(view.byteArrayView().toByteArray(), value.toByteArray());
+    else
+        QVERIFY(view.byteArrayView().isNull());
+
+    QCOMPARE(view.encoded().toByteArray(), encoded);
+    QCOMPARE(view.toCborValue(), value);
+}
+
+void tst_QCborValueView::chunkedStrings_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QCborValue>("expected");
+
+    QTest::newRow("String:empty") << raw("\x7f\xff") << QCborValue(u""_s);
+    QTest::newRow("String:1chunk") << raw("\x7f\x62Hi\xff") << QCborValue(u"Hi"_s);
+    QTest::newRow("String:3chunks") << raw("\x7f\x61H\x60\x64\xc3\xa9t\xc3\xa9\xff")
+                                    << QCborValue(u"Hété"_s);
+    QTest::newRow("ByteArray:empty") << raw("\x5f\xff") << QCborValue(QByteArray(""));
+    QTest::newRow("ByteArray:2chunks") << raw("\x5f\x41\0\x42\1\2\xff")
+                                       << QCborValue(QByteArray("\0\1\2", 3));
+}
+
+void tst_QCborValueView::chunkedStrings()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QCborValue, expected);
+
+    const QCborValueView view = QCborValueView::fromCbor(data);
+    QCOMPARE(view.type(), expected.type());
+    QCOMPARE(view.toString(), expected.toString());
+    QCOMPARE(view.toByteArray(), expected.toByteArray());
+    QCOMPARE(view.encoded().toByteArray(), data);
+
+    // the chunks aren't contiguous
+    QVERIFY(view.stringView().isNull());
+    QVERIFY(view.byteArrayView().isNull());
+}
+
+void tst_QCborValueView::arrays_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QCborArray>("expected");
+
+    const QCborArray array{ 1, u"two"_s, QCborArray{ 3 }, QCborMap{ { 4, 5 } }, 6.5 };
+    QTest::newRow("empty") << raw("\x80") << QCborArray();
+    QTest::newRow("empty:indefinite") << raw("\x9f\xff") << QCborArray();
+    QTest::newRow("definite") << QCborValue(array).toCbor() << array;
+    QTest::newRow("indefinite")
+            << raw("\x9f\1\x63two\x81\3\xa1\4\5\xfb\x40\x1a\0\0\0\0\0\0\xff") << array;
+}
+
+void tst_QCborValueView::arrays()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QCborArray, expected);
+
+    const QCborValueView view = QCborValueView::fromCbor(data);
+    QVERIFY(view.isArray());
+    QCOMPARE(view.size(), expected.size());
+    QCOMPARE(view.encoded().toByteArray(), data);
+    QCOMPARE(view.toCborValue(), QCborValue(expected));
+
+    qsizetype i = 0;
+    for (QCborValueView element : view) {
+        QCOMPARE(element.toCborValue(), expected.at(i));
+        QCOMPARE(view[i].toCborValue(), expected.at(i));
+        QCOMPARE(element.encoded().toByteArray(), expected.at(i).toCbor());
+        ++i;
+    }
+    QCOMPARE(i, expected.size());
+    QVERIFY(view[-1].isInvalid());
+    QVERIFY(view[expected.size()].isInvalid());
+    QVERIFY(view[u"two"].isInvalid());
+}
+
+void tst_QCborValueView::maps_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QCborMap>("expected");
+
+    const QCborMap map{ { 1, u"one"_s }, { u"two"_s, 2 }, { -3, QCborArray{ 3 } },
+                        { u"four"_s, QCborMap{ { 4, 4 } } } };
+    QTest::newRow("empty") << raw("\xa0") << QCborMap();
+    QTest::newRow("empty:indefinite") << raw("\xbf\xff") << QCborMap();
+    QTest::newRow("definite") << QCborValue(map).toCbor() << map;
+    QTest::newRow("indefinite")
+            << raw("\xbf\1\x63one\x63two\2\x22\x81\3\x64" "four\xa1\4\4\xff") << map;
+}
+
+void tst_QCborValueView::maps()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QCborMap, expected);
+
+    const QCborValueView view = QCborValueView::fromCbor(data);
+    QVERIFY(view.isMap());
+    QCOMPARE(view.size(), expected.size());
+    QCOMPARE(view.encoded().toByteArray(), data);
+    QCOMPARE(view.toCborValue(), QCborValue(expected));
+
+    qsizetype count = 0;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        const QCborValue key = it.key().toCborValue();
+        QVERIFY(expected.contains(key));
+        QCOMPARE(it.value().toCborValue(), expected.value(key));
+        QCOMPARE((*it).toCborValue(), expected.value(key));
+        if (key.isInteger())
+            QCOMPARE(view[key.toInteger()].toCborValue(), expected.value(key));
+        else
+            QCOMPARE(view[key.toString()].toCborValue(), expected.value(key));
+        ++count;
+    }
+    QCOMPARE(count, expected.size());
+    QVERIFY(view[2].isInvalid());
+    QVERIFY(view[u"one"].isInvalid());
+}
+
+void tst_QCborValueView::mapLookup()
+{
+    // one key is encoded in chunks
+    const QByteArray data = raw("\xa3\x63" "abc\1\x7f\x61" "d\x62" "ef\xff\2\x63\xc3\xa9z\3");
+    const QCborValueView view = QCborValueView::fromCbor(data);
+    QVERIFY(view.isMap());
+
+    // all string types can be used as keys
+    QCOMPARE(view[u"abc"].toInteger(), 1);
+    QCOMPARE(view["abc"].toInteger(), 1);
+    QCOMPARE(view[u8"abc"].toInteger(), 1);
+    QCOMPARE(view["abc"_L1].toInteger(), 1);
+    QCOMPARE(view[u"abc"_s].toInteger(), 1);
+    QCOMPARE(view[u"def"].toInteger(), 2);
+    QCOMPARE(view[u"éz"].toInteger(), 3);
+    QCOMPARE(view["\xe9z"_L1].toInteger(), 3);
+    QCOMPARE(view[u8"éz"].toInteger(), 3);
+
+    QVERIFY(view[u"ab"].isInvalid());
+    QVERIFY(view[u"abcd"].isInvalid());
+    QVERIFY(view[u""].isInvalid());
+}
+
+void tst_QCborValueView::nested()
+{
+    QCborArray icons;
+    for (int i = 0; i < 100; ++i)
+        icons.append(QCborMap{ { u"name"_s, QString::number(i) }, { u"size"_s, i * 2 } });
+    const QCborMap document{
+        { u"version"_s, 2 },
+        { u"themes"_s, QCborMap{ { u"dark"_s, QCborMap{ { u"icons"_s, icons } } } } }
+    };
+    const QByteArray encoded = QCborValue(document).toCbor();
+
+    const QCborValueView view = QCborValueView::fromCbor(encoded);
+    QCOMPARE(view["version"].toInteger(), 2);
+    const QCborValueView viewIcons = view["themes"]["dark"]["icons"];
+    QCOMPARE(viewIcons.size(), icons.size());
+    QCOMPARE(viewIcons[42]["name"].stringView().toString(), u"42"_s);
+    QCOMPARE(viewIcons[42]["size"].toInteger(), 84);
+    QVERIFY(viewIcons[100]["name"].isInvalid());
+    QVERIFY(view["themes"]["light"]["icons"][0].isInvalid());
+
+    // the views point into the data
+    const char *name = reinterpret_cast<const char *>(viewIcons[99]["name"].stringView().data());
+    QVERIFY(name >= encoded.constBegin() && name < encoded.constEnd());
+}
+
+void tst_QCborValueView::trailingData()
+{
+    const QByteArray data = raw("\x82\1\2\3\4");
+    QCborParserError error;
+    const QCborValueView view = QCborValueView::fromCbor(data, &error);
+    QCOMPARE(error.error, QCborError::NoError);
+    QCOMPARE(error.offset, 3);
+    QCOMPARE(view.size(), 2);
+    QCOMPARE(view.encoded().toByteArray(), raw("\x82\1\2"));
+}
+
+void tst_QCborValueView::validation_data()
+{
+    addValidationColumns();
+    addValidationData();
+}
+
+void tst_QCborValueView::validation()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(CborError, expectedError);
+    QCborError error = { QCborError::Code(expectedError) };
+
+    // The view doesn't copy the data, so it has no size limits. The sizes in
+    // the data that are too large are larger than the data.
+    if (error == QCborError::DataTooLarge)
+        error = { QCborError::EndOfFile };
+
+    QCborParserError parserError;
+    QCborValueView view = QCborValueView::fromCbor(data, &parserError);
+    QCOMPARE(parserError.error, error);
+    QVERIFY(view.isInvalid());
+
+    if (data.startsWith('\x81')) {
+        // decode without the array prefix
+        view = QCborValueView::fromCbor(QByteArrayView(data).sliced(1), &parserError);
+        QCOMPARE(parserError.error, error);
+        QVERIFY(view.isInvalid());
+    }
+}
+
+void tst_QCborValueView::recursionLimit_data()
+{
+    constexpr int RecursionAttempts = 4096;
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("array-nesting-too-deep") << QByteArray(RecursionAttempts, char(0x81));
+    QTest::newRow("_array-nesting-too-deep") << QByteArray(RecursionAttempts, char(0x9f));
+    QTest::newRow("map-nesting-too-deep") << QByteArray(RecursionAttempts, char(0xa1));
+    QTest::newRow("_map-nesting-too-deep") << QByteArray(RecursionAttempts, char(0xbf));
+    QTest::newRow("tag-nesting-too-deep") << QByteArray(RecursionAttempts, char(0xc0));
+}
+
+void tst_QCborValueView::recursionLimit()
+{
+    QFETCH(QByteArray, data);
+
+    QCborParserError error;
+    QCborValue::fromCbor(data, &error);
+    const QCborError expected = error.error;
+    QCOMPARE(expected, QCborError::NestingTooDeep);
+
+    const QCborValueView view = QCborValueView::fromCbor(data, &error);
+    QVERIFY(view.isInvalid());
+    QCOMPARE(error.error, expected);
+
+    // just below the limit
+    if (data.startsWith('\x81') || data.startsWith('\xc0')) {
+        data.truncate(1024);
+        data += '\1';
+        QVERIFY(!QCborValueView::fromCbor(data).isInvalid());
+    }
+}
+
+QTEST_MAIN(tst_QCborValueView)
+
+#include "tst_qcborvalueview.moc"
@@ -187,6 +187,10 @@ private slots:
 
     void floatingPointPrecision();
 
+    void arrays_data();
+    void arrays();
+    void readArrayPastEnd();
+
     void compatibility_Qt5();
     void compatibility_Qt3();
     void compatibility_Qt2();
@@ -3683,6 +3687,145 @@ void tst_QDataStream::floatingPointPrecision()
 
 }
 
+void tst_QDataStream::arrays_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+    QTest::addColumn<int>("version");
+
+    QTest::newRow("big-endian, double")
+            << QDataStream::BigEndian << QDataStream::DoublePrecision << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("little-endian, double")
+            << QDataStream::LittleEndian << QDataStream::DoublePrecision << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("big-endian, single")
+            << QDataStream::BigEndian << QDataStream::SinglePrecision << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("little-endian, single")
+            << QDataStream::LittleEndian << QDataStream::SinglePrecision << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("Qt 4.5, double")
+            << QDataStream::BigEndian << QDataStream::DoublePrecision << int(QDataStream::Qt_4_5);
+}
+
+template <typename T>
+static void checkArrayStreaming(QDataStream::ByteOrder byteOrder,
+                                QDataStream::FloatingPointPrecision precision, int version)
+{
+    const auto setup = [&](QDataStream &stream) {
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        stream.setVersion(version);
+    };
+
+    // enough elements for several conversion and byte-swapping blocks, and
+    // an odd count so that the SIMD code has a tail to handle
+    QList<T> values;
+    for (int i = 0; i < 5003; ++i)
+        values.append(T(T(i * 37 - 1000) / T(4)));
+
+    QByteArray expected;
+    {
+        QDataStream stream(&expected, QIODevice::WriteOnly);
+        setup(stream);
+        stream << quint32(values.size());
+        for (T value : std::as_const(values))
+            stream << value;
+    }
+
+    QByteArray written;
+    {
+        QDataStream stream(&written, QIODevice::WriteOnly);
+        setup(stream);
+        stream << values;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(written, expected);
+
+    {
+        QList<T> read;
+        QDataStream stream(expected);
+        setup(stream);
+        stream >> read;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(read, values);
+        QVERIFY(stream.atEnd());
+    }
+
+    written.clear();
+    {
+        QDataStream stream(&written, QIODevice::WriteOnly);
+        setup(stream);
+        stream.writeArray(values.constData(), values.size());
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(written, expected.mid(int(sizeof(quint32))));
+
+    {
+        QList<T> read(values.size());
+        QDataStream stream(written);
+        setup(stream);
+        stream.readArray(read.data(), read.size());
+        QCOMPARE(stream.status(), QDataStream::Ok);
+        QCOMPARE(read, values);
+    }
+}
+
+void tst_QDataStream::arrays()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+    QFETCH(int, version);
+
+    checkArrayStreaming<char>(byteOrder, precision, version);
+    checkArrayStreaming<quint8>(byteOrder, precision, version);
+    checkArrayStreaming<qint16>(byteOrder, precision, version);
+    checkArrayStreaming<quint16>(byteOrder, precision, version);
+    checkArrayStreaming<qint32>(byteOrder, precision, version);
+    checkArrayStreaming<quint32>(byteOrder, precision, version);
+    checkArrayStreaming<qint64>(byteOrder, precision, version);
+    checkArrayStreaming<quint64>(byteOrder, precision, version);
+    checkArrayStreaming<char16_t>(byteOrder, precision, version);
+    checkArrayStreaming<char32_t>(byteOrder, precision, version);
+    checkArrayStreaming<float>(byteOrder, precision, version);
+    checkArrayStreaming<double>(byteOrder, precision, version);
+}
+
+void tst_QDataStream::readArrayPastEnd()
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (qint32 i = 1; i <= 10; ++i)
+            stream << i;
+    }
+    data.chop(2);
+
+    {
+        qint32 values[10];
+        std::fill(std::begin(values), std::end(values), -1);
+        QDataStream stream(data);
+        stream.readArray(values, 10);
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        for (qint32 value : values)
+            QCOMPARE(value, 0);
+    }
+    {
+        // the stream holds doubles, which are converted while reading
+        float values[5];
+        std::fill(std::begin(values), std::end(values), -1.0f);
+        QDataStream stream(data);
+        stream.readArray(values, 5);
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        for (float value : values)
+            QCOMPARE(value, 0.0f);
+    }
+    {
+        QList<qint32> list;
+        QDataStream stream(QByteArray::fromHex("00000003") + data.left(8));
+        stream >> list;
+        QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+        QVERIFY(list.isEmpty());
+    }
+}
+
 void tst_QDataStream::transaction_data()
 {
     QTest::addColumn<qint8>("i8Data");
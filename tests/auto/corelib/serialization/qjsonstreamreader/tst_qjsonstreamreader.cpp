@@ -0,0 +1,409 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initialState();
+    void tokens_data();
+    void tokens();
+    void tokensIncremental_data() { tokens_data(); }
+    void tokensIncremental();
+    void tokensFromDevice_data() { tokens_data(); }
+    void tokensFromDevice();
+    void numbers_data();
+    void numbers();
+    void strings_data();
+    void strings();
+    void errors_data();
+    void errors();
+    void readValue_data();
+    void readValue();
+    void skipValue();
+    void containerDepth();
+    void deepNesting();
+    void clear();
+};
+
+using TokenList = QStringList;
+
+// Describes each token as a string, so that failures are easy to read
+static QString describe(const QJsonStreamReader &reader)
+{
+    switch (reader.tokenType()) {
+    case QJsonStreamReader::NoToken:
+        return u"NoToken"_s;
+    case QJsonStreamReader::Invalid:
+        return u"Invalid"_s;
+    case QJsonStreamReader::StartArray:
+        return u"["_s;
+    case QJsonStreamReader::EndArray:
+        return u"]"_s;
+    case QJsonStreamReader::StartObject:
+        return u"{"_s;
+    case QJsonStreamReader::EndObject:
+        return u"}"_s;
+    case QJsonStreamReader::Name:
+        return reader.text() + u':';
+    case QJsonStreamReader::String:
+        return u'"' + reader.text() + u'"';
+    case QJsonStreamReader::Number:
+        return QString::number(reader.toDouble());
+    case QJsonStreamReader::Bool:
+        return reader.toBool() ? u"true"_s : u"false"_s;
+    case QJsonStreamReader::Null:
+        return u"null"_s;
+    case QJsonStreamReader::EndDocument:
+        return u"EndDocument"_s;
+    }
+    return QString();
+}
+
+static TokenList readAll(QJsonStreamReader &reader)
+{
+    TokenList tokens;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        tokens << describe(reader);
+    }
+    return tokens;
+}
+
+void tst_QJsonStreamReader::initialState()
+{
+    QJsonStreamReader reader;
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QVERIFY(!reader.atEnd());
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.error(), QJsonParseError::NoError);
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.currentOffset(), qint64(0));
+    QCOMPARE(reader.device(), nullptr);
+
+    // there is no data yet
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<TokenList>("expected");
+
+    QTest::newRow("emptyArray") << QByteArray("[]") << TokenList{ "[", "]", "EndDocument" };
+    QTest::newRow("emptyObject") << QByteArray("{}") << TokenList{ "{", "}", "EndDocument" };
+    QTest::newRow("spaces") << QByteArray(" \r\n\t[ \n] \n")
+                            << TokenList{ "[", "]", "EndDocument" };
+    QTest::newRow("bom") << QByteArray("\xEF\xBB\xBF[]") << TokenList{ "[", "]", "EndDocument" };
+    QTest::newRow("string") << QByteArray("\"abc\"") << TokenList{ "\"abc\"", "EndDocument" };
+    QTest::newRow("number") << QByteArray("42") << TokenList{ "42", "EndDocument" };
+    QTest::newRow("true") << QByteArray("true") << TokenList{ "true", "EndDocument" };
+    QTest::newRow("null") << QByteArray("null") << TokenList{ "null", "EndDocument" };
+    QTest::newRow("array")
+            << QByteArray("[1, -2.5, \"x\", true, false, null]")
+            << TokenList{ "[", "1", "-2.5", "\"x\"", "true", "false", "null", "]", "EndDocument" };
+    QTest::newRow("object")
+            << QByteArray("{\"a\": 1, \"b\": \"c\", \"d\": null}")
+            << TokenList{ "{", "a:", "1", "b:", "\"c\"", "d:", "null", "}", "EndDocument" };
+    QTest::newRow("nested")
+            << QByteArray("{\"a\": [1, {\"b\": []}, {}], \"c\": {\"d\": [[]]}}")
+            << TokenList{ "{", "a:", "[", "1", "{", "b:", "[", "]", "}", "{", "}", "]",
+                          "c:", "{", "d:", "[", "[", "]", "]", "}", "}", "EndDocument" };
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(TokenList, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(readAll(reader), expected);
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.isEndDocument());
+    QCOMPARE(reader.currentOffset(), json.size());
+
+    // reading past the end keeps returning EndDocument
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::tokensIncremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(TokenList, expected);
+
+    // Top-level numbers and literals can only end at the end of the data, so
+    // add a space to mark the end.
+    json += ' ';
+
+    // add the data one byte at a time
+    QJsonStreamReader reader;
+    TokenList tokens;
+    for (char c : std::as_const(json)) {
+        reader.addData(QByteArray(1, c));
+        while (!reader.atEnd()) {
+            if (reader.readNext() != QJsonStreamReader::NoToken)
+                tokens << describe(reader);
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    }
+    QCOMPARE(tokens, expected);
+}
+
+void tst_QJsonStreamReader::tokensFromDevice()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(TokenList, expected);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QCOMPARE(readAll(reader), expected);
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStreamReader::numbers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<bool>("isInteger");
+    QTest::addColumn<qint64>("integer");
+    QTest::addColumn<double>("number");
+
+    QTest::newRow("0") << QByteArray("0") << true << qint64(0) << 0.;
+    QTest::newRow("-1") << QByteArray("-1") << true << qint64(-1) << -1.;
+    QTest::newRow("1.0") << QByteArray("1.0") << true << qint64(1) << 1.;
+    QTest::newRow("1.5") << QByteArray("1.5") << false << qint64(1) << 1.5;
+    QTest::newRow("1e3") << QByteArray("1e3") << true << qint64(1000) << 1000.;
+    QTest::newRow("-2.5E-1") << QByteArray("-2.5E-1") << false << qint64(0) << -0.25;
+    QTest::newRow("max") << QByteArray("9223372036854775807") << true
+                         << std::numeric_limits<qint64>::max() << 9223372036854775807.;
+    QTest::newRow("min") << QByteArray("-9223372036854775808") << true
+                         << std::numeric_limits<qint64>::min() << -9223372036854775808.;
+    QTest::newRow("1e100") << QByteArray("1e100") << false << qint64(0) << 1e100;
+}
+
+void tst_QJsonStreamReader::numbers()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(bool, isInteger);
+    QFETCH(qint64, integer);
+    QFETCH(double, number);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.isInteger(), isInteger);
+    QCOMPARE(reader.toDouble(), number);
+    if (isInteger || std::abs(number) < 1e18)
+        QCOMPARE(reader.toInteger(), integer);
+    QCOMPARE(reader.readValue(), QJsonDocument::fromJson('[' + json + ']').array().at(0));
+}
+
+void tst_QJsonStreamReader::strings_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty") << QByteArray(R"("")") << QString(u""_s);
+    QTest::newRow("ascii") << QByteArray(R"("Hello")") << u"Hello"_s;
+    QTest::newRow("escapes") << QByteArray(R"("\"\\\/\b\f\n\r\t")") << u"\"\\/\b\f\n\r\t"_s;
+    QTest::newRow("unicodeEscape") << QByteArray(R"("\u00e9\u20ac")") << u"é€"_s;
+    QTest::newRow("surrogates") << QByteArray(R"("\ud83d\ude00")") << u"\U0001F600"_s;
+    QTest::newRow("utf8") << QByteArray("\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"")
+                          << u"é€\U0001F600"_s;
+    QTest::newRow("utf8AndEscape") << QByteArray("\"\xc3\xa9\\n\"") << u"é\n"_s;
+}
+
+void tst_QJsonStreamReader::strings()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), expected);
+
+    // the same string as a name
+    QJsonStreamReader objectReader("{" + json + ": 1}");
+    QCOMPARE(objectReader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(objectReader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(objectReader.text(), expected);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+    QTest::addColumn<qint64>("offset");
+
+    QTest::newRow("empty") << QByteArray() << QJsonParseError::IllegalValue << qint64(0);
+    QTest::newRow("garbage") << QByteArray("[] x") << QJsonParseError::GarbageAtEnd << qint64(3);
+    QTest::newRow("illegalValue") << QByteArray("[x]") << QJsonParseError::IllegalValue << qint64(1);
+    QTest::newRow("illegalLiteral") << QByteArray("[tru]") << QJsonParseError::IllegalValue
+                                    << qint64(1);
+    QTest::newRow("missingValueSeparator") << QByteArray("[1 2]")
+                                           << QJsonParseError::MissingValueSeparator << qint64(3);
+    QTest::newRow("missingNameSeparator") << QByteArray("{\"a\" 1}")
+                                          << QJsonParseError::MissingNameSeparator << qint64(5);
+    QTest::newRow("trailingComma") << QByteArray("{\"a\": 1,}") << QJsonParseError::MissingObject
+                                   << qint64(8);
+    QTest::newRow("unterminatedArray") << QByteArray("[1, 2")
+                                       << QJsonParseError::UnterminatedArray << qint64(5);
+    QTest::newRow("unterminatedObject") << QByteArray("{\"a\": 1")
+                                        << QJsonParseError::UnterminatedObject << qint64(7);
+    QTest::newRow("unterminatedString") << QByteArray("[\"abc")
+                                        << QJsonParseError::UnterminatedString << qint64(1);
+    QTest::newRow("illegalEscape") << QByteArray(R"(["\x"])")
+                                   << QJsonParseError::IllegalEscapeSequence << qint64(2);
+    QTest::newRow("illegalUtf8") << QByteArray("[\"\xff\"]") << QJsonParseError::IllegalUTF8String
+                                 << qint64(1);
+    QTest::newRow("illegalNumber") << QByteArray("[-]") << QJsonParseError::IllegalNumber
+                                   << qint64(1);
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+    QFETCH(qint64, offset);
+
+    QJsonStreamReader reader(json);
+    const TokenList tokens = readAll(reader);
+    QCOMPARE(tokens.last(), u"Invalid"_s);
+    QVERIFY(reader.hasError());
+    QCOMPARE(reader.error(), error);
+    QCOMPARE(reader.currentOffset(), offset);
+    QVERIFY(!reader.errorString().isEmpty());
+
+    // the reader stays in the error state
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+
+    // QJsonDocument reports the same error
+    QJsonParseError parseError;
+    QJsonDocument::fromJson(json, &parseError);
+    QCOMPARE(parseError.error, error);
+}
+
+void tst_QJsonStreamReader::readValue_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("emptyArray") << QByteArray("[]");
+    QTest::newRow("emptyObject") << QByteArray("{}");
+    QTest::newRow("array") << QByteArray("[1, 2.5, \"x\", true, null, [], {}]");
+    QTest::newRow("object") << QByteArray("{\"a\": {\"b\": [1, {\"c\": \"d\"}]}, \"e\": false}");
+}
+
+void tst_QJsonStreamReader::readValue()
+{
+    QFETCH(QByteArray, json);
+
+    const QJsonDocument document = QJsonDocument::fromJson(json);
+    const QJsonValue expected = document.isArray() ? QJsonValue(document.array())
+                                                   : QJsonValue(document.object());
+
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    QCOMPARE(reader.readValue(), expected);
+    QVERIFY(reader.isEndArray() || reader.isEndObject());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // the same value as a member of an object
+    QJsonStreamReader objectReader("{\"v\": " + json + ", \"w\": 1}");
+    objectReader.readNext();
+    QCOMPARE(objectReader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(objectReader.readValue(), expected);
+    QCOMPARE(objectReader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(objectReader.text(), u"w"_s);
+
+    // an incomplete value
+    QJsonStreamReader incompleteReader;
+    incompleteReader.addData(json.chopped(1));
+    incompleteReader.readNext();
+    QCOMPARE(incompleteReader.readValue(), QJsonValue(QJsonValue::Undefined));
+}
+
+void tst_QJsonStreamReader::skipValue()
+{
+    QJsonStreamReader reader(R"({"a": [1, [2, {"b": 3}]], "c": {"d": {}}, "e": 4})");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.containerDepth(), 1);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.text(), u"c"_s);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.text(), u"e"_s);
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), qint64(4));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // running out of data
+    QJsonStreamReader incompleteReader;
+    incompleteReader.addData("[[1, 2]");
+    incompleteReader.readNext();
+    QVERIFY(!incompleteReader.skipValue());
+    QVERIFY(!incompleteReader.hasError());
+}
+
+void tst_QJsonStreamReader::containerDepth()
+{
+    QJsonStreamReader reader(R"([{"a": []}])");
+    const QList<int> expected = { 1, 2, 2, 3, 2, 1, 0, 0 };
+    QList<int> depths;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        depths << reader.containerDepth();
+    }
+    QCOMPARE(depths, expected);
+}
+
+void tst_QJsonStreamReader::deepNesting()
+{
+    QJsonStreamReader reader(QByteArray(2000, '['));
+    TokenList tokens = readAll(reader);
+    QCOMPARE(reader.error(), QJsonParseError::DeepNesting);
+    QCOMPARE(reader.containerDepth(), 1024);
+    QCOMPARE(tokens.size(), 1024 + 1);
+}
+
+void tst_QJsonStreamReader::clear()
+{
+    QJsonStreamReader reader("[1");
+    readAll(reader);
+    QVERIFY(reader.hasError());
+
+    reader.clear();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.containerDepth(), 0);
+
+    reader.addData("[1]");
+    QCOMPARE(readAll(reader), TokenList({ "[", "1", "]", "EndDocument" }));
+    QVERIFY(!reader.hasError());
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
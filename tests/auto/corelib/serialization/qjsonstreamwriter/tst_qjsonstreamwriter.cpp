@@ -0,0 +1,265 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+#include <QJsonStreamWriter>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase_data();
+    void sameAsToJson_data();
+    void sameAsToJson();
+    void writeValue_data() { sameAsToJson_data(); }
+    void writeValue();
+    void scalars_data();
+    void scalars();
+    void strings_data();
+    void strings();
+    void device();
+    void largeDocument();
+};
+
+// Writes the value with the individual write functions
+static void writeTokens(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+        writer.writeNull();
+        break;
+    case QJsonValue::Bool:
+        writer.writeBool(value.toBool());
+        break;
+    case QJsonValue::Double:
+        if (value.toInteger(-1) == value.toDouble())
+            writer.writeInteger(value.toInteger());
+        else
+            writer.writeDouble(value.toDouble());
+        break;
+    case QJsonValue::String:
+        writer.writeString(value.toString());
+        break;
+    case QJsonValue::Array:
+        writer.startArray();
+        for (const QJsonValue &element : value.toArray())
+            writeTokens(writer, element);
+        writer.endArray();
+        break;
+    case QJsonValue::Object: {
+        const QJsonObject object = value.toObject();
+        writer.startObject();
+        for (auto it = object.begin(), end = object.end(); it != end; ++it) {
+            writer.writeName(it.key());
+            writeTokens(writer, it.value());
+        }
+        writer.endObject();
+        break;
+    }
+    case QJsonValue::Undefined:
+        break;
+    }
+}
+
+void tst_QJsonStreamWriter::initTestCase_data()
+{
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+    QTest::newRow("indented") << QJsonDocument::Indented;
+    QTest::newRow("compact") << QJsonDocument::Compact;
+}
+
+void tst_QJsonStreamWriter::sameAsToJson_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("emptyArray") << QByteArray("[]");
+    QTest::newRow("emptyObject") << QByteArray("{}");
+    QTest::newRow("array") << QByteArray("[1, -2.5, \"x\", true, false, null, 1e100]");
+    QTest::newRow("object") << QByteArray("{\"a\": 1, \"b\": \"c\", \"d\": null}");
+    QTest::newRow("nested")
+            << QByteArray("{\"a\": [1, {\"b\": []}, {}], \"c\": {\"d\": [[]], \"e\": [{}]}}");
+    QTest::newRow("escapes") << QByteArray(R"({"\"\n": ["\\\t\u0001", "é€"]})");
+}
+
+void tst_QJsonStreamWriter::sameAsToJson()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QByteArray, json);
+
+    const QJsonDocument document = QJsonDocument::fromJson(json);
+    QVERIFY(!document.isNull());
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    QCOMPARE(writer.format(), format);
+    writeTokens(writer, document.isArray() ? QJsonValue(document.array())
+                                           : QJsonValue(document.object()));
+    QCOMPARE(output, document.toJson(format));
+}
+
+void tst_QJsonStreamWriter::writeValue()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QByteArray, json);
+
+    const QJsonDocument document = QJsonDocument::fromJson(json);
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    writer.writeValue(document.isArray() ? QJsonValue(document.array())
+                                         : QJsonValue(document.object()));
+    QCOMPARE(output, document.toJson(format));
+
+    // the same value inside of an array and an object
+    const QJsonValue value = document.isArray() ? QJsonValue(document.array())
+                                                : QJsonValue(document.object());
+    output.clear();
+    writer.startArray();
+    writer.writeValue(value);
+    writer.startObject();
+    writer.writeName(u"v");
+    writer.writeValue(value);
+    writer.endObject();
+    writer.endArray();
+    QJsonObject object;
+    object.insert(u"v"_s, value);
+    QCOMPARE(output, QJsonDocument(QJsonArray{ value, object }).toJson(format));
+}
+
+void tst_QJsonStreamWriter::scalars_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("null") << QJsonValue(QJsonValue::Null) << QByteArray("null");
+    QTest::newRow("true") << QJsonValue(true) << QByteArray("true");
+    QTest::newRow("false") << QJsonValue(false) << QByteArray("false");
+    QTest::newRow("integer") << QJsonValue(-42) << QByteArray("-42");
+    QTest::newRow("double") << QJsonValue(0.1) << QByteArray("0.1");
+    QTest::newRow("string") << QJsonValue(u"a\"b"_s) << QByteArray(R"("a\"b")");
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QJsonValue, value);
+    QFETCH(QByteArray, expected);
+
+    // unlike QJsonDocument, the writer can write any value at the top level
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setFormat(format);
+    writeTokens(writer, value);
+    QCOMPARE(output, expected);
+
+    output.clear();
+    writer.writeValue(value);
+    QCOMPARE(output, expected);
+}
+
+void tst_QJsonStreamWriter::strings_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("ascii") << u"Hello"_s;
+    QTest::newRow("controls") << u"\b\f\n\r\t\x01\x1f"_s;
+    QTest::newRow("quotes") << u"\"\\/"_s;
+    QTest::newRow("nonAscii") << u"é€\U0001F600"_s;
+}
+
+void tst_QJsonStreamWriter::strings()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+    QFETCH(QString, string);
+
+    const QByteArray expected = QJsonDocument(QJsonArray{ string }).toJson(format);
+
+    // all string view types produce the same output
+    const QByteArray utf8 = string.toUtf8();
+    for (QAnyStringView view : { QAnyStringView(string), QAnyStringView(utf8),
+                                 QAnyStringView(QUtf8StringView(utf8)) }) {
+        QByteArray output;
+        QJsonStreamWriter writer(&output);
+        writer.setFormat(format);
+        writer.startArray();
+        writer.writeString(view);
+        writer.endArray();
+        QCOMPARE(output, expected);
+    }
+
+    // Latin-1 can only represent some of the strings
+    if (string.toLatin1() == utf8) {
+        QByteArray output;
+        QJsonStreamWriter writer(&output);
+        writer.setFormat(format);
+        writer.startArray();
+        writer.writeString(QLatin1StringView(utf8));
+        writer.endArray();
+        QCOMPARE(output, expected);
+    }
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QJsonStreamWriter writer(&buffer);
+    QCOMPARE(writer.device(), &buffer);
+    writer.setFormat(format);
+
+    // the output is written when the top-level value is complete
+    writer.startArray();
+    writer.writeInteger(1);
+    writer.flush();
+    QVERIFY(!buffer.data().isEmpty());
+    writer.writeInteger(2);
+    writer.endArray();
+    QCOMPARE(buffer.data(), QJsonDocument(QJsonArray{ 1, 2 }).toJson(format));
+    QVERIFY(!writer.hasError());
+
+    // writing to a closed device fails
+    buffer.close();
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): device not open");
+    writer.writeNull();
+    QVERIFY(writer.hasError());
+}
+
+void tst_QJsonStreamWriter::largeDocument()
+{
+    QFETCH_GLOBAL(QJsonDocument::JsonFormat, format);
+
+    // larger than the amount of output that the writer collects
+    QJsonArray array;
+    for (int i = 0; i < 10000; ++i)
+        array.append(QJsonObject{ { u"index"_s, i }, { u"name"_s, QString::number(i) } });
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QJsonStreamWriter writer(&buffer);
+        writer.setFormat(format);
+        writeTokens(writer, array);
+    }
+    QCOMPARE(buffer.data(), QJsonDocument(array).toJson(format));
+
+    // and read it back
+    QJsonStreamReader reader(buffer.data());
+    reader.readNext();
+    QCOMPARE(reader.readValue(), QJsonValue(array));
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
@@ -111,6 +111,7 @@ private slots:
     void userDefinedLiterals();
     void toUpperLower_data();
     void toUpperLower();
+    void caseInsensitiveBlocks();
     void isUpper();
     void isLower();
 
@@ -2450,6 +2451,35 @@ void tst_QByteArray::toUpperLower_data()
                            << QByteArray("HELLO WORLD, THIS IS A STRING")
                            << QByteArray("hello world, this is a string");
     QTest::newRow("nul") << QByteArray("a\0B", 3) << QByteArray("A\0B", 3) << QByteArray("a\0b", 3);
+    QTest::newRow("edges") << QByteArray("@AZ[`az{\xc0\xe0\x7f\x80 0123456789 @AZ[`az{")
+                           << QByteArray("@AZ[`AZ{\xc0\xe0\x7f\x80 0123456789 @AZ[`AZ{")
+                           << QByteArray("@az[`az{\xc0\xe0\x7f\x80 0123456789 @az[`az{");
+}
+
+void tst_QByteArray::caseInsensitiveBlocks()
+{
+    // Compare case-insensitively with the one differing character at every
+    // position of a block and of the tail
+    const char specials[] = { 'A', 'Z', 'a', 'z', '@', '[', '`', '{', '\x7f', '\x80', '\xc0', '\xe0' };
+    const auto sign = [](int value) { return (value > 0) - (value < 0); };
+    const QByteArray text = "aBcDeFgHiJkLmNoPqRsTuVwXyZ-0123456789";
+
+    for (qsizetype size : { 15, 16, 17, 33 }) {
+        const QByteArray base = text.left(size);
+        for (qsizetype pos = 0; pos < size; ++pos) {
+            for (char c : specials) {
+                QByteArray s = base;
+                s[pos] = c;
+                for (char d : specials) {
+                    QByteArray t = base.toUpper();
+                    t[pos] = d;
+                    const int expected = sign(QtMiscUtils::caseCompareAscii(c, d));
+                    QCOMPARE(sign(s.compare(t, Qt::CaseInsensitive)), expected);
+                    QCOMPARE(sign(t.compare(s, Qt::CaseInsensitive)), -expected);
+                }
+            }
+        }
+    }
 }
 
 void tst_QByteArray::toUpperLower()
@@ -10,6 +10,8 @@
 
 #include <cstring>
 
+using namespace Qt::StringLiterals;
+
 class tst_QCollator : public QObject
 {
     Q_OBJECT
@@ -22,6 +24,11 @@ private Q_SLOTS:
     void compare();
 
     void state();
+
+    void sortKeys();
+    void sort_data();
+    void sort();
+    void sortKeyCache();
 };
 
 static bool dpointer_is_null(QCollator &c)
@@ -344,6 +351,106 @@ void tst_QCollator::state()
     QCOMPARE(c.locale(), QLocale(QLocale::NorwegianBokmal));
 }
 
+static QLocale collationTestLocale()
+{
+#if QT_CONFIG(icu) || defined(Q_OS_WIN) || defined(Q_OS_MACOS)
+    return QLocale(QLocale::German, QLocale::Germany);
+#else
+    return QLocale::system().collation();
+#endif
+}
+
+// Enough strings for sortKeys() to split them into several batches
+static QStringList collationTestStrings()
+{
+    const QStringList words = { u"Äpfel"_s, u"apfel"_s, u"Zebra"_s, u"zebra"_s, u"Öl"_s,
+                                u"ol"_s, u"Straße"_s, u"strasse"_s, u"file10"_s, u"file9"_s,
+                                u"élan"_s, u"Elan"_s, u""_s, u"-dash"_s };
+    QStringList strings;
+    for (int i = 0; i < 2000; ++i)
+        strings.append(words.at(i % words.size()) + QString::number(i % 37));
+    return strings;
+}
+
+void tst_QCollator::sortKeys()
+{
+    QCollator collator(collationTestLocale());
+    const QStringList strings = collationTestStrings();
+
+    const QList<QCollatorSortKey> keys = collator.sortKeys(strings);
+    QCOMPARE(keys.size(), strings.size());
+    for (qsizetype i = 0; i < strings.size(); ++i)
+        QCOMPARE(keys.at(i).compare(collator.sortKey(strings.at(i))), 0);
+
+    QVERIFY(collator.sortKeys({}).isEmpty());
+}
+
+void tst_QCollator::sort_data()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<Qt::CaseSensitivity>("caseSensitivity");
+    QTest::addColumn<bool>("numericMode");
+
+    QTest::newRow("C") << QLocale::c() << Qt::CaseSensitive << false;
+    QTest::newRow("C, case-insensitive") << QLocale::c() << Qt::CaseInsensitive << false;
+    QTest::newRow("collation locale") << collationTestLocale() << Qt::CaseSensitive << false;
+#if QT_CONFIG(icu)
+    QTest::newRow("case-insensitive") << collationTestLocale() << Qt::CaseInsensitive << false;
+    QTest::newRow("numeric") << collationTestLocale() << Qt::CaseSensitive << true;
+#endif
+}
+
+void tst_QCollator::sort()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(Qt::CaseSensitivity, caseSensitivity);
+    QFETCH(bool, numericMode);
+
+    QCollator collator(locale);
+    collator.setCaseSensitivity(caseSensitivity);
+    collator.setNumericMode(numericMode);
+
+    QStringList expected = collationTestStrings();
+    QStringList sorted = expected;
+    std::stable_sort(expected.begin(), expected.end(), collator);
+    collator.sort(sorted);
+    QCOMPARE(sorted, expected);
+}
+
+void tst_QCollator::sortKeyCache()
+{
+    QCollator collator(collationTestLocale());
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(collator.sortKeyCacheCapacity(), 0);
+
+    // copies keep their own capacity, and the other settings
+    QCollator cached = collator;
+    cached.setSortKeyCacheCapacity(8);
+    QCOMPARE(cached.sortKeyCacheCapacity(), 8);
+    QCOMPARE(collator.sortKeyCacheCapacity(), 0);
+    QCOMPARE(cached.caseSensitivity(), Qt::CaseInsensitive);
+
+    const auto asSign = [](int compared) { return (compared > 0) - (compared < 0); };
+    const QStringList strings = collationTestStrings().mid(0, 40);
+    // more strings than the capacity, compared twice, to exercise eviction
+    for (int round = 0; round < 2; ++round) {
+        for (const QString &s1 : strings) {
+            for (const QString &s2 : strings)
+                QCOMPARE(asSign(cached.compare(s1, s2)), asSign(collator.compare(s1, s2)));
+        }
+    }
+
+    // changing a setting must not reuse the old keys
+    cached.setCaseSensitivity(Qt::CaseSensitive);
+    collator.setCaseSensitivity(Qt::CaseSensitive);
+    QCOMPARE(cached.sortKeyCacheCapacity(), 8);
+    QCOMPARE(asSign(cached.compare(u"zebra"_s, u"Zebra"_s)),
+             asSign(collator.compare(u"zebra"_s, u"Zebra"_s)));
+
+    cached.setSortKeyCacheCapacity(-1);
+    QCOMPARE(cached.sortKeyCacheCapacity(), 0);
+}
+
 QTEST_APPLESS_MAIN(tst_QCollator)
 
 #include "tst_qcollator.moc"
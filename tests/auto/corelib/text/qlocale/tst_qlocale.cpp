@@ -949,6 +949,15 @@ void tst_QLocale::stringToDouble_data()
     QTest::newRow("C tiny") << QString("C") << QString("2e-324") << false << 0.;
     QTest::newRow("C -tiny") << QString("C") << QString("-2e-324") << false << 0.;
 
+    // Plain ASCII numbers skip the tokenizer, where the locale allows:
+    QTest::newRow("C two dots") << u"C"_s << u"1.5.5"_s << false << 0.;
+    QTest::newRow("C dot in exponent") << u"C"_s << u"1e5.5"_s << false << 0.;
+    QTest::newRow("C two exponents") << u"C"_s << u"1e5e5"_s << false << 0.;
+    QTest::newRow("en signs and E") << u"en_US"_s << u"+1.5E+3"_s << true << 1500.;
+    QTest::newRow("en grouped") << u"en_US"_s << u"1,500.5"_s << true << 1500.5;
+    QTest::newRow("de dot is grouping") << u"de_DE"_s << u"1.5"_s << false << 0.;
+    QTest::newRow("de grouped") << u"de_DE"_s << u"1.500,5"_s << true << 1500.5;
+
     // Test a tiny fraction (well beyond denomal) with a huge exponent:
     const QString zeros(500, '0');
     QTest::newRow("C tiny fraction, huge exponent")
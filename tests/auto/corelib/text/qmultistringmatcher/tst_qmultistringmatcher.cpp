@@ -0,0 +1,214 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/QMultiStringMatcher>
+#include <QtCore/QStringMatcher>
+
+#include <algorithm>
+
+using namespace Qt::StringLiterals;
+
+using Match = QMultiStringMatcher::Match;
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructed();
+    void matches_data();
+    void matches();
+    void utf8();
+    void caseInsensitive();
+    void setters();
+    void copies();
+    void compareWithStringMatcher_data();
+    void compareWithStringMatcher();
+};
+
+void tst_QMultiStringMatcher::defaultConstructed()
+{
+    QMultiStringMatcher matcher;
+    QVERIFY(matcher.patterns().isEmpty());
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(matcher.matches(u"anything"_s).isEmpty());
+    QVERIFY(matcher.matches("anything"_ba).isEmpty());
+    QVERIFY(matcher.matches(QStringView()).isEmpty());
+}
+
+void tst_QMultiStringMatcher::matches_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QList<Match>>("expected");
+
+    QTest::newRow("empty-haystack") << QStringList{ u"a"_s } << QString() << QList<Match>{};
+    QTest::newRow("no-match") << QStringList{ u"foo"_s, u"bar"_s } << u"fobaz"_s
+                              << QList<Match>{};
+    QTest::newRow("single") << QStringList{ u"foo"_s } << u"a foo, a foo"_s
+                            << QList<Match>{ { 2, 3, 0 }, { 9, 3, 0 } };
+    QTest::newRow("whole") << QStringList{ u"foo"_s } << u"foo"_s
+                           << QList<Match>{ { 0, 3, 0 } };
+    // the classic example: matches nested in and overlapping others
+    QTest::newRow("ushers") << QStringList{ u"he"_s, u"she"_s, u"his"_s, u"hers"_s }
+                            << u"ushers"_s
+                            << QList<Match>{ { 1, 3, 1 }, { 2, 2, 0 }, { 2, 4, 3 } };
+    QTest::newRow("overlapping") << QStringList{ u"aa"_s } << u"aaaa"_s
+                                 << QList<Match>{ { 0, 2, 0 }, { 1, 2, 0 }, { 2, 2, 0 } };
+    QTest::newRow("suffixes") << QStringList{ u"c"_s, u"abc"_s, u"bc"_s } << u"xabc"_s
+                              << QList<Match>{ { 1, 3, 1 }, { 2, 2, 2 }, { 3, 1, 0 } };
+    QTest::newRow("duplicates") << QStringList{ u"ab"_s, u"x"_s, u"ab"_s } << u"ab"_s
+                                << QList<Match>{ { 0, 2, 0 }, { 0, 2, 2 } };
+    QTest::newRow("empty-patterns") << QStringList{ QString(), u"b"_s, QString() } << u"abc"_s
+                                    << QList<Match>{ { 1, 1, 1 } };
+    QTest::newRow("non-ascii") << QStringList{ u"é"_s, u"€uro"_s } << u"café: 5 €uro"_s
+                               << QList<Match>{ { 3, 1, 0 }, { 8, 4, 1 } };
+    QTest::newRow("surrogates") << QStringList{ u"\U0001F600"_s, u"x\U0001F601"_s }
+                                << u"a\U0001F600x\U0001F601\U0001F600"_s
+                                << QList<Match>{ { 1, 2, 0 }, { 3, 3, 1 }, { 6, 2, 0 } };
+    QTest::newRow("nul") << QStringList{ QString(u"a\0b", 3) } << QString(u"a\0ba\0b", 6)
+                         << QList<Match>{ { 0, 3, 0 }, { 3, 3, 0 } };
+}
+
+void tst_QMultiStringMatcher::matches()
+{
+    QFETCH(const QStringList, patterns);
+    QFETCH(const QString, haystack);
+    QFETCH(const QList<Match>, expected);
+
+    const QMultiStringMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.matches(haystack), expected);
+    QCOMPARE(matcher.matches(QStringView(haystack)), expected);
+
+    // the UTF-8 matches are the same, in bytes
+    const QByteArray utf8 = haystack.toUtf8();
+    QList<Match> expectedUtf8;
+    for (const Match &match : expected) {
+        const qsizetype position = haystack.first(match.position).toUtf8().size();
+        const qsizetype length = haystack.sliced(match.position, match.length).toUtf8().size();
+        expectedUtf8.append({ position, length, match.patternIndex });
+    }
+    QCOMPARE(matcher.matches(utf8), expectedUtf8);
+}
+
+void tst_QMultiStringMatcher::utf8()
+{
+    const QMultiStringMatcher matcher({ u"Größe"_s, u"e"_s });
+    const QByteArray haystack = "Die Größe"_ba;
+    QCOMPARE(matcher.matches(haystack),
+             (QList<Match>{ { 2, 1, 1 }, { 4, 7, 0 }, { 10, 1, 1 } }));
+
+    // lone surrogates never match a pattern, but are replaced
+    const QMultiStringMatcher replacement({ u"�"_s });
+    const QString loneSurrogates = QString(u"\xD800a\xDC00"_s);
+    QCOMPARE(replacement.matches(loneSurrogates),
+             (QList<Match>{ { 0, 1, 0 }, { 2, 1, 0 } }));
+}
+
+void tst_QMultiStringMatcher::caseInsensitive()
+{
+    const QMultiStringMatcher matcher({ u"Error"_s, u"ÉCHEC"_s }, Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.matches(u"ERROR: échec, error"_s),
+             (QList<Match>{ { 0, 5, 0 }, { 7, 5, 1 }, { 14, 5, 0 } }));
+
+    // only ASCII letters are folded in UTF-8 text
+    QCOMPARE(matcher.matches("ERROR: échec, ÉCHEC"_ba),
+             (QList<Match>{ { 0, 5, 0 }, { 7, 6, 1 } }));
+
+    const QMultiStringMatcher sensitive({ u"Error"_s, u"ÉCHEC"_s });
+    QCOMPARE(sensitive.matches(u"ERROR: échec, Error"_s),
+             (QList<Match>{ { 14, 5, 0 } }));
+}
+
+void tst_QMultiStringMatcher::setters()
+{
+    QMultiStringMatcher matcher;
+    matcher.setPatterns({ u"ab"_s, u"b"_s });
+    QCOMPARE(matcher.patterns(), (QStringList{ u"ab"_s, u"b"_s }));
+    QCOMPARE(matcher.matches(u"AB ab"_s), (QList<Match>{ { 3, 2, 0 }, { 4, 1, 1 } }));
+
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.patterns(), (QStringList{ u"ab"_s, u"b"_s }));
+    QCOMPARE(matcher.matches(u"AB ab"_s),
+             (QList<Match>{ { 0, 2, 0 }, { 1, 1, 1 }, { 3, 2, 0 }, { 4, 1, 1 } }));
+
+    matcher.setPatterns({ u"x"_s });
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.matches(u"AB ab X"_s), (QList<Match>{ { 6, 1, 0 } }));
+}
+
+void tst_QMultiStringMatcher::copies()
+{
+    QMultiStringMatcher matcher({ u"a"_s });
+    QMultiStringMatcher copy = matcher;
+    matcher.setPatterns({ u"b"_s });
+    QCOMPARE(copy.matches(u"ab"_s), (QList<Match>{ { 0, 1, 0 } }));
+    QCOMPARE(matcher.matches(u"ab"_s), (QList<Match>{ { 1, 1, 0 } }));
+
+    QMultiStringMatcher moved = std::move(copy);
+    QCOMPARE(moved.matches(u"ab"_s), (QList<Match>{ { 0, 1, 0 } }));
+    moved.swap(matcher);
+    QCOMPARE(moved.matches(u"ab"_s), (QList<Match>{ { 1, 1, 0 } }));
+    QCOMPARE(matcher.matches(u"ab"_s), (QList<Match>{ { 0, 1, 0 } }));
+}
+
+void tst_QMultiStringMatcher::compareWithStringMatcher_data()
+{
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    QTest::newRow("case-sensitive") << Qt::CaseSensitive;
+    QTest::newRow("case-insensitive") << Qt::CaseInsensitive;
+}
+
+void tst_QMultiStringMatcher::compareWithStringMatcher()
+{
+    QFETCH(const Qt::CaseSensitivity, cs);
+
+    // a small alphabet, so that there are many overlapping matches
+    const QString alphabet = u"abABéÉ"_s;
+    quint32 seed = 1;
+    const auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return int((seed >> 16) % bound);
+    };
+    const auto randomString = [&](int maxLength) {
+        QString result;
+        for (int i = next(maxLength + 1); i; --i)
+            result += alphabet.at(next(alphabet.size()));
+        return result;
+    };
+
+    for (int round = 0; round < 200; ++round) {
+        QStringList patterns;
+        for (int i = next(10) + 1; i; --i)
+            patterns.append(randomString(4));
+        const QString haystack = randomString(60);
+
+        QList<Match> expected;
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            if (patterns.at(i).isEmpty())
+                continue;
+            const QStringMatcher single(patterns.at(i), cs);
+            for (qsizetype from = 0; (from = single.indexIn(haystack, from)) >= 0; ++from)
+                expected.append({ from, patterns.at(i).size(), i });
+        }
+        // sort as the multi-matcher does
+        std::stable_sort(expected.begin(), expected.end(), [](const Match &lhs, const Match &rhs) {
+            const qsizetype lhsEnd = lhs.position + lhs.length;
+            const qsizetype rhsEnd = rhs.position + rhs.length;
+            return lhsEnd < rhsEnd || (lhsEnd == rhsEnd && lhs.length > rhs.length);
+        });
+
+        const QMultiStringMatcher matcher(patterns, cs);
+        QCOMPARE(matcher.matches(haystack), expected);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_qmultistringmatcher.moc"
@@ -10,8 +10,11 @@
 
 #include <qobject.h>
 #include <qregularexpression.h>
+#include <qscopeguard.h>
 #include <qthread.h>
 
+#include <private/qregularexpression_p.h>
+
 #include <iostream>
 #include <optional>
 
@@ -63,6 +66,8 @@ private slots:
     void QStringAndQStringViewEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void compiledPatternCache();
+    void compiledPatternCacheThreadSafety();
 
     void returnsViewsIntoOriginalString();
     void wildcard_data();
@@ -2414,6 +2419,92 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::compiledPatternCache()
+{
+    // patterns that no other test uses, so that they are not cached yet
+    const QString pattern = QStringLiteral("compiledPatternCache-(\\d+)");
+    const QString invalidPattern = QStringLiteral("compiledPatternCache-(");
+    const QRegularExpressionCacheStatistics initial = QtPrivate::regularExpressionCacheStatistics();
+    QVERIFY(initial.maxCost > 0);
+
+    QRegularExpression re(pattern);
+    QVERIFY(re.isValid());
+    QRegularExpressionCacheStatistics statistics = QtPrivate::regularExpressionCacheStatistics();
+    QCOMPARE(statistics.misses, initial.misses + 1);
+    QCOMPARE(statistics.hits, initial.hits);
+    QCOMPARE(statistics.count, initial.count + 1);
+    QVERIFY(statistics.totalCost > initial.totalCost);
+
+    // the same pattern is compiled only once, even after changes
+    QRegularExpression same(pattern);
+    QCOMPARE(same.match(QStringLiteral("compiledPatternCache-42")).captured(1), QStringLiteral("42"));
+    QRegularExpression changed(QStringLiteral("something else"));
+    changed.setPattern(pattern);
+    QCOMPARE(changed.captureCount(), 1);
+    statistics = QtPrivate::regularExpressionCacheStatistics();
+    QCOMPARE(statistics.misses, initial.misses + 1);
+    QCOMPARE(statistics.hits, initial.hits + 2);
+
+    // but different options make a different pattern
+    QRegularExpression caseInsensitive(pattern, QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(caseInsensitive.match(QStringLiteral("COMPILEDPATTERNCACHE-1")).hasMatch());
+    statistics = QtPrivate::regularExpressionCacheStatistics();
+    QCOMPARE(statistics.misses, initial.misses + 2);
+
+    // invalid patterns are cached with their error
+    QRegularExpression invalid(invalidPattern);
+    QVERIFY(!invalid.isValid());
+    QRegularExpression invalidAgain(invalidPattern);
+    QVERIFY(!invalidAgain.isValid());
+    QCOMPARE(invalidAgain.errorString(), invalid.errorString());
+    QCOMPARE(invalidAgain.patternErrorOffset(), invalid.patternErrorOffset());
+    statistics = QtPrivate::regularExpressionCacheStatistics();
+    QCOMPARE(statistics.misses, initial.misses + 3);
+    QCOMPARE(statistics.hits, initial.hits + 3);
+
+    // evicting the patterns doesn't affect the objects using them
+    QtPrivate::setRegularExpressionCacheMaxCost(0);
+    auto restoreMaxCost = qScopeGuard([&] {
+        QtPrivate::setRegularExpressionCacheMaxCost(initial.maxCost);
+    });
+    statistics = QtPrivate::regularExpressionCacheStatistics();
+    QCOMPARE(statistics.count, 0);
+    QCOMPARE(statistics.totalCost, 0);
+    QCOMPARE(re.match(QStringLiteral("compiledPatternCache-7")).captured(1), QStringLiteral("7"));
+    QRegularExpression uncached(pattern);
+    QVERIFY(uncached.isValid());
+    statistics = QtPrivate::regularExpressionCacheStatistics();
+    QCOMPARE(statistics.misses, initial.misses + 4);
+    QCOMPARE(statistics.count, 0);
+}
+
+void tst_QRegularExpression::compiledPatternCacheThreadSafety()
+{
+    // all the threads construct the same expressions, and match concurrently
+    // with the same compiled code
+    const int threadCount = qMax(QThread::idealThreadCount(), 4);
+    QAtomicInt failures;
+    QList<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.append(QThread::create([&failures, i] {
+            for (int j = 0; j < 200; ++j) {
+                const QRegularExpression re(QStringLiteral("thread-(\\d+)-(\\w+)-%1").arg(j % 10));
+                const QString subject = QStringLiteral("thread-%1-x%2-%3").arg(i).arg(j).arg(j % 10);
+                const QRegularExpressionMatch match = re.match(subject);
+                if (match.captured(1) != QString::number(i)
+                        || match.captured(2) != QStringLiteral("x%1").arg(j)) {
+                    failures.ref();
+                }
+            }
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : std::as_const(threads))
+        QVERIFY(thread->wait());
+    qDeleteAll(threads);
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
 void tst_QRegularExpression::returnsViewsIntoOriginalString()
 {
     // https://bugreports.qt.io/browse/QTBUG-98653
@@ -544,6 +544,7 @@ private slots:
     void isLower_isUpper_data();
     void isLower_isUpper();
     void toCaseFolded();
+    void caseInsensitiveBlocks();
     void rightJustified();
     void leftJustified();
     void mid();
@@ -2800,6 +2801,76 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::caseInsensitiveBlocks()
+{
+    // The conversions and comparisons handle long Latin-1 runs in blocks;
+    // put characters at the edges of the fast paths at every position of a
+    // block and of the tail, and compare with converting one character at a
+    // time.
+    const char16_t specials[] = { u'A', u'Z', u'a', u'z', u'@', u'[', u'`', u'{', 0x7f, 0x80,
+                                  0xb5, 0xc0, 0xd7, 0xde, 0xdf, 0xe0, 0xf7, 0xff, 0x100,
+                                  0x130, 0x3bc };
+    const auto sign = [](int value) { return (value > 0) - (value < 0); };
+    const auto latin1Lower = [](char16_t c) -> char16_t {
+        if ((c >= u'A' && c <= u'Z') || (c >= 0xc0 && c <= 0xde && c != 0xd7))
+            return c + 0x20;
+        return c;
+    };
+    const QString text = u"aBcDeFgHiJkLmNoPqRsTuVwXyZ-0123456789"_s;
+
+    for (qsizetype size : { 7, 8, 9, 15, 16, 17, 33 }) {
+        const QString base = text.left(size);
+        for (qsizetype pos = 0; pos < size; ++pos) {
+            for (char16_t c : specials) {
+                QString s = base;
+                s[pos] = c;
+                QString lower, upper, folded;
+                for (QChar ch : std::as_const(s)) {
+                    lower += QString(ch).toLower();
+                    upper += QString(ch).toUpper();
+                    folded += QString(ch).toCaseFolded();
+                }
+                QCOMPARE(s.toLower(), lower);
+                QCOMPARE(s.toUpper(), upper);
+                QCOMPARE(s.toCaseFolded(), folded);
+                QString copy = s;
+                copy.detach();
+                QCOMPARE(std::move(copy).toLower(), lower); // in place
+
+                for (char16_t d : specials) {
+                    QString t = base.toUpper();
+                    t[pos] = d;
+                    const int expected = sign(int(QChar::toCaseFolded(char32_t(c)))
+                                              - int(QChar::toCaseFolded(char32_t(d))));
+                    QCOMPARE(sign(s.compare(t, Qt::CaseInsensitive)), expected);
+                    QCOMPARE(sign(t.compare(s, Qt::CaseInsensitive)), -expected);
+                    if (d > 0xff)
+                        continue;
+                    const QByteArray tLatin1 = t.toLatin1();
+                    QCOMPARE(sign(s.compare(QLatin1StringView(tLatin1), Qt::CaseInsensitive)),
+                             expected);
+                    if (c > 0xff)
+                        continue;
+                    const QByteArray sLatin1 = s.toLatin1();
+                    QCOMPARE(sign(QLatin1StringView(sLatin1).compare(QLatin1StringView(tLatin1),
+                                                                     Qt::CaseInsensitive)),
+                             sign(latin1Lower(c) - latin1Lower(d)));
+                }
+            }
+        }
+    }
+
+    // a surrogate pair straddling two blocks
+    QString upper = text.left(7) + QChar(QChar::highSurrogate(0x10400))
+            + QChar(QChar::lowSurrogate(0x10400)) + text.left(9);
+    QString lower = upper;
+    lower[7] = QChar::highSurrogate(0x10428);
+    lower[8] = QChar::lowSurrogate(0x10428);
+    QCOMPARE(upper.compare(lower, Qt::CaseInsensitive), 0);
+    QCOMPARE(upper.toLower(), lower.toLower());
+    QCOMPARE(lower.toUpper(), upper.toUpper());
+}
+
 void tst_QString::trimmed()
 {
     QString a;
@@ -60,6 +60,8 @@ private slots:
     void countingTest();
     void limitedReaders();
     void deleteOnUnlock();
+    void preference_data();
+    void preference();
 
 /*
     Performance tests
@@ -852,6 +854,65 @@ void tst_QReadWriteLock::deleteOnUnlock()
     }
 }
 
+void tst_QReadWriteLock::preference_data()
+{
+    QTest::addColumn<bool>("recursive");
+    QTest::addColumn<bool>("preferReaders");
+
+    QTest::newRow("PreferWriters") << false << false;
+    QTest::newRow("PreferReaders") << false << true;
+    QTest::newRow("recursive, PreferWriters") << true << false;
+    QTest::newRow("recursive, PreferReaders") << true << true;
+}
+
+/*
+    A reader holds the lock and a writer waits for it. A new reader only
+    gets the lock if the lock prefers readers.
+*/
+void tst_QReadWriteLock::preference()
+{
+    QFETCH(bool, recursive);
+    QFETCH(bool, preferReaders);
+    QReadWriteLock lock(recursive ? QReadWriteLock::Recursive : QReadWriteLock::NonRecursive,
+                        preferReaders ? QReadWriteLock::PreferReaders
+                                      : QReadWriteLock::PreferWriters);
+
+    // from another thread, as the lock may be recursive
+    auto tryLockForRead = [&lock] {
+        bool locked = false;
+        std::unique_ptr<QThread> reader(QThread::create([&] {
+            locked = lock.tryLockForRead();
+            if (locked)
+                lock.unlock();
+        }));
+        reader->start();
+        reader->wait();
+        return locked;
+    };
+
+    lock.lockForRead();
+    QVERIFY(tryLockForRead());
+
+    QAtomicInt writerDone;
+    std::unique_ptr<QThread> writer(QThread::create([&] {
+        lock.lockForWrite();
+        writerDone.storeRelaxed(1);
+        lock.unlock();
+    }));
+    writer->start();
+    if (preferReaders) {
+        QThread::sleep(200ms);
+        QVERIFY(tryLockForRead());
+    } else {
+        QTRY_VERIFY(!tryLockForRead());
+    }
+    QVERIFY(!writerDone.loadRelaxed());
+
+    lock.unlock();
+    QVERIFY(writer->wait());
+    QVERIFY(writerDone.loadRelaxed());
+    QVERIFY(tryLockForRead());
+}
 
 void tst_QReadWriteLock::uncontendedLocks()
 {
@@ -11,12 +11,23 @@
 #include <qstring.h>
 #include <qmutex.h>
 
+#include <memory>
+#include <vector>
+
 #ifdef Q_OS_UNIX
 #include <unistd.h>
 #endif
 
 using namespace std::chrono_literals;
 
+#ifdef USE_WORK_STEALING
+#  define tst_QThreadPool tst_QThreadPool_WorkStealing
+static bool workStealingEnabled = []() {
+    qputenv("QT_THREADPOOL_WORK_STEALING", "1");
+    return true;
+}();
+#endif
+
 typedef void (*FunctionPointer)();
 
 class FunctionPointerTask : public QRunnable
@@ -87,6 +98,10 @@ private slots:
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
     void threadReuse();
+    void startFromWorkers();
+    void startOrder();
+    void priorityStartFromWorker();
+    void tryTakeAndClearFromWorker();
     void nullFunctions();
 
 private:
@@ -1466,6 +1481,138 @@ void tst_QThreadPool::threadReuse()
     }
 }
 
+/*
+    Tasks started from the pool's own threads, which in work-stealing mode
+    end up in the workers' own queues.
+*/
+void tst_QThreadPool::startFromWorkers()
+{
+    TestThreadPool manager;
+    manager.setMaxThreadCount(4);
+
+    constexpr int fanOut = 8;
+    constexpr int depth = 4;
+    QAtomicInt ran = 0;
+
+    std::function<void(int)> spawn = [&](int level) {
+        ran.ref();
+        if (level == depth)
+            return;
+        for (int i = 0; i < fanOut; ++i)
+            manager.start([&spawn, level] { spawn(level + 1); });
+    };
+    manager.start([&spawn] { spawn(0); });
+
+    QVERIFY(manager.waitForDone(30000));
+    // 1 + 8 + 8^2 + 8^3 + 8^4
+    QCOMPARE(ran.loadRelaxed(), (fanOut * fanOut * fanOut * fanOut * fanOut - 1) / (fanOut - 1));
+}
+
+/*
+    Tasks of the same priority run in the order they were started, whether
+    they were started from another thread or from the pool's own.
+*/
+void tst_QThreadPool::startOrder()
+{
+    TestThreadPool manager;
+    manager.setMaxThreadCount(1);
+
+    constexpr int count = 200;
+    QMutex mutex;
+    QList<int> order;
+    const auto record = [&](int label) {
+        return [&, label] {
+            QMutexLocker locker(&mutex);
+            order << label;
+        };
+    };
+    QList<int> expected;
+    for (int i = 0; i < 2 * count; ++i)
+        expected << i;
+
+    QSemaphore proceed;
+    manager.start([&] { proceed.acquire(); });
+    // the only thread is busy, so these get queued
+    for (int i = 0; i < count; ++i)
+        manager.start(record(i));
+    proceed.release();
+    QVERIFY(manager.waitForDone(30000));
+
+    manager.start([&] {
+        for (int i = count; i < 2 * count; ++i)
+            manager.start(record(i));
+    });
+    QVERIFY(manager.waitForDone(30000));
+    QCOMPARE(order, expected);
+}
+
+void tst_QThreadPool::priorityStartFromWorker()
+{
+    TestThreadPool manager;
+    manager.setMaxThreadCount(1);
+
+    QMutex mutex;
+    QList<char> order;
+    const auto record = [&](char label) {
+        return [&, label] {
+            QMutexLocker locker(&mutex);
+            order << label;
+        };
+    };
+
+    manager.start([&] {
+        // the only thread is busy running this, so these get queued
+        manager.start(record('a'));
+        manager.start(record('b'));
+        manager.start(record('c'), 1);
+        manager.start(record('d'), -1);
+        manager.start(record('e'), 2);
+        manager.start(record('f'));
+        manager.start(record('g'), 1);
+    });
+
+    QVERIFY(manager.waitForDone(30000));
+    QCOMPARE(order, QList<char>({ 'e', 'c', 'g', 'a', 'b', 'f', 'd' }));
+}
+
+void tst_QThreadPool::tryTakeAndClearFromWorker()
+{
+    class CountingRunnable : public QRunnable
+    {
+    public:
+        QAtomicInt &ran;
+        explicit CountingRunnable(QAtomicInt &ran) : ran(ran) { setAutoDelete(false); }
+        void run() override { ran.ref(); }
+    };
+
+    TestThreadPool manager;
+    manager.setMaxThreadCount(1);
+
+    QAtomicInt ran = 0;
+    std::vector<std::unique_ptr<CountingRunnable>> runnables;
+    for (int i = 0; i < 10; ++i)
+        runnables.push_back(std::make_unique<CountingRunnable>(ran));
+
+    QSemaphore queued;
+    QSemaphore proceed;
+    manager.start([&] {
+        for (const auto &runnable : runnables)
+            manager.start(runnable.get());
+        queued.release();
+        proceed.acquire();
+    });
+
+    QVERIFY(queued.tryAcquire(1, 10000));
+    QVERIFY(manager.tryTake(runnables.front().get()));
+    QVERIFY(!manager.tryTake(runnables.front().get()));
+    QVERIFY(manager.tryTake(runnables.back().get()));
+    manager.clear();
+    proceed.release();
+
+    QVERIFY(manager.waitForDone(30000));
+    QCOMPARE(ran.loadRelaxed(), 0);
+}
+
 void tst_QThreadPool::nullFunctions()
 {
     const auto expectWarning = [] {
@@ -0,0 +1,283 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QArenaAllocator>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class tst_QArenaAllocator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void allocate();
+    void alignment();
+    void largeAllocation();
+    void reset();
+    void list();
+    void listGrows();
+    void listCopy();
+    void string();
+    void byteArray();
+    void hash();
+    void hashCopy();
+    void hashClear();
+};
+
+void tst_QArenaAllocator::allocate()
+{
+    QArenaAllocator arena;
+    QCOMPARE(arena.bytesAllocated(), 0);
+
+    void *first = arena.allocate(10, 1);
+    void *second = arena.allocate(10, 1);
+    QVERIFY(first);
+    QCOMPARE(static_cast<char *>(second), static_cast<char *>(first) + 10);
+    QCOMPARE(arena.bytesAllocated(), 20);
+}
+
+void tst_QArenaAllocator::alignment()
+{
+    QArenaAllocator arena;
+    (void)arena.allocate(1, 1);
+    for (qsizetype alignment : { 2, 8, 16, 64, 4096 }) {
+        void *p = arena.allocate(3, alignment);
+        QVERIFY(p);
+        QCOMPARE(quintptr(p) % alignment, 0u);
+    }
+}
+
+void tst_QArenaAllocator::largeAllocation()
+{
+    QArenaAllocator arena;
+    void *small = arena.allocate(16);
+    const qsizetype largeSize = 4 * arena.blockSize();
+    char *large = static_cast<char *>(arena.allocate(largeSize));
+    QVERIFY(large);
+    memset(large, 0xff, largeSize);
+
+    // the current block is still used for small allocations
+    void *next = arena.allocate(16);
+    QCOMPARE(static_cast<char *>(next), static_cast<char *>(small) + 16);
+}
+
+void tst_QArenaAllocator::reset()
+{
+    QArenaAllocator arena(4096);
+    for (int i = 0; i < 101; ++i)
+        QVERIFY(arena.allocate(100));
+    QVERIFY(arena.bytesAllocated() >= 101 * 100);
+
+    arena.reset();
+    QCOMPARE(arena.bytesAllocated(), 0);
+    // one block is kept, but not necessarily the first one
+    QVERIFY(arena.allocate(100));
+
+    QArenaAllocator single;
+    void *first = single.allocate(100);
+    single.reset();
+    QCOMPARE(single.allocate(100), first);
+}
+
+void tst_QArenaAllocator::list()
+{
+    QArenaAllocator arena;
+    {
+        char *begin = static_cast<char *>(arena.allocate(0, 1));
+        QList<int> list = arena.list<int>(100);
+        char *end = static_cast<char *>(arena.allocate(0, 1));
+        QVERIFY(list.capacity() >= 100);
+        QVERIFY(list.isEmpty());
+
+        for (int i = 0; i < 100; ++i)
+            list.append(i);
+        const char *data = reinterpret_cast<const char *>(list.constData());
+        QVERIFY(data > begin && data < end);
+        QCOMPARE(list.size(), 100);
+        QCOMPARE(list.last(), 99);
+    }
+    arena.reset();
+}
+
+void tst_QArenaAllocator::listGrows()
+{
+    QArenaAllocator arena;
+    {
+        QList<QString> list = arena.list<QString>(1);
+        const qsizetype before = arena.bytesAllocated();
+        for (int i = 0; i < 1000; ++i)
+            list.append(QString::number(i));
+        QVERIFY(arena.bytesAllocated() > before);
+
+        list.prepend(QStringLiteral("first"));
+        list.removeLast();
+        const qsizetype beforeReserve = arena.bytesAllocated();
+        list.reserve(5000);
+        QVERIFY(arena.bytesAllocated() >= beforeReserve + 5000 * qsizetype(sizeof(QString)));
+        QCOMPARE(list.size(), 1000);
+        QCOMPARE(list.first(), QStringLiteral("first"));
+        QCOMPARE(list.last(), QStringLiteral("998"));
+    }
+    arena.reset();
+}
+
+void tst_QArenaAllocator::listCopy()
+{
+    QArenaAllocator arena;
+    QList<QString> copy;
+    QList<QString> assigned;
+    {
+        QList<QString> list = arena.list<QString>(10);
+        list << QStringLiteral("a") << QStringLiteral("b") << QStringLiteral("c");
+        const qsizetype before = arena.bytesAllocated();
+        copy = list;
+        QList<QString> constructed(list);
+        assigned = constructed;
+
+        // memory of the arena is not shared
+        QVERIFY(!copy.isSharedWith(list));
+        QVERIFY(!constructed.isSharedWith(list));
+        QCOMPARE(arena.bytesAllocated(), before);
+        QCOMPARE(copy, list);
+
+        list[0] = QStringLiteral("changed");
+        QCOMPARE(copy.first(), QStringLiteral("a"));
+    }
+    arena.reset();
+
+    // overwrite the memory the list used
+    QList<QString> other = arena.list<QString>(10);
+    other << QStringLiteral("x") << QStringLiteral("y") << QStringLiteral("z");
+    QCOMPARE(copy, QList<QString>({ QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c") }));
+    QCOMPARE(assigned, copy);
+}
+
+void tst_QArenaAllocator::string()
+{
+    QArenaAllocator arena;
+    QString copy;
+    {
+        QString str = arena.string(4);
+        QVERIFY(str.isEmpty());
+        QVERIFY(!str.isNull());
+        QCOMPARE(str.data_ptr().arena(), &arena);
+
+        for (int i = 0; i < 100; ++i)
+            str += QString::number(i);
+        QCOMPARE(str.data_ptr().arena(), &arena);
+        QCOMPARE(str.utf16()[str.size()], u'\0');
+
+        copy = str;
+        QCOMPARE(copy.data_ptr().arena(), nullptr);
+        QCOMPARE(copy.utf16()[copy.size()], u'\0');
+        QCOMPARE(copy, str);
+    }
+    arena.reset();
+    (void)arena.string(1000).fill(u'x', 1000);
+    QVERIFY(copy.startsWith(QStringLiteral("012345678910")));
+}
+
+void tst_QArenaAllocator::byteArray()
+{
+    QArenaAllocator arena;
+    QByteArray copy;
+    {
+        QByteArray bytes = arena.byteArray();
+        QCOMPARE(bytes.data_ptr().arena(), &arena);
+        bytes.append("hello");
+        bytes.resize(1000, '!');
+        QCOMPARE(bytes.data_ptr().arena(), &arena);
+        QCOMPARE(bytes.constData()[bytes.size()], '\0');
+
+        copy = bytes;
+        QCOMPARE(copy.data_ptr().arena(), nullptr);
+        QCOMPARE(copy.constData()[copy.size()], '\0');
+    }
+    arena.reset();
+    QCOMPARE(copy.size(), 1000);
+    QVERIFY(copy.startsWith("hello!!!"));
+}
+
+void tst_QArenaAllocator::hash()
+{
+    QArenaAllocator arena;
+    {
+        const qsizetype before = arena.bytesAllocated();
+        QHash<QString, int> hash = arena.hash<QString, int>(10);
+        QVERIFY(arena.bytesAllocated() > before);
+        QVERIFY(hash.capacity() >= 10);
+
+        for (int i = 0; i < 1000; ++i)
+            hash.insert(QString::number(i), i);
+        QCOMPARE(hash.size(), 1000);
+        for (int i = 0; i < 1000; i += 2)
+            QVERIFY(hash.remove(QString::number(i)));
+        QCOMPARE(hash.size(), 500);
+        QCOMPARE(hash.value(QStringLiteral("1")), 1);
+        QVERIFY(!hash.contains(QStringLiteral("0")));
+
+        // growing allocates from the arena
+        const qsizetype beforeRehash = arena.bytesAllocated();
+        hash.reserve(5000);
+        QVERIFY(arena.bytesAllocated() > beforeRehash);
+        QCOMPARE(hash.value(QStringLiteral("999")), 999);
+    }
+    arena.reset();
+}
+
+void tst_QArenaAllocator::hashCopy()
+{
+    QArenaAllocator arena;
+    QHash<int, QString> copy;
+    {
+        QHash<int, QString> hash = arena.hash<int, QString>();
+        for (int i = 0; i < 100; ++i)
+            hash.insert(i, QString::number(i));
+
+        const qsizetype before = arena.bytesAllocated();
+        copy = hash;
+        QHash<int, QString> constructed(hash);
+        QCOMPARE(arena.bytesAllocated(), before);
+        QVERIFY(!copy.isSharedWith(hash));
+        QVERIFY(!constructed.isSharedWith(hash));
+        QCOMPARE(copy, hash);
+
+        hash[0] = QStringLiteral("changed");
+        QCOMPARE(copy.value(0), QStringLiteral("0"));
+        QCOMPARE(constructed.value(0), QStringLiteral("0"));
+
+        QHash<int, QString> moved = std::move(hash);
+        QCOMPARE(moved.size(), 100);
+    }
+    arena.reset();
+    QHash<int, QString> other = arena.hash<int, QString>();
+    for (int i = 0; i < 100; ++i)
+        other.insert(i, QStringLiteral("other"));
+    QCOMPARE(copy.size(), 100);
+    QCOMPARE(copy.value(42), QStringLiteral("42"));
+}
+
+void tst_QArenaAllocator::hashClear()
+{
+    QArenaAllocator arena;
+    {
+        QHash<int, int> hash = arena.hash<int, int>();
+        hash.insert(1, 1);
+        hash.clear();
+        QVERIFY(hash.isEmpty());
+
+        // a cleared hash uses the heap
+        const qsizetype before = arena.bytesAllocated();
+        for (int i = 0; i < 100; ++i)
+            hash.insert(i, i);
+        QCOMPARE(arena.bytesAllocated(), before);
+        QCOMPARE(hash.size(), 100);
+    }
+    arena.reset();
+}
+
+QTEST_APPLESS_MAIN(tst_QArenaAllocator)
+#include "tst_qarenaallocator.moc"
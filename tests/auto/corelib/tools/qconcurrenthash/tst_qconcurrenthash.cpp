@@ -0,0 +1,182 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QConcurrentHash>
+#include <QAtomicInt>
+#include <QString>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndLookup();
+    void replace();
+    void remove();
+    void grow();
+    void clear();
+    void reclaim();
+    void concurrentReadWrite();
+};
+
+// counts the live instances, to check that replaced and removed values get freed
+struct Counted
+{
+    static QAtomicInt alive;
+
+    Counted(int value = 0) : value(value) { alive.ref(); }
+    Counted(const Counted &other) : value(other.value) { alive.ref(); }
+    ~Counted() { alive.deref(); }
+    Counted &operator=(const Counted &) = default;
+
+    int value;
+};
+QAtomicInt Counted::alive;
+
+void tst_QConcurrentHash::insertAndLookup()
+{
+    QConcurrentHash<QString, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.value(QStringLiteral("one")), 0);
+    QCOMPARE(hash.value(QStringLiteral("one"), -1), -1);
+
+    hash.insert(QStringLiteral("one"), 1);
+    hash.insert(QStringLiteral("two"), 2);
+    QCOMPARE(hash.size(), 2);
+    QVERIFY(hash.contains(QStringLiteral("one")));
+    QVERIFY(!hash.contains(QStringLiteral("three")));
+    QCOMPARE(hash.value(QStringLiteral("one")), 1);
+    QCOMPARE(hash.value(QStringLiteral("two")), 2);
+}
+
+void tst_QConcurrentHash::replace()
+{
+    QConcurrentHash<int, QString> hash;
+    hash.insert(1, QStringLiteral("a"));
+    hash.insert(1, QStringLiteral("b"));
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hash.value(1), QStringLiteral("b"));
+}
+
+void tst_QConcurrentHash::remove()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+    for (int i = 0; i < 100; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+
+    // removed buckets are reused
+    for (int i = 0; i < 100; i += 2)
+        hash.insert(i, -i);
+    QCOMPARE(hash.size(), 100);
+    QCOMPARE(hash.value(42), -42);
+    QCOMPARE(hash.value(43), 43);
+}
+
+void tst_QConcurrentHash::grow()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 100000; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 100000);
+    for (int i = 0; i < 100000; ++i)
+        QCOMPARE(hash.value(i, -1), i * 2);
+
+    // many removals and insertions of new keys, which fill the tables with
+    // removed buckets
+    for (int i = 0; i < 100000; ++i) {
+        QVERIFY(hash.remove(i));
+        hash.insert(100000 + i, i);
+    }
+    QCOMPARE(hash.size(), 100000);
+    QVERIFY(!hash.contains(0));
+    QCOMPARE(hash.value(199999), 99999);
+}
+
+void tst_QConcurrentHash::clear()
+{
+    QConcurrentHash<int, int> hash(1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(1));
+    hash.insert(1, 2);
+    QCOMPARE(hash.value(1), 2);
+}
+
+void tst_QConcurrentHash::reclaim()
+{
+    const int before = Counted::alive.loadRelaxed();
+    {
+        QConcurrentHash<int, Counted> hash;
+        for (int i = 0; i < 10000; ++i)
+            hash.insert(0, Counted(i));
+        QCOMPARE(hash.value(0).value, 9999);
+
+        // the replaced values don't all wait for the hash to be destroyed
+        QVERIFY(Counted::alive.loadRelaxed() - before < 1000);
+    }
+    QVERIFY(Counted::alive.loadRelaxed() - before < 1000);
+}
+
+void tst_QConcurrentHash::concurrentReadWrite()
+{
+    // Keys are either missing or map to twice their value. Readers check this
+    // while writers keep replacing and removing items, forcing rehashes.
+    enum { KeyCount = 1000, Iterations = 20000 };
+    QConcurrentHash<int, std::shared_ptr<int>> hash;
+    for (int i = 0; i < KeyCount; ++i)
+        hash.insert(i, std::make_shared<int>(2 * i));
+
+    QAtomicInt errors;
+    QAtomicInt stop;
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back(QThread::create([&, t] {
+            int key = t;
+            while (!stop.loadRelaxed()) {
+                key = (key + 7) % KeyCount;
+                const std::shared_ptr<int> value = hash.value(key);
+                if (value && *value != 2 * key)
+                    errors.ref();
+            }
+        }));
+        readers.back()->start();
+    }
+
+    std::vector<std::unique_ptr<QThread>> writers;
+    for (int t = 0; t < 2; ++t) {
+        writers.emplace_back(QThread::create([&, t] {
+            for (int i = 0; i < Iterations; ++i) {
+                const int key = (i * 13 + t) % KeyCount;
+                if (i % 3 == 0)
+                    hash.remove(key);
+                else
+                    hash.insert(key, std::make_shared<int>(2 * key));
+            }
+        }));
+        writers.back()->start();
+    }
+
+    for (auto &writer : writers)
+        QVERIFY(writer->wait());
+    stop.storeRelaxed(1);
+    for (auto &reader : readers)
+        QVERIFY(reader->wait());
+    QCOMPARE(errors.loadRelaxed(), 0);
+    QVERIFY(hash.size() <= KeyCount);
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentHash)
+#include "tst_qconcurrenthash.moc"
@@ -23,6 +23,12 @@ private slots:
     void intermediary_result_data();
     void intermediary_result();
     void sha1();
+    void sha2_data();
+    void sha2();
+    void addDataAtBlockBoundaries_data();
+    void addDataAtBlockBoundaries();
+    void hashMany_data();
+    void hashMany();
     void sha3_data();
     void sha3();
     void blake2_data();
@@ -196,6 +202,115 @@ void tst_QCryptographicHash::sha1()
              QByteArray("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F"));
 }
 
+void tst_QCryptographicHash::sha2_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QByteArray>("expected");
+
+    const QByteArray abc = "abc";
+    const QByteArray twoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const QByteArray millionAs(1'000'000, 'a');
+
+    QTest::newRow("sha224_abc") << QCryptographicHash::Sha224 << abc
+            << QByteArray::fromHex("23097D223405D8228642A477BDA255B32AADBCE4BDA0B3F7E36C9DA7");
+    QTest::newRow("sha224_twoblocks") << QCryptographicHash::Sha224 << twoBlocks
+            << QByteArray::fromHex("75388B16512776CC5DBA5DA1FD890150B0C6455CB4F58B1952522525");
+    QTest::newRow("sha224_millionAs") << QCryptographicHash::Sha224 << millionAs
+            << QByteArray::fromHex("20794655980C91D8BBB4C1EA97618A4BF03F42581948B2EE4EE7AD67");
+    QTest::newRow("sha256_abc") << QCryptographicHash::Sha256 << abc
+            << QByteArray::fromHex("BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD");
+    QTest::newRow("sha256_twoblocks") << QCryptographicHash::Sha256 << twoBlocks
+            << QByteArray::fromHex("248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1");
+    QTest::newRow("sha256_millionAs") << QCryptographicHash::Sha256 << millionAs
+            << QByteArray::fromHex("CDC76E5C9914FB9281A1C7E284D73E67F1809A48A497200E046D39CCC7112CD0");
+}
+
+void tst_QCryptographicHash::sha2()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const QByteArray, data);
+    QFETCH(const QByteArray, expected);
+
+    QCOMPARE(QCryptographicHash::hash(data, algorithm), expected);
+}
+
+static QByteArray testMessage(qsizetype size)
+{
+    QByteArray message(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        message[i] = char(i * 7 + size);
+    return message;
+}
+
+void tst_QCryptographicHash::addDataAtBlockBoundaries_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("chunkSize");
+
+    const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Sha1, QCryptographicHash::Sha224, QCryptographicHash::Sha256
+    };
+    const auto metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (QCryptographicHash::Algorithm algorithm : algorithms) {
+        for (int chunkSize : { 1, 7, 55, 56, 63, 64, 65, 128, 1000 })
+            QTest::addRow("%s-%d", metaEnum.valueToKey(algorithm), chunkSize) << algorithm << chunkSize;
+    }
+}
+
+void tst_QCryptographicHash::addDataAtBlockBoundaries()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const int, chunkSize);
+
+    // the block functions buffer partial blocks themselves
+    const QByteArray data = testMessage(4097);
+    for (qsizetype size : { 0, 1, 55, 56, 63, 64, 65, 119, 120, 127, 128, 129, 4097 }) {
+        const QByteArrayView message = QByteArrayView(data).first(size);
+        QCryptographicHash hash(algorithm);
+        for (qsizetype i = 0; i < size; i += chunkSize)
+            hash.addData(message.sliced(i, qMin<qsizetype>(chunkSize, size - i)));
+        QCOMPARE(hash.resultView(), QCryptographicHash::hash(message, algorithm));
+    }
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("count");
+
+    const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Sha1, QCryptographicHash::Sha224, QCryptographicHash::Sha256,
+        QCryptographicHash::Md5, QCryptographicHash::Sha3_256, QCryptographicHash::Blake2b_256
+    };
+    const auto metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    for (QCryptographicHash::Algorithm algorithm : algorithms) {
+        for (int count : { 0, 1, 3, 4, 8, 9, 33 })
+            QTest::addRow("%s-%d", metaEnum.valueToKey(algorithm), count) << algorithm << count;
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const int, count);
+
+    if (!QCryptographicHash::supportsAlgorithm(algorithm))
+        QSKIP("QCryptographicHash doesn't support this algorithm");
+
+    // messages of different lengths, so that they end at different times
+    static const qsizetype sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 1000, 4097 };
+    QList<QByteArray> messages;
+    for (int i = 0; i < count; ++i)
+        messages.append(testMessage(sizes[i % std::size(sizes)] + i / std::size(sizes)));
+    const QList<QByteArrayView> views(messages.cbegin(), messages.cend());
+
+    const QByteArrayList results = QCryptographicHash::hashMany(views, algorithm);
+    QCOMPARE(results.size(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(results.at(i), QCryptographicHash::hash(messages.at(i), algorithm));
+}
+
 void tst_QCryptographicHash::sha3_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
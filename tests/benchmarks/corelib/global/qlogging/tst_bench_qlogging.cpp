@@ -0,0 +1,253 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QElapsedTimer>
+#include <QList>
+#include <QLoggingCategory>
+#include <QThread>
+
+#include <QtCore/private/qlogging_p.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+// Measures what logging costs the thread that logs, when the destination is
+// slower than the application: stderr is redirected to a pipe that is read
+// back slowly, like a busy journald or terminal would. Also measures how long
+// changing the logging rules takes when there are many categories.
+
+using namespace Qt::StringLiterals;
+
+static constexpr int MessagesPerThread = 2000;
+
+class tst_QLogging : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void throughput_data() { addRows(); }
+    void throughput();
+    void latency_data() { addRows(); }
+    void latency();
+    void setFilterRules_data();
+    void setFilterRules();
+    void disabledCategory_data();
+    void disabledCategory();
+
+private:
+    static void addRows();
+    static std::vector<qint64> logFromThreads(int threadCount, bool measure);
+
+#ifdef Q_OS_UNIX
+    int savedStderr = -1;
+    std::unique_ptr<QThread> reader;
+#endif
+    QtMessageHandler testHandler = nullptr;
+};
+
+void tst_QLogging::initTestCase()
+{
+#ifdef Q_OS_UNIX
+    // bypass journald and friends, we want to control the destination
+    qputenv("QT_FORCE_STDERR_LOGGING", "1");
+
+    int fds[2];
+    QVERIFY(::pipe(fds) == 0);
+    savedStderr = ::dup(STDERR_FILENO);
+    QVERIFY(savedStderr != -1);
+    QVERIFY(::dup2(fds[1], STDERR_FILENO) != -1);
+    ::close(fds[1]);
+
+    const int readEnd = fds[0];
+    reader.reset(QThread::create([readEnd] {
+        char buffer[4096];
+        while (::read(readEnd, buffer, sizeof(buffer)) > 0)
+            QThread::usleep(200);
+        ::close(readEnd);
+    }));
+    reader->start();
+#endif
+}
+
+void tst_QLogging::cleanupTestCase()
+{
+#ifdef Q_OS_UNIX
+    QtPrivate::setMessageOutputAsync(false);
+    fflush(stderr);
+    // closes the write end of the pipe, so the reader ends
+    ::dup2(savedStderr, STDERR_FILENO);
+    ::close(savedStderr);
+    reader->wait();
+#endif
+}
+
+void tst_QLogging::init()
+{
+    // QtTest installs a handler of its own; measure the default one
+    testHandler = qInstallMessageHandler(nullptr);
+}
+
+void tst_QLogging::cleanup()
+{
+    // writes what is still pending
+    QtPrivate::setMessageOutputAsync(false);
+    qInstallMessageHandler(testHandler);
+}
+
+void tst_QLogging::addRows()
+{
+    QTest::addColumn<bool>("async");
+    QTest::addColumn<int>("threadCount");
+
+    for (bool async : { false, true }) {
+        for (int threadCount : { 1, 4, 8 }) {
+            QTest::addRow("%s, %d thread(s)", async ? "async" : "sync", threadCount)
+                    << async << threadCount;
+        }
+    }
+}
+
+// Returns the duration of each call, in nanoseconds, if measure is true.
+std::vector<qint64> tst_QLogging::logFromThreads(int threadCount, bool measure)
+{
+    std::vector<std::vector<qint64>> durations(threadCount);
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        std::vector<qint64> &threadDurations = durations[i];
+        threads.emplace_back(QThread::create([&threadDurations, i, measure] {
+            if (measure)
+                threadDurations.reserve(MessagesPerThread);
+            QElapsedTimer timer;
+            for (int n = 0; n < MessagesPerThread; ++n) {
+                if (measure)
+                    timer.start();
+                qDebug("thread %d: message %d of the logging benchmark", i, n);
+                if (measure)
+                    threadDurations.push_back(timer.nsecsElapsed());
+            }
+        }));
+    }
+    for (const auto &thread : threads)
+        thread->start();
+    for (const auto &thread : threads)
+        thread->wait();
+
+    std::vector<qint64> result;
+    for (const std::vector<qint64> &threadDurations : durations)
+        result.insert(result.end(), threadDurations.cbegin(), threadDurations.cend());
+    return result;
+}
+
+void tst_QLogging::throughput()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("This benchmark redirects stderr to a pipe, which is only implemented on Unix");
+#endif
+    QFETCH(bool, async);
+    QFETCH(int, threadCount);
+
+    QtPrivate::setMessageOutputAsync(async);
+    // with async output, only the time until the messages are queued counts;
+    // messages that do not fit into the queues are dropped
+    QBENCHMARK {
+        logFromThreads(threadCount, false);
+    }
+}
+
+void tst_QLogging::latency()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("This benchmark redirects stderr to a pipe, which is only implemented on Unix");
+#endif
+    QFETCH(bool, async);
+    QFETCH(int, threadCount);
+
+    QtPrivate::setMessageOutputAsync(async);
+    std::vector<qint64> durations = logFromThreads(threadCount, true);
+    QCOMPARE(durations.size(), size_t(threadCount) * MessagesPerThread);
+
+    // the 99th percentile of the time a qDebug() call takes
+    const auto p99 = durations.begin() + durations.size() * 99 / 100;
+    std::nth_element(durations.begin(), p99, durations.end());
+    QTest::setBenchmarkResult(qreal(*p99), QTest::WalltimeNanoseconds);
+}
+
+void tst_QLogging::setFilterRules_data()
+{
+    QTest::addColumn<QString>("rules");
+
+    QTest::newRow("one category") << u"bench.module42.category7=false"_s;
+    QTest::newRow("prefix") << u"bench.module42.*=false"_s;
+    QTest::newRow("suffix") << u"*.category7=false"_s;
+    QTest::newRow("everything") << u"bench.*=false"_s;
+}
+
+void tst_QLogging::setFilterRules()
+{
+    QFETCH(QString, rules);
+
+    // 100 modules with 100 categories each
+    std::vector<QByteArray> names;
+    for (int module = 0; module < 100; ++module) {
+        for (int category = 0; category < 100; ++category)
+            names.push_back("bench.module" + QByteArray::number(module) + ".category"
+                            + QByteArray::number(category));
+    }
+    std::vector<std::unique_ptr<QLoggingCategory>> categories;
+    for (const QByteArray &name : names)
+        categories.push_back(std::make_unique<QLoggingCategory>(name.constData()));
+
+    // a rule that doesn't change stays in place, like in a reloaded file
+    const QString baseRules = u"qt.*.debug=false\n"_s;
+    QLoggingCategory::setFilterRules(baseRules);
+    QBENCHMARK {
+        QLoggingCategory::setFilterRules(baseRules + rules);
+        QLoggingCategory::setFilterRules(baseRules);
+    }
+    QLoggingCategory::setFilterRules(QString());
+}
+
+Q_LOGGING_CATEGORY(lcBenchRuntime, "bench.runtime", QtInfoMsg)
+Q_LOGGING_CATEGORY_WITH_MINIMUM_LEVEL(lcBenchMinimumLevel, QtInfoMsg, "bench.minimum")
+
+void tst_QLogging::disabledCategory_data()
+{
+    QTest::addColumn<bool>("minimumLevel");
+
+    QTest::newRow("disabled at run time") << false;
+    QTest::newRow("below the minimum level") << true;
+}
+
+void tst_QLogging::disabledCategory()
+{
+    QFETCH(bool, minimumLevel);
+
+    int count = 0;
+    if (minimumLevel) {
+        QBENCHMARK {
+            for (int i = 0; i < 1000; ++i)
+                qCDebug(lcBenchMinimumLevel) << "not logged" << ++count;
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < 1000; ++i)
+                qCDebug(lcBenchRuntime) << "not logged" << ++count;
+        }
+    }
+    QCOMPARE(count, 0);
+}
+
+QTEST_MAIN(tst_QLogging)
+
+#include "tst_bench_qlogging.moc"
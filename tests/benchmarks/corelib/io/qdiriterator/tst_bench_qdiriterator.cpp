@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 #include <QDebug>
 #include <QDirIterator>
+#include <QDirWalker>
 #include <QString>
 #include <qplatformdefs.h>
 
@@ -35,6 +36,12 @@ private slots:
     void diriterator_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
+    void diriteratorFileInfo();
+    void diriteratorFileInfo_data() { data(); }
+    void dirwalker();
+    void dirwalker_data() { data(); }
+    void dirwalkerFileInfo();
+    void dirwalkerFileInfo_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
 };
@@ -210,6 +217,58 @@ void tst_QDirIterator::fsiterator()
     qDebug() << count;
 }
 
+void tst_QDirIterator::diriteratorFileInfo()
+{
+    // reads the metadata an indexer needs for every file
+    QFETCH(QByteArray, dirpath);
+
+    qint64 totalSize = 0;
+
+    QBENCHMARK {
+        qint64 size = 0;
+        QDirIterator dir(dirpath, QDir::Files, QDirIterator::Subdirectories);
+        while (dir.hasNext()) {
+            const QFileInfo info = dir.nextFileInfo();
+            size += info.size() + info.lastModified().toMSecsSinceEpoch() % 2;
+        }
+        totalSize = size;
+    }
+    qDebug() << totalSize;
+}
+
+void tst_QDirIterator::dirwalker()
+{
+    QFETCH(QByteArray, dirpath);
+
+    qsizetype count = 0;
+
+    QBENCHMARK {
+        qsizetype c = 0;
+        QDirWalker walker(dirpath, QDir::Files);
+        walker.walk([&c](const QFileInfoList &batch) { c += batch.size(); });
+        count = c;
+    }
+    qDebug() << count;
+}
+
+void tst_QDirIterator::dirwalkerFileInfo()
+{
+    QFETCH(QByteArray, dirpath);
+
+    qint64 totalSize = 0;
+
+    QBENCHMARK {
+        qint64 size = 0;
+        QDirWalker walker(dirpath, QDir::Files);
+        walker.walk([&size](const QFileInfoList &batch) {
+            for (const QFileInfo &info : batch)
+                size += info.size() + info.lastModified().toMSecsSinceEpoch() % 2;
+        });
+        totalSize = size;
+    }
+    qDebug() << totalSize;
+}
+
 void tst_QDirIterator::stdRecursiveDirectoryIterator()
 {
 #if QT_CONFIG(cxx17_filesystem)
@@ -5,6 +5,9 @@
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QTimer>
 
 #include <private/qfsfileengine_p.h>
 
@@ -81,6 +84,11 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+    void readBigFileAsync_data();
+    void readBigFileAsync();
+#endif
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -292,6 +300,83 @@ void tst_qfile::readBigFile()
     }
 }
 
+#if QT_CONFIG(future) && defined(Q_OS_UNIX)
+enum class AsyncMode { Sync, ThreadPool, EventLoop };
+
+void tst_qfile::readBigFileAsync_data()
+{
+    QTest::addColumn<int>("blockSize");
+    QTest::addColumn<AsyncMode>("mode");
+
+    for (int blockSize : { 4 * 1024, 64 * 1024, BUFSIZE }) {
+        QTest::addRow("sync:%d", blockSize) << blockSize << AsyncMode::Sync;
+        QTest::addRow("thread-pool:%d", blockSize) << blockSize << AsyncMode::ThreadPool;
+        QTest::addRow("event-loop:%d", blockSize) << blockSize << AsyncMode::EventLoop;
+    }
+}
+
+// Streams the file with up to 64 reads in flight, the way a consumer of
+// QFile::readAsync() would. Started from inside an event loop, QFile may
+// use io_uring and complete the reads from that loop; otherwise the reads
+// are run on the thread pool.
+static qint64 readAsyncWindowed(QFile &file, qint64 size, int blockSize, bool inEventLoop)
+{
+    constexpr int Window = 64;
+    QList<QFuture<QByteArray>> inFlight;
+    qint64 offset = 0;
+    qint64 total = 0;
+    while (offset < size || !inFlight.isEmpty()) {
+        for (; offset < size && inFlight.size() < Window; offset += blockSize)
+            inFlight << file.readAsync(offset, blockSize);
+
+        const QFuture<QByteArray> oldest = inFlight.takeFirst();
+        if (inEventLoop && !oldest.isFinished()) {
+            QEventLoop loop;
+            QFutureWatcher<QByteArray> watcher;
+            QObject::connect(&watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+            watcher.setFuture(oldest);
+            loop.exec();
+        }
+        total += oldest.result().size();
+    }
+    return total;
+}
+
+void tst_qfile::readBigFileAsync()
+{
+    QFETCH(int, blockSize);
+    QFETCH(AsyncMode, mode);
+
+    QFile file(tempDir.filename);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+    const qint64 size = file.size();
+
+    QBENCHMARK {
+        qint64 total = 0;
+        switch (mode) {
+        case AsyncMode::Sync:
+            file.reset();
+            while (!file.atEnd())
+                total += file.read(blockSize).size();
+            break;
+        case AsyncMode::ThreadPool:
+            total = readAsyncWindowed(file, size, blockSize, false);
+            break;
+        case AsyncMode::EventLoop: {
+            QEventLoop loop;
+            QTimer::singleShot(0, &loop, [&] {
+                total = readAsyncWindowed(file, size, blockSize, true);
+                loop.quit();
+            });
+            loop.exec();
+            break;
+        }
+        }
+        QCOMPARE(total, size);
+    }
+}
+#endif // QT_CONFIG(future) && Q_OS_UNIX
+
 void tst_qfile::seek_data()
 {
     QTest::addColumn<tst_qfile::BenchmarkType>("testType");
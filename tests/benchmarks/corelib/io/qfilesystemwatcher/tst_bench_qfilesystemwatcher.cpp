@@ -0,0 +1,101 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QDir>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Qt::StringLiterals;
+
+class tst_QFileSystemWatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void watchTree_data();
+    void watchTree();
+
+private:
+    // 100 directories of 1000 directories each
+    static constexpr int TopLevelCount = 100;
+    static constexpr int SubdirectoryCount = 1000;
+
+    QTemporaryDir dir;
+    QStringList directories;
+};
+
+void tst_QFileSystemWatcher::initTestCase()
+{
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+
+    QDir root(dir.path());
+    directories.reserve(TopLevelCount * (SubdirectoryCount + 1));
+    for (int i = 0; i < TopLevelCount; ++i) {
+        const QString topLevel = root.filePath(QString::number(i));
+        QVERIFY(root.mkdir(topLevel));
+        directories.append(topLevel);
+        QDir parent(topLevel);
+        for (int j = 0; j < SubdirectoryCount; ++j) {
+            QVERIFY(parent.mkdir(QString::number(j)));
+            directories.append(parent.filePath(QString::number(j)));
+        }
+    }
+}
+
+void tst_QFileSystemWatcher::watchTree_data()
+{
+    QTest::addColumn<QString>("backend");
+    QTest::addColumn<bool>("recursive");
+
+    QTest::newRow("addPaths") << QString() << false;
+    QTest::newRow("addPathRecursively") << QString() << true;
+#ifdef QT_BUILD_INTERNAL
+    QTest::newRow("addPathRecursively, per directory") << u"native"_s << true;
+#endif
+}
+
+// what it costs to start and stop watching a large tree
+void tst_QFileSystemWatcher::watchTree()
+{
+    QFETCH(QString, backend);
+    QFETCH(bool, recursive);
+
+    QStringList all = directories;
+    all.prepend(dir.path());
+
+#ifdef Q_OS_LINUX
+    if (!recursive || !backend.isEmpty()) {
+        QFile limitFile(u"/proc/sys/fs/inotify/max_user_watches"_s);
+        if (limitFile.open(QIODevice::ReadOnly)
+                && limitFile.readAll().trimmed().toLongLong() < all.size()) {
+            QSKIP("The inotify watch limit is too low for one watch per directory");
+        }
+    }
+#endif
+
+    QBENCHMARK {
+        QFileSystemWatcher watcher;
+        if (!backend.isEmpty())
+            watcher.setObjectName("_qt_autotest_force_engine_"_L1 + backend);
+        if (recursive) {
+            if (!watcher.addPathRecursively(dir.path())) {
+                watcher.removePathRecursively(dir.path());
+                QSKIP("Could not watch the whole tree; the system limit may be too low");
+            }
+            QVERIFY(watcher.removePathRecursively(dir.path()));
+        } else {
+            if (!watcher.addPaths(all).isEmpty()) {
+                watcher.removePaths(all);
+                QSKIP("Could not watch the whole tree; the system limit may be too low");
+            }
+            QVERIFY(watcher.removePaths(all).isEmpty());
+        }
+    }
+}
+
+QTEST_MAIN(tst_QFileSystemWatcher)
+
+#include "tst_bench_qfilesystemwatcher.moc"
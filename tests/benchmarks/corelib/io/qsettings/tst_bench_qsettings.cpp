@@ -0,0 +1,129 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QFile>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <private/qsettings_p.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSettings : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void open_data();
+    void open();
+    void setValue_data();
+    void setValue();
+
+private:
+    static constexpr int GroupCount = 100;
+    static constexpr int KeysPerGroup = 100;
+
+    static QString key(int group, int key)
+    { return u"group%1/key%2"_s.arg(group).arg(key); }
+    QString createSettings(const QString &name, bool withCache);
+
+    QTemporaryDir dir;
+};
+
+void tst_QSettings::initTestCase()
+{
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+}
+
+// a 10k key INI file, optionally without its binary cache
+QString tst_QSettings::createSettings(const QString &name, bool withCache)
+{
+    const QString path = dir.filePath(name);
+    if (QFile::exists(path))
+        return path;
+
+    {
+        QSettings settings(path, QSettings::IniFormat);
+        for (int i = 0; i < GroupCount; ++i) {
+            for (int j = 0; j < KeysPerGroup; ++j)
+                settings.setValue(key(i, j), u"value of key %1 in group %2"_s.arg(j).arg(i));
+        }
+    }
+    const QString cachePath = path + ".cache"_L1;
+    if (!withCache)
+        QFile::remove(cachePath);
+    if (QFile::exists(cachePath) != withCache)
+        return QString();
+    return path;
+}
+
+void tst_QSettings::open_data()
+{
+    QTest::addColumn<bool>("withCache");
+    QTest::addColumn<int>("readCount");
+
+    QTest::newRow("ini, one key") << false << 1;
+    QTest::newRow("ini, one group") << false << KeysPerGroup;
+    QTest::newRow("ini, all keys") << false << GroupCount * KeysPerGroup;
+    QTest::newRow("cache, one key") << true << 1;
+    QTest::newRow("cache, one group") << true << KeysPerGroup;
+    QTest::newRow("cache, all keys") << true << GroupCount * KeysPerGroup;
+}
+
+// what every process sharing the file pays on startup or after a change
+void tst_QSettings::open()
+{
+#ifdef QT_BUILD_INTERNAL
+    QFETCH(bool, withCache);
+    QFETCH(int, readCount);
+
+    const QString path = createSettings(withCache ? u"cache.ini"_s : u"ini.ini"_s, withCache);
+    QVERIFY(!path.isEmpty());
+
+    QBENCHMARK {
+        QConfFile::clearCache();
+        QSettings settings(path, QSettings::IniFormat);
+        for (int i = 0; i < readCount; ++i) {
+            const QVariant value = settings.value(key(i / KeysPerGroup, i % KeysPerGroup));
+            QVERIFY(value.isValid());
+        }
+    }
+#else
+    QSKIP("This benchmark requires a developer build");
+#endif
+}
+
+void tst_QSettings::setValue_data()
+{
+    QTest::addColumn<bool>("syncEachValue");
+
+    QTest::newRow("sync each value") << true;
+    QTest::newRow("batched") << false;
+}
+
+void tst_QSettings::setValue()
+{
+    QFETCH(bool, syncEachValue);
+
+    const QString path = createSettings(u"write.ini"_s, true);
+    QVERIFY(!path.isEmpty());
+
+    QSettings settings(path, QSettings::IniFormat);
+    int round = 0;
+    QBENCHMARK {
+        ++round;
+        for (int i = 0; i < KeysPerGroup; ++i) {
+            settings.setValue(key(0, i), round);
+            if (syncEachValue)
+                settings.sync();
+        }
+        settings.sync();
+    }
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+QTEST_MAIN(tst_QSettings)
+
+#include "tst_bench_qsettings.moc"
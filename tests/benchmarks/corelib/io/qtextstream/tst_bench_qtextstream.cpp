@@ -13,6 +13,8 @@ class tst_QTextStream : public QObject
 private slots:
     void writeSingleChar_data();
     void writeSingleChar();
+    void readDouble_data();
+    void readDouble();
 
 private:
 };
@@ -90,6 +92,41 @@ void tst_QTextStream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+void tst_QTextStream::readDouble_data()
+{
+    QTest::addColumn<Output>("source");
+
+    QTest::newRow("string") << StringOutput;
+    QTest::newRow("device") << DeviceOutput;
+}
+
+void tst_QTextStream::readDouble()
+{
+    QFETCH(Output, source);
+
+    QString text;
+    for (int i = 0; i < 10000; ++i)
+        text += QString::number(i * 0.37 - 1000.0) + u' ';
+    const QByteArray utf8 = text.toUtf8();
+
+    double sum = 0;
+    QBENCHMARK {
+        QBuffer buffer;
+        QTextStream stream;
+        if (source == StringOutput) {
+            stream.setString(&text, QIODevice::ReadOnly);
+        } else {
+            buffer.setData(utf8);
+            QVERIFY(buffer.open(QIODevice::ReadOnly));
+            stream.setDevice(&buffer);
+        }
+        double value;
+        while (!(stream >> value).atEnd())
+            sum += value;
+    }
+    QVERIFY(sum != 0);
+}
+
 QTEST_MAIN(tst_QTextStream)
 
 #include "tst_bench_qtextstream.moc"
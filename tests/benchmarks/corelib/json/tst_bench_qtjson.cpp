@@ -1,10 +1,16 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include <QBuffer>
 #include <QTest>
 #include <QVariantMap>
+#include <qjsonarray.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
+#include <qjsonstreamwriter.h>
+
+using namespace Qt::StringLiterals;
 
 class BenchmarkQtJson: public QObject
 {
@@ -21,6 +27,13 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseCorpus_data();
+    void parseCorpus();
+    void streamReadJson();
+    void parseLargeDocument_data();
+    void parseLargeDocument();
+    void writeLargeDocument_data();
+    void writeLargeDocument();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -93,6 +106,172 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+// Documents of a few megabytes, shaped like typical real-world JSON
+static QByteArray corpus(QByteArrayView name)
+{
+    QJsonArray records;
+    if (name == "messages") {
+        // long ASCII texts, like a chat or social media feed
+        for (int i = 0; i < 10000; ++i) {
+            records.append(QJsonObject{
+                { u"id"_s, i },
+                { u"user"_s, QJsonObject{ { u"name"_s, u"user"_s + QString::number(i % 97) },
+                                          { u"verified"_s, i % 3 == 0 } } },
+                { u"text"_s, QString(u"The quick brown fox jumps over the lazy dog. "_s).repeated(5) },
+                { u"url"_s, u"https://example.com/messages/"_s + QString::number(i) },
+            });
+        }
+    } else if (name == "unicode") {
+        // mostly non-ASCII texts
+        for (int i = 0; i < 10000; ++i) {
+            records.append(QJsonObject{
+                { u"id"_s, i },
+                { u"de"_s, u"Größenänderung der Schriftart für Überschriften"_s },
+                { u"ja"_s, u"ウィンドウのサイズを変更する"_s },
+                { u"ru"_s, u"Изменить размер окна"_s },
+            });
+        }
+    } else if (name == "escapes") {
+        // strings with escape sequences, like embedded source code
+        for (int i = 0; i < 10000; ++i)
+            records.append(u"if (x) {\n\tprint(\"x\");\n}\n"_s.repeated(4));
+    } else if (name == "numbers") {
+        for (int i = 0; i < 10000; ++i) {
+            records.append(QJsonArray{ i, i * 0.25, -i, 1e10 + i, i / 3.0,
+                                       i % 2 == 0, QJsonValue::Null });
+        }
+    }
+    return QJsonDocument(records).toJson(QJsonDocument::Indented);
+}
+
+void BenchmarkQtJson::parseCorpus_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    for (const char *name : { "messages", "unicode", "escapes", "numbers" }) {
+        const QByteArray json = corpus(name);
+        QTest::addRow("%s-indented", name) << json;
+        QTest::addRow("%s-compact", name)
+                << QJsonDocument::fromJson(json).toJson(QJsonDocument::Compact);
+    }
+}
+
+void BenchmarkQtJson::parseCorpus()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+    }
+}
+
+void BenchmarkQtJson::streamReadJson()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        while (!reader.atEnd())
+            reader.readNext();
+        QVERIFY(!reader.hasError());
+    }
+}
+
+// An array of Count records, about 10 MB of JSON
+static QByteArray largeDocument()
+{
+    enum { Count = 100000 };
+    QByteArray json;
+    QJsonStreamWriter writer(&json);
+    writer.startArray();
+    for (int i = 0; i < Count; ++i) {
+        writer.startObject();
+        writer.writeName(u"id");
+        writer.writeInteger(i);
+        writer.writeName(u"name");
+        writer.writeString(u"record number "_s + QString::number(i));
+        writer.writeName(u"value");
+        writer.writeDouble(i / 7.0);
+        writer.writeName(u"tags");
+        writer.startArray();
+        writer.writeString(u"first");
+        writer.writeString(u"second");
+        writer.endArray();
+        writer.endObject();
+    }
+    writer.endArray();
+    return json;
+}
+
+void BenchmarkQtJson::parseLargeDocument_data()
+{
+    QTest::addColumn<bool>("stream");
+    QTest::newRow("QJsonDocument::fromJson") << false;
+    QTest::newRow("QJsonStreamReader") << true;
+}
+
+void BenchmarkQtJson::parseLargeDocument()
+{
+    QFETCH(bool, stream);
+    const QByteArray json = largeDocument();
+
+    // sum up the values of the records, reading the document from a device
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.setData(json);
+        buffer.open(QIODevice::ReadOnly);
+        double sum = 0;
+        if (stream) {
+            QJsonStreamReader reader(&buffer);
+            while (!reader.atEnd()) {
+                if (reader.readNext() == QJsonStreamReader::Name && reader.text() == u"value") {
+                    reader.readNext();
+                    sum += reader.toDouble();
+                }
+            }
+            QVERIFY(!reader.hasError());
+        } else {
+            const QJsonArray records = QJsonDocument::fromJson(buffer.readAll()).array();
+            for (const QJsonValue &record : records)
+                sum += record[u"value"].toDouble();
+        }
+        QVERIFY(sum > 0);
+    }
+}
+
+void BenchmarkQtJson::writeLargeDocument_data()
+{
+    QTest::addColumn<bool>("stream");
+    QTest::newRow("QJsonDocument::toJson") << false;
+    QTest::newRow("QJsonStreamWriter") << true;
+}
+
+void BenchmarkQtJson::writeLargeDocument()
+{
+    QFETCH(bool, stream);
+    const QJsonArray records = QJsonDocument::fromJson(largeDocument()).array();
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        if (stream) {
+            QJsonStreamWriter writer(&buffer);
+            writer.startArray();
+            for (const QJsonValue &record : records)
+                writer.writeValue(record);
+            writer.endArray();
+        } else {
+            buffer.write(QJsonDocument(records).toJson());
+        }
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
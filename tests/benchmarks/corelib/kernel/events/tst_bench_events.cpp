@@ -5,6 +5,11 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 class PingPong : public QObject
 {
 public:
@@ -71,6 +76,14 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+#if QT_CONFIG(thread)
+    void postEventFromThreads_data();
+    void postEventFromThreads();
+#endif
+#ifdef Q_OS_UNIX
+    void socketNotifiers_data();
+    void socketNotifiers();
+#endif
 };
 
 void EventsBench::initTestCase()
@@ -145,6 +158,127 @@ void EventsBench::postEvent()
     }
 }
 
+#if QT_CONFIG(thread)
+class CountingReceiver : public QObject
+{
+public:
+    QAtomicInt remaining = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() != QEvent::User)
+            return QObject::event(e);
+        if (!remaining.deref())
+            QTestEventLoop::instance().exitLoop();
+        return true;
+    }
+};
+
+void EventsBench::postEventFromThreads_data()
+{
+    QTest::addColumn<int>("producerCount");
+    QTest::addColumn<Qt::EventPriority>("priority");
+
+    // Events with the default priority are added to the receiving thread's
+    // list without locking it; any other priority takes the locked path.
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int producers = 1; producers <= qMax(4, idealThreadCount); producers *= 2) {
+        QTest::addRow("%d-producers", producers) << producers << Qt::NormalEventPriority;
+        QTest::addRow("%d-producers-locked", producers) << producers << Qt::HighEventPriority;
+    }
+}
+
+// Measures how long it takes producerCount threads to post events to one
+// receiver in the main thread, and the main thread to deliver them.
+void EventsBench::postEventFromThreads()
+{
+    QFETCH(int, producerCount);
+    QFETCH(Qt::EventPriority, priority);
+    constexpr int EventsPerProducer = 20000;
+
+    CountingReceiver receiver;
+    QBENCHMARK {
+        receiver.remaining.storeRelaxed(producerCount * EventsPerProducer);
+        std::vector<std::unique_ptr<QThread>> producers;
+        for (int i = 0; i < producerCount; ++i) {
+            producers.emplace_back(QThread::create([&receiver, priority] {
+                for (int j = 0; j < EventsPerProducer; ++j)
+                    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User), priority);
+            }));
+            producers.back()->start();
+        }
+        QTestEventLoop::instance().enterLoop(60);
+        for (const auto &producer : producers)
+            producer->wait();
+    }
+    QCOMPARE(receiver.remaining.loadRelaxed(), 0);
+}
+#endif // QT_CONFIG(thread)
+
+#ifdef Q_OS_UNIX
+void EventsBench::socketNotifiers_data()
+{
+    QTest::addColumn<int>("notifierCount");
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+// Measures one iteration of the event loop with notifierCount idle read
+// notifiers and a single ready one. Run with QT_EVENT_DISPATCHER_EPOLL=1 to
+// compare the epoll dispatcher, whose cost should not depend on the number
+// of idle notifiers, against the default one.
+void EventsBench::socketNotifiers()
+{
+    QFETCH(int, notifierCount);
+
+    // one pipe per notifier, plus some headroom for the rest of the process
+    const rlim_t wantedFds = rlim_t(notifierCount) * 2 + 64;
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < wantedFds) {
+        if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < wantedFds)
+            QSKIP("Not enough file descriptors available");
+        limit.rlim_cur = wantedFds;
+        if (setrlimit(RLIMIT_NOFILE, &limit) != 0)
+            QSKIP("Could not raise the file descriptor limit");
+    }
+
+    QList<int> fds;
+    fds.reserve(notifierCount * 2);
+    auto closeFds = qScopeGuard([&fds] {
+        for (int fd : std::as_const(fds))
+            ::close(fd);
+    });
+
+    std::vector<std::unique_ptr<QSocketNotifier>> notifiers;
+    notifiers.reserve(notifierCount);
+    for (int i = 0; i < notifierCount; ++i) {
+        int pipefd[2];
+        if (::pipe(pipefd) != 0)
+            QSKIP("Could not create enough pipes");
+        fds << pipefd[0] << pipefd[1];
+        notifiers.push_back(std::make_unique<QSocketNotifier>(pipefd[0], QSocketNotifier::Read));
+    }
+
+    // The data is never read, so the first notifier stays ready and fires
+    // once per iteration.
+    int activations = 0;
+    QObject::connect(notifiers.front().get(), &QSocketNotifier::activated,
+                     [&activations] { ++activations; });
+    const char c = 0;
+    QCOMPARE(::write(fds.at(1), &c, 1), 1);
+
+    QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance();
+    QBENCHMARK {
+        dispatcher->processEvents(QEventLoop::AllEvents);
+    }
+    QVERIFY(activations > 0);
+}
+#endif
+
 QTEST_MAIN(EventsBench)
 
 #include "tst_bench_events.moc"
@@ -0,0 +1,93 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qcorotask.h>
+#include <qfuture.h>
+#include <qpromise.h>
+
+class tst_QCoroTask : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void thenChain();
+    void awaitChain();
+    void thenContext();
+    void awaitPending();
+};
+
+static constexpr int ChainLength = 100;
+
+// thenChain() and awaitChain() both make a future for each of the steps
+// from the result of the previous one, starting with a finished future, and
+// neither goes through the event loop.
+void tst_QCoroTask::thenChain()
+{
+    QBENCHMARK {
+        QFuture<int> future = QtFuture::makeReadyValueFuture(0);
+        for (int i = 0; i < ChainLength; ++i)
+            future = future.then([](int value) { return value + 1; });
+        QCOMPARE(future.result(), ChainLength);
+    }
+}
+
+static QCoroTask<int> chain(QFuture<int> future)
+{
+    int value = co_await future;
+    for (int i = 0; i < ChainLength; ++i)
+        value = co_await QtFuture::makeReadyValueFuture(value + 1);
+    co_return value;
+}
+
+void tst_QCoroTask::awaitChain()
+{
+    QBENCHMARK {
+        QCoroTask<int> task = chain(QtFuture::makeReadyValueFuture(0));
+        QVERIFY(task.isFinished());
+        QCOMPARE(task.result(), ChainLength);
+    }
+}
+
+// thenContext() and awaitPending() both continue in the event loop once a
+// pending future is finished.
+void tst_QCoroTask::thenContext()
+{
+    QObject context;
+    QBENCHMARK {
+        QPromise<int> promise;
+        QFuture<int> future = promise.future().then(&context, [](int value) {
+            return value + 1;
+        });
+        promise.start();
+        promise.addResult(0);
+        promise.finish();
+        QCoreApplication::processEvents();
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 1);
+    }
+}
+
+static QCoroTask<int> addOne(QFuture<int> future)
+{
+    co_return co_await future + 1;
+}
+
+void tst_QCoroTask::awaitPending()
+{
+    QBENCHMARK {
+        QPromise<int> promise;
+        QCoroTask<int> task = addOne(promise.future());
+        promise.start();
+        promise.addResult(0);
+        promise.finish();
+        QCoreApplication::processEvents();
+        QVERIFY(task.isFinished());
+        QCOMPARE(task.result(), 1);
+    }
+}
+
+QTEST_MAIN(tst_QCoroTask)
+
+#include "tst_bench_qcorotask.moc"
@@ -0,0 +1,113 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QRandomGenerator>
+
+#include <private/qtimerinfo_unix_p.h>
+
+using namespace std::chrono_literals;
+
+Q_DECLARE_METATYPE(QTimerInfoList::Storage)
+
+class tst_QTimerInfoList : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void restartTimer_data();
+    void restartTimer();
+    void registerAndUnregister_data() { restartTimer_data(); }
+    void registerAndUnregister();
+    void activateTimers_data() { restartTimer_data(); }
+    void activateTimers();
+
+private:
+    // Registers timerCount idle timers with long intervals, like the idle
+    // timeouts of many network connections. The timeouts grow with the id,
+    // so that this is quick even for the sorted list.
+    static void registerIdleTimers(QTimerInfoList &list, int timerCount, QObject *object)
+    {
+        for (int id = 1; id <= timerCount; ++id)
+            list.registerTimer(id, 60s + std::chrono::milliseconds(id), Qt::PreciseTimer, object);
+    }
+
+    static std::chrono::milliseconds randomInterval()
+    {
+        return 60s + std::chrono::milliseconds(QRandomGenerator::global()->bounded(1'000'000));
+    }
+};
+
+void tst_QTimerInfoList::restartTimer_data()
+{
+    QTest::addColumn<QTimerInfoList::Storage>("storage");
+    QTest::addColumn<int>("timerCount");
+
+    for (int timerCount : { 1000, 10'000, 100'000, 1'000'000 }) {
+        QTest::addRow("list-%d", timerCount) << QTimerInfoList::SortedList << timerCount;
+        QTest::addRow("wheel-%d", timerCount) << QTimerInfoList::TimerWheel << timerCount;
+    }
+}
+
+// Restarts a random one of timerCount timers, as happens for the idle
+// timeout of a connection whenever there is activity on it.
+void tst_QTimerInfoList::restartTimer()
+{
+    QFETCH(QTimerInfoList::Storage, storage);
+    QFETCH(int, timerCount);
+
+    QObject object;
+    QTimerInfoList list(storage);
+    registerIdleTimers(list, timerCount, &object);
+
+    QBENCHMARK {
+        const int id = QRandomGenerator::global()->bounded(timerCount) + 1;
+        list.unregisterTimer(id);
+        list.registerTimer(id, randomInterval(), Qt::CoarseTimer, &object);
+    }
+
+    QCOMPARE(list.size(), timerCount);
+}
+
+// Registers and unregisters one more timer next to timerCount others.
+void tst_QTimerInfoList::registerAndUnregister()
+{
+    QFETCH(QTimerInfoList::Storage, storage);
+    QFETCH(int, timerCount);
+
+    QObject object;
+    QTimerInfoList list(storage);
+    registerIdleTimers(list, timerCount, &object);
+
+    const int id = timerCount + 1;
+    QBENCHMARK {
+        list.registerTimer(id, randomInterval(), Qt::PreciseTimer, &object);
+        list.unregisterTimer(id);
+    }
+
+    QCOMPARE(list.size(), timerCount);
+}
+
+// Fires a zero timer while timerCount other timers are waiting.
+void tst_QTimerInfoList::activateTimers()
+{
+    QFETCH(QTimerInfoList::Storage, storage);
+    QFETCH(int, timerCount);
+
+    QObject object;
+    QTimerInfoList list(storage);
+    registerIdleTimers(list, timerCount, &object);
+    list.registerTimer(timerCount + 1, 0ms, Qt::PreciseTimer, &object);
+
+    int activated = 0;
+    QBENCHMARK {
+        list.activateTimers();
+        ++activated;
+    }
+
+    QVERIFY(activated > 0);
+}
+
+QTEST_MAIN(tst_QTimerInfoList)
+
+#include "tst_bench_qtimerinfolist.moc"
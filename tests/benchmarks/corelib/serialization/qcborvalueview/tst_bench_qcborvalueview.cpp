@@ -0,0 +1,129 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QCborStreamWriter>
+#include <QCborValueView>
+#include <QTemporaryFile>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCborValueView : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void lookupCborValue_data() { lookup_data(); }
+    void lookupCborValue();
+    void lookupView_data() { lookup_data(); }
+    void lookupView();
+    void lookupValidatedView_data() { lookup_data(); }
+    void lookupValidatedView();
+
+private:
+    void lookup_data();
+
+    QTemporaryFile file;
+    QByteArrayView data;
+};
+
+static constexpr qsizetype RecordCount = 1'000'000;
+
+// Writes a map with an array of records of about 100 bytes each
+static void writeDocument(QIODevice *device)
+{
+    QCborStreamWriter writer(device);
+    writer.startMap(2);
+    writer.append("version"_L1);
+    writer.append(1);
+    writer.append("records"_L1);
+    writer.startArray(RecordCount);
+    const QByteArray payload(32, 'x');
+    for (qsizetype i = 0; i < RecordCount; ++i) {
+        writer.startMap(4);
+        writer.append("id"_L1);
+        writer.append(qint64(i));
+        writer.append("name"_L1);
+        writer.append(QString::asprintf("record %lld", qlonglong(i)));
+        writer.append("tags"_L1);
+        writer.startArray(3);
+        writer.append("alpha"_L1);
+        writer.append("beta"_L1);
+        writer.append(i % 7 == 0);
+        writer.endArray();
+        writer.append("payload"_L1);
+        writer.append(payload);
+        writer.endMap();
+    }
+    writer.endArray();
+    writer.endMap();
+}
+
+void tst_QCborValueView::initTestCase()
+{
+    QVERIFY(file.open());
+    writeDocument(&file);
+    QVERIFY(file.flush());
+    const uchar *mapped = file.map(0, file.size());
+    QVERIFY(mapped);
+    data = QByteArrayView(mapped, file.size());
+    qDebug("Document size: %lld MB", qlonglong(data.size() >> 20));
+}
+
+void tst_QCborValueView::cleanupTestCase()
+{
+    file.close();
+}
+
+void tst_QCborValueView::lookup_data()
+{
+    QTest::addColumn<qsizetype>("index");
+
+    QTest::newRow("first") << qsizetype(0);
+    QTest::newRow("middle") << RecordCount / 2;
+    QTest::newRow("last") << RecordCount - 1;
+}
+
+void tst_QCborValueView::lookupCborValue()
+{
+    QFETCH(qsizetype, index);
+    const QByteArray bytes = QByteArray::fromRawData(data.data(), data.size());
+
+    QString name;
+    QBENCHMARK {
+        const QCborValue document = QCborValue::fromCbor(bytes);
+        name = document["records"_L1][index]["name"_L1].toString();
+    }
+    QCOMPARE(name, u"record "_s + QString::number(index));
+}
+
+void tst_QCborValueView::lookupView()
+{
+    QFETCH(qsizetype, index);
+
+    QString name;
+    QBENCHMARK {
+        const QCborValueView document = QCborValueView::fromCbor(data);
+        name = document["records"][index]["name"].toString();
+    }
+    QCOMPARE(name, u"record "_s + QString::number(index));
+}
+
+void tst_QCborValueView::lookupValidatedView()
+{
+    QFETCH(qsizetype, index);
+
+    // the document was validated earlier, for instance when it was loaded
+    const QCborValueView document = QCborValueView::fromCbor(data);
+    QString name;
+    QBENCHMARK {
+        name = document["records"][index]["name"].toString();
+    }
+    QCOMPARE(name, u"record "_s + QString::number(index));
+}
+
+QTEST_MAIN(tst_QCborValueView)
+
+#include "tst_bench_qcborvalueview.moc"
@@ -0,0 +1,166 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QBuffer>
+#include <QDataStream>
+
+class tst_QDataStream : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void writeList_data() { lists_data(); }
+    void writeList();
+    void writeElements_data() { lists_data(); }
+    void writeElements();
+    void readList_data() { lists_data(); }
+    void readList();
+    void readElements_data() { lists_data(); }
+    void readElements();
+
+private:
+    void lists_data();
+};
+
+enum class ElementType { Float, Double, Int32 };
+
+void tst_QDataStream::lists_data()
+{
+    QTest::addColumn<ElementType>("type");
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+
+    const auto addRows = [](const char *name, ElementType type,
+                            QDataStream::FloatingPointPrecision precision) {
+        QTest::addRow("%s, big-endian", name) << type << QDataStream::BigEndian << precision;
+        QTest::addRow("%s, little-endian", name) << type << QDataStream::LittleEndian << precision;
+    };
+    addRows("float", ElementType::Float, QDataStream::SinglePrecision);
+    addRows("float as double", ElementType::Float, QDataStream::DoublePrecision);
+    addRows("double", ElementType::Double, QDataStream::DoublePrecision);
+    addRows("qint32", ElementType::Int32, QDataStream::DoublePrecision);
+}
+
+// one million samples of each type
+static constexpr qsizetype SampleCount = 1000 * 1000;
+
+template <typename T>
+static QList<T> samples()
+{
+    QList<T> list(SampleCount);
+    for (qsizetype i = 0; i < SampleCount; ++i)
+        list[i] = T(i % 4096) - T(2048);
+    return list;
+}
+
+template <typename T>
+static void benchmarkWrite(QDataStream::ByteOrder byteOrder,
+                           QDataStream::FloatingPointPrecision precision, bool elementWise)
+{
+    const QList<T> list = samples<T>();
+    QByteArray data;
+    data.reserve(SampleCount * sizeof(double) + sizeof(quint32));
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&buffer);
+    stream.setByteOrder(byteOrder);
+    stream.setFloatingPointPrecision(precision);
+
+    QBENCHMARK {
+        buffer.seek(0);
+        if (elementWise) {
+            stream << quint32(list.size());
+            for (T value : list)
+                stream << value;
+        } else {
+            stream << list;
+        }
+    }
+    QCOMPARE(stream.status(), QDataStream::Ok);
+}
+
+template <typename T>
+static void benchmarkRead(QDataStream::ByteOrder byteOrder,
+                          QDataStream::FloatingPointPrecision precision, bool elementWise)
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setByteOrder(byteOrder);
+        stream.setFloatingPointPrecision(precision);
+        stream << samples<T>();
+    }
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream stream(&buffer);
+    stream.setByteOrder(byteOrder);
+    stream.setFloatingPointPrecision(precision);
+
+    QList<T> list;
+    QBENCHMARK {
+        buffer.seek(0);
+        if (elementWise) {
+            quint32 n;
+            stream >> n;
+            list.clear();
+            list.reserve(n);
+            for (quint32 i = 0; i < n; ++i) {
+                T value;
+                stream >> value;
+                list.append(value);
+            }
+        } else {
+            stream >> list;
+        }
+    }
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QCOMPARE(list.size(), SampleCount);
+}
+
+using BenchmarkFunction = void (*)(QDataStream::ByteOrder, QDataStream::FloatingPointPrecision,
+                                   bool);
+
+static void run(BenchmarkFunction floatRun, BenchmarkFunction doubleRun,
+                BenchmarkFunction int32Run, bool elementWise)
+{
+    QFETCH(ElementType, type);
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+
+    switch (type) {
+    case ElementType::Float:
+        floatRun(byteOrder, precision, elementWise);
+        break;
+    case ElementType::Double:
+        doubleRun(byteOrder, precision, elementWise);
+        break;
+    case ElementType::Int32:
+        int32Run(byteOrder, precision, elementWise);
+        break;
+    }
+}
+
+void tst_QDataStream::writeList()
+{
+    run(benchmarkWrite<float>, benchmarkWrite<double>, benchmarkWrite<qint32>, false);
+}
+
+void tst_QDataStream::writeElements()
+{
+    run(benchmarkWrite<float>, benchmarkWrite<double>, benchmarkWrite<qint32>, true);
+}
+
+void tst_QDataStream::readList()
+{
+    run(benchmarkRead<float>, benchmarkRead<double>, benchmarkRead<qint32>, false);
+}
+
+void tst_QDataStream::readElements()
+{
+    run(benchmarkRead<float>, benchmarkRead<double>, benchmarkRead<qint32>, true);
+}
+
+QTEST_MAIN(tst_QDataStream)
+
+#include "tst_bench_qdatastream.moc"
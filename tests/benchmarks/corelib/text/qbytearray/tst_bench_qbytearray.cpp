@@ -31,6 +31,13 @@ private slots:
 
     void toPercentEncoding_data();
     void toPercentEncoding();
+
+    void toLower_data();
+    void toLower();
+    void toUpper_data() { toLower_data(); }
+    void toUpper();
+    void compareCaseInsensitive_data();
+    void compareCaseInsensitive();
 };
 
 void tst_QByteArray::initTestCase()
@@ -353,6 +360,54 @@ void tst_QByteArray::toPercentEncoding()
     QTEST(encoded, "expected");
 }
 
+void tst_QByteArray::toLower_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("source code") << sourcecode;
+    QTest::newRow("lowercase") << sourcecode.toLower();
+    QTest::newRow("uppercase") << sourcecode.toUpper();
+    QTest::newRow("short") << QByteArray("Content-Type");
+}
+
+void tst_QByteArray::toLower()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = data.toLower();
+    }
+}
+
+void tst_QByteArray::toUpper()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = data.toUpper();
+    }
+}
+
+void tst_QByteArray::compareCaseInsensitive_data()
+{
+    QTest::addColumn<QByteArray>("lhs");
+    QTest::addColumn<QByteArray>("rhs");
+
+    QTest::newRow("same case") << sourcecode << sourcecode;
+    QTest::newRow("other case") << sourcecode.toLower() << sourcecode.toUpper();
+    QTest::newRow("short") << QByteArray("Content-Type") << QByteArray("content-type");
+}
+
+void tst_QByteArray::compareCaseInsensitive()
+{
+    QFETCH(QByteArray, lhs);
+    QFETCH(QByteArray, rhs);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = lhs.compare(rhs, Qt::CaseInsensitive);
+    }
+}
+
 QTEST_MAIN(tst_QByteArray)
 
 #include "tst_bench_qbytearray.moc"
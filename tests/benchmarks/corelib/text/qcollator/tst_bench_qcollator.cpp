@@ -0,0 +1,126 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCollator>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCollator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void stdSort_data();
+    void stdSort();
+    void sortKeyLoop_data() { stdSort_data(); }
+    void sortKeyLoop();
+    void sortKeys_data() { stdSort_data(); }
+    void sortKeys();
+    void collatorSort_data() { stdSort_data(); }
+    void collatorSort();
+    void compareRepeatedly_data();
+    void compareRepeatedly();
+};
+
+// File names like those of a large directory listing
+static QStringList fileNames(qsizetype count)
+{
+    const QStringList stems = { u"Report"_s, u"résumé"_s, u"IMG_"_s, u"Straße"_s, u"notes"_s,
+                                u"Übersicht"_s, u"backup-"_s, u"Ölpreise"_s, u"zebra"_s };
+    const QStringList suffixes = { u".txt"_s, u".jpg"_s, u".pdf"_s, u".tar.gz"_s };
+    QRandomGenerator generator(1234);
+    QStringList names;
+    names.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        names.append(stems.at(generator.bounded(stems.size()))
+                     + QString::number(generator.bounded(100000))
+                     + suffixes.at(generator.bounded(suffixes.size())));
+    }
+    return names;
+}
+
+void tst_QCollator::stdSort_data()
+{
+    QTest::addColumn<QStringList>("strings");
+
+    QTest::newRow("1000") << fileNames(1000);
+    QTest::newRow("100000") << fileNames(100000);
+}
+
+void tst_QCollator::stdSort()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+
+    QBENCHMARK {
+        QStringList copy = strings;
+        std::sort(copy.begin(), copy.end(), collator);
+    }
+}
+
+void tst_QCollator::sortKeyLoop()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+
+    QBENCHMARK {
+        QList<QCollatorSortKey> keys;
+        keys.reserve(strings.size());
+        for (const QString &string : std::as_const(strings))
+            keys.append(collator.sortKey(string));
+    }
+}
+
+void tst_QCollator::sortKeys()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+
+    QBENCHMARK {
+        [[maybe_unused]] auto keys = collator.sortKeys(strings);
+    }
+}
+
+void tst_QCollator::collatorSort()
+{
+    QFETCH(QStringList, strings);
+    const QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+
+    QBENCHMARK {
+        QStringList copy = strings;
+        collator.sort(copy);
+    }
+}
+
+void tst_QCollator::compareRepeatedly_data()
+{
+    QTest::addColumn<qsizetype>("cacheCapacity");
+
+    QTest::newRow("no cache") << qsizetype(0);
+    QTest::newRow("cache") << qsizetype(1000);
+}
+
+void tst_QCollator::compareRepeatedly()
+{
+    // a view re-sorting the same rows, as when the user toggles the sort order
+    QFETCH(qsizetype, cacheCapacity);
+    QCollator collator(QLocale(QLocale::German, QLocale::Germany));
+    collator.setSortKeyCacheCapacity(cacheCapacity);
+    const QStringList strings = fileNames(500);
+
+    QBENCHMARK {
+        QStringList copy = strings;
+        std::sort(copy.begin(), copy.end(), collator);
+        std::sort(copy.begin(), copy.end(), [&collator](const QString &lhs, const QString &rhs) {
+            return collator.compare(rhs, lhs) < 0;
+        });
+    }
+}
+
+QTEST_MAIN(tst_QCollator)
+
+#include "tst_bench_qcollator.moc"
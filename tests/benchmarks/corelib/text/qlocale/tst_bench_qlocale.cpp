@@ -37,6 +37,10 @@ private Q_SLOTS:
     void toULongLong();
     void toDouble_data();
     void toDouble();
+    void toDoubleFields_data();
+    void toDoubleFields();
+    void toStringDouble_data();
+    void toStringDouble();
 };
 
 static QString data()
@@ -588,6 +592,70 @@ void tst_QLocale::toDouble()
     QCOMPARE(actual, expected);
 }
 
+// Values as they appear in the columns of a CSV file
+static QList<double> fieldValues()
+{
+    QList<double> values;
+    values.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+        values.append((i * 7919 % 100003) / 100.0 - 250.0 + (i % 3 ? 0 : i * 1e-7));
+    return values;
+}
+
+void tst_QLocale::toDoubleFields_data()
+{
+    QTest::addColumn<QString>("locale");
+
+    QTest::newRow("C") << u"C"_s;
+    QTest::newRow("en") << u"en"_s;
+    QTest::newRow("de") << u"de"_s;
+    QTest::newRow("ar_EG") << u"ar_EG"_s;
+}
+
+void tst_QLocale::toDoubleFields()
+{
+    QFETCH(QString, locale);
+    const QLocale loc(locale);
+    QStringList fields;
+    for (double value : fieldValues())
+        fields.append(loc.toString(value, 'g', QLocale::FloatingPointShortest));
+
+    double sum = 0;
+    QBENCHMARK {
+        for (const QString &field : std::as_const(fields))
+            sum += loc.toDouble(field);
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_QLocale::toStringDouble_data()
+{
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<char>("format");
+    QTest::addColumn<int>("precision");
+
+    QTest::newRow("C, shortest") << u"C"_s << 'g' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("C, 6 digits") << u"C"_s << 'g' << 6;
+    QTest::newRow("C, shortest, fixed") << u"C"_s << 'f' << int(QLocale::FloatingPointShortest);
+    QTest::newRow("de, shortest") << u"de"_s << 'g' << int(QLocale::FloatingPointShortest);
+}
+
+void tst_QLocale::toStringDouble()
+{
+    QFETCH(QString, locale);
+    QFETCH(char, format);
+    QFETCH(int, precision);
+    const QLocale loc(locale);
+    const QList<double> values = fieldValues();
+
+    QString s;
+    QBENCHMARK {
+        for (double value : values)
+            s = loc.toString(value, format, precision);
+    }
+    QVERIFY(!s.isEmpty());
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
@@ -0,0 +1,144 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QMultiStringMatcher>
+#include <QStringMatcher>
+#include <QTest>
+
+using namespace Qt::StringLiterals;
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data() { keywords_data(); }
+    void construct();
+    void stringMatcherLoop_data() { keywords_data(); }
+    void stringMatcherLoop();
+    void multiStringMatcher_data() { keywords_data(); }
+    void multiStringMatcher();
+    void multiStringMatcherUtf8_data() { keywords_data(); }
+    void multiStringMatcherUtf8();
+
+private:
+    void keywords_data();
+};
+
+// Pseudo-words, so that the keywords share prefixes and the lines contain
+// near-misses, as real log lines and keyword lists do
+static QString word(quint32 n)
+{
+    static const char16_t syllables[][4] = {
+        u"ka", u"lo", u"mi", u"net", u"pos", u"ra", u"sen", u"tu", u"vi", u"zor"
+    };
+    QString result;
+    do {
+        result += QStringView(syllables[n % 10]);
+        n /= 10;
+    } while (n);
+    return result;
+}
+
+static QStringList keywords(int count)
+{
+    QStringList result;
+    for (int i = 0; i < count; ++i)
+        result.append(word(1000 + i * 7919 % 9000));
+    return result;
+}
+
+static const QStringList &lines()
+{
+    static const QStringList result = [] {
+        QStringList lines;
+        quint32 n = 1;
+        for (int i = 0; i < 1000; ++i) {
+            QString line = u"2023-06-01T12:00:00 qt.core: "_s;
+            for (int j = 0; j < 12; ++j) {
+                n = n * 1103515245 + 12345;
+                line += word((n >> 8) % 100000) + u' ';
+            }
+            lines.append(line);
+        }
+        return lines;
+    }();
+    return result;
+}
+
+void tst_QMultiStringMatcher::keywords_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("500") << 500;
+}
+
+void tst_QMultiStringMatcher::construct()
+{
+    QFETCH(const int, count);
+    const QStringList patterns = keywords(count);
+
+    QBENCHMARK {
+        const QMultiStringMatcher matcher(patterns);
+        Q_UNUSED(matcher);
+    }
+}
+
+void tst_QMultiStringMatcher::stringMatcherLoop()
+{
+    QFETCH(const int, count);
+    QList<QStringMatcher> matchers;
+    for (const QString &pattern : keywords(count))
+        matchers.append(QStringMatcher(pattern));
+    const QStringList &haystacks = lines();
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &line : haystacks) {
+            for (const QStringMatcher &matcher : std::as_const(matchers)) {
+                for (qsizetype from = 0; (from = matcher.indexIn(line, from)) >= 0; ++from)
+                    ++found;
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcher()
+{
+    QFETCH(const int, count);
+    const QMultiStringMatcher matcher(keywords(count));
+    const QStringList &haystacks = lines();
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &line : haystacks)
+            found += matcher.matches(line).size();
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QMultiStringMatcher::multiStringMatcherUtf8()
+{
+    QFETCH(const int, count);
+    const QMultiStringMatcher matcher(keywords(count));
+    QByteArrayList haystacks;
+    for (const QString &line : lines())
+        haystacks.append(line.toUtf8());
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QByteArray &line : std::as_const(haystacks))
+            found += matcher.matches(line).size();
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+
+#include "tst_bench_qmultistringmatcher.moc"
@@ -2,7 +2,11 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QRegularExpression>
+#include <QScopeGuard>
 #include <QTest>
+#include <QThread>
+
+#include <private/qregularexpression_p.h>
 
 /*!
     \internal
@@ -45,6 +49,11 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void constructAndMatch_data();
+    void constructAndMatch();
+    void constructAndMatchInThreads_data() { constructAndMatch_data(); }
+    void constructAndMatchInThreads();
 };
 
 void tst_QRegularExpressionBenchmark::createDefault()
@@ -88,8 +97,8 @@ void tst_QRegularExpressionBenchmark::createAndMoveCustom()
 /*!
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for a default-constructed object.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    We create the object every time, so that its pattern gets compiled again,
+    or looked up in the cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::matchDefault()
 {
@@ -123,8 +132,8 @@ void tst_QRegularExpressionBenchmark::matchDefaultOptimized()
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for an object with custom pattern and pattern
     options.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    We create the object every time, so that its pattern gets compiled again,
+    or looked up in the cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::matchCustom()
 {
@@ -154,8 +163,8 @@ void tst_QRegularExpressionBenchmark::matchCustomOptimized()
 /*!
     \internal This benchmark measures the performance of the globalMatch()
     together with the pattern compilation for a default-constructed object.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    We create the object every time, so that its pattern gets compiled again,
+    or looked up in the cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::globalMatchDefault()
 {
@@ -189,8 +198,8 @@ void tst_QRegularExpressionBenchmark::globalMatchDefaultOptimized()
     \internal This benchmark measures the performance of the globalMatch()
     together with the pattern compilation for an object with custom pattern
     and pattern options.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    We create the object every time, so that its pattern gets compiled again,
+    or looked up in the cache of compiled patterns.
 */
 void tst_QRegularExpressionBenchmark::globalMatchCustom()
 {
@@ -270,6 +279,71 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+void tst_QRegularExpressionBenchmark::constructAndMatch_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("cached") << true;
+    QTest::newRow("uncached") << false;
+}
+
+/*!
+    \internal This benchmark measures the common pattern of constructing a
+    QRegularExpression right before using it, in a loop, with and without the
+    cache of compiled patterns.
+*/
+void tst_QRegularExpressionBenchmark::constructAndMatch()
+{
+    QFETCH(const bool, cached);
+
+    const qsizetype maxCost = QtPrivate::regularExpressionCacheStatistics().maxCost;
+    if (!cached)
+        QtPrivate::setRegularExpressionCacheMaxCost(0);
+    const auto restoreMaxCost = qScopeGuard([&] {
+        QtPrivate::setRegularExpressionCacheMaxCost(maxCost);
+    });
+
+    QBENCHMARK {
+        const QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+}
+
+/*!
+    \internal Same as constructAndMatch(), in as many threads as there are
+    cores, which all use the same pattern.
+*/
+void tst_QRegularExpressionBenchmark::constructAndMatchInThreads()
+{
+    QFETCH(const bool, cached);
+
+    const qsizetype maxCost = QtPrivate::regularExpressionCacheStatistics().maxCost;
+    if (!cached)
+        QtPrivate::setRegularExpressionCacheMaxCost(0);
+    const auto restoreMaxCost = qScopeGuard([&] {
+        QtPrivate::setRegularExpressionCacheMaxCost(maxCost);
+    });
+
+    const int threadCount = QThread::idealThreadCount();
+    QBENCHMARK {
+        QList<QThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.append(QThread::create([] {
+                for (int j = 0; j < 1000; ++j) {
+                    const QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+                    auto matchResult = re.match(textToMatch);
+                    Q_UNUSED(matchResult);
+                }
+            }));
+            threads.last()->start();
+        }
+        for (QThread *thread : std::as_const(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
@@ -25,6 +25,12 @@ private slots:
     void toLower();
     void toCaseFolded_data();
     void toCaseFolded();
+    void compareCaseInsensitive_data();
+    void compareCaseInsensitive();
+    void compareCaseInsensitiveLatin1_data() { compareCaseInsensitive_data(); }
+    void compareCaseInsensitiveLatin1();
+    void compareCaseInsensitiveLatin1Latin1_data() { compareCaseInsensitive_data(); }
+    void compareCaseInsensitiveLatin1Latin1();
 
     // Serializing:
     void number_qlonglong_data();
@@ -46,7 +52,57 @@ private slots:
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
-    template <typename Integer> void number_impl();
+    void tst_QString::compareCaseInsensitive_data()
+{
+    QTest::addColumn<QString>("lhs");
+    QTest::addColumn<QString>("rhs");
+
+    const QString text = u"The Quick Brown Fox Jumps Over The Lazy Dog. "_s.repeated(13);
+    const QString accented = u"Ça Déçoit Où Était L'Âne Ému À Noël. "_s.repeated(16);
+
+    QTest::newRow("ASCII, same case") << text << text;
+    QTest::newRow("ASCII, other case") << text << text.toUpper();
+    QTest::newRow("Latin-1, other case") << accented << accented.toUpper();
+    QTest::newRow("short") << u"Content-Type"_s << u"content-type"_s;
+}
+
+void tst_QString::compareCaseInsensitive()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+    // defeat the same-data shortcut
+    rhs.detach();
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = lhs.compare(rhs, Qt::CaseInsensitive);
+    }
+}
+
+void tst_QString::compareCaseInsensitiveLatin1()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+    const QByteArray latin1 = rhs.toLatin1();
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = lhs.compare(QLatin1StringView(latin1), Qt::CaseInsensitive);
+    }
+}
+
+void tst_QString::compareCaseInsensitiveLatin1Latin1()
+{
+    QFETCH(QString, lhs);
+    QFETCH(QString, rhs);
+    const QByteArray lhsLatin1 = lhs.toLatin1();
+    const QByteArray rhsLatin1 = rhs.toLatin1();
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = QLatin1StringView(lhsLatin1).compare(QLatin1StringView(rhsLatin1),
+                                                                       Qt::CaseInsensitive);
+    }
+}
+
+template <typename Integer> void number_impl();
 };
 
 tst_QString::tst_QString()
@@ -126,6 +182,8 @@ void tst_QString::toUpper_data()
 
     QString lowerLigature(600, QChar(0xFB03));
 
+    const QString text = u"The Quick Brown Fox Jumps Over The Lazy Dog. "_s.repeated(13);
+
     QTest::newRow("600<a>") << (lowerLatin1 + lowerLatin1);
     QTest::newRow("600<A>") << (upperLatin1 + upperLatin1);
 
@@ -144,6 +202,8 @@ void tst_QString::toUpper_data()
     QTest::newRow("300A+150<10428>") << (upperLatin1 + lowerDeseret);
 
     QTest::newRow("600<FB03> (ligature)") << lowerLigature;
+
+    QTest::newRow("mixed-case ASCII text") << text;
 }
 
 void tst_QString::toUpper()
@@ -24,6 +24,11 @@ struct QRecursiveReadWriteLock : QReadWriteLock
     QRecursiveReadWriteLock() : QReadWriteLock(Recursive) {}
 };
 
+struct QReaderPreferringReadWriteLock : QReadWriteLock
+{
+    QReaderPreferringReadWriteLock() : QReadWriteLock(NonRecursive, PreferReaders) {}
+};
+
 template <typename T, size_t N>
   // requires N = 2^M for some Integral M >= 0
 struct Recursive
@@ -82,7 +87,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
-    // void readWrite();
+    void readWrite_data();
+    void readWrite();
 };
 
 struct FunctionPtrHolder
@@ -294,5 +300,88 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+static QHash<int, QString> global_cache;
+
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReadWrite()
+{
+    // The threads share the work, so that the results show how well it scales.
+    // One access in WriteInterval is a write.
+    enum { WriteInterval = 16 };
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        int first;
+        void run() override
+        {
+            const int count = Iterations / threadCount;
+            for (int i = first; i < first + count; ++i) {
+                const int key = i % 1024;
+                if (i % WriteInterval == 0) {
+                    QString s = QString::number(i); // Do something outside the lock
+                    WriteLocker locker(lock);
+                    global_cache.insert(key, s);
+                } else {
+                    ReadLocker locker(lock);
+                    global_cache.contains(key);
+                }
+            }
+        }
+    };
+    Mutex lock;
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        auto t = std::make_unique<Thread>();
+        t->lock = &lock;
+        t->first = i * (Iterations / threadCount);
+        threads.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : threads) {
+            t->start();
+        }
+        for (auto &t : threads) {
+            t->wait();
+        }
+    }
+}
+
+void tst_QReadWriteLock::readWrite_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+    QTest::addColumn<int>("threads");
+
+    for (int threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        QTest::addRow("QMutex, %d threads", threads)
+            << FunctionPtrHolder(testReadWrite<QMutex, QMutexLocker<QMutex>,
+                                               QMutexLocker<QMutex>>)
+            << threads;
+        QTest::addRow("QReadWriteLock, %d threads", threads)
+            << FunctionPtrHolder(testReadWrite<QReadWriteLock, QReadLocker, QWriteLocker>)
+            << threads;
+        QTest::addRow("QReadWriteLock, PreferReaders, %d threads", threads)
+            << FunctionPtrHolder(testReadWrite<QReaderPreferringReadWriteLock, QReadLocker,
+                                               QWriteLocker>)
+            << threads;
+#ifdef __cpp_lib_shared_mutex
+        QTest::addRow("std::shared_mutex, %d threads", threads)
+            << FunctionPtrHolder(
+                   testReadWrite<std::shared_mutex,
+                                 LockerWrapper<std::shared_lock<std::shared_mutex>>,
+                                 LockerWrapper<std::unique_lock<std::shared_mutex>>>)
+            << threads;
+#endif
+    }
+}
+
+void tst_QReadWriteLock::readWrite()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    QFETCH(int, threads);
+    const int defaultThreadCount = std::exchange(threadCount, threads);
+    holder.value();
+    threadCount = defaultThreadCount;
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
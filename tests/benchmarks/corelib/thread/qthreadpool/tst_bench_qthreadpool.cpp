@@ -15,6 +15,13 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void startRunnablesScaling_data() { scaling_data(); }
+    void startRunnablesScaling();
+    void fanOutScaling_data() { scaling_data(); }
+    void fanOutScaling();
+
+private:
+    void scaling_data();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +57,70 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::scaling_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int threadCount = 1; ; threadCount = qMin(threadCount * 2, idealThreadCount)) {
+        QTest::addRow("%d-threads", threadCount) << threadCount << false;
+        QTest::addRow("%d-threads-work-stealing", threadCount) << threadCount << true;
+        if (threadCount == idealThreadCount)
+            break;
+    }
+}
+
+// the mode is picked when the pool is created
+static std::unique_ptr<QThreadPool> createThreadPool(int threadCount, bool workStealing)
+{
+    if (workStealing)
+        qputenv("QT_THREADPOOL_WORK_STEALING", "1");
+    auto threadPool = std::make_unique<QThreadPool>();
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+    threadPool->setMaxThreadCount(threadCount);
+    return threadPool;
+}
+
+void tst_QThreadPool::startRunnablesScaling()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    const auto threadPool = createThreadPool(threadCount, workStealing);
+    constexpr int taskCount = 10000;
+    QSemaphore done;
+
+    QBENCHMARK {
+        for (int i = 0; i < taskCount; ++i)
+            threadPool->start([&done] { done.release(); });
+        done.acquire(taskCount);
+    }
+}
+
+void tst_QThreadPool::fanOutScaling()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    const auto threadPool = createThreadPool(threadCount, workStealing);
+    constexpr int rootCount = 64;
+    constexpr int childCount = 256;
+    QSemaphore done;
+
+    // short tasks started from the worker threads, as QtConcurrent and
+    // recursive algorithms do
+    QBENCHMARK {
+        for (int i = 0; i < rootCount; ++i) {
+            threadPool->start([&] {
+                for (int j = 0; j < childCount; ++j)
+                    threadPool->start([&done] { done.release(); });
+            });
+        }
+        done.acquire(rootCount * childCount);
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
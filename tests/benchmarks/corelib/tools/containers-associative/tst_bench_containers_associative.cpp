@@ -1,5 +1,6 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <QArenaAllocator>
 #include <QString>
 #include <QMap>
 #include <QHash>
@@ -14,6 +15,8 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void temporaries_data();
+    void temporaries();
 };
 
 template <typename T>
@@ -103,6 +106,40 @@ void tst_associative_containers::lookup()
     }
 }
 
+void tst_associative_containers::temporaries_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 10, 100, 1000 }) {
+        const QByteArray sizeString = QByteArray::number(size);
+        QTest::newRow(QByteArray("heap--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("arena--" + sizeString).constData()) << true << size;
+    }
+}
+
+// Builds many short-lived hashes, as a request handler would.
+void tst_associative_containers::temporaries()
+{
+    QFETCH(bool, useArena);
+    QFETCH(int, size);
+
+    QArenaAllocator arena;
+    qsizetype total = 0;
+    QBENCHMARK {
+        for (int round = 0; round < 100; ++round) {
+            {
+                QHash<int, int> hash = useArena ? arena.hash<int, int>() : QHash<int, int>();
+                for (int i = 0; i < size; ++i)
+                    hash.insert(i, i);
+                total += hash.size();
+            }
+            arena.reset();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
 QTEST_MAIN(tst_associative_containers)
 
 #include "tst_bench_containers_associative.moc"
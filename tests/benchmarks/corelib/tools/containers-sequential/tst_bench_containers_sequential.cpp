@@ -124,6 +124,8 @@ private slots:
     void lookup_int();
     void lookup_Large_data();
     void lookup_Large();
+    void temporaries_data();
+    void temporaries();
 };
 
 void tst_vector_vs_std::insert_int_data()
@@ -218,6 +220,44 @@ void tst_vector_vs_std::lookup_Large()
         useCases_QList_Large->lookup(size);
 }
 
+void tst_vector_vs_std::temporaries_data()
+{
+    QTest::addColumn<bool>("useArena");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 10, 100, 1000 }) {
+        const QByteArray sizeString = QByteArray::number(size);
+        QTest::newRow(QByteArray("heap--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("arena--" + sizeString).constData()) << true << size;
+    }
+}
+
+// Builds many short-lived lists of strings, as a request handler would.
+void tst_vector_vs_std::temporaries()
+{
+    QFETCH(bool, useArena);
+    QFETCH(int, size);
+
+    QArenaAllocator arena;
+    qsizetype total = 0;
+    QBENCHMARK {
+        for (int round = 0; round < 100; ++round) {
+            {
+                QList<QString> list = useArena ? arena.list<QString>() : QList<QString>();
+                for (int i = 0; i < size; ++i) {
+                    QString item = useArena ? arena.string() : QString();
+                    item += u"item";
+                    item += QString::number(i);
+                    list.append(std::move(item));
+                }
+                total += list.size();
+            }
+            arena.reset();
+        }
+    }
+    QVERIFY(total > 0);
+}
+
 QTEST_MAIN(tst_vector_vs_std)
 
 #include "tst_bench_containers_sequential.moc"
@@ -0,0 +1,111 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QConcurrentHash>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+// A shared cache of KeyCount items. Each thread does Iterations lookups, and
+// replaces one item every WriteInterval lookups.
+enum { KeyCount = 10000, Iterations = 200000, WriteInterval = 100 };
+
+class LockedHash
+{
+public:
+    int value(const QString &key) const
+    {
+        QReadLocker locker(&lock);
+        return hash.value(key);
+    }
+    void insert(const QString &key, int value)
+    {
+        QWriteLocker locker(&lock);
+        hash.insert(key, value);
+    }
+
+private:
+    mutable QReadWriteLock lock;
+    QHash<QString, int> hash;
+};
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void readMostly_data();
+    void readMostly();
+
+private:
+    QStringList keys;
+};
+
+void tst_QConcurrentHash::initTestCase()
+{
+    for (int i = 0; i < KeyCount; ++i)
+        keys.append(QStringLiteral("host%1.example.com").arg(i));
+}
+
+void tst_QConcurrentHash::readMostly_data()
+{
+    QTest::addColumn<bool>("concurrent");
+    QTest::addColumn<int>("threadCount");
+    for (int threadCount : { 1, 2, 4, 8, 16 }) {
+        QTest::addRow("QHash+QReadWriteLock, %d threads", threadCount) << false << threadCount;
+        QTest::addRow("QConcurrentHash, %d threads", threadCount) << true << threadCount;
+    }
+}
+
+template <typename Hash>
+static void runReadMostly(Hash &hash, const QStringList &keys, int threadCount)
+{
+    for (int i = 0; i < KeyCount; ++i)
+        hash.insert(keys.at(i), i);
+
+    QAtomicInteger<qsizetype> total;
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(QThread::create([&hash, &keys, &total, t] {
+                qsizetype sum = 0;
+                for (int i = 0; i < Iterations; ++i) {
+                    const int key = (i * 31 + t * 997) % KeyCount;
+                    if (i % WriteInterval == 0)
+                        hash.insert(keys.at(key), key);
+                    else
+                        sum += hash.value(keys.at(key));
+                }
+                total.fetchAndAddRelaxed(sum);
+            }));
+            threads.back()->start();
+        }
+        for (auto &thread : threads)
+            thread->wait();
+    }
+    QVERIFY(total.loadRelaxed() > 0);
+}
+
+void tst_QConcurrentHash::readMostly()
+{
+    QFETCH(bool, concurrent);
+    QFETCH(int, threadCount);
+
+    if (concurrent) {
+        QConcurrentHash<QString, int> hash;
+        runReadMostly(hash, keys, threadCount);
+    } else {
+        LockedHash hash;
+        runReadMostly(hash, keys, threadCount);
+    }
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+
+#include "tst_bench_qconcurrenthash.moc"
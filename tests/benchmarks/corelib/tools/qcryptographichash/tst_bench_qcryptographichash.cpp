@@ -4,6 +4,7 @@
 
 #include <QByteArray>
 #include <QCryptographicHash>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QMetaEnum>
 #include <QMessageAuthenticationCode>
@@ -33,6 +34,12 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void throughput_data();
+    void throughput();
+    void hashMany_data();
+    void hashMany();
+    void hashManyLoop_data() { hashMany_data(); }
+    void hashManyLoop();
 
     // QMessageAuthenticationCode:
     void hmac_hash_data() { hash_data(); }
@@ -142,6 +149,86 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::throughput_data()
+{
+    QTest::addColumn<Algorithm>("algo");
+    for_each_algorithm([] (Algorithm algo, const char *name) {
+        if (algo == Algorithm::NumAlgorithms)
+            return;
+        QTest::addRow("%s", name) << algo;
+    });
+}
+
+void tst_QCryptographicHash::throughput()
+{
+    QFETCH(const Algorithm, algo);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    // reports the hashing speed instead of the time taken
+    const QByteArrayView data = blockOfData;
+    qint64 bytes = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        [[maybe_unused]]
+        auto r = QCryptographicHash::hash(data, algo);
+        bytes += data.size();
+    } while (timer.elapsed() < 500);
+    QTest::setBenchmarkResult(bytes * 1e9 / timer.nsecsElapsed(), QTest::BytesPerSecond);
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<Algorithm>("algo");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 64, 1024, 4096 }) {
+        for (Algorithm algo : { Algorithm::Sha1, Algorithm::Sha256, Algorithm::Md5 })
+            QTest::addRow("%s-%d", QMetaEnum::fromType<Algorithm>().valueToKey(algo), size)
+                    << algo << size;
+    }
+}
+
+static QList<QByteArrayView> manyMessages(const QByteArray &data, int size)
+{
+    // 1000 different messages, as hashing a file list would see
+    QList<QByteArrayView> messages;
+    for (int i = 0; i < 1000; ++i)
+        messages.append(QByteArrayView(data).sliced((i * 61) % (data.size() - size), size));
+    return messages;
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const int, size);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    const QList<QByteArrayView> messages = manyMessages(blockOfData, size);
+    QBENCHMARK {
+        [[maybe_unused]]
+        auto r = QCryptographicHash::hashMany(messages, algo);
+    }
+}
+
+void tst_QCryptographicHash::hashManyLoop()
+{
+    QFETCH(const Algorithm, algo);
+    QFETCH(const int, size);
+
+    SKIP_IF_NOT_SUPPORTED(algo);
+
+    const QList<QByteArrayView> messages = manyMessages(blockOfData, size);
+    QBENCHMARK {
+        QByteArrayList r;
+        r.reserve(messages.size());
+        for (QByteArrayView message : messages)
+            r.append(QCryptographicHash::hash(message, algo));
+    }
+}
+
 static QByteArray hmacKey() {
     static QByteArray key = [] {
             QByteArray result(277, Qt::Uninitialized);
@@ -6,6 +6,7 @@
 
 #include <QFile>
 #include <QHash>
+#include <QRandomGenerator>
 #include <QString>
 #include <QStringList>
 #include <QUuid>
@@ -36,8 +37,14 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_int_data() { lookupData(); }
+    void lookup_int();
+    void lookup_string_data() { lookupData(); }
+    void lookup_string();
+
 private:
     void data();
+    void lookupData();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
 
@@ -144,6 +151,68 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+///////////////////// lookups in large hashes /////////////////////
+
+void tst_QHash::lookupData()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("hit");
+    for (int size : { 1'000'000, 2'000'000 }) {
+        QTest::addRow("%d-hit", size) << size << true;
+        QTest::addRow("%d-miss", size) << size << false;
+    }
+}
+
+// Keys 0 to size - 1 are in the hash, the lookups use random keys from that
+// range, or from the next one for misses.
+static QList<int> lookupKeys(int size, bool hit)
+{
+    QRandomGenerator generator(size);
+    QList<int> keys;
+    keys.reserve(100'000);
+    for (int i = 0; i < 100'000; ++i)
+        keys.append(int(generator.bounded(size)) + (hit ? 0 : size));
+    return keys;
+}
+
+void tst_QHash::lookup_int()
+{
+    QFETCH(int, size);
+    QFETCH(bool, hit);
+
+    QHash<int, int> hash;
+    for (int i = 0; i < size; ++i)
+        hash.insert(i, i);
+    const QList<int> keys = lookupKeys(size, hit);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        for (int key : keys)
+            found += hash.contains(key);
+    }
+    QCOMPARE(found > 0, hit);
+}
+
+void tst_QHash::lookup_string()
+{
+    QFETCH(int, size);
+    QFETCH(bool, hit);
+
+    QHash<QString, int> hash;
+    for (int i = 0; i < size; ++i)
+        hash.insert(QString::number(i), i);
+    QStringList keys;
+    for (int key : lookupKeys(size, hit))
+        keys.append(QString::number(key));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        for (const QString &key : std::as_const(keys))
+            found += hash.contains(key);
+    }
+    QCOMPARE(found > 0, hit);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"